@@ -14,6 +14,9 @@
 #include <../impl/API/ewk_context_form_autofill_profile_private.h>
 #endif
 
+#include <tizen_webview/public/tw_favicon_cache_statistics.h>
+#include <tizen_webview/public/tw_http_cache_statistics.h>
+#include <tizen_webview/public/tw_memory_sample.h>
 #include <tizen_webview/public/tw_security_origin.h>
 #include <tizen_webview/public/tw_web_context.h>
 #include <tizen_webview/public/tw_url.h>
@@ -24,6 +27,7 @@
 #include "private/ewk_security_origin_private.h"
 #include "private/chromium_glue.h"
 #include "private/ewk_favicon_database_private.h"
+#include "private/ewk_view_private.h"
 
 
 using tizen_webview::WebContext;
@@ -80,6 +84,18 @@ void ewk_context_proxy_uri_set(Ewk_Context* context, const char* proxy)
     context->SetProxyUri(proxy);
 }
 
+Eina_Bool ewk_context_proxy_set(Ewk_Context* context, const char* proxy, const char* bypass_rule, Ewk_Context_Proxy_Set_Callback callback, void* user_data)
+{
+  EINA_SAFETY_ON_NULL_RETURN_VAL(context, EINA_FALSE);
+  return context->SetProxy(proxy, bypass_rule, callback, user_data);
+}
+
+Eina_Bool ewk_context_proxy_pac_url_set(Ewk_Context* context, const char* pac_url, Ewk_Context_Proxy_Set_Callback callback, void* user_data)
+{
+  EINA_SAFETY_ON_NULL_RETURN_VAL(context, EINA_FALSE);
+  return context->SetProxyPacUrl(pac_url, callback, user_data);
+}
+
 const char* ewk_context_proxy_uri_get(Ewk_Context* context)
 {
   EINA_SAFETY_ON_NULL_RETURN_VAL(context,0);
@@ -158,6 +174,32 @@ Evas_Object* ewk_context_icon_database_icon_object_add(Ewk_Context* context, con
   return context->AddFaviconObject(uri, canvas);
 }
 
+Eina_Bool ewk_context_icon_database_icon_object_add_async(Ewk_Context* context, const char* uri, Evas* canvas, Ewk_Context_Icon_Database_Icon_Object_Add_Callback callback, void* user_data)
+{
+  EINA_SAFETY_ON_NULL_RETURN_VAL(context, EINA_FALSE);
+  EINA_SAFETY_ON_NULL_RETURN_VAL(uri, EINA_FALSE);
+  EINA_SAFETY_ON_NULL_RETURN_VAL(canvas, EINA_FALSE);
+  EINA_SAFETY_ON_NULL_RETURN_VAL(callback, EINA_FALSE);
+  context->AddFaviconObjectAsync(uri, canvas, callback, user_data);
+  return EINA_TRUE;
+}
+
+Eina_Bool ewk_context_icon_database_statistics_get(Ewk_Context* context, Ewk_Icon_Database_Statistics* statistics)
+{
+  EINA_SAFETY_ON_NULL_RETURN_VAL(context, EINA_FALSE);
+  EINA_SAFETY_ON_NULL_RETURN_VAL(statistics, EINA_FALSE);
+  tizen_webview::Favicon_Cache_Statistics tw_statistics;
+  context->GetFaviconCacheStatistics(&tw_statistics);
+  statistics->hits = tw_statistics.hits;
+  statistics->misses = tw_statistics.misses;
+  statistics->evictions = tw_statistics.evictions;
+  statistics->evicted_size = tw_statistics.evicted_size;
+  statistics->count = tw_statistics.count;
+  statistics->size = tw_statistics.size;
+  statistics->capacity = tw_statistics.capacity;
+  return EINA_TRUE;
+}
+
 Eina_Bool ewk_context_local_file_system_all_delete(Ewk_Context *context)
 {
   EINA_SAFETY_ON_NULL_RETURN_VAL(context, EINA_FALSE);
@@ -286,6 +328,41 @@ Ewk_Cache_Model ewk_context_cache_model_get(Ewk_Context* context)
   return chromium_glue::from(context->GetCacheModel());
 }
 
+namespace {
+
+struct HttpCacheStatisticsGetData {
+  Ewk_Context_Http_Cache_Statistics_Get_Callback callback;
+  void* user_data;
+};
+
+void HttpCacheStatisticsGot(const tizen_webview::Http_Cache_Statistics* statistics, void* data)
+{
+  HttpCacheStatisticsGetData* get_data = static_cast<HttpCacheStatisticsGetData*>(data);
+  Ewk_Http_Cache_Statistics ewk_statistics;
+  ewk_statistics.memory_hits = statistics->memory_hits;
+  ewk_statistics.memory_misses = statistics->memory_misses;
+  ewk_statistics.disk_hits = statistics->disk_hits;
+  ewk_statistics.disk_misses = statistics->disk_misses;
+  ewk_statistics.memory_size = statistics->memory_size;
+  ewk_statistics.memory_capacity = statistics->memory_capacity;
+  get_data->callback(&ewk_statistics, get_data->user_data);
+  delete get_data;
+}
+
+} // namespace
+
+Eina_Bool ewk_context_http_cache_statistics_get(Ewk_Context* context, Ewk_Context_Http_Cache_Statistics_Get_Callback callback, void* user_data)
+{
+  EINA_SAFETY_ON_NULL_RETURN_VAL(context, EINA_FALSE);
+  EINA_SAFETY_ON_NULL_RETURN_VAL(callback, EINA_FALSE);
+
+  HttpCacheStatisticsGetData* data = new HttpCacheStatisticsGetData;
+  data->callback = callback;
+  data->user_data = user_data;
+  context->GetHttpCacheStatistics(HttpCacheStatisticsGot, data);
+  return EINA_TRUE;
+}
+
 Eina_Bool ewk_context_cache_disabled_set(Ewk_Context* context, Eina_Bool cacheDisabled)
 {
   EINA_SAFETY_ON_NULL_RETURN_VAL(context, EINA_FALSE);
@@ -351,6 +428,73 @@ void ewk_context_memory_sampler_stop(Ewk_Context* context)
   context->StopMemorySampler();
 }
 
+Eina_Bool ewk_context_memory_sampler_dump_path_set(Ewk_Context* context, const char* path)
+{
+  EINA_SAFETY_ON_NULL_RETURN_VAL(context, EINA_FALSE);
+  context->SetMemorySamplerDumpPath(path);
+  return EINA_TRUE;
+}
+
+namespace {
+
+struct MemoryUsageGetData {
+  Ewk_Context_Memory_Usage_Get_Callback callback;
+  void* user_data;
+};
+
+void MemoryUsageGot(const tizen_webview::Memory_Sample* samples, unsigned count, void* data)
+{
+  MemoryUsageGetData* get_data = static_cast<MemoryUsageGetData*>(data);
+  std::vector<Ewk_Memory_Sample> ewk_samples(count);
+  for (unsigned i = 0; i < count; ++i) {
+    ewk_samples[i].time = samples[i].time;
+    ewk_samples[i].process_type = static_cast<Ewk_Process_Type>(samples[i].process_type);
+    ewk_samples[i].pid = samples[i].pid;
+    ewk_samples[i].rss = samples[i].rss;
+    ewk_samples[i].pss = samples[i].pss;
+    ewk_samples[i].private_dirty = samples[i].private_dirty;
+    ewk_samples[i].web_cache = samples[i].web_cache;
+    ewk_samples[i].v8_heap_used = samples[i].v8_heap_used;
+    ewk_samples[i].v8_heap_total = samples[i].v8_heap_total;
+  }
+  get_data->callback(count ? &ewk_samples[0] : NULL, count, get_data->user_data);
+  delete get_data;
+}
+
+} // namespace
+
+Eina_Bool ewk_context_memory_usage_get(Ewk_Context* context, Ewk_Context_Memory_Usage_Get_Callback callback, void* user_data)
+{
+  EINA_SAFETY_ON_NULL_RETURN_VAL(context, EINA_FALSE);
+  EINA_SAFETY_ON_NULL_RETURN_VAL(callback, EINA_FALSE);
+
+  MemoryUsageGetData* data = new MemoryUsageGetData;
+  data->callback = callback;
+  data->user_data = user_data;
+  context->GetMemoryUsage(MemoryUsageGot, data);
+  return EINA_TRUE;
+}
+
+Eina_Bool ewk_context_session_data_restore(Ewk_Context* context, Evas_Object** views, const char** data, const unsigned* lengths, unsigned count, unsigned foreground, Ewk_Context_Session_Restore_Callback callback, void* user_data)
+{
+  EINA_SAFETY_ON_NULL_RETURN_VAL(context, EINA_FALSE);
+  EINA_SAFETY_ON_NULL_RETURN_VAL(views, EINA_FALSE);
+  EINA_SAFETY_ON_NULL_RETURN_VAL(data, EINA_FALSE);
+  EINA_SAFETY_ON_NULL_RETURN_VAL(lengths, EINA_FALSE);
+
+  std::vector<tizen_webview::WebView*> webViews;
+  std::vector<std::string> sessions;
+  for (unsigned i = 0; i < count; ++i) {
+    tizen_webview::WebView* webView = GetWebViewFromEvasObject(views[i]);
+    if (!webView)
+      return EINA_FALSE;
+    webViews.push_back(webView);
+    sessions.push_back(data[i] ? std::string(data[i], lengths[i]) : std::string());
+  }
+
+  return context->RestoreSessions(webViews, sessions, foreground, callback, user_data);
+}
+
 Eina_Bool ewk_context_additional_plugin_path_set(Ewk_Context *context, const char *path)
 {
   EINA_SAFETY_ON_NULL_RETURN_VAL(context, EINA_FALSE);
@@ -361,11 +505,8 @@ Eina_Bool ewk_context_additional_plugin_path_set(Ewk_Context *context, const cha
 
 void ewk_context_memory_saving_mode_set(Ewk_Context* context, Eina_Bool mode)
 {
-  //memory saving mode should be handled in chromium in different way
-  //than it is handled in WebKit, so implementation of this feature
-  //is postponed, for now dummy implementation is enough
-  NOTIMPLEMENTED();
-  return;
+  EINA_SAFETY_ON_NULL_RETURN(context);
+  context->SetMemorySavingMode(mode);
 }
 
 void ewk_context_form_password_data_delete_all(Ewk_Context* context)
@@ -53,6 +53,10 @@ EAPI void ewk_context_delete(Ewk_Context* context);
 /**
  * Notify low memory to free unused memory.
  *
+ * The first notification frees data which is cheap to rebuild. If another one
+ * follows within a few seconds, or memory saving mode is enabled, all caches
+ * that can be recomputed are dropped.
+ *
  * @param o context object to notify low memory.
  *
  * @return @c EINA_TRUE on success or @c EINA_FALSE otherwise.
@@ -62,11 +66,60 @@ EAPI Eina_Bool ewk_context_notify_low_memory(Ewk_Context* ewkContext);
 /**
  * Sets the given proxy URI to network backend of specific context.
  *
+ * Returns right away, requests started after the change reached the
+ * network backend use the proxy. Use ewk_context_proxy_set to be told when.
+ *
  * @param ewkContext context object to set proxy URI.
  * @param proxy URI to set
  */
 EAPI void ewk_context_proxy_uri_set(Ewk_Context* ewkContext, const char* proxy);
 
+/**
+ * Callback for ewk_context_proxy_set and ewk_context_proxy_pac_url_set
+ *
+ * Called once requests started from then on use the new proxy settings.
+ *
+ * @param user_data user_data will be passed when the proxy was set
+ */
+typedef void (*Ewk_Context_Proxy_Set_Callback)(void* user_data);
+
+/**
+ * Sets the proxy and the hosts which bypass it.
+ *
+ * Requests in flight are not affected. Connections are made directly when
+ * @a proxy is @c NULL or empty.
+ *
+ * @param context context object
+ * @param proxy proxy URI, e.g. "http://proxy:8080", or proxy rules such as
+ *        "http=proxy1:80;https=proxy2:443"
+ * @param bypass_rule comma separated hosts, domains ("*.example.com"), IP
+ *        ranges ("10.0.0.0/8") and "<local>" not to use the proxy for, or
+ *        @c NULL
+ * @param callback callback called when the settings are applied, or @c NULL
+ * @param user_data user data passed to @a callback
+ *
+ * @return @c EINA_TRUE on success or @c EINA_FALSE if @a proxy or
+ *         @a bypass_rule can not be parsed, the settings are then unchanged
+ */
+EAPI Eina_Bool ewk_context_proxy_set(Ewk_Context* context, const char* proxy, const char* bypass_rule, Ewk_Context_Proxy_Set_Callback callback, void* user_data);
+
+/**
+ * Makes the proxy of each request be chosen by a proxy auto-config script.
+ *
+ * The script is downloaded by the network backend. Requests in flight are
+ * not affected. Connections are made directly when @a pac_url is @c NULL or
+ * empty, or when the script can not be loaded.
+ *
+ * @param context context object
+ * @param pac_url URL of the PAC script
+ * @param callback callback called when the settings are applied, or @c NULL
+ * @param user_data user data passed to @a callback
+ *
+ * @return @c EINA_TRUE on success or @c EINA_FALSE if @a pac_url is not a
+ *         valid URL, the settings are then unchanged
+ */
+EAPI Eina_Bool ewk_context_proxy_pac_url_set(Ewk_Context* context, const char* pac_url, Ewk_Context_Proxy_Set_Callback callback, void* user_data);
+
 /**
  * Gets the proxy URI from the network backend of specific context.
  *
@@ -185,6 +238,103 @@ typedef void (*Ewk_Context_Did_Start_Download_Callback)(const char* download_url
  */
 typedef Eina_Bool (*Ewk_Context_Override_Mime_For_Url_Callback)(const char* url, const char *mime, char **new_mime);
 
+/**
+ * Callback for ewk_context_session_data_restore
+ *
+ * @param view view whose session was read
+ * @param success @c EINA_TRUE if the session was restored, @c EINA_FALSE if its data was invalid
+ *        or the view navigated before it was read
+ * @param user_data user_data will be passed when ewk_context_session_data_restore is called
+ */
+typedef void (*Ewk_Context_Session_Restore_Callback)(Evas_Object* view, Eina_Bool success, void* user_data);
+
+/**
+ * @brief Kind of process a memory sample was taken from.
+ *
+ * The GPU runs in the browser process, its memory is part of the browser
+ * samples. No sample is reported with @c EWK_PROCESS_TYPE_GPU.
+ */
+typedef enum {
+    EWK_PROCESS_TYPE_BROWSER,
+    EWK_PROCESS_TYPE_RENDERER,
+    EWK_PROCESS_TYPE_GPU
+} Ewk_Process_Type;
+
+/**
+ * @brief Memory use of one process at one point in time, filled by ewk_context_memory_usage_get.
+ *
+ * Sizes are in kB.
+ */
+typedef struct Ewk_Memory_Sample Ewk_Memory_Sample;
+struct Ewk_Memory_Sample {
+    double time;                  /**< seconds since the epoch at which the process was read */
+    Ewk_Process_Type process_type;
+    int pid;
+    size_t rss;                   /**< resident set size */
+    size_t pss;                   /**< proportional set size */
+    size_t private_dirty;         /**< private dirty pages */
+    size_t web_cache;             /**< Blink memory cache, renderers only */
+    size_t v8_heap_used;          /**< used JavaScript heap, renderers only */
+    size_t v8_heap_total;         /**< JavaScript heap size, renderers only */
+};
+
+/**
+ * Callback for ewk_context_memory_usage_get
+ *
+ * @param samples samples ordered by time, one per process and sampling, valid only during the call
+ * @param count number of @a samples
+ * @param user_data user_data will be passed when ewk_context_memory_usage_get is called
+ */
+typedef void (*Ewk_Context_Memory_Usage_Get_Callback)(const Ewk_Memory_Sample* samples, unsigned int count, void* user_data);
+
+/**
+ * @brief Lookups of the HTTP cache tiers, filled by ewk_context_http_cache_statistics_get.
+ *
+ * Every entry the HTTP cache looks up counts once in each tier it is looked up in.
+ */
+typedef struct Ewk_Http_Cache_Statistics Ewk_Http_Cache_Statistics;
+struct Ewk_Http_Cache_Statistics {
+    unsigned int memory_hits;     /**< entries read from the in-memory hot tier */
+    unsigned int memory_misses;
+    unsigned int disk_hits;       /**< entries read from the disk cache */
+    unsigned int disk_misses;     /**< entries in neither tier */
+    size_t memory_size;           /**< bytes held by the hot tier */
+    size_t memory_capacity;       /**< bytes the hot tier may hold */
+};
+
+/**
+ * Callback for ewk_context_http_cache_statistics_get
+ *
+ * @param statistics statistics of the context, valid only during the call
+ * @param user_data user_data will be passed when ewk_context_http_cache_statistics_get is called
+ */
+typedef void (*Ewk_Context_Http_Cache_Statistics_Get_Callback)(const Ewk_Http_Cache_Statistics* statistics, void* user_data);
+
+/**
+ * Callback for ewk_context_icon_database_icon_object_add_async
+ *
+ * @param icon newly allocated Evas_Object instance or @c 0 if there is no icon for the URL,
+ *        delete the object with evas_object_del()
+ * @param user_data user_data will be passed when ewk_context_icon_database_icon_object_add_async is called
+ */
+typedef void (*Ewk_Context_Icon_Database_Icon_Object_Add_Callback)(Evas_Object* icon, void* user_data);
+
+/**
+ * @brief Favicon bitmaps kept in memory, filled by ewk_context_icon_database_statistics_get.
+ *
+ * Counts are taken since the icon database was first used.
+ */
+typedef struct Ewk_Icon_Database_Statistics Ewk_Icon_Database_Statistics;
+struct Ewk_Icon_Database_Statistics {
+    unsigned int hits;            /**< icons found in memory */
+    unsigned int misses;          /**< icons read from the database */
+    unsigned int evictions;       /**< icons dropped from memory */
+    size_t evicted_size;          /**< bytes of the dropped icons */
+    unsigned int count;           /**< icons in memory */
+    size_t size;                  /**< bytes of the icons in memory */
+    size_t capacity;              /**< bytes the icons in memory may take */
+};
+
 /**
  * Requests for freeing origins.
  *
@@ -263,6 +413,10 @@ EAPI Eina_Bool ewk_context_icon_database_path_set(Ewk_Context* context, const ch
 /**
  * Requests to get image representing the given URL.
  *
+ * Only images kept in memory are returned, the function never reads the
+ * database. Use ewk_context_icon_database_icon_object_add_async for the
+ * others.
+ *
  * @param context context object
  * @param url which url to query icon, must not be @c 0
  * @param canvas evas instance where to add resulting object, must not be @c 0
@@ -272,6 +426,36 @@ EAPI Eina_Bool ewk_context_icon_database_path_set(Ewk_Context* context, const ch
  */
 EAPI Evas_Object* ewk_context_icon_database_icon_object_add(Ewk_Context* context, const char* uri, Evas* canvas);
 
+/**
+ * Requests to get image representing the given URL without blocking.
+ *
+ * Only the icon URLs are loaded when the database is opened, the images are
+ * read when first asked for and the recently used ones are kept in memory.
+ * ewk_context_icon_database_icon_object_add returns the images in memory
+ * only, this function reads the others on another thread. The callback is
+ * called asynchronously.
+ *
+ * @param context context object
+ * @param uri which url to query icon, must not be @c 0
+ * @param canvas evas instance where to add resulting object, must not be @c 0,
+ *        it has to stay alive until @a callback is called
+ * @param callback callback to receive the image
+ * @param user_data user data passed to @a callback
+ *
+ * @return @c EINA_TRUE on successful request or @c EINA_FALSE on failure
+ */
+EAPI Eina_Bool ewk_context_icon_database_icon_object_add_async(Ewk_Context* context, const char* uri, Evas* canvas, Ewk_Context_Icon_Database_Icon_Object_Add_Callback callback, void* user_data);
+
+/**
+ * Gets how the icon images kept in memory are used.
+ *
+ * @param context context object
+ * @param statistics structure to fill, must not be @c 0
+ *
+ * @return @c EINA_TRUE on success or @c EINA_FALSE otherwise
+ */
+EAPI Eina_Bool ewk_context_icon_database_statistics_get(Ewk_Context* context, Ewk_Icon_Database_Statistics* statistics);
+
 /**
  * Requests for deleting all local file systems.
  *
@@ -478,6 +662,22 @@ EAPI Eina_Bool ewk_context_cache_model_set(Ewk_Context* context, Ewk_Cache_Model
 */
 EAPI Ewk_Cache_Model ewk_context_cache_model_get(Ewk_Context* context);
 
+/**
+ * Requests the hit and miss counts of the HTTP cache tiers.
+ *
+ * Contexts with a disk cache keep the small entries which are loaded over
+ * and over in memory, in front of the disk cache. The memory tier is sized
+ * by the cache model. Contexts without a disk cache report zeros.
+ * The callback is called asynchronously.
+ *
+ * @param context context object
+ * @param callback callback to receive the statistics
+ * @param user_data user data passed to @a callback
+ *
+ * @return @c EINA_TRUE on success or @c EINA_FALSE otherwise
+ */
+EAPI Eina_Bool ewk_context_http_cache_statistics_get(Ewk_Context* context, Ewk_Context_Http_Cache_Statistics_Get_Callback callback, void* user_data);
+
 /**
 * Toggles the cache enable and disable
 *
@@ -544,6 +744,11 @@ EAPI void ewk_context_mime_override_callback_set(Ewk_Context_Override_Mime_For_U
 /**
  * start memory sampler.
  *
+ * Every @a interval seconds the memory use of the browser and the renderers
+ * of @a context is sampled. GPU memory is counted in the browser process,
+ * where the GPU runs. Samples are kept until they are fetched with
+ * ewk_context_memory_usage_get.
+ *
  * @param context context object
  * @param interval time gap to fire the timer
 */
@@ -556,6 +761,58 @@ EAPI void ewk_context_memory_sampler_start(Ewk_Context* context, double timer_in
 */
 EAPI void ewk_context_memory_sampler_stop(Ewk_Context* context);
 
+/**
+ * Sets a CSV file every memory sample is appended to.
+ *
+ * The file gets a header line when it is created.
+ *
+ * @param context context object
+ * @param path file to append to, @c NULL to stop writing samples
+ *
+ * @return @c EINA_TRUE on success or @c EINA_FALSE otherwise
+ */
+EAPI Eina_Bool ewk_context_memory_sampler_dump_path_set(Ewk_Context* context, const char* path);
+
+/**
+ * Requests the memory samples taken since the previous request.
+ *
+ * If the memory sampler is not running, a single sample is taken for the
+ * request. The callback is called asynchronously.
+ *
+ * @param context context object
+ * @param callback callback to receive the samples
+ * @param user_data user data passed to @a callback
+ *
+ * @return @c EINA_TRUE on success or @c EINA_FALSE otherwise
+ */
+EAPI Eina_Bool ewk_context_memory_usage_get(Ewk_Context* context, Ewk_Context_Memory_Usage_Get_Callback callback, void* user_data);
+
+/**
+ * Restores the sessions of several views at once.
+ *
+ * The session data of all views is read in parallel, off the main loop.
+ * The foreground view is restored first, the other views only keep the
+ * url and title of their history items and load nothing until they are
+ * shown. @a callback is called once for every view when its session was
+ * read, the foreground view first. It is not called for views deleted
+ * in the meantime.
+ *
+ * @param context context object
+ * @param views views created for @a context which have no history yet
+ * @param data session data of each view, as accepted by ewk_view_add_with_session_data(),
+ *        copied before the function returns
+ * @param lengths length of each session data
+ * @param count number of views
+ * @param foreground index of the view shown first
+ * @param callback callback called when a view was restored, may be @c NULL
+ * @param user_data user data passed to @a callback
+ *
+ * @return @c EINA_TRUE if the sessions are being restored, @c EINA_FALSE if
+ *         a view does not belong to @a context, has history already or
+ *         is passed more than once
+ */
+EAPI Eina_Bool ewk_context_session_data_restore(Ewk_Context* context, Evas_Object** views, const char** data, const unsigned* lengths, unsigned count, unsigned foreground, Ewk_Context_Session_Restore_Callback callback, void* user_data);
+
 /**
  * @typedef Ewk_Vibration_Client_Vibrate_Cb Ewk_Vibration_Client_Vibrate_Cb
  * @brief Type definition for a function that will be called back when vibrate
@@ -664,6 +921,9 @@ EAPI void ewk_context_vibration_client_callbacks_set(Ewk_Context *context, Ewk_V
 /**
  * Sets memory saving mode.
  *
+ * Enabling it frees unused memory right away and makes every low memory
+ * notification free as much as possible.
+ *
  * @param context context object
  * @param enable or disable memory saving mode
  *
@@ -91,3 +91,23 @@ void ewk_cookie_manager_cookies_clear(Ewk_Cookie_Manager* manager)
   cookie_manager->DeleteCookiesAsync();
 }
 
+void ewk_cookie_manager_cookies_export(const Ewk_Cookie_Manager* manager,
+                                       Ewk_Cookie_Manager_Cookies_Export_Cb callback,
+                                       void* data)
+{
+  EWK_COOKIE_MANAGER_GET_OR_RETURN(manager, cookie_manager);
+  EINA_SAFETY_ON_NULL_RETURN(callback);
+  cookie_manager->ExportCookiesAsync(callback, data);
+}
+
+void ewk_cookie_manager_cookies_import(Ewk_Cookie_Manager* manager,
+                                       const char* data,
+                                       size_t size,
+                                       Ewk_Cookie_Manager_Cookies_Import_Cb callback,
+                                       void* user_data)
+{
+  EWK_COOKIE_MANAGER_GET_OR_RETURN(manager, cookie_manager);
+  EINA_SAFETY_ON_NULL_RETURN(data);
+  cookie_manager->ImportCookiesAsync(std::string(data, size), callback, user_data);
+}
+
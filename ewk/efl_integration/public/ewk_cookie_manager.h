@@ -84,6 +84,27 @@ typedef void (*Ewk_Cookie_Manager_Policy_Async_Get_Cb)(Ewk_Cookie_Accept_Policy
  */
 typedef void (*Ewk_Cookie_Manager_Async_Hostnames_Get_Cb)(Eina_List *hostnames, Ewk_Error *error, void *event_info);
 
+/**
+ * @typedef Ewk_Cookie_Manager_Cookies_Export_Cb Ewk_Cookie_Manager_Cookies_Export_Cb
+ * @brief Callback type for use with ewk_cookie_manager_cookies_export
+ *
+ * @a data holds one JSON object per cookie, each on its own line. The name and value
+ * of the cookie are base64 encoded, they need not be UTF-8. A chunk always ends
+ * with a complete line, so chunks can be imported one by one. @a data is only valid
+ * during the call. The last chunk has @a finished set, it is empty if there are no cookies.
+ *
+ * @return @c EINA_FALSE to stop the export, the callback is not called again
+ */
+typedef Eina_Bool (*Ewk_Cookie_Manager_Cookies_Export_Cb)(const char *data, size_t size, Eina_Bool finished, void *user_data);
+
+/**
+ * @typedef Ewk_Cookie_Manager_Cookies_Import_Cb Ewk_Cookie_Manager_Cookies_Import_Cb
+ * @brief Callback type for use with ewk_cookie_manager_cookies_import
+ *
+ * @a imported cookies were set, @a rejected lines could not be read or were refused.
+ */
+typedef void (*Ewk_Cookie_Manager_Cookies_Import_Cb)(unsigned imported, unsigned rejected, void *user_data);
+
 
 /**
  * Set the @a filename where non-session cookies are stored persistently using @a storage as the format to read/write the cookies.
@@ -146,6 +167,32 @@ EAPI void ewk_cookie_manager_hostname_cookies_clear(Ewk_Cookie_Manager *manager,
  */
 EAPI void ewk_cookie_manager_cookies_clear(Ewk_Cookie_Manager *manager);
 
+/**
+ * Asynchronously export all cookies of @a manager.
+ *
+ * The cookies are handed to @a callback in chunks. The next chunk is only prepared
+ * once @a callback returned, large cookie stores do not block the main loop.
+ *
+ * @param manager The cookie manager to query.
+ * @param callback The function to call with each chunk.
+ * @param data User data (may be @c NULL).
+ */
+EAPI void ewk_cookie_manager_cookies_export(const Ewk_Cookie_Manager *manager, Ewk_Cookie_Manager_Cookies_Export_Cb callback, void *data);
+
+/**
+ * Asynchronously set the cookies of @a data, as exported by ewk_cookie_manager_cookies_export.
+ *
+ * @a data may hold any number of complete lines, such as one exported chunk.
+ * Cookies which already exist are replaced.
+ *
+ * @param manager The cookie manager to update.
+ * @param data The exported cookies, copied before returning.
+ * @param size The size of @a data in bytes.
+ * @param callback The function to call once all cookies were set (may be @c NULL).
+ * @param user_data User data (may be @c NULL).
+ */
+EAPI void ewk_cookie_manager_cookies_import(Ewk_Cookie_Manager *manager, const char *data, size_t size, Ewk_Cookie_Manager_Cookies_Import_Cb callback, void *user_data);
+
 #ifdef __cplusplus
 }
 #endif
@@ -87,9 +87,7 @@ int ewk_policy_decision_response_status_code_get(const Ewk_Policy_Decision* poli
 Eina_Bool ewk_policy_decision_suspend(Ewk_Policy_Decision* policyDecision)
 {
   EINA_SAFETY_ON_NULL_RETURN_VAL(policyDecision, EINA_FALSE);
-  policyDecision->Suspend();
-  // It is already suspended. We don't need to take any action here.
-  return EINA_TRUE;
+  return policyDecision->Suspend();
 }
 
 Eina_Bool ewk_policy_decision_use(Ewk_Policy_Decision* policyDecision)
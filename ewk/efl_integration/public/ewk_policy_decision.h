@@ -143,6 +143,10 @@ EAPI Ewk_Policy_Decision_Type ewk_policy_decision_type_get(const Ewk_Policy_Deci
  *
  * This suspends the operation for policy decision when the signal for policy is emitted.
  * This is very useful to decide the policy from the additional UI operation like the popup.
+ * A suspended navigation is held back until ewk_policy_decision_use(),
+ * ewk_policy_decision_ignore() or ewk_policy_decision_download() is called.
+ * Reloads, history navigations and redirects cannot be held back, suspending
+ * them fails and they start as if the decision was used.
  *
  * @param policy_decision policy decision object
  *
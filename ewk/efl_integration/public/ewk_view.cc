@@ -434,6 +434,83 @@ Evas_Object* ewk_view_screenshot_contents_get(const Evas_Object* view, Eina_Rect
   return impl->GetSnapshot(view_area);
 }
 
+Eina_Bool ewk_view_screenshot_contents_get_async(const Evas_Object* view, Eina_Rectangle view_area, float scale_factor, Evas* canvas, Ewk_Web_App_Screenshot_Captured_Callback callback, void* user_data)
+{
+  EINA_SAFETY_ON_NULL_RETURN_VAL(canvas, EINA_FALSE);
+  EINA_SAFETY_ON_NULL_RETURN_VAL(callback, EINA_FALSE);
+  EWK_VIEW_IMPL_GET_OR_RETURN(view, impl, EINA_FALSE);
+  return impl->GetSnapshotAsync(view_area, scale_factor, canvas, callback, user_data);
+}
+
+Eina_Bool ewk_view_frame_timing_enabled_set(Evas_Object* view, Eina_Bool enabled)
+{
+  EWK_VIEW_IMPL_GET_OR_RETURN(view, impl, EINA_FALSE);
+  return impl->SetFrameTimingEnabled(enabled == EINA_TRUE);
+}
+
+unsigned int ewk_view_frame_timing_get(const Evas_Object* view, Ewk_Frame_Timing* timings, unsigned int count)
+{
+  EINA_SAFETY_ON_NULL_RETURN_VAL(timings, 0);
+  EWK_VIEW_IMPL_GET_OR_RETURN(view, impl, 0);
+
+  std::vector<tizen_webview::Frame_Timing> frames;
+  if (!impl->GetFrameTimings(&frames))
+    return 0;
+
+  // Return the most recent frames if the caller asked for fewer.
+  size_t first = frames.size() > count ? frames.size() - count : 0;
+  unsigned int written = 0;
+  for (size_t i = first; i < frames.size(); ++i, ++written) {
+    timings[written].swap_time = frames[i].swap_time;
+    timings[written].present_time = frames[i].present_time;
+    timings[written].paint_duration = frames[i].paint_duration;
+    timings[written].dropped_frames = frames[i].dropped_frames;
+  }
+  return written;
+}
+
+Eina_Bool ewk_view_navigation_policy_enabled_set(Evas_Object* view, Eina_Bool enabled)
+{
+  EWK_VIEW_IMPL_GET_OR_RETURN(view, impl, EINA_FALSE);
+  impl->SetNavigationPolicyEnabled(enabled == EINA_TRUE);
+  return EINA_TRUE;
+}
+
+Eina_Bool ewk_view_navigation_policy_enabled_get(const Evas_Object* view)
+{
+  EWK_VIEW_IMPL_GET_OR_RETURN(view, impl, EINA_FALSE);
+  return impl->NavigationPolicyEnabled();
+}
+
+Eina_Bool ewk_view_response_policy_enabled_set(Evas_Object* view, Eina_Bool enabled)
+{
+  EWK_VIEW_IMPL_GET_OR_RETURN(view, impl, EINA_FALSE);
+  impl->SetResponsePolicyEnabled(enabled == EINA_TRUE);
+  return EINA_TRUE;
+}
+
+static void StringListFromEinaList(const Eina_List* list, std::vector<std::string>* strings)
+{
+  const Eina_List* l;
+  void* data;
+  EINA_LIST_FOREACH(list, l, data) {
+    if (data)
+      strings->push_back(static_cast<const char*>(data));
+  }
+}
+
+Eina_Bool ewk_view_response_policy_filter_set(Evas_Object* view, const Eina_List* mime_types, const Eina_List* url_patterns)
+{
+  EWK_VIEW_IMPL_GET_OR_RETURN(view, impl, EINA_FALSE);
+
+  std::vector<std::string> mime_type_list;
+  std::vector<std::string> url_pattern_list;
+  StringListFromEinaList(mime_types, &mime_type_list);
+  StringListFromEinaList(url_patterns, &url_pattern_list);
+  impl->SetResponsePolicyFilter(mime_type_list, url_pattern_list);
+  return EINA_TRUE;
+}
+
 unsigned int ewk_view_inspector_server_start(Evas_Object* ewkView, unsigned int port)
 {
   EWK_VIEW_IMPL_GET_OR_RETURN(ewkView, impl, false);
@@ -973,6 +1050,21 @@ void ewk_view_session_data_get(Evas_Object* ewkView, const char** data, unsigned
   impl->GetSessionData(data, length);
 }
 
+void ewk_view_session_data_checkpoint_get(Evas_Object* ewkView, const char** data, unsigned* length)
+{
+  EINA_SAFETY_ON_NULL_RETURN(data);
+  EINA_SAFETY_ON_NULL_RETURN(length);
+
+  WebView* impl = GetWebViewFromEvasObject(ewkView);
+  if (!impl) {
+    *data = NULL;
+    *length = 0;
+    return;
+  }
+
+  impl->GetSessionCheckpoint(data, length);
+}
+
 Eina_Bool ewk_view_mode_set(Evas_Object* ewkView, Ewk_View_Mode view_mode)
 {
  EWK_VIEW_IMPL_GET_OR_RETURN(ewkView, impl, EINA_FALSE);
@@ -293,6 +293,27 @@ typedef void (*Ewk_Web_App_Icon_URL_Get_Callback)(const char* icon_url, void* us
  * @param user_data user_data will be passsed when ewk_view_web_app_icon_urls_get is called
  */
 typedef void (*Ewk_Web_App_Icon_URLs_Get_Callback)(Eina_List *icon_urls, void *user_data);
+
+/**
+ * @brief Timing of one frame presented by the view, filled by ewk_view_frame_timing_get.
+ *
+ * Times are in seconds on the monotonic clock.
+ */
+typedef struct Ewk_Frame_Timing Ewk_Frame_Timing;
+struct Ewk_Frame_Timing {
+    double swap_time;            /**< compositor swap reached the view */
+    double present_time;         /**< Evas finished rendering the frame */
+    double paint_duration;       /**< time spent painting the frame into the view surface, 0 for zero-copy presentation */
+    unsigned int dropped_frames; /**< frames swapped but superseded before this one was shown */
+};
+
+/**
+ * Callback for ewk_view_screenshot_contents_get_async
+ *
+ * @param image captured evas image object or @c 0 on failure, it @b should be freed after use
+ * @param user_data user_data will be passsed when ewk_view_screenshot_contents_get_async is called
+ */
+typedef void (*Ewk_Web_App_Screenshot_Captured_Callback)(Evas_Object* image, void* user_data);
 // #endif
 
 /**
@@ -426,6 +447,12 @@ typedef enum _Ewk_Find_Options Ewk_Find_Options;
 /**
  * Creates a new EFL WebKit view object.
  *
+ * @p data is either session data got from ewk_view_session_data_get(),
+ * optionally followed by checkpoints got from
+ * ewk_view_session_data_checkpoint_get(), or checkpoints alone. Only the
+ * current page is restored completely, the other history items are
+ * completed when they are visited.
+ *
  * @param e canvas object where to create the view object
  * @param data a pointer to data to restore session data
  * @param length length of session data to restore session data
@@ -932,6 +959,113 @@ EAPI Eina_Bool ewk_view_visibility_set(const Evas_Object* o, Eina_Bool enable);
  */
 EAPI Evas_Object* ewk_view_screenshot_contents_get(const Evas_Object* o, Eina_Rectangle viewArea, float scaleFactor, Evas* canvas);
 
+/**
+ * Requests the evas image object of the specified viewArea of page without blocking.
+ *
+ * The pixels are read back and scaled on the GPU, @a callback is called
+ * from the main loop once the image is ready.
+ *
+ * @param o view object to get specified rectangle of the page.
+ * @param viewArea rectangle of the page in view coordinates.
+ * @param scaleFactor scale factor applied to the captured rectangle.
+ * @param canvas canvas for creating evas image.
+ * @param callback callback receiving the newly allocated evas image object.
+ * @param user_data user data passed to @a callback.
+ *
+ * @return @c EINA_TRUE if the request was started, @c EINA_FALSE otherwise.
+ */
+EAPI Eina_Bool ewk_view_screenshot_contents_get_async(const Evas_Object* o, Eina_Rectangle viewArea, float scaleFactor, Evas* canvas, Ewk_Web_App_Screenshot_Captured_Callback callback, void* user_data);
+
+/**
+ * Enables or disables recording of per frame timing.
+ *
+ * Recording is off by default. Enabling it starts a ring buffer holding the
+ * most recent frames, each recorded frame is also emitted as trace events
+ * in the "efl" category. Disabling it drops the recorded frames.
+ *
+ * @param o view object
+ * @param enabled @c EINA_TRUE to start recording, @c EINA_FALSE to stop
+ *
+ * @return @c EINA_TRUE on success or @c EINA_FALSE on failure
+ */
+EAPI Eina_Bool ewk_view_frame_timing_enabled_set(Evas_Object* o, Eina_Bool enabled);
+
+/**
+ * Gets the timing of the most recently presented frames.
+ *
+ * @param o view object
+ * @param timings array receiving at most @a count frames, oldest first
+ * @param count capacity of @a timings
+ *
+ * @return number of frames written to @a timings, 0 if recording is disabled
+ *
+ * @see ewk_view_frame_timing_enabled_set
+ */
+EAPI unsigned int ewk_view_frame_timing_get(const Evas_Object* o, Ewk_Frame_Timing* timings, unsigned int count);
+
+/**
+ * Sets whether navigations are offered to the application for a decision.
+ *
+ * When enabled, which is the default, "policy,navigation,decide" is emitted
+ * for every navigation of the view. Applications which do not listen to it
+ * should disable it, navigations then start without a round trip to the
+ * application. "save,session,data" is still emitted when a main frame load
+ * starts.
+ *
+ * Reloads, history navigations and redirects are decided while the signal is
+ * emitted. ewk_policy_decision_suspend() fails for them and their decision
+ * object must not be used once the signal handler returns.
+ *
+ * @param o view object
+ * @param enabled @c EINA_TRUE to ask for navigation policy decisions
+ *
+ * @return @c EINA_TRUE on success or @c EINA_FALSE on failure
+ */
+EAPI Eina_Bool ewk_view_navigation_policy_enabled_set(Evas_Object* o, Eina_Bool enabled);
+
+/**
+ * Queries whether navigations are offered to the application for a decision.
+ *
+ * @param o view object
+ *
+ * @return @c EINA_TRUE if enabled or @c EINA_FALSE otherwise
+ *
+ * @see ewk_view_navigation_policy_enabled_set
+ */
+EAPI Eina_Bool ewk_view_navigation_policy_enabled_get(const Evas_Object* o);
+
+/**
+ * Sets whether responses are offered to the application for a decision.
+ *
+ * When enabled, which is the default, "policy,response,decide" is emitted
+ * for the responses matching the filter set with
+ * ewk_view_response_policy_filter_set(). The other responses are used
+ * without waiting for the application.
+ *
+ * @param o view object
+ * @param enabled @c EINA_TRUE to ask for response policy decisions
+ *
+ * @return @c EINA_TRUE on success or @c EINA_FALSE on failure
+ */
+EAPI Eina_Bool ewk_view_response_policy_enabled_set(Evas_Object* o, Eina_Bool enabled);
+
+/**
+ * Restricts the responses offered to the application for a decision.
+ *
+ * Both lists hold strings which may use * and ? wildcards, e.g.
+ * "application/octet-stream" or "http://*.example.com/*". A response is
+ * offered when its MIME type matches one of @a mime_types and its URL
+ * matches one of @a url_patterns. An empty or @c NULL list matches every
+ * response.
+ *
+ * @param o view object
+ * @param mime_types list of MIME type patterns, may be @c NULL
+ * @param url_patterns list of URL patterns, may be @c NULL
+ *
+ * @return @c EINA_TRUE on success or @c EINA_FALSE on failure
+ */
+EAPI Eina_Bool ewk_view_response_policy_filter_set(Evas_Object* o, const Eina_List* mime_types, const Eina_List* url_patterns);
+
 /**
  * Returns the evas image object for the cache image specified in url.
  *
@@ -1150,6 +1284,10 @@ typedef void (*Ewk_View_Hit_Test_Request_Callback)(Evas_Object* o, int x, int y,
  * @param hit_test_mode  the Ewk_Hit_Test_Mode enum value to query
  * @param callback       callback to be executed when hit test request was finished
  *
+ * Requests for nearly the same point and mode share one query to the web
+ * process. If the main frame navigates before the result arrives the request
+ * is cancelled and @a callback is called with a @c NULL hit test.
+ *
  * @return EINA_TRUE if hit test request was queued, otherwise EINA_FALSE
  */
 EAPI Eina_Bool ewk_view_hit_test_request(Evas_Object* o, int x, int y, int hit_test_mode, Ewk_View_Hit_Test_Request_Callback, void* user_data);
@@ -1533,6 +1671,26 @@ EAPI void ewk_view_browser_font_set(Evas_Object* o);
  */
 EAPI void ewk_view_session_data_get(Evas_Object* ewkView, const char** data, unsigned* length);
 
+/**
+ * Gets the session changes made since the previous checkpoint.
+ *
+ * Checkpoints only hold the history items which changed, they are meant to
+ * be appended to the session data stored before, in the order they were
+ * got. The data and the checkpoints following it can be passed as a whole
+ * to ewk_view_add_with_session_data(). The first checkpoint of a view
+ * holds its whole session. Calling ewk_view_session_data_get() does not
+ * interrupt the checkpoints, the data it got can replace the stored data
+ * and be followed by the checkpoints got after it.
+ *
+ * @param ewkView view object whose session needs to be stored.
+ * @param data out parameter checkpoint data to be freed with free(), or
+ *        @c NULL if nothing changed
+ * @param length out parameter length of checkpoint data
+ *
+ * @return void
+ */
+EAPI void ewk_view_session_data_checkpoint_get(Evas_Object* ewkView, const char** data, unsigned* length);
+
 /**
  * Load the error page which web page is not found.
  *
@@ -0,0 +1,152 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "utc_blink_ewk_base.h"
+
+#include <vector>
+
+class utc_blink_ewk_back_forward_list_perf : public utc_blink_ewk_base
+{
+protected:
+  void PreTearDown()
+  {
+    for (size_t i = 0; i < views.size(); ++i)
+      evas_object_del(views[i]);
+    views.clear();
+  }
+
+  void LoadFinished(Evas_Object *) {
+    EventLoopStop(Success);
+  }
+
+  // Opens |count| more views, each with some history of its own.
+  void OpenViews(int count)
+  {
+    for (int i = 0; i < count; ++i) {
+      Evas_Object* view = ewk_view_add(GetEwkEvas());
+      ASSERT_TRUE(view);
+      views.push_back(view);
+      ASSERT_EQ(EINA_TRUE, ewk_view_url_set(view, GetResourceUrl(TEST_URL1).c_str()));
+    }
+    // Background views report their loads to nobody, give them time.
+    EventLoopWait(5.0);
+  }
+
+  // Returns the URL the test view loads on its |i|th navigation.
+  std::string NavigationUrl(int i) const
+  {
+    return GetResourceUrl((i % 2) ? TEST_URL2 : TEST_URL3);
+  }
+
+  // Returns the average time of a navigation of the test view, in ms. Each
+  // navigation is expected to become the current item, with the previous one
+  // right behind it.
+  double MeasureNavigations(int navigations)
+  {
+    double start = ecore_time_get();
+    for (int i = 0; i < navigations; ++i) {
+      EXPECT_EQ(EINA_TRUE, ewk_view_url_set(GetEwkWebView(), NavigationUrl(i).c_str()));
+      EXPECT_EQ(Success, EventLoopStart());
+      // Reading the list makes it build its items.
+      Ewk_Back_Forward_List* list = ewk_view_back_forward_list_get(GetEwkWebView());
+      Ewk_Back_Forward_List_Item* current = ewk_back_forward_list_current_item_get(list);
+      EXPECT_TRUE(current);
+      if (current)
+        EXPECT_STREQ(NavigationUrl(i).c_str(), ewk_back_forward_list_item_url_get(current));
+      if (i) {
+        Ewk_Back_Forward_List_Item* previous = ewk_back_forward_list_item_at_index_get(list, -1);
+        EXPECT_TRUE(previous);
+        if (previous)
+          EXPECT_STREQ(NavigationUrl(i - 1).c_str(), ewk_back_forward_list_item_url_get(previous));
+      }
+    }
+    return (ecore_time_get() - start) * 1000.0 / navigations;
+  }
+
+  // Returns the average time of a back forward list lookup, in us.
+  double MeasureListCalls(int calls)
+  {
+    Ewk_Back_Forward_List* list = ewk_view_back_forward_list_get(GetEwkWebView());
+    double start = ecore_time_get();
+    for (int i = 0; i < calls; ++i) {
+      EXPECT_GT(ewk_back_forward_list_count(list), 0u);
+      EXPECT_TRUE(ewk_back_forward_list_item_at_index_get(list, -1));
+    }
+    return (ecore_time_get() - start) * 1000000.0 / calls;
+  }
+
+  static void PrintResult(const char* trace, double value, const char* units = "ms")
+  {
+    printf("*RESULT ewk_back_forward_list_navigation: %s= %f %s\n", trace, value, units);
+    fflush(stdout);
+  }
+
+protected:
+  std::vector<Evas_Object*> views;
+
+  static const char* const TEST_URL1;
+  static const char* const TEST_URL2;
+  static const char* const TEST_URL3;
+  static const int kNavigations = 60;
+  static const int kOpenViews = 30;
+  static const int kListCalls = 10000;
+};
+
+const char* const utc_blink_ewk_back_forward_list_perf::TEST_URL1 = "ewk_history/page1.html";
+const char* const utc_blink_ewk_back_forward_list_perf::TEST_URL2 = "ewk_history/page2.html";
+const char* const utc_blink_ewk_back_forward_list_perf::TEST_URL3 = "ewk_history/page3.html";
+
+/**
+ * @brief Reports the cost of a navigation with and without other open views.
+ *
+ * Navigating more than the session history holds also exercises pruning of
+ * the oldest entries. The timings are printed for the perf dashboard, only
+ * the items of the list are checked.
+ */
+TEST_F(utc_blink_ewk_back_forward_list_perf, PERF_TEST)
+{
+  double alone = MeasureNavigations(kNavigations);
+  PrintResult("single_view", alone);
+
+  OpenViews(kOpenViews);
+  double crowded = MeasureNavigations(kNavigations);
+  PrintResult("30_views", crowded);
+
+  // The list kept up with both batches.
+  Ewk_Back_Forward_List* list = ewk_view_back_forward_list_get(GetEwkWebView());
+  ASSERT_TRUE(list);
+  EXPECT_GE(ewk_back_forward_list_count(list), 2u);
+  Ewk_Back_Forward_List_Item* previous = ewk_back_forward_list_item_at_index_get(list, -1);
+  ASSERT_TRUE(previous);
+  EXPECT_STREQ(NavigationUrl(kNavigations - 2).c_str(), ewk_back_forward_list_item_url_get(previous));
+}
+
+/**
+ * @brief Reports list lookups with a short and a long history.
+ *
+ * The timings are printed for the perf dashboard. The long history has to be
+ * longer, up to what the session history holds, and lookups have to find the
+ * previous page.
+ */
+TEST_F(utc_blink_ewk_back_forward_list_perf, PERF_TEST_HISTORY_LENGTH)
+{
+  Ewk_Back_Forward_List* list = ewk_view_back_forward_list_get(GetEwkWebView());
+  ASSERT_TRUE(list);
+
+  MeasureNavigations(2);
+  unsigned short_count = ewk_back_forward_list_count(list);
+  EXPECT_GE(short_count, 2u);
+  PrintResult("lookup_short_history", MeasureListCalls(kListCalls), "us");
+
+  MeasureNavigations(kNavigations);
+  unsigned long_count = ewk_back_forward_list_count(list);
+  EXPECT_GT(long_count, short_count);
+  EXPECT_LE(long_count, static_cast<unsigned>(kNavigations + 2));
+  PrintResult("lookup_long_history", MeasureListCalls(kListCalls), "us");
+
+  // Both batches end on the same page, with the other one behind it.
+  Ewk_Back_Forward_List_Item* previous = ewk_back_forward_list_item_at_index_get(list, -1);
+  ASSERT_TRUE(previous);
+  EXPECT_STREQ(NavigationUrl(kNavigations - 2).c_str(), ewk_back_forward_list_item_url_get(previous));
+}
@@ -0,0 +1,47 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "utc_blink_ewk_base.h"
+
+class utc_blink_ewk_context_http_cache_statistics_get : public utc_blink_ewk_base
+{
+protected:
+  utc_blink_ewk_context_http_cache_statistics_get()
+    : received(false)
+    , sizeWithinCapacity(false)
+  {
+  }
+
+  static void statisticsGot(const Ewk_Http_Cache_Statistics* statistics, void* data)
+  {
+    utc_blink_ewk_context_http_cache_statistics_get* owner = static_cast<utc_blink_ewk_context_http_cache_statistics_get*>(data);
+    owner->received = statistics != NULL;
+    if (statistics)
+      owner->sizeWithinCapacity = statistics->memory_size <= statistics->memory_capacity;
+    owner->EventLoopStop(Success);
+  }
+
+  bool received;
+  bool sizeWithinCapacity;
+};
+
+/**
+ * @brief Checking whether the statistics are delivered.
+ */
+TEST_F(utc_blink_ewk_context_http_cache_statistics_get, POS_TEST)
+{
+  ASSERT_EQ(EINA_TRUE, ewk_context_http_cache_statistics_get(ewk_view_context_get(GetEwkWebView()), statisticsGot, this));
+  ASSERT_EQ(EventLoopStart(), Success);
+  ASSERT_TRUE(received);
+  ASSERT_TRUE(sizeWithinCapacity);
+}
+
+/**
+ * @brief Checking whether function works properly in case of NULL of a context or callback.
+ */
+TEST_F(utc_blink_ewk_context_http_cache_statistics_get, NEG_TEST)
+{
+  ASSERT_EQ(EINA_FALSE, ewk_context_http_cache_statistics_get(NULL, statisticsGot, this));
+  ASSERT_EQ(EINA_FALSE, ewk_context_http_cache_statistics_get(ewk_view_context_get(GetEwkWebView()), NULL, this));
+}
@@ -0,0 +1,77 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "utc_blink_ewk_base.h"
+
+class utc_blink_ewk_context_icon_database_icon_object_add_async : public utc_blink_ewk_base
+{
+protected:
+  void PostSetUp()
+  {
+    evas_object_smart_callback_add(GetEwkWebView(), "icon,received", cb_icon_received, this);
+  }
+
+  void PreTearDown()
+  {
+    evas_object_smart_callback_del(GetEwkWebView(), "icon,received", cb_icon_received);
+  }
+
+  static void cb_icon_received(void *data, Evas_Object *, void *)
+  {
+    ASSERT_TRUE(data != NULL);
+    utc_blink_ewk_context_icon_database_icon_object_add_async *owner = static_cast<utc_blink_ewk_context_icon_database_icon_object_add_async *>(data);
+    ASSERT_EQ(EINA_TRUE, ewk_context_icon_database_icon_object_add_async(ewk_context_default_get(), owner->GetResourceUrl(PAGE_PATH).c_str(), owner->GetEwkEvas(), cb_icon_object_added, owner));
+  }
+
+  static void cb_icon_object_added(Evas_Object *favicon, void *data)
+  {
+    ASSERT_TRUE(data != NULL);
+    utc_blink_ewk_context_icon_database_icon_object_add_async *owner = static_cast<utc_blink_ewk_context_icon_database_icon_object_add_async *>(data);
+    if (!favicon) {
+      owner->EventLoopStop(Failure);
+      return;
+    }
+
+    Evas_Object *img = evas_object_image_filled_add(owner->GetEwkEvas());
+    evas_object_image_file_set(img, owner->GetResourcePath(ICON_PATH).c_str(), NULL);
+
+    int w = 0, h = 0;
+    evas_object_image_size_get(favicon, &w, &h);
+
+    bool same = !memcmp(evas_object_image_data_get(favicon, EINA_FALSE),
+                        evas_object_image_data_get(img, EINA_FALSE),
+                        w * h * PIXEL_SIZE);
+    evas_object_del(img);
+    evas_object_del(favicon);
+    owner->EventLoopStop(same ? Success : Failure);
+  }
+
+  static const int PIXEL_SIZE = 4;
+  static const char *PAGE_PATH;
+  static const char *ICON_PATH;
+};
+
+const char *utc_blink_ewk_context_icon_database_icon_object_add_async::PAGE_PATH = "ewk_context_icon_database/favicon2.html";
+const char *utc_blink_ewk_context_icon_database_icon_object_add_async::ICON_PATH = "ewk_context_icon_database/tizen-icon.bmp";
+
+/**
+ * @brief Checking whether the icon of a loaded page is delivered.
+ */
+TEST_F(utc_blink_ewk_context_icon_database_icon_object_add_async, POS_TEST)
+{
+  ASSERT_EQ(EINA_TRUE, ewk_view_url_set(GetEwkWebView(), GetResourceUrl(PAGE_PATH).c_str()));
+  ASSERT_EQ(Success, EventLoopStart());
+}
+
+/**
+ * @brief Checking whether function works properly in case of NULL arguments.
+ */
+TEST_F(utc_blink_ewk_context_icon_database_icon_object_add_async, NEG_TEST)
+{
+  Ewk_Context *context = ewk_context_default_get();
+  ASSERT_EQ(EINA_FALSE, ewk_context_icon_database_icon_object_add_async(NULL, "http://www.example.com", GetEwkEvas(), cb_icon_object_added, this));
+  ASSERT_EQ(EINA_FALSE, ewk_context_icon_database_icon_object_add_async(context, NULL, GetEwkEvas(), cb_icon_object_added, this));
+  ASSERT_EQ(EINA_FALSE, ewk_context_icon_database_icon_object_add_async(context, "http://www.example.com", NULL, cb_icon_object_added, this));
+  ASSERT_EQ(EINA_FALSE, ewk_context_icon_database_icon_object_add_async(context, "http://www.example.com", GetEwkEvas(), NULL, this));
+}
@@ -0,0 +1,30 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "utc_blink_ewk_base.h"
+
+class utc_blink_ewk_context_icon_database_statistics_get : public utc_blink_ewk_base
+{
+};
+
+/**
+ * @brief Checking whether the statistics are filled.
+ */
+TEST_F(utc_blink_ewk_context_icon_database_statistics_get, POS_TEST)
+{
+  Ewk_Icon_Database_Statistics statistics;
+  ASSERT_EQ(EINA_TRUE, ewk_context_icon_database_statistics_get(ewk_context_default_get(), &statistics));
+  ASSERT_GT(statistics.capacity, 0u);
+  ASSERT_EQ(statistics.count == 0, statistics.size == 0);
+}
+
+/**
+ * @brief Checking whether function works properly in case of NULL of a context or statistics.
+ */
+TEST_F(utc_blink_ewk_context_icon_database_statistics_get, NEG_TEST)
+{
+  Ewk_Icon_Database_Statistics statistics;
+  ASSERT_EQ(EINA_FALSE, ewk_context_icon_database_statistics_get(NULL, &statistics));
+  ASSERT_EQ(EINA_FALSE, ewk_context_icon_database_statistics_get(ewk_context_default_get(), NULL));
+}
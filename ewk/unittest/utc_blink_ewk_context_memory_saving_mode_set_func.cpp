@@ -0,0 +1,49 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "utc_blink_ewk_base.h"
+
+class utc_blink_ewk_context_memory_saving_mode_set : public utc_blink_ewk_base
+{
+protected:
+  void LoadFinished(Evas_Object*)
+  {
+    EventLoopStop(Success);
+  }
+};
+
+/**
+ * @brief Checking whether the view keeps working after memory was purged.
+ */
+TEST_F(utc_blink_ewk_context_memory_saving_mode_set, POS_TEST)
+{
+  Ewk_Context* context = ewk_view_context_get(GetEwkWebView());
+  std::string firstPage = GetResourceUrl("common/sample.html");
+  std::string secondPage = GetResourceUrl("common/sample_1.html");
+
+  ewk_view_url_set(GetEwkWebView(), firstPage.c_str());
+  ASSERT_EQ(EventLoopStart(), Success);
+
+  ewk_context_memory_saving_mode_set(context, EINA_TRUE);
+  ASSERT_EQ(ewk_context_notify_low_memory(context), EINA_TRUE);
+
+  ewk_view_url_set(GetEwkWebView(), secondPage.c_str());
+  ASSERT_EQ(EventLoopStart(), Success);
+
+  ASSERT_TRUE(ewk_view_back(GetEwkWebView()));
+  ASSERT_EQ(EventLoopStart(), Success);
+  ASSERT_STREQ(firstPage.c_str(), ewk_view_url_get(GetEwkWebView()));
+
+  ewk_context_memory_saving_mode_set(context, EINA_FALSE);
+}
+
+/**
+ * @brief Checking whether function works properly in case of NULL of a context.
+ */
+TEST_F(utc_blink_ewk_context_memory_saving_mode_set, NEG_TEST)
+{
+  ewk_context_memory_saving_mode_set(NULL, EINA_TRUE);
+
+  utc_pass();
+}
@@ -0,0 +1,58 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "utc_blink_ewk_base.h"
+
+class utc_blink_ewk_context_memory_usage_get : public utc_blink_ewk_base
+{
+protected:
+  utc_blink_ewk_context_memory_usage_get()
+    : browserSamples(0)
+    , rendererSamples(0)
+  {
+  }
+
+  void LoadFinished(Evas_Object*)
+  {
+    EventLoopStop(Success);
+  }
+
+  static void usageGot(const Ewk_Memory_Sample* samples, unsigned int count, void* data)
+  {
+    utc_blink_ewk_context_memory_usage_get* owner = static_cast<utc_blink_ewk_context_memory_usage_get*>(data);
+    for (unsigned int i = 0; i < count; ++i) {
+      if (samples[i].process_type == EWK_PROCESS_TYPE_BROWSER && samples[i].rss > 0)
+        ++owner->browserSamples;
+      if (samples[i].process_type == EWK_PROCESS_TYPE_RENDERER)
+        ++owner->rendererSamples;
+    }
+    owner->EventLoopStop(Success);
+  }
+
+  unsigned browserSamples;
+  unsigned rendererSamples;
+};
+
+/**
+ * @brief Checking whether a sample is taken when the sampler is not running.
+ */
+TEST_F(utc_blink_ewk_context_memory_usage_get, POS_TEST)
+{
+  ewk_view_url_set(GetEwkWebView(), GetResourceUrl("common/sample.html").c_str());
+  ASSERT_EQ(EventLoopStart(), Success);
+
+  ASSERT_EQ(EINA_TRUE, ewk_context_memory_usage_get(ewk_view_context_get(GetEwkWebView()), usageGot, this));
+  ASSERT_EQ(EventLoopStart(), Success);
+  ASSERT_EQ(1u, browserSamples);
+  ASSERT_GE(rendererSamples, 1u);
+}
+
+/**
+ * @brief Checking whether function works properly in case of NULL of a context or callback.
+ */
+TEST_F(utc_blink_ewk_context_memory_usage_get, NEG_TEST)
+{
+  ASSERT_EQ(EINA_FALSE, ewk_context_memory_usage_get(NULL, usageGot, this));
+  ASSERT_EQ(EINA_FALSE, ewk_context_memory_usage_get(ewk_view_context_get(GetEwkWebView()), NULL, this));
+}
@@ -0,0 +1,57 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "utc_blink_ewk_base.h"
+
+class utc_blink_ewk_context_proxy_pac_url_set : public utc_blink_ewk_base
+{
+protected:
+  utc_blink_ewk_context_proxy_pac_url_set()
+    : applied(false)
+  {
+  }
+
+  static void proxySet(void* data)
+  {
+    utc_blink_ewk_context_proxy_pac_url_set* owner = static_cast<utc_blink_ewk_context_proxy_pac_url_set*>(data);
+    owner->applied = true;
+    owner->EventLoopStop(Success);
+  }
+
+  bool applied;
+};
+
+/**
+ * @brief Checking whether the PAC script URL is applied without blocking.
+ */
+TEST_F(utc_blink_ewk_context_proxy_pac_url_set, POS_TEST)
+{
+  ASSERT_EQ(EINA_TRUE, ewk_context_proxy_pac_url_set(ewk_view_context_get(GetEwkWebView()), "http://proxy.tc.url/proxy.pac", proxySet, this));
+  ASSERT_FALSE(applied);
+  ASSERT_EQ(EventLoopStart(), Success);
+  ASSERT_TRUE(applied);
+
+  // Connect directly again for the following tests.
+  applied = false;
+  ASSERT_EQ(EINA_TRUE, ewk_context_proxy_set(ewk_view_context_get(GetEwkWebView()), NULL, NULL, proxySet, this));
+  ASSERT_EQ(EventLoopStart(), Success);
+  ASSERT_TRUE(applied);
+}
+
+/**
+ * @brief Checking whether function works properly in case of NULL of a context.
+ */
+TEST_F(utc_blink_ewk_context_proxy_pac_url_set, NEG_TEST)
+{
+  ASSERT_EQ(EINA_FALSE, ewk_context_proxy_pac_url_set(NULL, "http://proxy.tc.url/proxy.pac", proxySet, this));
+}
+
+/**
+ * @brief Checking whether a PAC URL which is not valid is rejected.
+ */
+TEST_F(utc_blink_ewk_context_proxy_pac_url_set, NEG_TEST_INVALID_URL)
+{
+  ASSERT_EQ(EINA_FALSE, ewk_context_proxy_pac_url_set(ewk_view_context_get(GetEwkWebView()), "not a url", proxySet, this));
+  ASSERT_FALSE(applied);
+}
@@ -0,0 +1,57 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "utc_blink_ewk_base.h"
+
+class utc_blink_ewk_context_proxy_set : public utc_blink_ewk_base
+{
+protected:
+  utc_blink_ewk_context_proxy_set()
+    : applied(false)
+  {
+  }
+
+  static void proxySet(void* data)
+  {
+    utc_blink_ewk_context_proxy_set* owner = static_cast<utc_blink_ewk_context_proxy_set*>(data);
+    owner->applied = true;
+    owner->EventLoopStop(Success);
+  }
+
+  bool applied;
+};
+
+/**
+ * @brief Checking whether the proxy and bypass list are applied without blocking.
+ */
+TEST_F(utc_blink_ewk_context_proxy_set, POS_TEST)
+{
+  ASSERT_EQ(EINA_TRUE, ewk_context_proxy_set(ewk_view_context_get(GetEwkWebView()), "http://proxy.tc.url:8080", "localhost,*.example.com", proxySet, this));
+  ASSERT_FALSE(applied);
+  ASSERT_EQ(EventLoopStart(), Success);
+  ASSERT_TRUE(applied);
+
+  // Connect directly again for the following tests.
+  applied = false;
+  ASSERT_EQ(EINA_TRUE, ewk_context_proxy_set(ewk_view_context_get(GetEwkWebView()), NULL, NULL, proxySet, this));
+  ASSERT_EQ(EventLoopStart(), Success);
+  ASSERT_TRUE(applied);
+}
+
+/**
+ * @brief Checking whether function works properly in case of NULL of a context.
+ */
+TEST_F(utc_blink_ewk_context_proxy_set, NEG_TEST)
+{
+  ASSERT_EQ(EINA_FALSE, ewk_context_proxy_set(NULL, "http://proxy.tc.url:8080", NULL, proxySet, this));
+}
+
+/**
+ * @brief Checking whether bypass rules which can not be parsed are rejected.
+ */
+TEST_F(utc_blink_ewk_context_proxy_set, NEG_TEST_INVALID_BYPASS_RULE)
+{
+  ASSERT_EQ(EINA_FALSE, ewk_context_proxy_set(ewk_view_context_get(GetEwkWebView()), "http://proxy.tc.url:8080", "localhost,10.0.0.0/99", proxySet, this));
+  ASSERT_FALSE(applied);
+}
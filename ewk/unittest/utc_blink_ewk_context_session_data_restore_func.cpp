@@ -0,0 +1,121 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "utc_blink_ewk_base.h"
+
+class utc_blink_ewk_context_session_data_restore_func : public utc_blink_ewk_base
+{
+protected:
+  static const unsigned viewCount = 2;
+
+  std::string firstPage;
+  std::string secondPage;
+
+  Evas_Object *views[viewCount];
+  Evas_Object *restoredViews[viewCount];
+  unsigned restoredCount;
+
+  void PreSetUp()
+  {
+    firstPage  = GetResourceUrl("common/sample.html");
+    secondPage = GetResourceUrl("common/sample_1.html");
+    restoredCount = 0;
+    for (unsigned i = 0; i < viewCount; ++i) {
+      views[i] = NULL;
+      restoredViews[i] = NULL;
+    }
+  }
+
+  void LoadFinished(Evas_Object*)
+  {
+    EventLoopStop(Success);
+  }
+
+  void PostTearDown()
+  {
+    for (unsigned i = 0; i < viewCount; ++i) {
+      if (views[i])
+        evas_object_del(views[i]);
+    }
+  }
+
+  static void SessionRestored(Evas_Object* view, Eina_Bool success, void* user_data)
+  {
+    utc_blink_ewk_context_session_data_restore_func* owner =
+        static_cast<utc_blink_ewk_context_session_data_restore_func*>(user_data);
+    if (!success) {
+      owner->EventLoopStop(Failure);
+      return;
+    }
+
+    owner->restoredViews[owner->restoredCount++] = view;
+    if (owner->restoredCount == viewCount)
+      owner->EventLoopStop(Success);
+  }
+};
+
+/**
+ * @brief Tests if the sessions of all views are restored, the foreground view first.
+ */
+TEST_F(utc_blink_ewk_context_session_data_restore_func, POS_TEST)
+{
+  ewk_view_url_set(GetEwkWebView(), firstPage.c_str());
+  ASSERT_EQ(EventLoopStart(), Success);
+  ewk_view_url_set(GetEwkWebView(), secondPage.c_str());
+  ASSERT_EQ(EventLoopStart(), Success);
+
+  const char *sessionData = NULL;
+  unsigned length = 0;
+  ewk_view_session_data_get(GetEwkWebView(), &sessionData, &length);
+  ASSERT_TRUE(sessionData);
+
+  Ewk_Context *context = ewk_view_context_get(GetEwkWebView());
+  const char *data[viewCount];
+  unsigned lengths[viewCount];
+  for (unsigned i = 0; i < viewCount; ++i) {
+    views[i] = ewk_view_add_with_context(GetEwkEvas(), context);
+    data[i] = sessionData;
+    lengths[i] = length;
+  }
+
+  Eina_Bool result = ewk_context_session_data_restore(context, views, data, lengths, viewCount, 1, SessionRestored, this);
+  free(const_cast<char *>(sessionData));
+  ASSERT_EQ(result, EINA_TRUE);
+  ASSERT_EQ(EventLoopStart(), Success);
+
+  ASSERT_EQ(restoredViews[0], views[1]);
+  for (unsigned i = 0; i < viewCount; ++i) {
+    ASSERT_STREQ(secondPage.c_str(), ewk_view_url_get(views[i]));
+    ASSERT_TRUE(ewk_view_back_possible(views[i]));
+  }
+}
+
+/**
+ * @brief Tests if views which have history already are refused.
+ */
+TEST_F(utc_blink_ewk_context_session_data_restore_func, NEG_TEST_VIEW_WITH_HISTORY)
+{
+  ewk_view_url_set(GetEwkWebView(), firstPage.c_str());
+  ASSERT_EQ(EventLoopStart(), Success);
+
+  const char *sessionData = NULL;
+  unsigned length = 0;
+  ewk_view_session_data_get(GetEwkWebView(), &sessionData, &length);
+
+  Evas_Object *view = GetEwkWebView();
+  Eina_Bool result = ewk_context_session_data_restore(ewk_view_context_get(view), &view, &sessionData, &length, 1, 0, NULL, NULL);
+  free(const_cast<char *>(sessionData));
+  utc_check_eq(result, EINA_FALSE);
+}
+
+/**
+ * @brief Tests if returns EINA_FALSE when called with NULL context.
+ */
+TEST_F(utc_blink_ewk_context_session_data_restore_func, NEG_TEST_NULL_CONTEXT)
+{
+  Evas_Object *view = GetEwkWebView();
+  const char *data = NULL;
+  unsigned length = 0;
+  utc_check_eq(ewk_context_session_data_restore(NULL, &view, &data, &length, 1, 0, NULL, NULL), EINA_FALSE);
+}
@@ -0,0 +1,70 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "utc_blink_ewk_base.h"
+
+#include <string>
+
+class utc_blink_ewk_cookie_manager_cookies_export : public utc_blink_ewk_base {
+protected:
+  utc_blink_ewk_cookie_manager_cookies_export()
+    : chunk_count(0)
+  {
+  }
+
+  static Eina_Bool cookiesExportCallback(const char* data, size_t size, Eina_Bool finished, void* user_data)
+  {
+    utc_blink_ewk_cookie_manager_cookies_export* owner = static_cast<utc_blink_ewk_cookie_manager_cookies_export*>(user_data);
+
+    owner->exported.append(data, size);
+    ++owner->chunk_count;
+    if (finished)
+      owner->EventLoopStop(utc_blink_ewk_base::Success);
+    return EINA_TRUE;
+  }
+
+  void LoadFinished(Evas_Object* webview)
+  {
+    EventLoopStop(utc_blink_ewk_base::Success);
+  }
+
+protected:
+  std::string exported;
+  int chunk_count;
+};
+
+/**
+ * @brief Positive test case of ewk_cookie_manager_cookies_export()
+ */
+TEST_F(utc_blink_ewk_cookie_manager_cookies_export, POS_TEST)
+{
+  Ewk_Cookie_Manager* cookieManager = ewk_context_cookie_manager_get(ewk_view_context_get(GetEwkWebView()));
+  ASSERT_TRUE(cookieManager != NULL);
+
+  ewk_cookie_manager_accept_policy_set(cookieManager, EWK_COOKIE_ACCEPT_POLICY_ALWAYS);
+
+  ASSERT_EQ(EINA_TRUE, ewk_view_url_set(GetEwkWebView(), "http://www.google.com"));
+  ASSERT_EQ(Success, EventLoopStart());
+
+  ewk_cookie_manager_cookies_export(cookieManager, cookiesExportCallback, this);
+  ASSERT_EQ(Success, EventLoopStart());
+
+  ASSERT_GT(chunk_count, 0);
+  ASSERT_FALSE(exported.empty());
+  // Every chunk ends with a complete line.
+  EXPECT_EQ('\n', exported[exported.size() - 1]);
+  EXPECT_NE(std::string::npos, exported.find("\"domain\""));
+}
+
+/**
+* @brief Checking whether function works properly in case of NULL is sent.
+*/
+TEST_F(utc_blink_ewk_cookie_manager_cookies_export, NEG_TEST)
+{
+  ewk_cookie_manager_cookies_export(NULL, cookiesExportCallback, this);
+
+  Ewk_Cookie_Manager* cookieManager = ewk_context_cookie_manager_get(ewk_view_context_get(GetEwkWebView()));
+  ASSERT_TRUE(cookieManager != NULL);
+  ewk_cookie_manager_cookies_export(cookieManager, NULL, this);
+}
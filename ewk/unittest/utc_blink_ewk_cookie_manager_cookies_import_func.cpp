@@ -0,0 +1,82 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "utc_blink_ewk_base.h"
+
+#include <string>
+
+class utc_blink_ewk_cookie_manager_cookies_import : public utc_blink_ewk_base {
+protected:
+  utc_blink_ewk_cookie_manager_cookies_import()
+    : imported(0),
+      rejected(0),
+      host_count(0)
+  {
+  }
+
+  static void cookiesImportCallback(unsigned imported, unsigned rejected, void* user_data)
+  {
+    utc_blink_ewk_cookie_manager_cookies_import* owner = static_cast<utc_blink_ewk_cookie_manager_cookies_import*>(user_data);
+
+    owner->imported = imported;
+    owner->rejected = rejected;
+    owner->EventLoopStop(utc_blink_ewk_base::Success);
+  }
+
+  static void getHostnamesWithCookiesCallback(Eina_List* hostnames, Ewk_Error* error, void* event_info)
+  {
+    utc_blink_ewk_cookie_manager_cookies_import* owner = static_cast<utc_blink_ewk_cookie_manager_cookies_import*>(event_info);
+
+    owner->host_count = eina_list_count(hostnames);
+    owner->EventLoopStop(utc_blink_ewk_base::Success);
+  }
+
+protected:
+  unsigned imported;
+  unsigned rejected;
+  int host_count;
+};
+
+/**
+ * @brief Positive test case of ewk_cookie_manager_cookies_import()
+ */
+TEST_F(utc_blink_ewk_cookie_manager_cookies_import, POS_TEST)
+{
+  Ewk_Cookie_Manager* cookieManager = ewk_context_cookie_manager_get(ewk_view_context_get(GetEwkWebView()));
+  ASSERT_TRUE(cookieManager != NULL);
+
+  ewk_cookie_manager_cookies_clear(cookieManager);
+
+  // Names and values are base64 encoded.
+  std::string lines =
+      "{\"name\":\"Zmlyc3Q=\",\"value\":\"MQ==\",\"domain\":\".example.com\",\"path\":\"/\","
+      "\"creation\":\"0\",\"expiry\":\"0\",\"secure\":false,\"httponly\":false,\"priority\":\"medium\"}\n"
+      "{\"name\":\"c2Vjb25k\",\"value\":\"Mg==\",\"domain\":\"www.example.com\",\"path\":\"/\","
+      "\"creation\":\"0\",\"expiry\":\"0\",\"secure\":true,\"httponly\":true,\"priority\":\"high\"}\n"
+      "{\"name\":\"not base64!\",\"value\":\"MQ==\",\"domain\":\".example.com\",\"path\":\"/\","
+      "\"creation\":\"0\",\"expiry\":\"0\",\"secure\":false,\"httponly\":false,\"priority\":\"medium\"}\n"
+      "not a cookie\n";
+  ewk_cookie_manager_cookies_import(cookieManager, lines.data(), lines.size(), cookiesImportCallback, this);
+  ASSERT_EQ(Success, EventLoopStart());
+
+  EXPECT_EQ(2u, imported);
+  EXPECT_EQ(2u, rejected);
+
+  ewk_cookie_manager_async_hostnames_with_cookies_get(cookieManager, getHostnamesWithCookiesCallback, this);
+  ASSERT_EQ(Success, EventLoopStart());
+
+  EXPECT_EQ(2, host_count);
+}
+
+/**
+* @brief Checking whether function works properly in case of NULL is sent.
+*/
+TEST_F(utc_blink_ewk_cookie_manager_cookies_import, NEG_TEST)
+{
+  ewk_cookie_manager_cookies_import(NULL, "", 0, cookiesImportCallback, this);
+
+  Ewk_Cookie_Manager* cookieManager = ewk_context_cookie_manager_get(ewk_view_context_get(GetEwkWebView()));
+  ASSERT_TRUE(cookieManager != NULL);
+  ewk_cookie_manager_cookies_import(cookieManager, NULL, 0, cookiesImportCallback, this);
+}
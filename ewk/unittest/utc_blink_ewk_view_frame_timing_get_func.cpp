@@ -0,0 +1,65 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "utc_blink_ewk_base.h"
+
+class utc_blink_ewk_view_frame_timing_get : public utc_blink_ewk_base
+{
+ protected:
+  /* Callback for load finished */
+  void LoadFinished(Evas_Object* webview)
+  {
+    EventLoopStop(Success);
+  }
+
+  static const char*const sample;
+};
+
+static const unsigned int max_frames = 16;
+
+const char*const utc_blink_ewk_view_frame_timing_get::sample="common/sample.html";
+
+/**
+ * @brief Checking whether frames presented while recording is enabled are reported.
+ */
+TEST_F(utc_blink_ewk_view_frame_timing_get, POS_TEST)
+{
+  utc_check_eq(ewk_view_frame_timing_enabled_set(GetEwkWebView(), EINA_TRUE), EINA_TRUE);
+
+  if (!ewk_view_url_set(GetEwkWebView(), GetResourceUrl(sample).c_str()))
+    utc_fail();
+  if (Success!=EventLoopStart())
+    utc_fail();
+  // Let the first frames of the page reach the screen.
+  EventLoopWait(1.0);
+
+  Ewk_Frame_Timing timings[max_frames];
+  unsigned int count = ewk_view_frame_timing_get(GetEwkWebView(), timings, max_frames);
+  utc_check_ne(count, 0u);
+  utc_check_le(count, max_frames);
+  for (unsigned int i = 0; i < count; ++i)
+    utc_check_ge(timings[i].present_time, timings[i].swap_time);
+}
+
+/**
+ * @brief Checking whether nothing is reported when recording is disabled.
+ */
+TEST_F(utc_blink_ewk_view_frame_timing_get, NEG_TEST1)
+{
+  utc_check_eq(ewk_view_frame_timing_enabled_set(GetEwkWebView(), EINA_FALSE), EINA_TRUE);
+
+  Ewk_Frame_Timing timings[max_frames];
+  utc_check_eq(ewk_view_frame_timing_get(GetEwkWebView(), timings, max_frames), 0u);
+}
+
+/**
+ * @brief Checking whether function works properly in case of NULL of a webview or an array.
+ */
+TEST_F(utc_blink_ewk_view_frame_timing_get, NEG_TEST2)
+{
+  Ewk_Frame_Timing timings[max_frames];
+  utc_check_eq(ewk_view_frame_timing_get(NULL, timings, max_frames), 0u);
+  utc_check_eq(ewk_view_frame_timing_get(GetEwkWebView(), NULL, max_frames), 0u);
+  utc_check_eq(ewk_view_frame_timing_enabled_set(NULL, EINA_TRUE), EINA_FALSE);
+}
@@ -0,0 +1,79 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "utc_blink_ewk_base.h"
+
+class utc_blink_ewk_view_navigation_policy_enabled_set : public utc_blink_ewk_base
+{
+ protected:
+  utc_blink_ewk_view_navigation_policy_enabled_set()
+    : decisions(0)
+  {
+  }
+
+  void PostSetUp()
+  {
+    evas_object_smart_callback_add(GetEwkWebView(), "policy,navigation,decide", policy_navigation_decide, this);
+  }
+
+  void PreTearDown()
+  {
+    evas_object_smart_callback_del(GetEwkWebView(), "policy,navigation,decide", policy_navigation_decide);
+  }
+
+  /* Callback for load finished */
+  void LoadFinished(Evas_Object* webview)
+  {
+    EventLoopStop(Success);
+  }
+
+  static void policy_navigation_decide(void* data, Evas_Object* webview, void* event_info)
+  {
+    utc_message("[policy_navigation_decide] :: \n");
+    static_cast<utc_blink_ewk_view_navigation_policy_enabled_set*>(data)->decisions++;
+  }
+
+  int decisions;
+  static const char*const sample;
+};
+
+const char*const utc_blink_ewk_view_navigation_policy_enabled_set::sample="common/sample.html";
+
+/**
+ * @brief Checking whether navigations are offered to the application by default.
+ */
+TEST_F(utc_blink_ewk_view_navigation_policy_enabled_set, POS_TEST1)
+{
+  utc_check_eq(ewk_view_navigation_policy_enabled_get(GetEwkWebView()), EINA_TRUE);
+
+  if (!ewk_view_url_set(GetEwkWebView(), GetResourceUrl(sample).c_str()))
+    utc_fail();
+  if (Success!=EventLoopStart())
+    utc_fail();
+  utc_check_gt(decisions, 0);
+}
+
+/**
+ * @brief Checking whether no navigation is offered to the application once disabled.
+ */
+TEST_F(utc_blink_ewk_view_navigation_policy_enabled_set, POS_TEST2)
+{
+  utc_check_eq(ewk_view_navigation_policy_enabled_set(GetEwkWebView(), EINA_FALSE), EINA_TRUE);
+  utc_check_eq(ewk_view_navigation_policy_enabled_get(GetEwkWebView()), EINA_FALSE);
+
+  if (!ewk_view_url_set(GetEwkWebView(), GetResourceUrl(sample).c_str()))
+    utc_fail();
+  if (Success!=EventLoopStart())
+    utc_fail();
+  utc_check_eq(decisions, 0);
+}
+
+/**
+ * @brief Checking whether function works properly in case of NULL of a webview.
+ */
+TEST_F(utc_blink_ewk_view_navigation_policy_enabled_set, NEG_TEST)
+{
+  utc_check_eq(ewk_view_navigation_policy_enabled_set(NULL, EINA_FALSE), EINA_FALSE);
+  utc_check_eq(ewk_view_navigation_policy_enabled_get(NULL), EINA_FALSE);
+}
@@ -0,0 +1,85 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "utc_blink_ewk_base.h"
+
+class utc_blink_ewk_view_response_policy_filter_set : public utc_blink_ewk_base {
+protected:
+  utc_blink_ewk_view_response_policy_filter_set()
+    : decisions(0)
+  {
+  }
+
+  void PostSetUp()
+  {
+    evas_object_smart_callback_add(GetEwkWebView(), "policy,response,decide", policy_response_decide, this);
+  }
+
+  void PreTearDown()
+  {
+    evas_object_smart_callback_del(GetEwkWebView(), "policy,response,decide", policy_response_decide);
+  }
+
+  void LoadFinished(Evas_Object* webview)
+  {
+    EventLoopStop(utc_blink_ewk_base::Success);
+  }
+
+  static void policy_response_decide(void* data, Evas_Object* webview, void* event_info)
+  {
+    utc_message("[policy_response_decide] :: \n");
+    static_cast<utc_blink_ewk_view_response_policy_filter_set*>(data)->decisions++;
+  }
+
+  int decisions;
+};
+
+/**
+ * @brief Tests if responses matching the filter are offered to the application.
+ */
+TEST_F(utc_blink_ewk_view_response_policy_filter_set, POS_TEST1)
+{
+  Eina_List* mime_types = eina_list_append(NULL, "text/*");
+  ASSERT_EQ(EINA_TRUE, ewk_view_response_policy_filter_set(GetEwkWebView(), mime_types, NULL));
+  eina_list_free(mime_types);
+
+  ASSERT_TRUE(ewk_view_url_set(GetEwkWebView(), "http://www.google.com"));
+  ASSERT_EQ(Success, EventLoopStart());
+  ASSERT_GT(decisions, 0);
+}
+
+/**
+ * @brief Tests if responses not matching the filter are used without asking.
+ */
+TEST_F(utc_blink_ewk_view_response_policy_filter_set, POS_TEST2)
+{
+  Eina_List* mime_types = eina_list_append(NULL, "application/octet-stream");
+  ASSERT_EQ(EINA_TRUE, ewk_view_response_policy_filter_set(GetEwkWebView(), mime_types, NULL));
+  eina_list_free(mime_types);
+
+  ASSERT_TRUE(ewk_view_url_set(GetEwkWebView(), "http://www.google.com"));
+  ASSERT_EQ(Success, EventLoopStart());
+  ASSERT_EQ(0, decisions);
+}
+
+/**
+ * @brief Tests if no response is offered to the application once disabled.
+ */
+TEST_F(utc_blink_ewk_view_response_policy_filter_set, POS_TEST3)
+{
+  ASSERT_EQ(EINA_TRUE, ewk_view_response_policy_enabled_set(GetEwkWebView(), EINA_FALSE));
+
+  ASSERT_TRUE(ewk_view_url_set(GetEwkWebView(), "http://www.google.com"));
+  ASSERT_EQ(Success, EventLoopStart());
+  ASSERT_EQ(0, decisions);
+}
+
+/**
+ * @brief Tests if function works properly in case of NULL of a webview
+ */
+TEST_F(utc_blink_ewk_view_response_policy_filter_set, NEG_TEST)
+{
+  ASSERT_EQ(EINA_FALSE, ewk_view_response_policy_filter_set(NULL, NULL, NULL));
+  ASSERT_EQ(EINA_FALSE, ewk_view_response_policy_enabled_set(NULL, EINA_TRUE));
+}
@@ -0,0 +1,87 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "utc_blink_ewk_base.h"
+
+class utc_blink_ewk_view_screenshot_contents_get_async : public utc_blink_ewk_base
+{
+ protected:
+  utc_blink_ewk_view_screenshot_contents_get_async()
+    : snapshot(NULL)
+  {
+  }
+
+  /* Callback for load finished */
+  void LoadFinished(Evas_Object* webview)
+  {
+    EventLoopStop(Success);
+  }
+
+  /* Ewk_Web_App_Screenshot_Captured_Callback */
+  static void screenshotCaptured(Evas_Object* image, void* data)
+  {
+    utc_message("[screenshotCaptured] ::");
+    utc_blink_ewk_view_screenshot_contents_get_async* owner = static_cast<utc_blink_ewk_view_screenshot_contents_get_async*>(data);
+    owner->snapshot = image;
+    owner->EventLoopStop(image ? Success : Failure);
+  }
+
+  Evas_Object* snapshot;
+  static const char*const sample;
+};
+
+const char*const utc_blink_ewk_view_screenshot_contents_get_async::sample="common/sample.html";
+
+/**
+ * @brief Checking whether the evas image object of the specified viewArea of page is passed to the callback.
+ */
+TEST_F(utc_blink_ewk_view_screenshot_contents_get_async, POS_TEST)
+{
+  if (!ewk_view_url_set(GetEwkWebView(), GetResourceUrl(sample).c_str()))
+    utc_fail();
+
+  if (Success!=EventLoopStart())
+    utc_fail();
+
+  Eina_Rectangle snapshot_rect;
+  snapshot_rect.x = snapshot_rect.y = 0;
+  evas_object_geometry_get(GetEwkWebView(), NULL, NULL, &snapshot_rect.w, &snapshot_rect.h);
+
+  Eina_Bool result = ewk_view_screenshot_contents_get_async(GetEwkWebView(), snapshot_rect, 0.5f, evas_object_evas_get(GetEwkWebView()), screenshotCaptured, this);
+  if (!result)
+    utc_fail();
+
+  if (Success!=EventLoopStart())
+    utc_fail();
+
+  int width = 0, height = 0;
+  evas_object_image_size_get(snapshot, &width, &height);
+  evas_object_del(snapshot);
+  utc_check_eq(width, snapshot_rect.w / 2);
+  utc_check_eq(height, snapshot_rect.h / 2);
+}
+
+/**
+ * @brief Checking whether function works properly in case that webview and canvas object are NULL.
+ */
+TEST_F(utc_blink_ewk_view_screenshot_contents_get_async, NEG_TEST1)
+{
+  Eina_Rectangle snapshot_rect;
+  snapshot_rect.x = snapshot_rect.y = 0;
+  evas_object_geometry_get(GetEwkWebView(), NULL, NULL, &snapshot_rect.w, &snapshot_rect.h);
+
+  utc_check_eq(ewk_view_screenshot_contents_get_async(NULL, snapshot_rect, 1.0f, NULL, screenshotCaptured, this), EINA_FALSE);
+}
+
+/**
+ * @brief Checking whether function works properly in case of NULL of a callback.
+ */
+TEST_F(utc_blink_ewk_view_screenshot_contents_get_async, NEG_TEST2)
+{
+  Eina_Rectangle snapshot_rect;
+  snapshot_rect.x = snapshot_rect.y = 0;
+  evas_object_geometry_get(GetEwkWebView(), NULL, NULL, &snapshot_rect.w, &snapshot_rect.h);
+
+  utc_check_eq(ewk_view_screenshot_contents_get_async(GetEwkWebView(), snapshot_rect, 1.0f, evas_object_evas_get(GetEwkWebView()), NULL, NULL), EINA_FALSE);
+}
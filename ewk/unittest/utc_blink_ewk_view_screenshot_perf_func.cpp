@@ -0,0 +1,103 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "utc_blink_ewk_base.h"
+
+class utc_blink_ewk_view_screenshot_perf : public utc_blink_ewk_base
+{
+ protected:
+  utc_blink_ewk_view_screenshot_perf()
+    : snapshot(NULL)
+  {
+  }
+
+  void LoadFinished(Evas_Object* webview)
+  {
+    EventLoopStop(Success);
+  }
+
+  static void screenshotCaptured(Evas_Object* image, void* data)
+  {
+    utc_blink_ewk_view_screenshot_perf* owner = static_cast<utc_blink_ewk_view_screenshot_perf*>(data);
+    owner->snapshot = image;
+    owner->EventLoopStop(image ? Success : Failure);
+  }
+
+  // Returns the average time of a GPU scaled readback to |scale|, in ms.
+  double MeasureAsyncReadback(const Eina_Rectangle& rect, float scale)
+  {
+    double start = ecore_time_get();
+    for (int i = 0; i < kReadbacks; ++i) {
+      EXPECT_EQ(EINA_TRUE, ewk_view_screenshot_contents_get_async(GetEwkWebView(), rect, scale, GetEwkEvas(), screenshotCaptured, this));
+      EXPECT_EQ(Success, EventLoopStart());
+
+      int width = 0, height = 0;
+      evas_object_image_size_get(snapshot, &width, &height);
+      EXPECT_EQ(static_cast<int>(rect.w * scale), width);
+      EXPECT_EQ(static_cast<int>(rect.h * scale), height);
+      evas_object_del(snapshot);
+      snapshot = NULL;
+    }
+    return (ecore_time_get() - start) * 1000.0 / kReadbacks;
+  }
+
+  // Returns the average time of a blocking full size readback, in ms. The
+  // synchronous path does not scale.
+  double MeasureSyncReadback(const Eina_Rectangle& rect)
+  {
+    double start = ecore_time_get();
+    for (int i = 0; i < kReadbacks; ++i) {
+      Evas_Object* image = ewk_view_screenshot_contents_get(GetEwkWebView(), rect, 1.0f, GetEwkEvas());
+      EXPECT_TRUE(image);
+      evas_object_del(image);
+    }
+    return (ecore_time_get() - start) * 1000.0 / kReadbacks;
+  }
+
+  static void PrintResult(const char* trace, double value)
+  {
+    printf("*RESULT ewk_view_screenshot_readback: %s= %f ms\n", trace, value);
+    fflush(stdout);
+  }
+
+  Evas_Object* snapshot;
+  static const char* const sample;
+  static const int kReadbacks = 20;
+};
+
+const char* const utc_blink_ewk_view_screenshot_perf::sample = "common/sample.html";
+
+/**
+ * @brief Reports readbacks scaled on the GPU at several target sizes and a
+ * blocking full size readback.
+ *
+ * Only the scaled pixels cross to the CPU on the GPU path. The timings are
+ * printed for the perf dashboard, only the image sizes are checked.
+ */
+TEST_F(utc_blink_ewk_view_screenshot_perf, PERF_TEST)
+{
+  ASSERT_EQ(EINA_TRUE, ewk_view_url_set(GetEwkWebView(), GetResourceUrl(sample).c_str()));
+  ASSERT_EQ(Success, EventLoopStart());
+
+  Eina_Rectangle rect;
+  rect.x = rect.y = 0;
+  evas_object_geometry_get(GetEwkWebView(), NULL, NULL, &rect.w, &rect.h);
+  ASSERT_GT(rect.w, 0);
+  ASSERT_GT(rect.h, 0);
+
+  static const struct {
+    const char* trace;
+    float scale;
+  } kTargets[] = {
+    { "gpu_scaled_100", 1.0f },
+    { "gpu_scaled_50", 0.5f },
+    { "gpu_scaled_25", 0.25f },
+    { "gpu_scaled_12", 0.125f },
+  };
+
+  for (size_t i = 0; i < sizeof(kTargets) / sizeof(kTargets[0]); ++i)
+    PrintResult(kTargets[i].trace, MeasureAsyncReadback(rect, kTargets[i].scale));
+
+  PrintResult("sync_full_size", MeasureSyncReadback(rect));
+}
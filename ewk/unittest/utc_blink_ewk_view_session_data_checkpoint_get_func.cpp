@@ -0,0 +1,149 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "utc_blink_ewk_base.h"
+
+class utc_blink_ewk_view_session_data_checkpoint_get_func : public utc_blink_ewk_base
+{
+protected:
+  std::string firstPage;
+  std::string secondPage;
+
+  std::string storedSession;
+  Evas_Object *otherWebview;
+
+  void PreSetUp()
+  {
+    firstPage  = GetResourceUrl("common/sample.html");
+    secondPage = GetResourceUrl("common/sample_1.html");
+    otherWebview = NULL;
+  }
+
+  void LoadFinished(Evas_Object*)
+  {
+    EventLoopStop(Success);
+  }
+
+  void PostTearDown()
+  {
+    if (otherWebview)
+      evas_object_del(otherWebview);
+  }
+
+  // Appends a checkpoint to the stored session, returns its length.
+  unsigned AppendCheckpoint()
+  {
+    const char *data = NULL;
+    unsigned length = 0;
+    ewk_view_session_data_checkpoint_get(GetEwkWebView(), &data, &length);
+    if (data) {
+      storedSession.append(data, length);
+      free(const_cast<char *>(data));
+    }
+    return length;
+  }
+};
+
+/**
+ * @brief Tests if checkpoints appended to each other restore the session.
+ */
+TEST_F(utc_blink_ewk_view_session_data_checkpoint_get_func, POS_TEST)
+{
+  ewk_view_url_set(GetEwkWebView(), firstPage.c_str());
+  ASSERT_EQ(EventLoopStart(), Success);
+  ASSERT_NE(AppendCheckpoint(), 0u);
+
+  ewk_view_url_set(GetEwkWebView(), secondPage.c_str());
+  ASSERT_EQ(EventLoopStart(), Success);
+  ASSERT_NE(AppendCheckpoint(), 0u);
+
+  otherWebview = ewk_view_add_with_session_data(GetEwkEvas(), storedSession.data(), storedSession.size());
+  ASSERT_TRUE(otherWebview);
+
+  ASSERT_STREQ(secondPage.c_str(), ewk_view_url_get(otherWebview));
+  ASSERT_TRUE(ewk_view_back_possible(otherWebview));
+}
+
+/**
+ * @brief Tests if checkpoints following session data restore the session.
+ */
+TEST_F(utc_blink_ewk_view_session_data_checkpoint_get_func, POS_TEST_AFTER_SESSION_DATA)
+{
+  ewk_view_url_set(GetEwkWebView(), firstPage.c_str());
+  ASSERT_EQ(EventLoopStart(), Success);
+
+  const char *data = NULL;
+  unsigned length = 0;
+  ewk_view_session_data_get(GetEwkWebView(), &data, &length);
+  ASSERT_TRUE(data);
+  storedSession.assign(data, length);
+  free(const_cast<char *>(data));
+
+  ewk_view_url_set(GetEwkWebView(), secondPage.c_str());
+  ASSERT_EQ(EventLoopStart(), Success);
+  ASSERT_NE(AppendCheckpoint(), 0u);
+
+  otherWebview = ewk_view_add_with_session_data(GetEwkEvas(), storedSession.data(), storedSession.size());
+  ASSERT_TRUE(otherWebview);
+
+  ASSERT_STREQ(secondPage.c_str(), ewk_view_url_get(otherWebview));
+  ASSERT_TRUE(ewk_view_back_possible(otherWebview));
+}
+
+/**
+ * @brief Tests if session data got between checkpoints is continued by the
+ * checkpoints got after it.
+ */
+TEST_F(utc_blink_ewk_view_session_data_checkpoint_get_func, POS_TEST_SESSION_DATA_BETWEEN_CHECKPOINTS)
+{
+  ewk_view_url_set(GetEwkWebView(), firstPage.c_str());
+  ASSERT_EQ(EventLoopStart(), Success);
+  ASSERT_NE(AppendCheckpoint(), 0u);
+
+  const char *data = NULL;
+  unsigned length = 0;
+  ewk_view_session_data_get(GetEwkWebView(), &data, &length);
+  ASSERT_TRUE(data);
+  storedSession.assign(data, length);
+  free(const_cast<char *>(data));
+
+  ewk_view_url_set(GetEwkWebView(), secondPage.c_str());
+  ASSERT_EQ(EventLoopStart(), Success);
+  ASSERT_NE(AppendCheckpoint(), 0u);
+
+  otherWebview = ewk_view_add_with_session_data(GetEwkEvas(), storedSession.data(), storedSession.size());
+  ASSERT_TRUE(otherWebview);
+
+  ASSERT_STREQ(secondPage.c_str(), ewk_view_url_get(otherWebview));
+  ASSERT_TRUE(ewk_view_back_possible(otherWebview));
+}
+
+/**
+ * @brief Tests if no checkpoint is returned when nothing changed.
+ */
+TEST_F(utc_blink_ewk_view_session_data_checkpoint_get_func, POS_TEST_NOTHING_CHANGED)
+{
+  ewk_view_url_set(GetEwkWebView(), firstPage.c_str());
+  ASSERT_EQ(EventLoopStart(), Success);
+  ASSERT_NE(AppendCheckpoint(), 0u);
+
+  const char *data = NULL;
+  unsigned length = 0;
+  ewk_view_session_data_checkpoint_get(GetEwkWebView(), &data, &length);
+  ASSERT_FALSE(data);
+  ASSERT_EQ(length, 0u);
+}
+
+/**
+ * @brief Tests if returns NULL when called with NULL webview object.
+ */
+TEST_F(utc_blink_ewk_view_session_data_checkpoint_get_func, NEG_TEST_NULL_WEBVIEW)
+{
+  const char *data;
+  unsigned length;
+  ewk_view_session_data_checkpoint_get(NULL, &data, &length);
+
+  ASSERT_FALSE(data);
+  ASSERT_EQ(length, 0u);
+}
@@ -203,8 +203,16 @@ void _Ewk_Policy_Decision::Download() {
   }
 }
 
-void _Ewk_Policy_Decision::Suspend() {
+bool _Ewk_Policy_Decision::Suspend() {
+  if (type_ == _Ewk_Policy_Decision::POLICY_NAVIGATION &&
+      !navigation_policy_handler_->IsDeferred()) {
+    LOG(WARNING) << "The navigation policy decision for " << url_
+                 << " cannot be suspended, it is used";
+    return false;
+  }
+
   isSuspended_ = true;
+  return true;
 }
 
 void _Ewk_Policy_Decision::InitializeOnUIThread() {
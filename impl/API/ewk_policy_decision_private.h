@@ -55,7 +55,9 @@ class _Ewk_Policy_Decision {
   void Use();
   void Ignore();
   void Download();
-  void Suspend();
+  // Returns false for navigations the renderer waits on, they are decided
+  // when the callback returns.
+  bool Suspend();
 
   bool isDecided() const { return isDecided_; }
   bool isSuspended() const { return isSuspended_; }
@@ -0,0 +1,126 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "browser/async_hit_test_queue_efl.h"
+
+#include <stdlib.h>
+
+#include "base/bind.h"
+#include "base/debug/trace_event.h"
+#include "base/message_loop/message_loop.h"
+
+namespace {
+
+// Requests this close (in view coordinates) to a pending query reuse it.
+const int kCoalesceDistance = 2;
+
+} // namespace
+
+AsyncHitTestQueueEfl::AsyncHitTestQueueEfl(Evas_Object* web_view,
+                                           const SendCallback& send_callback)
+  : web_view_(web_view)
+  , send_callback_(send_callback)
+  , flush_scheduled_(false)
+  , coalesced_requests_(0)
+  , weak_factory_(this) {
+}
+
+AsyncHitTestQueueEfl::~AsyncHitTestQueueEfl() {
+  // Callers still have to release their user data.
+  CancelAll();
+}
+
+void AsyncHitTestQueueEfl::Add(const gfx::Point& point,
+                               tizen_webview::Hit_Test_Mode mode,
+                               AsyncHitTestRequest* request) {
+  DCHECK(request);
+  Query* query = FindQuery(point, mode);
+  if (query) {
+    query->requests.push_back(request);
+    ++coalesced_requests_;
+    TRACE_COUNTER1("efl", "CoalescedHitTests", coalesced_requests_);
+    return;
+  }
+
+  query = new Query;
+  query->point = point;
+  query->mode = mode;
+  query->sent = false;
+  query->requests.push_back(request);
+  queries_.Add(query);
+
+  if (flush_scheduled_)
+    return;
+  flush_scheduled_ = true;
+  base::MessageLoop::current()->PostTask(FROM_HERE,
+      base::Bind(&AsyncHitTestQueueEfl::Flush, weak_factory_.GetWeakPtr()));
+}
+
+void AsyncHitTestQueueEfl::Dispatch(int query_id,
+                                    tizen_webview::Hit_Test* hit_test) {
+  Query* query = queries_.Lookup(query_id);
+  if (!query)
+    return;
+
+  // Requests may queue new hit tests, take them out of the map first.
+  ScopedVector<AsyncHitTestRequest> requests;
+  requests.swap(query->requests);
+  queries_.Remove(query_id);
+
+  for (size_t i = 0; i < requests.size(); ++i)
+    requests[i]->Run(hit_test, web_view_);
+}
+
+void AsyncHitTestQueueEfl::CancelAll() {
+  ScopedVector<AsyncHitTestRequest> requests;
+  for (IDMap<Query, IDMapOwnPointer>::iterator it(&queries_);
+       !it.IsAtEnd(); it.Advance()) {
+    ScopedVector<AsyncHitTestRequest>& pending = it.GetCurrentValue()->requests;
+    for (size_t i = 0; i < pending.size(); ++i)
+      requests.push_back(pending[i]);
+    pending.weak_clear();
+  }
+  queries_.Clear();
+
+  for (size_t i = 0; i < requests.size(); ++i)
+    requests[i]->Run(NULL, web_view_);
+}
+
+AsyncHitTestQueueEfl::Query* AsyncHitTestQueueEfl::FindQuery(
+    const gfx::Point& point, tizen_webview::Hit_Test_Mode mode) {
+  for (IDMap<Query, IDMapOwnPointer>::iterator it(&queries_);
+       !it.IsAtEnd(); it.Advance()) {
+    Query* query = it.GetCurrentValue();
+    if (query->mode == mode &&
+        abs(query->point.x() - point.x()) <= kCoalesceDistance &&
+        abs(query->point.y() - point.y()) <= kCoalesceDistance)
+      return query;
+  }
+  return NULL;
+}
+
+void AsyncHitTestQueueEfl::Flush() {
+  flush_scheduled_ = false;
+
+  HitTestAsyncQueriesEfl batch;
+  for (IDMap<Query, IDMapOwnPointer>::iterator it(&queries_);
+       !it.IsAtEnd(); it.Advance()) {
+    Query* query = it.GetCurrentValue();
+    if (query->sent)
+      continue;
+
+    HitTestAsyncQueryEfl params;
+    params.query_id = it.GetCurrentKey();
+    params.point = query->point;
+    params.mode = query->mode;
+    batch.push_back(params);
+    query->sent = true;
+  }
+
+  if (batch.empty())
+    return;
+
+  TRACE_EVENT1("efl", "AsyncHitTestQueueEfl::Flush", "queries", batch.size());
+  send_callback_.Run(batch);
+}
@@ -0,0 +1,92 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef ASYNC_HIT_TEST_QUEUE_EFL_H_
+#define ASYNC_HIT_TEST_QUEUE_EFL_H_
+
+#include <Evas.h>
+
+#include "base/callback.h"
+#include "base/id_map.h"
+#include "base/memory/scoped_vector.h"
+#include "base/memory/weak_ptr.h"
+#include "common/hit_test_params_efl.h"
+#include "tizen_webview/public/tw_callbacks.h"
+
+class AsyncHitTestRequest {
+ public:
+  AsyncHitTestRequest(int x, int y, tizen_webview::Hit_Test_Mode mode,
+                      tizen_webview::View_Hit_Test_Request_Callback callback,
+                      void* user_data)
+    : x_(x)
+    , y_(y)
+    , mode_(mode)
+    , callback_(callback)
+    , user_data_(user_data) {
+  }
+
+  void Run(tizen_webview::Hit_Test* hit_test, Evas_Object* web_view) {
+    DCHECK(callback_);
+    callback_(web_view, x_, y_, mode_, hit_test, user_data_);
+  }
+
+ private:
+  int x_;
+  int y_;
+  tizen_webview::Hit_Test_Mode mode_;
+  tizen_webview::View_Hit_Test_Request_Callback callback_;
+  void* user_data_;
+};
+
+// Coalesces asynchronous hit test requests of a view. Requests for the same
+// mode at (nearly) the same point share one renderer query, whether that
+// query is still queued or already sent. Queries are sent as a single batch
+// once the current task returns to the message loop, so a burst of requests
+// from one event costs one IPC.
+class AsyncHitTestQueueEfl {
+ public:
+  typedef base::Callback<void(const HitTestAsyncQueriesEfl&)> SendCallback;
+
+  // Requests are run with |web_view|. Requests still pending when the queue
+  // goes away are run with a NULL hit test.
+  AsyncHitTestQueueEfl(Evas_Object* web_view,
+                       const SendCallback& send_callback);
+  ~AsyncHitTestQueueEfl();
+
+  // |point| is in view coordinates, |request| is run once the result of the
+  // query it is attached to arrives.
+  void Add(const gfx::Point& point, tizen_webview::Hit_Test_Mode mode,
+           AsyncHitTestRequest* request);
+
+  // Runs every request waiting for |query_id|, with a NULL |hit_test| if the
+  // renderer could not do it. Unknown ids belong to cancelled queries and
+  // are ignored.
+  void Dispatch(int query_id, tizen_webview::Hit_Test* hit_test);
+
+  // Drops all pending queries, their requests are run with a NULL hit test
+  // so callers can release their user data.
+  void CancelAll();
+
+ private:
+  struct Query {
+    gfx::Point point;
+    tizen_webview::Hit_Test_Mode mode;
+    bool sent;
+    ScopedVector<AsyncHitTestRequest> requests;
+  };
+
+  Query* FindQuery(const gfx::Point& point, tizen_webview::Hit_Test_Mode mode);
+  void Flush();
+
+  Evas_Object* web_view_;
+  SendCallback send_callback_;
+  IDMap<Query, IDMapOwnPointer> queries_;
+  bool flush_scheduled_;
+  int coalesced_requests_;
+  base::WeakPtrFactory<AsyncHitTestQueueEfl> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(AsyncHitTestQueueEfl);
+};
+
+#endif // ASYNC_HIT_TEST_QUEUE_EFL_H_
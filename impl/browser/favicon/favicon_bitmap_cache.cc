@@ -0,0 +1,144 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "browser/favicon/favicon_bitmap_cache.h"
+
+FaviconBitmapCache::Stats::Stats()
+  : hits(0),
+    misses(0),
+    evictions(0),
+    evictedSize(0),
+    size(0),
+    capacity(0),
+    count(0) {
+}
+
+FaviconBitmapCache::FaviconBitmapCache(size_t capacity)
+  : m_size(0),
+    m_capacity(capacity) {
+}
+
+FaviconBitmapCache::~FaviconBitmapCache() {
+}
+
+bool FaviconBitmapCache::Get(const GURL &faviconUrl, SkBitmap *bitmap) {
+  base::AutoLock locker(m_lock);
+  EntryMap::iterator it = m_entries.find(faviconUrl);
+  if (it == m_entries.end()) {
+    ++m_stats.misses;
+    return false;
+  }
+  ++m_stats.hits;
+  m_lru.splice(m_lru.begin(), m_lru, it->second.lruPosition);
+  *bitmap = it->second.bitmap;
+  return true;
+}
+
+void FaviconBitmapCache::Put(const GURL &faviconUrl, const SkBitmap &bitmap) {
+  base::AutoLock locker(m_lock);
+  EntryMap::iterator it = m_entries.find(faviconUrl);
+  if (it != m_entries.end()) {
+    Erase(it);
+  }
+  Insert(faviconUrl, bitmap);
+}
+
+void FaviconBitmapCache::Fill(const GURL &faviconUrl, const SkBitmap &bitmap) {
+  base::AutoLock locker(m_lock);
+  // A bitmap put meanwhile is newer than what sqlite had.
+  if (m_entries.count(faviconUrl)) {
+    return;
+  }
+  Insert(faviconUrl, bitmap);
+}
+
+void FaviconBitmapCache::Remove(const GURL &faviconUrl) {
+  base::AutoLock locker(m_lock);
+  EntryMap::iterator it = m_entries.find(faviconUrl);
+  if (it != m_entries.end()) {
+    Erase(it);
+  }
+}
+
+void FaviconBitmapCache::Clear() {
+  base::AutoLock locker(m_lock);
+  m_entries.clear();
+  m_lru.clear();
+  m_size = 0;
+}
+
+void FaviconBitmapCache::Pin(const GURL &faviconUrl) {
+  base::AutoLock locker(m_lock);
+  ++m_pins[faviconUrl];
+}
+
+void FaviconBitmapCache::Unpin(const GURL &faviconUrl) {
+  base::AutoLock locker(m_lock);
+  std::map<GURL, int>::iterator it = m_pins.find(faviconUrl);
+  if (it == m_pins.end()) {
+    return;
+  }
+  if (--it->second == 0) {
+    m_pins.erase(it);
+  }
+  // Bitmaps put while pinned may have gone over the capacity.
+  TrimLocked(m_capacity);
+}
+
+void FaviconBitmapCache::SetCapacity(size_t capacity) {
+  base::AutoLock locker(m_lock);
+  m_capacity = capacity;
+  TrimLocked(m_capacity);
+}
+
+size_t FaviconBitmapCache::Trim(size_t size) {
+  base::AutoLock locker(m_lock);
+  return TrimLocked(size);
+}
+
+FaviconBitmapCache::Stats FaviconBitmapCache::GetStats() const {
+  base::AutoLock locker(m_lock);
+  Stats stats = m_stats;
+  stats.size = m_size;
+  stats.capacity = m_capacity;
+  stats.count = m_entries.size();
+  return stats;
+}
+
+void FaviconBitmapCache::Insert(const GURL &faviconUrl, const SkBitmap &bitmap) {
+  m_lru.push_front(faviconUrl);
+  Entry &entry = m_entries[faviconUrl];
+  entry.bitmap = bitmap;
+  entry.lruPosition = m_lru.begin();
+  m_size += bitmap.getSize();
+  TrimLocked(m_capacity);
+}
+
+void FaviconBitmapCache::Erase(EntryMap::iterator it) {
+  m_size -= it->second.bitmap.getSize();
+  m_lru.erase(it->second.lruPosition);
+  m_entries.erase(it);
+}
+
+size_t FaviconBitmapCache::TrimLocked(size_t size) {
+  size_t freed = 0;
+  LruList::iterator it = m_lru.end();
+  while (m_size > size && it != m_lru.begin()) {
+    --it;
+    if (m_pins.count(*it)) {
+      continue;
+    }
+    EntryMap::iterator entry = m_entries.find(*it);
+    size_t bytes = entry->second.bitmap.getSize();
+    // Erase() invalidates |it|, carry on from the entry after it.
+    LruList::iterator next = it;
+    ++next;
+    Erase(entry);
+    it = next;
+    freed += bytes;
+    ++m_stats.evictions;
+    m_stats.evictedSize += bytes;
+  }
+  return freed;
+}
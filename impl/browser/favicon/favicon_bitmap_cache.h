@@ -0,0 +1,79 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAVICON_BITMAP_CACHE_H
+#define FAVICON_BITMAP_CACHE_H
+
+#include <list>
+#include <map>
+#include "base/basictypes.h"
+#include "base/synchronization/lock.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "url/gurl.h"
+
+// The favicon bitmaps kept in memory, least recently used ones are dropped
+// once they take more than the capacity. Pinned bitmaps, the ones not
+// written to sqlite yet, are never dropped. Can be used on any thread.
+class FaviconBitmapCache {
+ public:
+  struct Stats {
+    Stats();
+
+    int64 hits;
+    int64 misses;
+    int64 evictions;
+    // In bytes.
+    int64 evictedSize;
+    int64 size;
+    int64 capacity;
+    size_t count;
+  };
+
+  explicit FaviconBitmapCache(size_t capacity);
+  ~FaviconBitmapCache();
+
+  // Counts a hit or a miss.
+  bool Get(const GURL &faviconUrl, SkBitmap *bitmap);
+  // Adds or replaces the bitmap of |faviconUrl|.
+  void Put(const GURL &faviconUrl, const SkBitmap &bitmap);
+  // Adds a bitmap read from sqlite, unless one is there already.
+  void Fill(const GURL &faviconUrl, const SkBitmap &bitmap);
+  void Remove(const GURL &faviconUrl);
+  void Clear();
+
+  // Pins are counted and outlive Remove() and Clear().
+  void Pin(const GURL &faviconUrl);
+  void Unpin(const GURL &faviconUrl);
+
+  void SetCapacity(size_t capacity);
+  // Drops bitmaps until at most |size| bytes stay. Returns the bytes freed.
+  size_t Trim(size_t size);
+  Stats GetStats() const;
+
+ private:
+  typedef std::list<GURL> LruList;
+  struct Entry {
+    SkBitmap bitmap;
+    LruList::iterator lruPosition;
+  };
+  typedef std::map<GURL, Entry> EntryMap;
+
+  void Insert(const GURL &faviconUrl, const SkBitmap &bitmap);
+  void Erase(EntryMap::iterator it);
+  // Called with |m_lock| held.
+  size_t TrimLocked(size_t size);
+
+  mutable base::Lock m_lock;
+  EntryMap m_entries;
+  // Most recently used first.
+  LruList m_lru;
+  std::map<GURL, int> m_pins;
+  size_t m_size;
+  size_t m_capacity;
+  Stats m_stats;
+
+  DISALLOW_COPY_AND_ASSIGN(FaviconBitmapCache);
+};
+
+#endif // FAVICON_BITMAP_CACHE_H
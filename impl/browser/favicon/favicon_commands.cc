@@ -6,6 +6,9 @@
 #include "browser/favicon/favicon_database_p.h"
 #include "third_party/sqlite/sqlite3.h"
 #include "base/message_loop/message_loop_proxy.h"
+#include "base/sha1.h"
+#include "base/strings/string_number_conversions.h"
+#include "ui/gfx/codec/png_codec.h"
 #include <iostream>
 
 #define CHECK_RESULT(qry, var, res, st, ret) if (var != res) {\
@@ -22,6 +25,13 @@
                                               return ret;\
                                             }
 
+#define CHECK_CACHED_MSG(var, res, st, ret) if (var != res) {\
+                                              std::cerr << "ERROR! " << name() << " : " << sqlite3ErrStr(result) << std::endl;\
+                                              sqlite3_reset(st);\
+                                              setError(sqlite3ErrStr(result));\
+                                              return ret;\
+                                            }
+
 #define CHECK_PREP_MSG(qry, var, res, ret) if (var != res) {\
                                               std::cerr << "ERROR! " << name() << " : " << sqlite3ErrStr(result) << std::endl;\
                                               if (qry) sqlite3_free(qry);\
@@ -30,6 +40,56 @@
                                             }
 
 
+bool Command::storeBitmap(const std::string &faviconUrl, const SkBitmap &bitmap) {
+  std::vector<unsigned char> png;
+  if (!encode(bitmap, &png)) {
+    setError("can not encode bitmap");
+    return false;
+  }
+  std::string key = hash(png);
+
+  // Icons served from several URLs are stored once.
+  sqlite3_stmt *stmt = db()->cachedStatement(FaviconDatabasePrivate::INSERT_BITMAP);
+  if (!stmt) {
+    setError(sqlite3_errmsg(db()->sqlite));
+    return false;
+  }
+
+  int result = sqlite3_bind_text(stmt, 1, key.c_str(), key.size(), SQLITE_STATIC);
+  CHECK_CACHED_MSG(result, SQLITE_OK, stmt, false);
+  result = sqlite3_bind_blob(stmt, 2, &png[0], png.size(), SQLITE_STATIC);
+  CHECK_CACHED_MSG(result, SQLITE_OK, stmt, false);
+
+  result = sqlite3_step(stmt);
+  CHECK_CACHED_MSG(result, SQLITE_DONE, stmt, false);
+  sqlite3_reset(stmt);
+
+  stmt = db()->cachedStatement(FaviconDatabasePrivate::SET_BITMAP_HASH);
+  if (!stmt) {
+    setError(sqlite3_errmsg(db()->sqlite));
+    return false;
+  }
+
+  result = sqlite3_bind_text(stmt, 1, faviconUrl.c_str(), faviconUrl.size(), SQLITE_STATIC);
+  CHECK_CACHED_MSG(result, SQLITE_OK, stmt, false);
+  result = sqlite3_bind_text(stmt, 2, key.c_str(), key.size(), SQLITE_STATIC);
+  CHECK_CACHED_MSG(result, SQLITE_OK, stmt, false);
+
+  result = sqlite3_step(stmt);
+  CHECK_CACHED_MSG(result, SQLITE_DONE, stmt, false);
+
+  sqlite3_reset(stmt);
+  return true;
+}
+
+std::string Command::columnText(sqlite3_stmt *stmt, int column) {
+  const unsigned char *text = sqlite3_column_text(stmt, column);
+  if (!text) {
+    return std::string();
+  }
+  return std::string(reinterpret_cast<const char *>(text), sqlite3_column_bytes(stmt, column));
+}
+
 std::string Command::lastError() const {
   return std::string("[") + m_name + "] :: " + m_lastError;
 }
@@ -42,34 +102,55 @@ void Command::setError(const std::string &err) {
   m_lastError = err;
 }
 
-scoped_refptr<SerializedBitmap> Command::serialize(const SkBitmap &bitmap) {
-  scoped_refptr<SerializedBitmap> res(new SerializedBitmap);
+bool Command::encode(const SkBitmap &bitmap, std::vector<unsigned char> *png) {
   if (bitmap.isNull()) {
-    return res;
+    return false;
+  }
+  if (bitmap.colorType() == kN32_SkColorType) {
+    return gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, png);
+  }
+  SkBitmap copy;
+  if (!bitmap.copyTo(&copy, kN32_SkColorType)) {
+    return false;
   }
-  res->alloc(bitmap.getSize() + 4 * sizeof(int));
-  static_cast<int *>(res->data)[0] = static_cast<int>(bitmap.colorType());
-  static_cast<int *>(res->data)[1] = static_cast<int>(bitmap.alphaType());
-  static_cast<int *>(res->data)[2] = bitmap.width();
-  static_cast<int *>(res->data)[3] = bitmap.height();
-  if (!bitmap.copyPixelsTo(static_cast<int *>(res->data) + 4, bitmap.getSize())) {
-    res->free();
+  return gfx::PNGCodec::EncodeBGRASkBitmap(copy, false, png);
+}
+
+SkBitmap Command::decode(const void *data, size_t size) {
+  SkBitmap bitmap;
+  if (!data || !gfx::PNGCodec::Decode(static_cast<const unsigned char *>(data), size, &bitmap)) {
+    return SkBitmap();
   }
-  return res;
+  return bitmap;
+}
+
+std::string Command::hash(const std::vector<unsigned char> &png) {
+  std::string digest = base::SHA1HashString(std::string(png.begin(), png.end()));
+  return base::HexEncode(digest.data(), digest.size());
 }
 
-SkBitmap Command::deserialize(const void *data) {
-  if (!data) {
+SkBitmap Command::deserializeLegacy(const void *data, size_t size) {
+  if (!data || size < 4 * sizeof(int)) {
+    return SkBitmap();
+  }
+
+  const int *header = static_cast<const int *>(data);
+  SkColorType colorType = static_cast<SkColorType>(header[0]);
+  SkAlphaType alphaType = static_cast<SkAlphaType>(header[1]);
+  int width = header[2];
+  int height = header[3];
+  if (colorType < 0 || colorType > kLastEnum_SkColorType ||
+      alphaType < 0 || alphaType > kLastEnum_SkAlphaType ||
+      width <= 0 || height <= 0) {
     return SkBitmap();
   }
 
-  SkColorType colorType = static_cast<SkColorType>(static_cast<const int *>(data)[0]);
-  SkAlphaType alphaType = static_cast<SkAlphaType>(static_cast<const int *>(data)[1]);
-  int width = static_cast<const int *>(data)[1];
-  int height = static_cast<const int *>(data)[2];
   SkBitmap bitmap;
-  bitmap.setInfo(SkImageInfo::Make(width, height, colorType, alphaType), 0);
-  bitmap.setPixels(static_cast<int *>(const_cast<void *>(data)) + 4);
+  if (!bitmap.setInfo(SkImageInfo::Make(width, height, colorType, alphaType), 0) ||
+      bitmap.getSize() > size - 4 * sizeof(int)) {
+    return SkBitmap();
+  }
+  bitmap.setPixels(const_cast<int *>(header) + 4);
 
   // as the |data| set to the |bitmap| are retrieved from sqlite blob,
   // this |data| would be freed by sqlite on finalize, so to be sure that
@@ -139,19 +220,114 @@ bool InitDatabaseCommand::sqlExecute() {
   sqlite3_finalize(stmt);
   sqlite3_free(query);
 
-  query = sqlite3_mprintf("CREATE TABLE IF NOT EXISTS %q (%q TEXT PRIMARY KEY REFERENCES %q (%q), %q BLOB);",
-                          db()->faviconUrlToBitmapTable, db()->faviconUrlColumn,
-                          db()->pageUrlToFaviconUrlTable, db()->faviconUrlColumn,
-                          db()->bitmapColumn);
+  query = sqlite3_mprintf("CREATE TABLE IF NOT EXISTS %q (%q TEXT PRIMARY KEY, %q TEXT);"
+                          "CREATE INDEX IF NOT EXISTS %q_%q ON %q (%q);"
+                          "CREATE TABLE IF NOT EXISTS %q (%q TEXT PRIMARY KEY, %q BLOB);",
+                          db()->faviconUrlToHashTable, db()->faviconUrlColumn, db()->hashColumn,
+                          db()->faviconUrlToHashTable, db()->hashColumn,
+                          db()->faviconUrlToHashTable, db()->hashColumn,
+                          db()->bitmapTable, db()->hashColumn, db()->bitmapColumn);
 
-  result = sqlite3_prepare_v2(db()->sqlite, query, -1, &stmt, 0);
-  CHECK_PREP_MSG(query, result, SQLITE_OK, false);
+  result = sqlite3_exec(db()->sqlite, query, 0, 0, 0);
+  sqlite3_free(query);
+  if (result != SQLITE_OK) {
+    setError(sqlite3ErrStr(result));
+    return false;
+  }
+  return true;
+}
+
+// MIGRATE
+MigrateDatabaseCommand::MigrateDatabaseCommand(FaviconDatabasePrivate *db)
+  : Command("MigrateDatabase", db) {
+}
 
+bool MigrateDatabaseCommand::isNeeded() {
+  sqlite3_stmt *stmt = 0;
+  int result = sqlite3_prepare_v2(db()->sqlite, "PRAGMA user_version;", -1, &stmt, 0);
+  CHECK_PREP_MSG(0, result, SQLITE_OK, false);
   result = sqlite3_step(stmt);
-  CHECK_RESULT_MSG(query, result, SQLITE_DONE, stmt, false);
+  CHECK_RESULT_MSG(0, result, SQLITE_ROW, stmt, false);
+  int version = sqlite3_column_int(stmt, 0);
+  sqlite3_finalize(stmt);
+  return version < FaviconDatabasePrivate::schemaVersion;
+}
+
+bool MigrateDatabaseCommand::sqlExecute() {
+  if (!isNeeded()) {
+    return true;
+  }
 
+  sqlite3_stmt *stmt = 0;
+  int result = sqlite3_prepare_v2(db()->sqlite, "SELECT name FROM sqlite_master WHERE type = 'table' AND name = ? ;",
+                              -1, &stmt, 0);
+  CHECK_PREP_MSG(0, result, SQLITE_OK, false);
+  result = sqlite3_bind_text(stmt, 1, db()->faviconUrlToBitmapTable, -1, SQLITE_STATIC);
+  CHECK_RESULT_MSG(0, result, SQLITE_OK, stmt, false);
+  result = sqlite3_step(stmt);
+  bool hasLegacyTable = result == SQLITE_ROW;
   sqlite3_finalize(stmt);
+
+  result = sqlite3_exec(db()->sqlite, "BEGIN TRANSACTION;", 0, 0, 0);
+  if (result != SQLITE_OK) {
+    setError(sqlite3ErrStr(result));
+    return false;
+  }
+
+  if (hasLegacyTable) {
+    char *query = sqlite3_mprintf("SELECT %q, %q FROM %q;", db()->faviconUrlColumn,
+                                  db()->bitmapColumn, db()->faviconUrlToBitmapTable);
+    result = sqlite3_prepare_v2(db()->sqlite, query, -1, &stmt, 0);
+    sqlite3_free(query);
+    if (result != SQLITE_OK) {
+      setError(sqlite3ErrStr(result));
+      sqlite3_exec(db()->sqlite, "ROLLBACK;", 0, 0, 0);
+      return false;
+    }
+
+    // Bitmaps which can not be read are left behind, their icons will be
+    // downloaded again.
+    int migrated = 0;
+    int dropped = 0;
+    while ((result = sqlite3_step(stmt)) == SQLITE_ROW) {
+      std::string faviconUrl = columnText(stmt, 0);
+      if (faviconUrl.empty()) {
+        ++dropped;
+        continue;
+      }
+      SkBitmap bitmap = deserializeLegacy(sqlite3_column_blob(stmt, 1), sqlite3_column_bytes(stmt, 1));
+      if (!bitmap.isNull() && storeBitmap(faviconUrl, bitmap)) {
+        ++migrated;
+      } else {
+        ++dropped;
+      }
+    }
+    sqlite3_finalize(stmt);
+    if (result != SQLITE_DONE) {
+      setError(sqlite3ErrStr(result));
+      sqlite3_exec(db()->sqlite, "ROLLBACK;", 0, 0, 0);
+      return false;
+    }
+    LOG(INFO) << "[FaviconDatabase] :: Migrated " << migrated << " bitmaps, dropped " << dropped;
+  }
+
+  char *query = sqlite3_mprintf("DROP TABLE IF EXISTS %q; PRAGMA user_version = %d;",
+                                db()->faviconUrlToBitmapTable, FaviconDatabasePrivate::schemaVersion);
+  result = sqlite3_exec(db()->sqlite, query, 0, 0, 0);
   sqlite3_free(query);
+  if (result == SQLITE_OK) {
+    result = sqlite3_exec(db()->sqlite, "COMMIT;", 0, 0, 0);
+  }
+  if (result != SQLITE_OK) {
+    setError(sqlite3ErrStr(result));
+    sqlite3_exec(db()->sqlite, "ROLLBACK;", 0, 0, 0);
+    return false;
+  }
+
+  // Give the pages of the raw bitmaps back to the file system.
+  if (hasLegacyTable) {
+    sqlite3_exec(db()->sqlite, "VACUUM;", 0, 0, 0);
+  }
   return true;
 }
 
@@ -160,10 +336,19 @@ LoadDatabaseCommand::LoadDatabaseCommand(FaviconDatabasePrivate *db)
   : Command("LoadDatabase", db) {
 }
 
+bool LoadDatabaseCommand::execute() {
+  db()->pageToFaviconUrl.swap(m_pageToFaviconUrl);
+  db()->faviconUrls.swap(m_faviconUrls);
+  db()->bitmapCache.Clear();
+  m_pageToFaviconUrl.clear();
+  m_faviconUrls.clear();
+  return true;
+}
+
 bool LoadDatabaseCommand::sqlExecute()
 {
-  db()->pageToFaviconUrl.clear();
-  db()->faviconUrlToBitmap.clear();
+  m_pageToFaviconUrl.clear();
+  m_faviconUrls.clear();
 
   char *query = sqlite3_mprintf("SELECT %q, %q FROM %q;", db()->pageUrlColumn,
                                 db()->faviconUrlColumn, db()->pageUrlToFaviconUrlTable);
@@ -173,26 +358,30 @@ bool LoadDatabaseCommand::sqlExecute()
   CHECK_PREP_MSG(query, result, SQLITE_OK, false);
 
   while ((result = sqlite3_step(stmt)) == SQLITE_ROW) {
-    GURL pageUrl(reinterpret_cast<const char *>(sqlite3_column_text(stmt, 0)));
-    GURL faviconUrl(reinterpret_cast<const char *>(sqlite3_column_text(stmt, 1)));
-    db()->pageToFaviconUrl[pageUrl] = faviconUrl;
+    GURL pageUrl(columnText(stmt, 0));
+    GURL faviconUrl(columnText(stmt, 1));
+    if (pageUrl.is_valid() && faviconUrl.is_valid()) {
+      m_pageToFaviconUrl[pageUrl] = faviconUrl;
+    }
   }
 
   CHECK_RESULT_MSG(query, result, SQLITE_DONE, stmt, false);
   sqlite3_finalize(stmt);
   sqlite3_free(query);
 
-  query = sqlite3_mprintf("SELECT %q, %q FROM %q;", db()->faviconUrlColumn,
-                          db()->bitmapColumn, db()->faviconUrlToBitmapTable);
+  // Bitmaps are read when first asked for, only which favicons have one
+  // is loaded.
+  query = sqlite3_mprintf("SELECT %q FROM %q;", db()->faviconUrlColumn,
+                          db()->faviconUrlToHashTable);
 
   result = sqlite3_prepare_v2(db()->sqlite, query, -1, &stmt, 0);
   CHECK_PREP_MSG(query, result, SQLITE_OK, false);
 
   while ((result = sqlite3_step(stmt)) == SQLITE_ROW) {
-    GURL faviconUrl(reinterpret_cast<const char *>(sqlite3_column_text(stmt, 0)));
-    const void *data = sqlite3_column_blob(stmt, 1);
-    SkBitmap bitmap = deserialize(data);
-    db()->faviconUrlToBitmap[faviconUrl] = bitmap;
+    GURL faviconUrl(columnText(stmt, 0));
+    if (faviconUrl.is_valid()) {
+      m_faviconUrls.insert(faviconUrl);
+    }
   }
 
   CHECK_RESULT_MSG(query, result, SQLITE_DONE, stmt, false);
@@ -202,6 +391,33 @@ bool LoadDatabaseCommand::sqlExecute()
   return true;
 }
 
+// LOAD BITMAP
+LoadBitmapCommand::LoadBitmapCommand(FaviconDatabasePrivate *db, const GURL &faviconUrl)
+  : Command("LoadBitmap", db),
+    m_faviconUrl(faviconUrl.spec()) {
+}
+
+bool LoadBitmapCommand::sqlExecute() {
+  sqlite3_stmt *stmt = db()->cachedStatement(FaviconDatabasePrivate::LOAD_BITMAP);
+  if (!stmt) {
+    setError(sqlite3_errmsg(db()->sqlite));
+    return false;
+  }
+
+  int result = sqlite3_bind_text(stmt, 1, m_faviconUrl.c_str(), m_faviconUrl.size(), SQLITE_STATIC);
+  CHECK_CACHED_MSG(result, SQLITE_OK, stmt, false);
+
+  result = sqlite3_step(stmt);
+  if (result == SQLITE_ROW) {
+    m_bitmap = decode(sqlite3_column_blob(stmt, 0), sqlite3_column_bytes(stmt, 0));
+    result = SQLITE_DONE;
+  }
+  CHECK_CACHED_MSG(result, SQLITE_DONE, stmt, false);
+
+  sqlite3_reset(stmt);
+  return true;
+}
+
 // CLEAR
 ClearDatabaseCommand::ClearDatabaseCommand(FaviconDatabasePrivate *db)
   : Command("ClearDatabase", db) {
@@ -209,13 +425,15 @@ ClearDatabaseCommand::ClearDatabaseCommand(FaviconDatabasePrivate *db)
 
 bool ClearDatabaseCommand::execute() {
   db()->pageToFaviconUrl.clear();
-  db()->faviconUrlToBitmap.clear();
+  db()->faviconUrls.clear();
+  db()->bitmapCache.Clear();
   return true;
 }
 
 bool ClearDatabaseCommand::sqlExecute() {
-  char *query = sqlite3_mprintf("DELETE FROM %q; DELETE FROM %q;",
-                                db()->faviconUrlToBitmapTable, db()->pageUrlToFaviconUrlTable);
+  char *query = sqlite3_mprintf("DELETE FROM %q; DELETE FROM %q; DELETE FROM %q;",
+                                db()->bitmapTable, db()->faviconUrlToHashTable,
+                                db()->pageUrlToFaviconUrlTable);
 
   int result = sqlite3_exec(db()->sqlite, query, 0, 0, 0);
   sqlite3_free(query);
@@ -240,22 +458,21 @@ bool InsertFaviconURLCommand::execute() {
 }
 
 bool InsertFaviconURLCommand::sqlExecute() {
-  char *query = sqlite3_mprintf("INSERT INTO %q VALUES(?, ?);", db()->pageUrlToFaviconUrlTable);
-
-  sqlite3_stmt *stmt = 0;
-  int result = sqlite3_prepare_v2(db()->sqlite, query, -1, &stmt, 0);
-  CHECK_PREP_MSG(query, result, SQLITE_OK, false);
+  sqlite3_stmt *stmt = db()->cachedStatement(FaviconDatabasePrivate::INSERT_FAVICON_URL);
+  if (!stmt) {
+    setError(sqlite3_errmsg(db()->sqlite));
+    return false;
+  }
 
-  result = sqlite3_bind_text(stmt, 1, m_pageUrl.c_str(), m_pageUrl.size(), SQLITE_STATIC);
-  CHECK_RESULT_MSG(query, result, SQLITE_OK, stmt, false);
+  int result = sqlite3_bind_text(stmt, 1, m_pageUrl.c_str(), m_pageUrl.size(), SQLITE_STATIC);
+  CHECK_CACHED_MSG(result, SQLITE_OK, stmt, false);
   result = sqlite3_bind_text(stmt, 2, m_faviconUrl.c_str(), m_faviconUrl.size(), SQLITE_STATIC);
-  CHECK_RESULT_MSG(query, result, SQLITE_OK, stmt, false);
+  CHECK_CACHED_MSG(result, SQLITE_OK, stmt, false);
 
   result = sqlite3_step(stmt);
-  CHECK_RESULT_MSG(query, result, SQLITE_DONE, stmt, false);
+  CHECK_CACHED_MSG(result, SQLITE_DONE, stmt, false);
 
-  sqlite3_finalize(stmt);
-  sqlite3_free(query);
+  sqlite3_reset(stmt);
   return true;
 }
 
@@ -274,24 +491,21 @@ bool UpdateFaviconURLCommand::execute() {
 }
 
 bool UpdateFaviconURLCommand::sqlExecute() {
-  char *query = sqlite3_mprintf("UPDATE %q SET %q = ? WHERE %q = ? ;",
-                                db()->pageUrlToFaviconUrlTable, db()->faviconUrlColumn,
-                                db()->pageUrlColumn);
-
-  sqlite3_stmt *stmt = 0;
-  int result = sqlite3_prepare_v2(db()->sqlite, query, -1, &stmt, 0);
-  CHECK_PREP_MSG(query, result, SQLITE_OK, false);
+  sqlite3_stmt *stmt = db()->cachedStatement(FaviconDatabasePrivate::UPDATE_FAVICON_URL);
+  if (!stmt) {
+    setError(sqlite3_errmsg(db()->sqlite));
+    return false;
+  }
 
-  result = sqlite3_bind_text(stmt, 1, m_pageUrl.c_str(), m_pageUrl.size(), SQLITE_STATIC);
-  CHECK_RESULT_MSG(query, result, SQLITE_OK, stmt, false);
-  result = sqlite3_bind_text(stmt, 2, m_faviconUrl.c_str(), m_faviconUrl.size(), SQLITE_STATIC);
-  CHECK_RESULT_MSG(query, result, SQLITE_OK, stmt, false);
+  int result = sqlite3_bind_text(stmt, 1, m_faviconUrl.c_str(), m_faviconUrl.size(), SQLITE_STATIC);
+  CHECK_CACHED_MSG(result, SQLITE_OK, stmt, false);
+  result = sqlite3_bind_text(stmt, 2, m_pageUrl.c_str(), m_pageUrl.size(), SQLITE_STATIC);
+  CHECK_CACHED_MSG(result, SQLITE_OK, stmt, false);
 
   result = sqlite3_step(stmt);
-  CHECK_RESULT_MSG(query, result, SQLITE_DONE, stmt, false);
+  CHECK_CACHED_MSG(result, SQLITE_DONE, stmt, false);
 
-  sqlite3_finalize(stmt);
-  sqlite3_free(query);
+  sqlite3_reset(stmt);
   return true;
 }
 
@@ -301,40 +515,30 @@ InsertBitmapCommand::InsertBitmapCommand(FaviconDatabasePrivate *db,
                                          const SkBitmap &bitmap)
   : Command("InsertBitmap", db),
     m_faviconUrl(faviconUrl.spec()),
-    m_bitmap(bitmap) {
+    m_bitmap(bitmap),
+    m_pinned(false) {
+}
+
+InsertBitmapCommand::~InsertBitmapCommand() {
+  if (m_pinned) {
+    db()->bitmapCache.Unpin(GURL(m_faviconUrl));
+  }
 }
 
 bool InsertBitmapCommand::execute() {
-  db()->faviconUrlToBitmap[GURL(m_faviconUrl)] = m_bitmap;
+  GURL faviconUrl(m_faviconUrl);
+  db()->faviconUrls.insert(faviconUrl);
+  // Kept in memory until written to sqlite.
+  if (!m_pinned) {
+    db()->bitmapCache.Pin(faviconUrl);
+    m_pinned = true;
+  }
+  db()->bitmapCache.Put(faviconUrl, m_bitmap);
   return true;
 }
 
 bool InsertBitmapCommand::sqlExecute() {
-  char *query = sqlite3_mprintf("INSERT INTO %q VALUES (?, ?);", db()->faviconUrlToBitmapTable);
-
-  sqlite3_stmt *stmt = 0;
-  int result = sqlite3_prepare_v2(db()->sqlite, query, -1, &stmt, 0);
-  CHECK_PREP_MSG(query, result, SQLITE_OK, false);
-
-  result = sqlite3_bind_text(stmt, 1, m_faviconUrl.c_str(), m_faviconUrl.size(), SQLITE_STATIC);
-  CHECK_RESULT_MSG(query, result, SQLITE_OK, stmt, false);
-
-  scoped_refptr<SerializedBitmap> serializedBitmap = serialize(m_bitmap);
-  if (!serializedBitmap->data) {
-    sqlite3_finalize(stmt);
-    sqlite3_free(query);
-    return false;
-  }
-
-  result = sqlite3_bind_blob(stmt, 2, serializedBitmap->data, serializedBitmap->size, SQLITE_TRANSIENT);
-  CHECK_RESULT_MSG(query, result, SQLITE_OK, stmt, false);
-
-  result = sqlite3_step(stmt);
-  CHECK_RESULT_MSG(query, result, SQLITE_DONE, stmt, false);
-
-  sqlite3_finalize(stmt);
-  sqlite3_free(query);
-  return true;
+  return storeBitmap(m_faviconUrl, m_bitmap);
 }
 
 // UPDATE BITMAP
@@ -343,41 +547,30 @@ UpdateBitmapCommand::UpdateBitmapCommand(FaviconDatabasePrivate *db,
                                          const SkBitmap &bitmap)
   : Command("UpdateBitmap", db),
     m_faviconUrl(faviconUrl.spec()),
-    m_bitmap(bitmap) {
+    m_bitmap(bitmap),
+    m_pinned(false) {
+}
+
+UpdateBitmapCommand::~UpdateBitmapCommand() {
+  if (m_pinned) {
+    db()->bitmapCache.Unpin(GURL(m_faviconUrl));
+  }
 }
 
 bool UpdateBitmapCommand::execute() {
-  db()->faviconUrlToBitmap[GURL(m_faviconUrl)] = m_bitmap;
+  GURL faviconUrl(m_faviconUrl);
+  db()->faviconUrls.insert(faviconUrl);
+  // Kept in memory until written to sqlite.
+  if (!m_pinned) {
+    db()->bitmapCache.Pin(faviconUrl);
+    m_pinned = true;
+  }
+  db()->bitmapCache.Put(faviconUrl, m_bitmap);
   return true;
 }
 
 bool UpdateBitmapCommand::sqlExecute() {
-  char *query = sqlite3_mprintf("UPDATE %q SET %q = ? WHERE %q = ? ;",
-                                db()->faviconUrlToBitmapTable, db()->bitmapColumn,
-                                db()->faviconUrlColumn);
-
-  sqlite3_stmt *stmt = 0;
-  int result = sqlite3_prepare_v2(db()->sqlite, query, -1, &stmt, 0);
-  CHECK_PREP_MSG(query, result, SQLITE_OK, false);
-
-  scoped_refptr<SerializedBitmap> serializedBitmap = serialize(m_bitmap);
-  if (!serializedBitmap->data) {
-    sqlite3_finalize(stmt);
-    return false;
-  }
-
-  result = sqlite3_bind_blob(stmt, 1, serializedBitmap->data, serializedBitmap->size, SQLITE_STATIC);
-  CHECK_RESULT_MSG(query, result, SQLITE_OK, stmt, false);
-
-  result = sqlite3_bind_text(stmt, 2, m_faviconUrl.c_str(), m_faviconUrl.size(), SQLITE_STATIC);
-  CHECK_RESULT_MSG(query, result, SQLITE_OK, stmt, false);
-
-  result = sqlite3_step(stmt);
-  CHECK_RESULT_MSG(query, result, SQLITE_DONE, stmt, false);
-
-  sqlite3_finalize(stmt);
-  sqlite3_free(query);
-  return true;
+  return storeBitmap(m_faviconUrl, m_bitmap);
 }
 
 // REMOVE BITMAP
@@ -387,24 +580,24 @@ RemoveBitmapCommand::RemoveBitmapCommand(FaviconDatabasePrivate *db, const GURL
 }
 
 bool RemoveBitmapCommand::execute() {
-  std::map<GURL, SkBitmap>::iterator it = db()->faviconUrlToBitmap.find(GURL(m_faviconUrl));
-  if (it != db()->faviconUrlToBitmap.end()) {
-    db()->faviconUrlToBitmap.erase(it);
-  }
+  db()->faviconUrls.erase(GURL(m_faviconUrl));
+  db()->bitmapCache.Remove(GURL(m_faviconUrl));
   return true;
 }
 
 bool RemoveBitmapCommand::sqlExecute() {
-  char *query = sqlite3_mprintf("DELETE FROM %q WHERE %q = ? ;", db()->faviconUrlToBitmapTable, db()->faviconUrlColumn);
+  sqlite3_stmt *stmt = db()->cachedStatement(FaviconDatabasePrivate::REMOVE_BITMAP);
+  if (!stmt) {
+    setError(sqlite3_errmsg(db()->sqlite));
+    return false;
+  }
 
-  sqlite3_stmt *stmt = 0;
-  int result = sqlite3_prepare_v2(db()->sqlite, query, -1, &stmt, 0);
-  CHECK_PREP_MSG(query, result, SQLITE_OK, false);
+  int result = sqlite3_bind_text(stmt, 1, m_faviconUrl.c_str(), m_faviconUrl.size(), SQLITE_STATIC);
+  CHECK_CACHED_MSG(result, SQLITE_OK, stmt, false);
 
   result = sqlite3_step(stmt);
-  CHECK_RESULT_MSG(query, result, SQLITE_DONE, stmt, false);
+  CHECK_CACHED_MSG(result, SQLITE_DONE, stmt, false);
 
-  sqlite3_finalize(stmt);
-  sqlite3_free(query);
+  sqlite3_reset(stmt);
   return true;
 }
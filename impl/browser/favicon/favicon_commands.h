@@ -5,35 +5,14 @@
 #ifndef FAVICON_COMMANDS_H
 #define FAVICON_COMMANDS_H
 
+#include <map>
+#include <set>
+#include <vector>
 #include "url/gurl.h"
-#include "base/memory/ref_counted.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 
 class FaviconDatabasePrivate;
-
-struct SerializedBitmap : public base::RefCounted<SerializedBitmap> {
-  SerializedBitmap() : data(0), size(0) {}
-  ~SerializedBitmap() {
-    free();
-  }
-
-  void alloc(size_t n) {
-    free();
-    data = ::operator new(n);
-    size = n;
-  }
-
-  void free() {
-    if (data) {
-      ::operator delete(data);
-      data = 0;
-      size = 0;
-    }
-  }
-
-  void *data;
-  size_t size;
-};
+struct sqlite3_stmt;
 
 class Command {
  public:
@@ -47,9 +26,18 @@ class Command {
   std::string name() const;
 
  protected:
-  static scoped_refptr<SerializedBitmap> serialize(const SkBitmap &bitmap);
-  static SkBitmap deserialize(const void *data);
+  // Bitmaps are stored as PNG, keyed by the hash of the PNG data.
+  static bool encode(const SkBitmap &bitmap, std::vector<unsigned char> *png);
+  static SkBitmap decode(const void *data, size_t size);
+  static std::string hash(const std::vector<unsigned char> &png);
+  // Reads the raw pixels stored by the first version of the database.
+  static SkBitmap deserializeLegacy(const void *data, size_t size);
   static const char *sqlite3ErrStr(int rc);
+  // Text of |column| in the current row, empty if it is NULL.
+  static std::string columnText(sqlite3_stmt *stmt, int column);
+
+  // Writes |bitmap| once per content and points |faviconUrl| to it.
+  bool storeBitmap(const std::string &faviconUrl, const SkBitmap &bitmap);
 
   FaviconDatabasePrivate *db() const {
     return m_db;
@@ -70,11 +58,40 @@ class InitDatabaseCommand : public Command {
   bool sqlExecute();
 };
 
+// Moves the bitmaps of the first version of the database, one raw blob per
+// favicon URL, to the current tables.
+class MigrateDatabaseCommand : public Command {
+ public:
+  MigrateDatabaseCommand(FaviconDatabasePrivate *db);
+  // Whether the file was written by an older version. Cheap, unlike
+  // running the migration.
+  bool isNeeded();
+  bool execute() { return sqlExecute(); }
+  bool sqlExecute();
+};
+
+// Reads the index from sqlite, then replaces the maps with it. Only
+// execute() needs |mutex|.
 class LoadDatabaseCommand : public Command {
  public:
   LoadDatabaseCommand(FaviconDatabasePrivate *db);
+  bool execute();
+  bool sqlExecute();
+ private:
+  std::map<GURL, GURL> m_pageToFaviconUrl;
+  std::set<GURL> m_faviconUrls;
+};
+
+// Reads a bitmap which is not in memory.
+class LoadBitmapCommand : public Command {
+ public:
+  LoadBitmapCommand(FaviconDatabasePrivate *db, const GURL &faviconUrl);
   bool execute() { return sqlExecute(); }
   bool sqlExecute();
+  const SkBitmap &bitmap() const { return m_bitmap; }
+ private:
+  std::string m_faviconUrl;
+  SkBitmap m_bitmap;
 };
 
 class ClearDatabaseCommand : public Command {
@@ -107,21 +124,25 @@ class UpdateFaviconURLCommand : public Command {
 class InsertBitmapCommand : public Command {
  public:
   InsertBitmapCommand(FaviconDatabasePrivate *db, const GURL &faviconUrl, const SkBitmap &bitmap);
+  virtual ~InsertBitmapCommand();
   bool execute();
   bool sqlExecute();
  private:
   std::string m_faviconUrl;
   SkBitmap m_bitmap;
+  bool m_pinned;
 };
 
 class UpdateBitmapCommand : public Command {
  public:
   UpdateBitmapCommand(FaviconDatabasePrivate *db, const GURL &faviconUrl, const SkBitmap &bitmap);
+  virtual ~UpdateBitmapCommand();
   bool execute();
   bool sqlExecute();
  private:
   std::string m_faviconUrl;
   SkBitmap m_bitmap;
+  bool m_pinned;
 };
 
 class RemoveBitmapCommand : public Command {
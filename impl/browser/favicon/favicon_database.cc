@@ -35,6 +35,13 @@ bool FaviconDatabase::SetPath(const std::string &path) {
 }
 
 bool FaviconDatabase::Open() {
+  {
+    base::AutoLock locker(d->mutex);
+    if (d->sqlite) {
+      return true;
+    }
+  }
+  base::AutoLock syncLocker(d->syncMutex);
   base::AutoLock locker(d->mutex);
   if (d->sqlite) {
     return true;
@@ -45,19 +52,36 @@ bool FaviconDatabase::Open() {
                << result << ")!";
     return false;
   }
-  if (!IsDatabaseInitialized()) {
-    if (!InitDatabase())
+  if (!InitDatabase()) {
+    return false;
+  }
+  // Databases written by older versions keep raw bitmaps per favicon URL.
+  // Converting them takes seconds, the DB thread does it and publishes the
+  // index afterwards. Without one, as in tests, it is done right here.
+  MigrateDatabaseCommand migrateCmd(d.get());
+  if (migrateCmd.isNeeded()) {
+    if (d->taskRunner()->PostTask(FROM_HERE, base::Bind(&FaviconDatabasePrivate::migrateAndLoad,
+                                                        d->weakPtrFactory.GetWeakPtr()))) {
+      return true;
+    }
+    if (!migrateCmd.execute()) {
+      LOG(ERROR) << "[FaviconDatabase] :: Error migrating SQLite database: "
+                 << migrateCmd.lastError();
       return false;
+    }
   }
   if (!LoadDatabase()) {
     return false;
   }
+  d->publishIndex();
   return true;
 }
 
 void FaviconDatabase::Close() {
+  base::AutoLock syncLocker(d->syncMutex);
   base::AutoLock locker(d->mutex);
   if (d->sqlite) {
+    d->finalizeStatements();
     sqlite3_close(d->sqlite);
     d->sqlite = 0;
   }
@@ -79,23 +103,23 @@ bool FaviconDatabase::IsPrivateBrowsingEnabled() const {
 }
 
 GURL FaviconDatabase::GetFaviconURLForPageURL(const GURL &pageUrl) const {
-  base::AutoLock locker(d->mutex);
-  return d->faviconUrlForPageUrl(pageUrl);
+  return d->snapshot()->faviconUrlForPageUrl(pageUrl);
 }
 
 SkBitmap FaviconDatabase::GetBitmapForPageURL(const GURL &pageUrl) const {
-  base::AutoLock locker(d->mutex);
-  GURL faviconUrl = d->faviconUrlForPageUrl(pageUrl);
-  if (!faviconUrl.is_valid()) {
-    return SkBitmap();
-  }
-
-  return d->bitmapForFaviconUrl(faviconUrl);
+  return BitmapForPageURL(pageUrl, false);
 }
 
 SkBitmap FaviconDatabase::GetBitmapForFaviconURL(const GURL &iconUrl) const {
-  base::AutoLock locker(d->mutex);
-  return d->bitmapForFaviconUrl(iconUrl);
+  return d->bitmapForFaviconUrl(*d->snapshot(), iconUrl, false);
+}
+
+SkBitmap FaviconDatabase::LoadBitmapForPageURL(const GURL &pageUrl) const {
+  return BitmapForPageURL(pageUrl, true);
+}
+
+SkBitmap FaviconDatabase::LoadBitmapForFaviconURL(const GURL &iconUrl) const {
+  return d->bitmapForFaviconUrl(*d->snapshot(), iconUrl, true);
 }
 
 void FaviconDatabase::SetFaviconURLForPageURL(const GURL &iconUrl, const GURL &pageUrl) {
@@ -111,22 +135,22 @@ void FaviconDatabase::SetFaviconURLForPageURL(const GURL &iconUrl, const GURL &p
   if (old.is_empty()) {
     // |old| is empty when it was just inserted by operator []
     // so we just assign new value to it and return
-    Command *cmd = new InsertFaviconURLCommand(d.get(), pageUrl, iconUrl);
-    cmd->execute();
-    d->commands.push(cmd);
+    d->apply(new InsertFaviconURLCommand(d.get(), pageUrl, iconUrl));
+    d->publishPage(pageUrl);
     ScheduleSync();
     return;
   }
 
-  // |old| is not empty, so we have to remove it and its bitmap
-  // from 'favicon url to bitmap'
-  Command *cmd = new RemoveBitmapCommand(d.get(), iconUrl);
-  cmd->execute();
-  d->commands.push(cmd);
-  // and update it in 'page url to favicon url'
-  cmd = new UpdateFaviconURLCommand(d.get(), pageUrl, iconUrl);
-  cmd->execute();
-  d->commands.push(cmd);
+  // |old| is not empty, so we update it in 'page url to favicon url'
+  GURL oldIconUrl = old;
+  d->apply(new UpdateFaviconURLCommand(d.get(), pageUrl, iconUrl));
+  // and drop the old icon's bitmap, unless other pages still use it
+  // (e.g. a site wide /favicon.ico)
+  if (!d->isFaviconURLUsed(oldIconUrl)) {
+    d->apply(new RemoveBitmapCommand(d.get(), oldIconUrl));
+    d->publishFavicon(oldIconUrl);
+  }
+  d->publishPage(pageUrl);
 
   ScheduleSync();
 }
@@ -136,42 +160,50 @@ void FaviconDatabase::SetBitmapForFaviconURL(const SkBitmap &bitmap, const GURL
   if (d->privateBrowsing) {
     return;
   }
-  if (d->faviconUrlToBitmap.find(iconUrl) != d->faviconUrlToBitmap.end()) {
-    Command *cmd = new UpdateBitmapCommand(d.get(), iconUrl, bitmap);
-    cmd->execute();
-    d->commands.push(cmd);
+  if (d->existsForFaviconURL(iconUrl)) {
+    d->apply(new UpdateBitmapCommand(d.get(), iconUrl, bitmap));
     ScheduleSync();
     return;
   }
-  Command *cmd = new InsertBitmapCommand(d.get(), iconUrl, bitmap);
-  cmd->execute();
-  d->commands.push(cmd);
+  d->apply(new InsertBitmapCommand(d.get(), iconUrl, bitmap));
+  d->publishFavicon(iconUrl);
 
   ScheduleSync();
 }
 
 bool FaviconDatabase::ExistsForPageURL(const GURL &pageUrl) const {
-  base::AutoLock locker(d->mutex);
-  std::map<GURL, GURL>::const_iterator it = d->pageToFaviconUrl.find(pageUrl);
-  if (it == d->pageToFaviconUrl.end()) {
-    return false;
-  }
-  return d->existsForFaviconURL(it->second);
+  scoped_refptr<const FaviconSnapshot> snapshot = d->snapshot();
+  return snapshot->existsForFaviconURL(snapshot->faviconUrlForPageUrl(pageUrl));
 }
 
 bool FaviconDatabase::ExistsForFaviconURL(const GURL &iconUrl) const {
-  base::AutoLock locker(d->mutex);
-  return d->existsForFaviconURL(iconUrl);
+  return d->snapshot()->existsForFaviconURL(iconUrl);
 }
 
 void FaviconDatabase::Clear() {
-  Command *cmd = new ClearDatabaseCommand(d.get());
-  cmd->execute();
-  d->commands.push(cmd);
+  base::AutoLock locker(d->mutex);
+  d->apply(new ClearDatabaseCommand(d.get()));
+  d->publishClear();
 
   ScheduleSync();
 }
 
+size_t FaviconDatabase::TrimMemory(bool critical) {
+  // Flush pending changes first, bitmaps not in sqlite yet can not be
+  // dropped.
+  d->performSync();
+
+  size_t size = 0;
+  if (!critical) {
+    size = d->bitmapCache.GetStats().size / 2;
+  }
+  return d->bitmapCache.Trim(size);
+}
+
+FaviconBitmapCache::Stats FaviconDatabase::GetCacheStatistics() const {
+  return d->bitmapCache.GetStats();
+}
+
 void FaviconDatabase::SyncSQLite() {
   scoped_refptr<base::SingleThreadTaskRunner> ptr = content::BrowserThread::GetMessageLoopProxyForThread(content::BrowserThread::DB);
   ptr->PostTask(FROM_HERE, base::Bind(&FaviconDatabasePrivate::performSync, d->weakPtrFactory.GetWeakPtr()));
@@ -183,46 +215,22 @@ void FaviconDatabase::ScheduleSync() {
   }
 }
 
-bool FaviconDatabase::IsDatabaseInitialized() {
-  std::string query("SELECT name FROM sqlite_master WHERE type='table' AND (name = ? OR name = ?);");
-
-  sqlite3_stmt *stmt;
-  int result = sqlite3_prepare_v2(d->sqlite, query.c_str(), query.size(), &stmt, 0);
-  if (result != SQLITE_OK) {
-    return false;
-  }
-
-  result = sqlite3_bind_text(stmt, 1, d->pageUrlToFaviconUrlTable, strlen(d->pageUrlToFaviconUrlTable), SQLITE_STATIC);
-  if (result != SQLITE_OK) {
-    sqlite3_finalize(stmt);
-    return false;
-  }
-  result = sqlite3_bind_text(stmt, 2, d->faviconUrlToBitmapTable, strlen(d->faviconUrlColumn), SQLITE_STATIC);
-  if (result != SQLITE_OK) {
-    sqlite3_finalize(stmt);
-    return false;
-  }
-
-  int count = 0;
-  while ((result = sqlite3_step(stmt)) == SQLITE_ROW) {
-    ++count;
-  }
-
-  if (result != SQLITE_DONE || count != 2) {
-    sqlite3_finalize(stmt);
-    return false;
-  }
-
-  sqlite3_finalize(stmt);
-  return true;
-}
-
 bool FaviconDatabase::InitDatabase() {
   InitDatabaseCommand initCmd(d.get());
   return initCmd.execute();
 }
 
+SkBitmap FaviconDatabase::BitmapForPageURL(const GURL &pageUrl, bool readDatabase) const {
+  scoped_refptr<const FaviconSnapshot> snapshot = d->snapshot();
+  GURL faviconUrl = snapshot->faviconUrlForPageUrl(pageUrl);
+  if (!faviconUrl.is_valid()) {
+    return SkBitmap();
+  }
+
+  return d->bitmapForFaviconUrl(*snapshot, faviconUrl, readDatabase);
+}
+
 bool FaviconDatabase::LoadDatabase() {
   LoadDatabaseCommand loadCmd(d.get());
-  return loadCmd.execute();
+  return loadCmd.sqlExecute() && loadCmd.execute();
 }
@@ -11,6 +11,7 @@
 #include "url/gurl.h"
 #include "base/memory/weak_ptr.h"
 #include "base/macros.h"
+#include "favicon_bitmap_cache.h"
 
 struct FaviconDatabasePrivate;
 class FaviconService;
@@ -25,6 +26,8 @@ class FaviconDatabase {
   virtual ~FaviconDatabase();
 
   bool SetPath(const std::string &path);
+  // A database written by an older version is migrated on the DB thread,
+  // lookups find nothing until that is done.
   bool Open();
   void Close();
   bool IsOpen() const;
@@ -32,8 +35,13 @@ class FaviconDatabase {
   bool IsPrivateBrowsingEnabled() const;
 
   GURL GetFaviconURLForPageURL(const GURL &pageUrl) const;
+  // Return only bitmaps kept in memory, never wait.
   SkBitmap GetBitmapForPageURL(const GURL &pageUrl) const;
   SkBitmap GetBitmapForFaviconURL(const GURL &iconUrl) const;
+  // Read bitmaps which are not in memory any more from sqlite, which waits
+  // for a running sync. Called on the DB thread.
+  SkBitmap LoadBitmapForPageURL(const GURL &pageUrl) const;
+  SkBitmap LoadBitmapForFaviconURL(const GURL &iconUrl) const;
 
   void SetFaviconURLForPageURL(const GURL &iconUrl, const GURL &pageUrl);
   void SetBitmapForFaviconURL(const SkBitmap &bitmap, const GURL &iconUrl);
@@ -41,20 +49,27 @@ class FaviconDatabase {
   bool ExistsForFaviconURL(const GURL &iconUrl) const;
   void Clear();
 
+  // Drops the least recently used bitmaps from memory, they are read back
+  // from sqlite when asked for. Half of them go, all of them if |critical|
+  // is set. Returns the number of bytes freed. Called on the DB thread.
+  size_t TrimMemory(bool critical);
+  FaviconBitmapCache::Stats GetCacheStatistics() const;
+
  private:
   FaviconDatabase();
   DISALLOW_COPY_AND_ASSIGN(FaviconDatabase);
 
   void SyncSQLite();
   void ScheduleSync();
-  bool IsDatabaseInitialized();
   bool InitDatabase();
   bool LoadDatabase();
+  SkBitmap BitmapForPageURL(const GURL &pageUrl, bool readDatabase) const;
 
   scoped_refptr<FaviconDatabasePrivate> d;
   static const int SYNC_DELAY;
 
   friend class FaviconService;
+  friend class FaviconDatabasePerfTest;
 };
 
 #endif // FAVICON_DATABASE_H
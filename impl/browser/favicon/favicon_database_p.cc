@@ -4,34 +4,279 @@
 
 #include "favicon_database_p.h"
 #include "favicon_commands.h"
-#include <iostream>
+#include "base/logging.h"
 
+const int FaviconDatabasePrivate::schemaVersion = 2;
 const char *FaviconDatabasePrivate::pageUrlToFaviconUrlTable = "url_to_favicon_url";
+const char *FaviconDatabasePrivate::faviconUrlToHashTable = "favicon_url_to_hash";
+const char *FaviconDatabasePrivate::bitmapTable = "favicon_bitmaps";
 const char *FaviconDatabasePrivate::faviconUrlToBitmapTable = "favicon_url_to_bitmap";
 const char *FaviconDatabasePrivate::pageUrlColumn = "page_url";
 const char *FaviconDatabasePrivate::faviconUrlColumn = "favicon_url";
+const char *FaviconDatabasePrivate::hashColumn = "hash";
 const char *FaviconDatabasePrivate::bitmapColumn = "bitmap";
 
-GURL FaviconDatabasePrivate::faviconUrlForPageUrl(const GURL &pageUrl) const {
-  std::map<GURL, GURL>::const_iterator it = pageToFaviconUrl.find(pageUrl);
-  if (it != pageToFaviconUrl.end()) {
+namespace {
+
+// Room for 256 icons of 32x32 pixels.
+const size_t kBitmapCacheCapacity = 1024 * 1024;
+
+} // namespace
+
+FaviconSnapshot::FaviconSnapshot()
+  : cleared(false),
+    generation(0) {
+}
+
+GURL FaviconSnapshot::faviconUrlForPageUrl(const GURL &pageUrl) const {
+  std::map<GURL, GURL>::const_iterator changed = changedPages.find(pageUrl);
+  if (changed != changedPages.end()) {
+    return changed->second;
+  }
+  if (cleared || !index.get()) {
+    return GURL();
+  }
+  std::map<GURL, GURL>::const_iterator it = index->pageToFaviconUrl.find(pageUrl);
+  if (it != index->pageToFaviconUrl.end()) {
     return it->second;
   }
   return GURL();
 }
 
-SkBitmap FaviconDatabasePrivate::bitmapForFaviconUrl(const GURL &faviconUrl) const {
-  std::map<GURL, SkBitmap>::const_iterator it = faviconUrlToBitmap.find(faviconUrl);
-  if (it != faviconUrlToBitmap.end()) {
+bool FaviconSnapshot::existsForFaviconURL(const GURL &faviconUrl) const {
+  std::map<GURL, bool>::const_iterator changed = changedFavicons.find(faviconUrl);
+  if (changed != changedFavicons.end()) {
+    return changed->second;
+  }
+  if (cleared || !index.get()) {
+    return false;
+  }
+  return index->faviconUrls.count(faviconUrl);
+}
+
+scoped_refptr<FaviconSnapshot> FaviconSnapshot::copy() const {
+  scoped_refptr<FaviconSnapshot> snapshot(new FaviconSnapshot);
+  snapshot->index = index;
+  snapshot->changedPages = changedPages;
+  snapshot->changedFavicons = changedFavicons;
+  snapshot->cleared = cleared;
+  snapshot->generation = generation;
+  return snapshot;
+}
 
-    return it->second;
+FaviconDatabasePrivate::FaviconDatabasePrivate()
+  : bitmapCache(kBitmapCacheCapacity),
+    path("/tmp/favicon_database.db"),
+    privateBrowsing(false),
+    sqlite(0),
+    weakPtrFactory(this),
+    currentSnapshot(new FaviconSnapshot) {
+  for (int i = 0; i < STATEMENT_COUNT; ++i) {
+    statements[i] = 0;
+  }
+}
+
+FaviconDatabasePrivate::~FaviconDatabasePrivate() {
+}
+
+SkBitmap FaviconDatabasePrivate::bitmapForFaviconUrl(const FaviconSnapshot &snapshot,
+                                                     const GURL &faviconUrl,
+                                                     bool readDatabase) {
+  if (!snapshot.existsForFaviconURL(faviconUrl)) {
+    return SkBitmap();
+  }
+  SkBitmap bitmap;
+  if (bitmapCache.Get(faviconUrl, &bitmap) || !readDatabase) {
+    return bitmap;
+  }
+
+  // Bitmaps not written yet are pinned in the cache, so sqlite has this one.
+  // Reading it waits for a running sync.
+  base::AutoLock locker(syncMutex);
+  if (!sqlite) {
+    return SkBitmap();
   }
-  return SkBitmap();
+  LoadBitmapCommand cmd(this, faviconUrl);
+  if (!cmd.execute()) {
+    return SkBitmap();
+  }
+  bitmapCache.Fill(faviconUrl, cmd.bitmap());
+  return cmd.bitmap();
 }
 
 bool FaviconDatabasePrivate::existsForFaviconURL(const GURL &faviconUrl) const {
-  std::map<GURL, SkBitmap>::const_iterator it = faviconUrlToBitmap.find(faviconUrl);
-  return it != faviconUrlToBitmap.end();
+  return faviconUrls.count(faviconUrl);
+}
+
+bool FaviconDatabasePrivate::isFaviconURLUsed(const GURL &faviconUrl) const {
+  std::map<GURL, GURL>::const_iterator it = pageToFaviconUrl.begin();
+  for (; it != pageToFaviconUrl.end(); ++it) {
+    if (it->second == faviconUrl) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void FaviconDatabasePrivate::apply(Command *cmd) {
+  cmd->execute();
+  commands.push(cmd);
+}
+
+void FaviconDatabasePrivate::publishPage(const GURL &pageUrl) {
+  scoped_refptr<FaviconSnapshot> next = snapshot()->copy();
+  std::map<GURL, GURL>::const_iterator it = pageToFaviconUrl.find(pageUrl);
+  next->changedPages[pageUrl] = it != pageToFaviconUrl.end() ? it->second : GURL();
+  setSnapshot(next);
+}
+
+void FaviconDatabasePrivate::publishFavicon(const GURL &faviconUrl) {
+  scoped_refptr<FaviconSnapshot> next = snapshot()->copy();
+  next->changedFavicons[faviconUrl] = faviconUrls.count(faviconUrl) != 0;
+  setSnapshot(next);
+}
+
+void FaviconDatabasePrivate::publishClear() {
+  scoped_refptr<const FaviconSnapshot> current = snapshot();
+  scoped_refptr<FaviconSnapshot> next(new FaviconSnapshot);
+  next->index = current->index;
+  next->cleared = true;
+  next->generation = current->generation + 1;
+  setSnapshot(next);
+}
+
+void FaviconDatabasePrivate::publishIndex() {
+  scoped_refptr<FaviconIndex> index(new FaviconIndex);
+  index->pageToFaviconUrl = pageToFaviconUrl;
+  index->faviconUrls = faviconUrls;
+
+  scoped_refptr<FaviconSnapshot> next(new FaviconSnapshot);
+  next->index = index;
+  next->generation = snapshot()->generation + 1;
+  setSnapshot(next);
+}
+
+scoped_refptr<const FaviconSnapshot> FaviconDatabasePrivate::snapshot() const {
+  base::AutoLock locker(snapshotMutex);
+  return currentSnapshot;
+}
+
+void FaviconDatabasePrivate::setSnapshot(const scoped_refptr<const FaviconSnapshot> &snapshot) {
+  base::AutoLock locker(snapshotMutex);
+  currentSnapshot = snapshot;
+}
+
+void FaviconDatabasePrivate::rebaseSnapshot(const scoped_refptr<const FaviconSnapshot> &folded) {
+  // Copying the index takes a while with a long history, no lock is held
+  // meanwhile.
+  scoped_refptr<FaviconIndex> index(new FaviconIndex);
+  if (!folded->cleared && folded->index.get()) {
+    index->pageToFaviconUrl = folded->index->pageToFaviconUrl;
+    index->faviconUrls = folded->index->faviconUrls;
+  }
+  for (std::map<GURL, GURL>::const_iterator it = folded->changedPages.begin();
+       it != folded->changedPages.end(); ++it) {
+    if (it->second.is_empty()) {
+      index->pageToFaviconUrl.erase(it->first);
+    } else {
+      index->pageToFaviconUrl[it->first] = it->second;
+    }
+  }
+  for (std::map<GURL, bool>::const_iterator it = folded->changedFavicons.begin();
+       it != folded->changedFavicons.end(); ++it) {
+    if (it->second) {
+      index->faviconUrls.insert(it->first);
+    } else {
+      index->faviconUrls.erase(it->first);
+    }
+  }
+
+  base::AutoLock locker(mutex);
+  scoped_refptr<const FaviconSnapshot> current = snapshot();
+  // Cleared or opened again meanwhile, the index is of no use any more.
+  if (current->generation != folded->generation) {
+    return;
+  }
+
+  // Changes made since |folded| stay on top of the new index.
+  scoped_refptr<FaviconSnapshot> next(new FaviconSnapshot);
+  next->index = index;
+  next->generation = current->generation;
+  for (std::map<GURL, GURL>::const_iterator it = current->changedPages.begin();
+       it != current->changedPages.end(); ++it) {
+    std::map<GURL, GURL>::const_iterator old = folded->changedPages.find(it->first);
+    if (old == folded->changedPages.end() || old->second != it->second) {
+      next->changedPages.insert(*it);
+    }
+  }
+  for (std::map<GURL, bool>::const_iterator it = current->changedFavicons.begin();
+       it != current->changedFavicons.end(); ++it) {
+    std::map<GURL, bool>::const_iterator old = folded->changedFavicons.find(it->first);
+    if (old == folded->changedFavicons.end() || old->second != it->second) {
+      next->changedFavicons.insert(*it);
+    }
+  }
+  setSnapshot(next);
+}
+
+sqlite3_stmt *FaviconDatabasePrivate::cachedStatement(StatementId id) {
+  if (statements[id]) {
+    sqlite3_reset(statements[id]);
+    sqlite3_clear_bindings(statements[id]);
+    return statements[id];
+  }
+
+  char *query = 0;
+  switch (id) {
+    case INSERT_FAVICON_URL:
+      // Pages set while the index was still being loaded may already be
+      // in the file.
+      query = sqlite3_mprintf("INSERT OR REPLACE INTO %q VALUES (?, ?);", pageUrlToFaviconUrlTable);
+      break;
+    case UPDATE_FAVICON_URL:
+      query = sqlite3_mprintf("UPDATE %q SET %q = ? WHERE %q = ? ;",
+                              pageUrlToFaviconUrlTable, faviconUrlColumn, pageUrlColumn);
+      break;
+    case INSERT_BITMAP:
+      query = sqlite3_mprintf("INSERT OR IGNORE INTO %q VALUES (?, ?);", bitmapTable);
+      break;
+    case SET_BITMAP_HASH:
+      query = sqlite3_mprintf("INSERT OR REPLACE INTO %q VALUES (?, ?);", faviconUrlToHashTable);
+      break;
+    case REMOVE_BITMAP:
+      query = sqlite3_mprintf("DELETE FROM %q WHERE %q = ? ;",
+                              faviconUrlToHashTable, faviconUrlColumn);
+      break;
+    case DELETE_UNUSED_BITMAPS:
+      query = sqlite3_mprintf("DELETE FROM %q WHERE NOT EXISTS (SELECT 1 FROM %q WHERE %q.%q = %q.%q);",
+                              bitmapTable, faviconUrlToHashTable,
+                              faviconUrlToHashTable, hashColumn, bitmapTable, hashColumn);
+      break;
+    case LOAD_BITMAP:
+      query = sqlite3_mprintf("SELECT %q.%q FROM %q JOIN %q ON %q.%q = %q.%q WHERE %q.%q = ? ;",
+                              bitmapTable, bitmapColumn, faviconUrlToHashTable, bitmapTable,
+                              faviconUrlToHashTable, hashColumn, bitmapTable, hashColumn,
+                              faviconUrlToHashTable, faviconUrlColumn);
+      break;
+    case STATEMENT_COUNT:
+      NOTREACHED();
+      return 0;
+  }
+
+  int result = sqlite3_prepare_v2(sqlite, query, -1, &statements[id], 0);
+  sqlite3_free(query);
+  if (result != SQLITE_OK) {
+    sqlite3_finalize(statements[id]);
+    statements[id] = 0;
+  }
+  return statements[id];
+}
+
+void FaviconDatabasePrivate::finalizeStatements() {
+  for (int i = 0; i < STATEMENT_COUNT; ++i) {
+    sqlite3_finalize(statements[i]);
+    statements[i] = 0;
+  }
 }
 
 scoped_refptr<base::SingleThreadTaskRunner> FaviconDatabasePrivate::taskRunner() const {
@@ -39,16 +284,90 @@ scoped_refptr<base::SingleThreadTaskRunner> FaviconDatabasePrivate::taskRunner()
 }
 
 void FaviconDatabasePrivate::performSync() {
-  std::cerr << "[FaviconDatabasePrivate::performSync()]" << std::endl;
+  scoped_refptr<const FaviconSnapshot> folded;
+  {
+    base::AutoLock syncLocker(syncMutex);
+    if (!syncCommands(&folded)) {
+      return;
+    }
+  }
+  rebaseSnapshot(folded);
+}
+
+void FaviconDatabasePrivate::migrateAndLoad() {
+  base::AutoLock syncLocker(syncMutex);
+  if (!sqlite) {
+    return;
+  }
+  MigrateDatabaseCommand migrateCmd(this);
+  if (!migrateCmd.execute()) {
+    // The icons of the old tables will be downloaded again.
+    LOG(ERROR) << "[FaviconDatabasePrivate::migrateAndLoad] :: Error migrating: "
+               << migrateCmd.lastError();
+  }
+  LoadDatabaseCommand loadCmd(this);
+  if (!loadCmd.sqlExecute()) {
+    LOG(ERROR) << "[FaviconDatabasePrivate::migrateAndLoad] :: Error loading: "
+               << loadCmd.lastError();
+    return;
+  }
+
   base::AutoLock locker(mutex);
-  timer.Stop();
-  while (!commands.empty()) {
-    Command *cmd = commands.front();
-    if (!cmd->sqlExecute()) {
-      std::cerr << "[FaviconDatabasePrivate::performSync] :: " << "Error while executing command:\n\t" << cmd->lastError() << std::endl;
-      // abort or what?
-    }
-    commands.pop();
+  loadCmd.execute();
+  // Changes made meanwhile are still queued, not yet in the file. They go on
+  // top of what was read.
+  std::queue<Command *> pending;
+  pending.swap(commands);
+  while (!pending.empty()) {
+    pending.front()->execute();
+    commands.push(pending.front());
+    pending.pop();
+  }
+  publishIndex();
+}
+
+bool FaviconDatabasePrivate::syncCommands(scoped_refptr<const FaviconSnapshot> *folded) {
+  // The index already holds what the commands write, so they are handed over
+  // to sqlite without keeping readers and writers of the index waiting.
+  std::queue<Command *> pending;
+  {
+    base::AutoLock locker(mutex);
+    timer.Stop();
+    pending.swap(commands);
+    // Holds the changes of exactly these commands and the ones before.
+    *folded = snapshot();
+  }
+  if (pending.empty()) {
+    return false;
+  }
+
+  // One transaction syncs the file once instead of once per command.
+  bool transaction = sqlite && sqlite3_exec(sqlite, "BEGIN TRANSACTION;", 0, 0, 0) == SQLITE_OK;
+  while (!pending.empty()) {
+    Command *cmd = pending.front();
+    if (sqlite && !cmd->sqlExecute()) {
+      LOG(ERROR) << "[FaviconDatabasePrivate::performSync] :: Error while executing command: "
+                 << cmd->lastError();
+    }
+    pending.pop();
     delete cmd;
   }
+
+  // Bitmaps no favicon URL points to any more.
+  if (sqlite) {
+    sqlite3_stmt *stmt = cachedStatement(DELETE_UNUSED_BITMAPS);
+    if (stmt && sqlite3_step(stmt) != SQLITE_DONE) {
+      LOG(ERROR) << "[FaviconDatabasePrivate::performSync] :: Error deleting unused bitmaps: "
+                 << sqlite3_errmsg(sqlite);
+    }
+    if (stmt) {
+      sqlite3_reset(stmt);
+    }
+  }
+  if (transaction && sqlite3_exec(sqlite, "COMMIT;", 0, 0, 0) != SQLITE_OK) {
+    LOG(ERROR) << "[FaviconDatabasePrivate::performSync] :: Error committing: "
+               << sqlite3_errmsg(sqlite);
+    sqlite3_exec(sqlite, "ROLLBACK;", 0, 0, 0);
+  }
+  return true;
 }
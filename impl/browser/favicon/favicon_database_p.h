@@ -7,50 +7,165 @@
 
 #include <map>
 #include <queue>
+#include <set>
 #include "url/gurl.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/sqlite/sqlite3.h"
+#include "base/memory/ref_counted.h"
 #include "base/single_thread_task_runner.h"
 #include "base/synchronization/lock.h"
 #include "base/timer/timer.h"
 #include "base/memory/weak_ptr.h"
 #include "content/public/browser/browser_thread.h"
+#include "favicon_bitmap_cache.h"
 #include "favicon_database.h"
 
 class Command;
 
-struct FaviconDatabasePrivate : public base::RefCountedThreadSafe<FaviconDatabasePrivate> {
-  FaviconDatabasePrivate()
-    : path("/tmp/favicon_database.db"),
-      privateBrowsing(false),
-      sqlite(0),
-      weakPtrFactory(this)
-  {}
+// A copy of the index built on the DB thread, never changed once published.
+struct FaviconIndex : public base::RefCountedThreadSafe<FaviconIndex> {
+  std::map<GURL, GURL> pageToFaviconUrl;
+  std::set<GURL> faviconUrls;
+
+ private:
+  friend class base::RefCountedThreadSafe<FaviconIndex>;
+  ~FaviconIndex() {}
+};
+
+// What readers use without taking any lock, never changed once published:
+// the index as of the last sync plus the changes made since. Writers publish
+// a new one per change and only copy the changes, the DB thread folds them
+// into a new index after every sync.
+struct FaviconSnapshot : public base::RefCountedThreadSafe<FaviconSnapshot> {
+  FaviconSnapshot();
 
   GURL faviconUrlForPageUrl(const GURL &pageUrl) const;
-  SkBitmap bitmapForFaviconUrl(const GURL &faviconUrl) const;
+  bool existsForFaviconURL(const GURL &faviconUrl) const;
+  // A new snapshot with the same index and changes.
+  scoped_refptr<FaviconSnapshot> copy() const;
+
+  // Null until the database is opened.
+  scoped_refptr<const FaviconIndex> index;
+  // Favicon URL of the pages changed since |index| was built, empty if a
+  // page has none any more.
+  std::map<GURL, GURL> changedPages;
+  // Whether the favicons changed since |index| was built have a bitmap.
+  std::map<GURL, bool> changedFavicons;
+  // Set if the database was cleared after |index| was built.
+  bool cleared;
+  // Bumped whenever |index| stops counting, by a clear or by opening the
+  // database. Changes are only folded into the index of their generation.
+  int generation;
+
+ private:
+  friend class base::RefCountedThreadSafe<FaviconSnapshot>;
+  ~FaviconSnapshot() {}
+};
 
+struct FaviconDatabasePrivate : public base::RefCountedThreadSafe<FaviconDatabasePrivate> {
+  // Statements the commands run on every sync, prepared once.
+  enum StatementId {
+    INSERT_FAVICON_URL,
+    UPDATE_FAVICON_URL,
+    INSERT_BITMAP,
+    SET_BITMAP_HASH,
+    REMOVE_BITMAP,
+    DELETE_UNUSED_BITMAPS,
+    LOAD_BITMAP,
+    STATEMENT_COUNT
+  };
+
+  FaviconDatabasePrivate();
+
+  // Bitmaps |snapshot| knows of but which are not in |bitmapCache| are read
+  // from sqlite if |readDatabase| is set, which waits for a running sync.
+  // Only the DB thread does.
+  SkBitmap bitmapForFaviconUrl(const FaviconSnapshot &snapshot,
+                               const GURL &faviconUrl,
+                               bool readDatabase);
+
+  // Called with |mutex| held.
   bool existsForFaviconURL(const GURL &faviconUrl) const;
+  // Whether any page points to |faviconUrl|. Called with |mutex| held.
+  bool isFaviconURLUsed(const GURL &faviconUrl) const;
+
+  // Runs |cmd| on the maps and queues it for sqlite. Called with |mutex|
+  // held.
+  void apply(Command *cmd);
+  // Publish what the maps hold for one page or favicon, or that they were
+  // cleared, to readers. Called with |mutex| held.
+  void publishPage(const GURL &pageUrl);
+  void publishFavicon(const GURL &faviconUrl);
+  void publishClear();
+  // Publishes a new index built from the maps, once they are loaded.
+  // Called with |mutex| held.
+  void publishIndex();
+  // The maps as of the last change.
+  scoped_refptr<const FaviconSnapshot> snapshot() const;
+
+  // Returns the statement |id| reset and with no parameters bound, or null.
+  // Called with |syncMutex| held.
+  sqlite3_stmt *cachedStatement(StatementId id);
+  void finalizeStatements();
 
   scoped_refptr<base::SingleThreadTaskRunner> taskRunner() const;
+  // Writes the queued commands to sqlite, then folds their changes into a
+  // new index. Called on the DB thread.
   void performSync();
+  // Migrates a database written by an older version, then loads and
+  // publishes the index. The maps stay available to writers meanwhile.
+  // Called on the DB thread.
+  void migrateAndLoad();
 
+  // The index, loaded at Open() or by migrateAndLoad(). Guarded by |mutex|.
   std::map<GURL, GURL> pageToFaviconUrl;
-  std::map<GURL, SkBitmap> faviconUrlToBitmap;
+  // Favicons with a bitmap, in memory or only in sqlite.
+  std::set<GURL> faviconUrls;
+  FaviconBitmapCache bitmapCache;
   std::string path;
   bool privateBrowsing;
 
+  // Set with both |syncMutex| and |mutex| held.
   sqlite3 *sqlite;
+  // Held while sqlite is written to, so that the maps stay available.
+  // Taken before |mutex|.
+  base::Lock syncMutex;
   base::Lock mutex;
   base::RepeatingTimer<FaviconDatabase> timer;
   std::queue<Command *> commands;
+  sqlite3_stmt *statements[STATEMENT_COUNT];
   base::WeakPtrFactory<FaviconDatabasePrivate> weakPtrFactory;
 
+  // Favicon URLs point to the hash of their PNG data, bitmaps are stored
+  // once per hash. Version 1 stored raw pixels per favicon URL in
+  // |faviconUrlToBitmapTable|.
+  static const int schemaVersion;
   static const char *pageUrlToFaviconUrlTable;
+  static const char *faviconUrlToHashTable;
+  static const char *bitmapTable;
   static const char *faviconUrlToBitmapTable;
   static const char *pageUrlColumn;
   static const char *faviconUrlColumn;
+  static const char *hashColumn;
   static const char *bitmapColumn;
+
+ private:
+  friend class base::RefCountedThreadSafe<FaviconDatabasePrivate>;
+  ~FaviconDatabasePrivate();
+
+  // Hands the queued commands to sqlite, |folded| is set to the snapshot
+  // holding their changes. Returns false if there were none. Called with
+  // |syncMutex| held.
+  bool syncCommands(scoped_refptr<const FaviconSnapshot> *folded);
+  // Called with |mutex| held.
+  void setSnapshot(const scoped_refptr<const FaviconSnapshot> &snapshot);
+  // Builds an index holding the changes of |folded| on the DB thread, and
+  // publishes it with the changes made since.
+  void rebaseSnapshot(const scoped_refptr<const FaviconSnapshot> &folded);
+
+  // Replaced with |mutex| held, read under |snapshotMutex| alone.
+  mutable base::Lock snapshotMutex;
+  scoped_refptr<const FaviconSnapshot> currentSnapshot;
 };
 
 #endif // FAVICON_DATABASE_P_H
@@ -0,0 +1,133 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures syncing a burst of favicons to sqlite, how long readers wait
+// meanwhile, the size of the file, and opening the database again.
+
+#include "browser/favicon/favicon_database.h"
+#include "browser/favicon/favicon_database_p.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "base/at_exit.h"
+#include "base/bind.h"
+#include "base/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/message_loop/message_loop.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/thread.h"
+#include "base/time/time.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+const int kBurstSize = 500;
+const int kIconSize = 16;
+
+void PrintResult(const char* trace, double value, const char* units) {
+  printf("*RESULT efl_favicon_database_sync: %s= %f %s\n", trace, value, units);
+  fflush(stdout);
+}
+
+GURL PageURL(int i) {
+  return GURL(base::StringPrintf("http://site%d.example.com/index.html", i));
+}
+
+GURL IconURL(int i) {
+  return GURL(base::StringPrintf("http://site%d.example.com/favicon.ico", i));
+}
+
+} // namespace
+
+class FaviconDatabasePerfTest : public testing::Test {
+ protected:
+  FaviconDatabasePerfTest()
+    : database_(FaviconDatabase::Instance()) {
+  }
+
+  virtual void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    ASSERT_TRUE(database_->SetPath(
+        temp_dir_.path().AppendASCII("favicons.db").value()));
+    ASSERT_TRUE(database_->Open());
+  }
+
+  virtual void TearDown() override {
+    database_->Clear();
+    Sync();
+    database_->Close();
+  }
+
+  void Sync() {
+    database_->d->performSync();
+  }
+
+  // Runs the sync on |thread|, signals |done| once it is over.
+  void SyncOn(base::Thread* thread, base::WaitableEvent* done) {
+    thread->message_loop()->PostTask(FROM_HERE,
+        base::Bind(&FaviconDatabasePrivate::performSync, database_->d));
+    thread->message_loop()->PostTask(FROM_HERE,
+        base::Bind(&base::WaitableEvent::Signal, base::Unretained(done)));
+  }
+
+  base::MessageLoop message_loop_;
+  base::ScopedTempDir temp_dir_;
+  FaviconDatabase* database_;
+};
+
+TEST_F(FaviconDatabasePerfTest, BurstSync) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(kIconSize, kIconSize);
+  bitmap.eraseARGB(255, 0, 128, 255);
+
+  for (int i = 0; i < kBurstSize; ++i) {
+    database_->SetFaviconURLForPageURL(IconURL(i), PageURL(i));
+    database_->SetBitmapForFaviconURL(bitmap, IconURL(i));
+  }
+
+  base::Thread thread("FaviconSync");
+  ASSERT_TRUE(thread.Start());
+  base::WaitableEvent done(false, false);
+  base::TimeTicks start = base::TimeTicks::Now();
+  SyncOn(&thread, &done);
+
+  // Readers should not notice the sync.
+  base::TimeDelta longest_read;
+  int reads = 0;
+  while (!done.IsSignaled()) {
+    base::TimeTicks read_start = base::TimeTicks::Now();
+    EXPECT_FALSE(database_->GetBitmapForPageURL(PageURL(reads % kBurstSize)).isNull());
+    longest_read = std::max(longest_read, base::TimeTicks::Now() - read_start);
+    ++reads;
+  }
+  base::TimeDelta sync_time = base::TimeTicks::Now() - start;
+  thread.Stop();
+
+  PrintResult("burst_500", sync_time.InMillisecondsF(), "ms");
+  PrintResult("longest_read_during_sync", longest_read.InMillisecondsF(), "ms");
+
+  // The icons are identical, their bitmap is stored once.
+  database_->Close();
+  int64 file_size = 0;
+  ASSERT_TRUE(base::GetFileSize(temp_dir_.path().AppendASCII("favicons.db"), &file_size));
+  PrintResult("file_size_500", file_size / 1024.0, "kb");
+
+  // Everything reached sqlite. Opening reads the index only.
+  start = base::TimeTicks::Now();
+  ASSERT_TRUE(database_->Open());
+  PrintResult("open_500", (base::TimeTicks::Now() - start).InMillisecondsF(), "ms");
+  for (int i = 0; i < kBurstSize; ++i)
+    ASSERT_TRUE(database_->ExistsForPageURL(PageURL(i)));
+  SkBitmap loaded = database_->LoadBitmapForFaviconURL(IconURL(0));
+  ASSERT_EQ(kIconSize, loaded.width());
+  ASSERT_EQ(kIconSize, loaded.height());
+}
+
+int main(int argc, char** argv) {
+  base::AtExitManager at_exit;
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
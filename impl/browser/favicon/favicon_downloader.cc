@@ -4,6 +4,7 @@
 
 #include "favicon_downloader.h"
 #include "base/bind.h"
+#include "content/public/browser/navigation_details.h"
 #include "content/public/browser/web_contents.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 
@@ -20,6 +21,32 @@ void FaviconDownloader::Start() {
   DownloadFavicon(m_faviconUrl);
 }
 
+void FaviconDownloader::SetAbortCallback(const base::Closure &abortCallback) {
+  m_abortCallback = abortCallback;
+}
+
+void FaviconDownloader::RenderProcessGone(base::TerminationStatus status) {
+  Abort();
+}
+
+void FaviconDownloader::DidNavigateMainFrame(const content::LoadCommittedDetails &details,
+                                             const content::FrameNavigateParams &params) {
+  if (!details.is_in_page) {
+    Abort();
+  }
+}
+
+void FaviconDownloader::Abort() {
+  // A reply coming after all is dropped, and so are further events.
+  m_weakPtrFactory.InvalidateWeakPtrs();
+  Observe(NULL);
+  if (!m_abortCallback.is_null()) {
+    m_abortCallback.Run();
+    return;
+  }
+  m_callback.Run(false, GURL(), SkBitmap());
+}
+
 int FaviconDownloader::DownloadFavicon(const GURL &faviconUrl) {
   return web_contents()->DownloadImage(faviconUrl,
                                        true,
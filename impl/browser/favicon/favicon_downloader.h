@@ -28,7 +28,20 @@ class FaviconDownloader : public content::WebContentsObserver {
                     FaviconDownloaderCallback callback);
   virtual ~FaviconDownloader() {}
 
-  void Start();
+  virtual void Start();
+
+  // Run instead of the callback when the download is cut short, which says
+  // nothing about the icon. Without it the download fails.
+  void SetAbortCallback(const base::Closure &abortCallback);
+
+  // content::WebContentsObserver implementation. The renderer drops the
+  // download when it goes away or the page navigates, which aborts it.
+  virtual void RenderProcessGone(base::TerminationStatus status) override;
+  virtual void DidNavigateMainFrame(const content::LoadCommittedDetails &details,
+                                    const content::FrameNavigateParams &params) override;
+
+ protected:
+  void Abort();
 
  private:
   int DownloadFavicon(const GURL &faviconUrl);
@@ -41,6 +54,7 @@ class FaviconDownloader : public content::WebContentsObserver {
 
   GURL m_faviconUrl;
   FaviconDownloaderCallback m_callback;
+  base::Closure m_abortCallback;
   base::WeakPtrFactory<FaviconDownloader> m_weakPtrFactory;
   DISALLOW_COPY_AND_ASSIGN(FaviconDownloader);
 };
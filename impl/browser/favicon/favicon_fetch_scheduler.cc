@@ -0,0 +1,269 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "browser/favicon/favicon_fetch_scheduler.h"
+#include "base/bind.h"
+#include "base/message_loop/message_loop.h"
+#include "base/stl_util.h"
+#include "browser/favicon/favicon_service.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/web_contents.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+using content::BrowserThread;
+
+namespace {
+
+// Downloads of icons of pages which are not shown, at once.
+const size_t kMaxDeferredDownloads = 4;
+// Pages which keep loading do not hold the icons of the others back longer.
+const int kMaxDeferralSeconds = 10;
+const int kFailedRetryMinutes = 5;
+const size_t kMaxFailedIcons = 256;
+// DownloadImage never answers if the request got lost on the way.
+const int kDownloadTimeoutSeconds = 30;
+
+} // namespace
+
+FaviconFetchScheduler::PendingFetch::PendingFetch()
+  : downloadingContents(0),
+    timeout(false, false) {
+}
+
+FaviconFetchScheduler::PendingFetch::~PendingFetch() {
+}
+
+FaviconFetchScheduler::FaviconFetchScheduler()
+  : m_downloadTimeout(base::TimeDelta::FromSeconds(kDownloadTimeoutSeconds)),
+    m_weakPtrFactory(this) {
+}
+
+FaviconFetchScheduler::~FaviconFetchScheduler() {
+  STLDeleteValues(&m_fetches);
+}
+
+void FaviconFetchScheduler::Fetch(content::WebContents *webContents,
+                                  const GURL &faviconUrl,
+                                  Priority priority,
+                                  const FaviconDownloader::FaviconDownloaderCallback &callback) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  std::map<GURL, base::TimeTicks>::iterator failed = m_failedUntil.find(faviconUrl);
+  if (failed != m_failedUntil.end()) {
+    if (base::TimeTicks::Now() < failed->second) {
+      callback.Run(false, GURL(), SkBitmap());
+      return;
+    }
+    m_failedUntil.erase(failed);
+  }
+
+  PendingFetch *&fetch = m_fetches[faviconUrl];
+  if (!fetch) {
+    fetch = new PendingFetch;
+  }
+  Waiter waiter = { webContents, callback };
+  fetch->waiters.push_back(waiter);
+  if (fetch->downloader) {
+    return;
+  }
+
+  // A shown page does not wait for the others.
+  if (priority == PRIORITY_HIGH) {
+    Start(faviconUrl, fetch);
+    return;
+  }
+  StartDeferred(false);
+}
+
+void FaviconFetchScheduler::Cancel(content::WebContents *webContents) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  m_loading.erase(webContents);
+
+  PendingFetchMap::iterator it = m_fetches.begin();
+  while (it != m_fetches.end()) {
+    PendingFetch *fetch = it->second;
+    std::vector<Waiter> waiters;
+    for (size_t i = 0; i < fetch->waiters.size(); ++i) {
+      if (fetch->waiters[i].webContents != webContents) {
+        waiters.push_back(fetch->waiters[i]);
+      }
+    }
+    fetch->waiters.swap(waiters);
+
+    if (fetch->waiters.empty()) {
+      delete fetch;
+      m_fetches.erase(it++);
+      continue;
+    }
+    if (fetch->downloader && fetch->downloadingContents == webContents) {
+      Start(it->first, fetch);
+    }
+    ++it;
+  }
+  StartDeferred(false);
+}
+
+void FaviconFetchScheduler::LoadingStateChanged(content::WebContents *webContents, bool loading) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  if (loading) {
+    m_loading.insert(webContents);
+    return;
+  }
+  m_loading.erase(webContents);
+  StartDeferred(false);
+}
+
+void FaviconFetchScheduler::SetDownloadTimeoutForTesting(base::TimeDelta timeout) {
+  m_downloadTimeout = timeout;
+}
+
+FaviconDownloader *FaviconFetchScheduler::CreateDownloader(content::WebContents *webContents,
+                                                           const GURL &faviconUrl,
+                                                           const FaviconDownloader::FaviconDownloaderCallback &callback) {
+  return new FaviconDownloader(webContents, faviconUrl, callback);
+}
+
+void FaviconFetchScheduler::StoreBitmap(const GURL &faviconUrl, const SkBitmap &bitmap) {
+  FaviconService fs;
+  fs.SetBitmapForFaviconURL(bitmap, faviconUrl);
+}
+
+void FaviconFetchScheduler::Start(const GURL &faviconUrl, PendingFetch *fetch) {
+  DCHECK(!fetch->waiters.empty());
+  fetch->downloadingContents = fetch->waiters.front().webContents;
+  fetch->downloader.reset(CreateDownloader(fetch->downloadingContents,
+                                           faviconUrl,
+                                           base::Bind(&FaviconFetchScheduler::DidDownloadFavicon,
+                                                      m_weakPtrFactory.GetWeakPtr(),
+                                                      faviconUrl)));
+  fetch->downloader->SetAbortCallback(base::Bind(&FaviconFetchScheduler::DownloadInterrupted,
+                                                 m_weakPtrFactory.GetWeakPtr(),
+                                                 faviconUrl));
+  fetch->timeout.Start(FROM_HERE, m_downloadTimeout,
+                       base::Bind(&FaviconFetchScheduler::DownloadTimedOut,
+                                  m_weakPtrFactory.GetWeakPtr(),
+                                  faviconUrl));
+  fetch->downloader->Start();
+}
+
+void FaviconFetchScheduler::StartDeferred(bool force) {
+  size_t running = RunningCount();
+  bool deferred = false;
+  for (PendingFetchMap::iterator it = m_fetches.begin(); it != m_fetches.end(); ++it) {
+    if (it->second->downloader) {
+      continue;
+    }
+    if ((!force && !m_loading.empty()) || running >= kMaxDeferredDownloads) {
+      deferred = true;
+      break;
+    }
+    Start(it->first, it->second);
+    ++running;
+  }
+
+  if (!deferred) {
+    m_deferralTimer.Stop();
+  } else if (!m_deferralTimer.IsRunning()) {
+    m_deferralTimer.Start(FROM_HERE, base::TimeDelta::FromSeconds(kMaxDeferralSeconds),
+                          this, &FaviconFetchScheduler::DeferralTimedOut);
+  }
+}
+
+void FaviconFetchScheduler::DeferralTimedOut() {
+  StartDeferred(true);
+}
+
+void FaviconFetchScheduler::DownloadTimedOut(const GURL &faviconUrl) {
+  DownloadInterrupted(faviconUrl);
+}
+
+void FaviconFetchScheduler::DownloadInterrupted(const GURL &faviconUrl) {
+  PendingFetchMap::iterator it = m_fetches.find(faviconUrl);
+  if (it == m_fetches.end() || !it->second->downloader) {
+    return;
+  }
+  PendingFetch *fetch = it->second;
+  // May be called from within the downloader.
+  base::MessageLoop::current()->DeleteSoon(FROM_HERE, fetch->downloader.release());
+  fetch->timeout.Stop();
+
+  // Retrying with the same page could keep it waiting forever.
+  std::vector<Waiter> failed;
+  std::vector<Waiter> waiters;
+  for (size_t i = 0; i < fetch->waiters.size(); ++i) {
+    if (fetch->waiters[i].webContents == fetch->downloadingContents) {
+      failed.push_back(fetch->waiters[i]);
+    } else {
+      waiters.push_back(fetch->waiters[i]);
+    }
+  }
+  fetch->waiters.swap(waiters);
+  fetch->downloadingContents = 0;
+
+  if (fetch->waiters.empty()) {
+    delete fetch;
+    m_fetches.erase(it);
+  } else {
+    Start(faviconUrl, fetch);
+  }
+
+  for (size_t i = 0; i < failed.size(); ++i) {
+    failed[i].callback.Run(false, faviconUrl, SkBitmap());
+  }
+  StartDeferred(false);
+}
+
+void FaviconFetchScheduler::RememberFailure(const GURL &faviconUrl) {
+  base::TimeTicks now = base::TimeTicks::Now();
+  std::map<GURL, base::TimeTicks>::iterator earliest = m_failedUntil.end();
+  std::map<GURL, base::TimeTicks>::iterator it = m_failedUntil.begin();
+  while (it != m_failedUntil.end()) {
+    if (it->second <= now) {
+      m_failedUntil.erase(it++);
+      continue;
+    }
+    if (earliest == m_failedUntil.end() || it->second < earliest->second) {
+      earliest = it;
+    }
+    ++it;
+  }
+  if (m_failedUntil.size() >= kMaxFailedIcons && earliest != m_failedUntil.end()) {
+    m_failedUntil.erase(earliest);
+  }
+  m_failedUntil[faviconUrl] = now + base::TimeDelta::FromMinutes(kFailedRetryMinutes);
+}
+
+size_t FaviconFetchScheduler::RunningCount() const {
+  size_t count = 0;
+  for (PendingFetchMap::const_iterator it = m_fetches.begin(); it != m_fetches.end(); ++it) {
+    if (it->second->downloader) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+void FaviconFetchScheduler::DidDownloadFavicon(const GURL &faviconUrl,
+                                               bool success,
+                                               const GURL &imageUrl,
+                                               const SkBitmap &bitmap) {
+  PendingFetchMap::iterator it = m_fetches.find(faviconUrl);
+  if (it == m_fetches.end()) {
+    return;
+  }
+  scoped_ptr<PendingFetch> fetch(it->second);
+  m_fetches.erase(it);
+  // Called from within the downloader.
+  base::MessageLoop::current()->DeleteSoon(FROM_HERE, fetch->downloader.release());
+
+  if (success) {
+    StoreBitmap(faviconUrl, bitmap);
+  } else {
+    RememberFailure(faviconUrl);
+  }
+
+  for (size_t i = 0; i < fetch->waiters.size(); ++i) {
+    fetch->waiters[i].callback.Run(success, faviconUrl, bitmap);
+  }
+  StartDeferred(false);
+}
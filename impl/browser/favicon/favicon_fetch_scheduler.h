@@ -0,0 +1,108 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FAVICON_FETCH_SCHEDULER_H
+#define FAVICON_FETCH_SCHEDULER_H
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "browser/favicon/favicon_downloader.h"
+#include "url/gurl.h"
+
+namespace content {
+class WebContents;
+}
+
+// Downloads the favicons of the pages of one context. A page asking for an
+// icon which is already being downloaded waits for that download, and every
+// page waiting is called back with its result, which is stored once.
+// Downloads go through the renderer and so through the HTTP cache. Icons of
+// pages which are not shown wait until no page of the context is loading.
+// A download which gets no reply in time, or which its page cuts short by
+// navigating, fails for that page and moves on to another waiting page.
+// Only icons which failed to download are not asked for again for a while.
+// Lives on the UI thread.
+class FaviconFetchScheduler {
+ public:
+  enum Priority {
+    PRIORITY_LOW,
+    PRIORITY_HIGH
+  };
+
+  FaviconFetchScheduler();
+  virtual ~FaviconFetchScheduler();
+
+  // Runs |callback| once |faviconUrl| is downloaded with |webContents|, or
+  // with the page of another request for the same icon.
+  void Fetch(content::WebContents *webContents,
+             const GURL &faviconUrl,
+             Priority priority,
+             const FaviconDownloader::FaviconDownloaderCallback &callback);
+  // Drops the requests of |webContents|, which is going away. Downloads
+  // other pages still wait for move to one of them.
+  void Cancel(content::WebContents *webContents);
+  void LoadingStateChanged(content::WebContents *webContents, bool loading);
+
+  void SetDownloadTimeoutForTesting(base::TimeDelta timeout);
+
+ protected:
+  // Overridden by tests.
+  virtual FaviconDownloader *CreateDownloader(content::WebContents *webContents,
+                                              const GURL &faviconUrl,
+                                              const FaviconDownloader::FaviconDownloaderCallback &callback);
+  virtual void StoreBitmap(const GURL &faviconUrl, const SkBitmap &bitmap);
+
+ private:
+  struct Waiter {
+    content::WebContents *webContents;
+    FaviconDownloader::FaviconDownloaderCallback callback;
+  };
+
+  struct PendingFetch {
+    PendingFetch();
+    ~PendingFetch();
+
+    std::vector<Waiter> waiters;
+    // Null while deferred.
+    scoped_ptr<FaviconDownloader> downloader;
+    content::WebContents *downloadingContents;
+    // Interrupts the download if it does not answer.
+    base::Timer timeout;
+  };
+  typedef std::map<GURL, PendingFetch*> PendingFetchMap;
+
+  void Start(const GURL &faviconUrl, PendingFetch *fetch);
+  // Starts deferred downloads if no page is loading or |force| is set, and
+  // forces the rest after a while.
+  void StartDeferred(bool force);
+  void DeferralTimedOut();
+  void DownloadTimedOut(const GURL &faviconUrl);
+  // Fails the waiters of the downloading page, the download moves to the
+  // next page waiting for the icon.
+  void DownloadInterrupted(const GURL &faviconUrl);
+  void RememberFailure(const GURL &faviconUrl);
+  size_t RunningCount() const;
+  void DidDownloadFavicon(const GURL &faviconUrl,
+                          bool success,
+                          const GURL &imageUrl,
+                          const SkBitmap &bitmap);
+
+  PendingFetchMap m_fetches;
+  std::set<content::WebContents*> m_loading;
+  // Icons which could not be downloaded are not asked for again until then.
+  // Bounded, expired entries are dropped first.
+  std::map<GURL, base::TimeTicks> m_failedUntil;
+  base::TimeDelta m_downloadTimeout;
+  base::OneShotTimer<FaviconFetchScheduler> m_deferralTimer;
+  base::WeakPtrFactory<FaviconFetchScheduler> m_weakPtrFactory;
+  DISALLOW_COPY_AND_ASSIGN(FaviconFetchScheduler);
+};
+
+#endif // FAVICON_FETCH_SCHEDULER_H
@@ -0,0 +1,303 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Tests for FaviconFetchScheduler with downloaders which only answer when
+// told to: requests for one icon share a download, every waiting page gets
+// its result, downloads move to another page when theirs goes away,
+// navigates or does not answer, and downloads which never answer do not
+// hold the others back.
+
+#include "browser/favicon/favicon_fetch_scheduler.h"
+
+#include <map>
+#include <vector>
+
+#include "base/at_exit.h"
+#include "base/bind.h"
+#include "base/run_loop.h"
+#include "base/strings/stringprintf.h"
+#include "content/public/test/test_browser_thread_bundle.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+namespace {
+
+// Pages are only compared, never used.
+content::WebContents *FakeContents(int i) {
+  return reinterpret_cast<content::WebContents *>(0x1000 + i * 0x10);
+}
+
+GURL IconURL(int i) {
+  return GURL(base::StringPrintf("http://site%d.example.com/favicon.ico", i));
+}
+
+class FakeDownloader;
+typedef std::map<GURL, FakeDownloader *> FakeDownloaderMap;
+
+// Answers once Finish() is called, is cut short by Abort() as if its page
+// navigated, unregisters itself when deleted.
+class FakeDownloader : public FaviconDownloader {
+ public:
+  FakeDownloader(FakeDownloaderMap *running,
+                 content::WebContents *webContents,
+                 const GURL &faviconUrl,
+                 const FaviconDownloaderCallback &callback)
+    : FaviconDownloader(NULL, faviconUrl, callback),
+      m_running(running),
+      m_webContents(webContents),
+      m_faviconUrl(faviconUrl),
+      m_callback(callback) {
+  }
+
+  virtual ~FakeDownloader() {
+    FakeDownloaderMap::iterator it = m_running->find(m_faviconUrl);
+    if (it != m_running->end() && it->second == this) {
+      m_running->erase(it);
+    }
+  }
+
+  virtual void Start() override {
+    (*m_running)[m_faviconUrl] = this;
+  }
+
+  void Finish(bool success) {
+    SkBitmap bitmap;
+    if (success) {
+      bitmap.allocN32Pixels(16, 16);
+      bitmap.eraseARGB(255, 0, 128, 255);
+    }
+    m_callback.Run(success, success ? m_faviconUrl : GURL(), bitmap);
+  }
+
+  void Abort() {
+    FaviconDownloader::Abort();
+  }
+
+  content::WebContents *webContents() const { return m_webContents; }
+
+ private:
+  FakeDownloaderMap *m_running;
+  content::WebContents *m_webContents;
+  GURL m_faviconUrl;
+  FaviconDownloaderCallback m_callback;
+};
+
+// |running| outlives the scheduler, which deletes its downloaders.
+class TestFaviconFetchScheduler : public FaviconFetchScheduler {
+ public:
+  explicit TestFaviconFetchScheduler(FakeDownloaderMap *running)
+    : m_running(running),
+      m_created(0) {
+  }
+
+  FakeDownloader *Running(const GURL &faviconUrl) {
+    FakeDownloaderMap::iterator it = m_running->find(faviconUrl);
+    return it == m_running->end() ? NULL : it->second;
+  }
+
+  size_t RunningCount() const { return m_running->size(); }
+  int created() const { return m_created; }
+  const std::vector<GURL> &stored() const { return m_stored; }
+
+ protected:
+  virtual FaviconDownloader *CreateDownloader(content::WebContents *webContents,
+                                              const GURL &faviconUrl,
+                                              const FaviconDownloader::FaviconDownloaderCallback &callback) override {
+    ++m_created;
+    return new FakeDownloader(m_running, webContents, faviconUrl, callback);
+  }
+
+  virtual void StoreBitmap(const GURL &faviconUrl, const SkBitmap &bitmap) override {
+    m_stored.push_back(faviconUrl);
+  }
+
+ private:
+  FakeDownloaderMap *m_running;
+  int m_created;
+  std::vector<GURL> m_stored;
+};
+
+} // namespace
+
+class FaviconFetchSchedulerTest : public testing::Test {
+ protected:
+  FaviconFetchSchedulerTest()
+    : scheduler_(&running_),
+      succeeded_(0),
+      failed_(0) {
+  }
+
+  void Fetch(int page, const GURL &faviconUrl, FaviconFetchScheduler::Priority priority) {
+    scheduler_.Fetch(FakeContents(page), faviconUrl, priority,
+                     base::Bind(&FaviconFetchSchedulerTest::DidFetch, base::Unretained(this)));
+  }
+
+  void DidFetch(bool success, const GURL &faviconUrl, const SkBitmap &bitmap) {
+    if (success) {
+      ++succeeded_;
+    } else {
+      ++failed_;
+    }
+  }
+
+  // Deletes the downloaders which are done.
+  void RunUntilIdle() {
+    base::RunLoop().RunUntilIdle();
+  }
+
+  // Downloaders deleted with the pending tasks unregister here.
+  FakeDownloaderMap running_;
+  content::TestBrowserThreadBundle thread_bundle_;
+  TestFaviconFetchScheduler scheduler_;
+  int succeeded_;
+  int failed_;
+};
+
+TEST_F(FaviconFetchSchedulerTest, SharesDownloadAndCallsEveryPage) {
+  Fetch(0, IconURL(0), FaviconFetchScheduler::PRIORITY_HIGH);
+  Fetch(1, IconURL(0), FaviconFetchScheduler::PRIORITY_HIGH);
+  Fetch(2, IconURL(0), FaviconFetchScheduler::PRIORITY_LOW);
+  ASSERT_EQ(1, scheduler_.created());
+  ASSERT_TRUE(scheduler_.Running(IconURL(0)));
+
+  scheduler_.Running(IconURL(0))->Finish(true);
+  RunUntilIdle();
+  EXPECT_EQ(3, succeeded_);
+  EXPECT_EQ(0, failed_);
+  ASSERT_EQ(1u, scheduler_.stored().size());
+  EXPECT_EQ(IconURL(0), scheduler_.stored()[0]);
+  EXPECT_EQ(0u, scheduler_.RunningCount());
+}
+
+TEST_F(FaviconFetchSchedulerTest, HandsDownloadOverWhenPageGoesAway) {
+  Fetch(0, IconURL(0), FaviconFetchScheduler::PRIORITY_HIGH);
+  Fetch(1, IconURL(0), FaviconFetchScheduler::PRIORITY_HIGH);
+  ASSERT_EQ(FakeContents(0), scheduler_.Running(IconURL(0))->webContents());
+
+  scheduler_.Cancel(FakeContents(0));
+  ASSERT_EQ(2, scheduler_.created());
+  ASSERT_TRUE(scheduler_.Running(IconURL(0)));
+  EXPECT_EQ(FakeContents(1), scheduler_.Running(IconURL(0))->webContents());
+
+  scheduler_.Running(IconURL(0))->Finish(true);
+  RunUntilIdle();
+  EXPECT_EQ(1, succeeded_);
+  EXPECT_EQ(0, failed_);
+}
+
+TEST_F(FaviconFetchSchedulerTest, HandsDownloadOverWhenPageNavigates) {
+  Fetch(0, IconURL(0), FaviconFetchScheduler::PRIORITY_HIGH);
+  Fetch(1, IconURL(0), FaviconFetchScheduler::PRIORITY_HIGH);
+  ASSERT_EQ(FakeContents(0), scheduler_.Running(IconURL(0))->webContents());
+
+  scheduler_.Running(IconURL(0))->Abort();
+  RunUntilIdle();
+  EXPECT_EQ(1, failed_);
+  ASSERT_EQ(2, scheduler_.created());
+  ASSERT_TRUE(scheduler_.Running(IconURL(0)));
+  EXPECT_EQ(FakeContents(1), scheduler_.Running(IconURL(0))->webContents());
+
+  scheduler_.Running(IconURL(0))->Finish(true);
+  RunUntilIdle();
+  EXPECT_EQ(1, succeeded_);
+  ASSERT_EQ(1u, scheduler_.stored().size());
+}
+
+TEST_F(FaviconFetchSchedulerTest, DoesNotRememberAbortedDownloads) {
+  Fetch(0, IconURL(0), FaviconFetchScheduler::PRIORITY_HIGH);
+  scheduler_.Running(IconURL(0))->Abort();
+  RunUntilIdle();
+  EXPECT_EQ(1, failed_);
+  EXPECT_EQ(0u, scheduler_.RunningCount());
+
+  // Downloaded again right away.
+  Fetch(0, IconURL(0), FaviconFetchScheduler::PRIORITY_HIGH);
+  EXPECT_EQ(2, scheduler_.created());
+  EXPECT_TRUE(scheduler_.Running(IconURL(0)));
+}
+
+TEST_F(FaviconFetchSchedulerTest, DropsDownloadWithoutWaiters) {
+  Fetch(0, IconURL(0), FaviconFetchScheduler::PRIORITY_HIGH);
+  scheduler_.Cancel(FakeContents(0));
+  RunUntilIdle();
+  EXPECT_EQ(0u, scheduler_.RunningCount());
+  EXPECT_EQ(0, succeeded_ + failed_);
+}
+
+TEST_F(FaviconFetchSchedulerTest, DefersLowPriorityWhileLoading) {
+  scheduler_.LoadingStateChanged(FakeContents(9), true);
+  Fetch(0, IconURL(0), FaviconFetchScheduler::PRIORITY_LOW);
+  EXPECT_EQ(0, scheduler_.created());
+
+  scheduler_.LoadingStateChanged(FakeContents(9), false);
+  EXPECT_EQ(1, scheduler_.created());
+}
+
+TEST_F(FaviconFetchSchedulerTest, RemembersFailures) {
+  Fetch(0, IconURL(0), FaviconFetchScheduler::PRIORITY_HIGH);
+  scheduler_.Running(IconURL(0))->Finish(false);
+  RunUntilIdle();
+  EXPECT_EQ(1, failed_);
+
+  // Not downloaded again for a while.
+  Fetch(1, IconURL(0), FaviconFetchScheduler::PRIORITY_HIGH);
+  EXPECT_EQ(2, failed_);
+  EXPECT_EQ(1, scheduler_.created());
+}
+
+TEST_F(FaviconFetchSchedulerTest, BoundsFailures) {
+  // kMaxFailedIcons in favicon_fetch_scheduler.cc.
+  const int kMaxFailedIcons = 256;
+  for (int i = 0; i <= kMaxFailedIcons; ++i) {
+    Fetch(0, IconURL(i), FaviconFetchScheduler::PRIORITY_HIGH);
+    scheduler_.Running(IconURL(i))->Finish(false);
+  }
+  RunUntilIdle();
+
+  // The first failure made room for the last one.
+  int created = scheduler_.created();
+  Fetch(0, IconURL(0), FaviconFetchScheduler::PRIORITY_HIGH);
+  EXPECT_EQ(created + 1, scheduler_.created());
+  Fetch(0, IconURL(kMaxFailedIcons), FaviconFetchScheduler::PRIORITY_HIGH);
+  EXPECT_EQ(created + 1, scheduler_.created());
+}
+
+TEST_F(FaviconFetchSchedulerTest, TimedOutDownloadsDoNotBlockOthers) {
+  scheduler_.SetDownloadTimeoutForTesting(base::TimeDelta());
+  // None of them is ever answered, the last waits for the others.
+  for (int i = 0; i < 5; ++i) {
+    Fetch(i, IconURL(i), FaviconFetchScheduler::PRIORITY_LOW);
+  }
+  EXPECT_EQ(4, scheduler_.created());
+  EXPECT_FALSE(scheduler_.Running(IconURL(4)));
+
+  RunUntilIdle();
+  EXPECT_EQ(5, scheduler_.created());
+  EXPECT_EQ(0u, scheduler_.RunningCount());
+  EXPECT_EQ(5, failed_);
+
+  // A timeout says nothing about the icon, it is downloaded again.
+  scheduler_.SetDownloadTimeoutForTesting(base::TimeDelta::FromSeconds(30));
+  Fetch(0, IconURL(0), FaviconFetchScheduler::PRIORITY_HIGH);
+  EXPECT_EQ(6, scheduler_.created());
+}
+
+TEST_F(FaviconFetchSchedulerTest, TimedOutDownloadMovesToAnotherPage) {
+  scheduler_.SetDownloadTimeoutForTesting(base::TimeDelta());
+  Fetch(0, IconURL(0), FaviconFetchScheduler::PRIORITY_HIGH);
+  Fetch(1, IconURL(0), FaviconFetchScheduler::PRIORITY_HIGH);
+  Fetch(1, IconURL(0), FaviconFetchScheduler::PRIORITY_HIGH);
+
+  // Each page is tried once, then its requests fail.
+  RunUntilIdle();
+  EXPECT_EQ(2, scheduler_.created());
+  EXPECT_EQ(0u, scheduler_.RunningCount());
+  EXPECT_EQ(3, failed_);
+}
+
+int main(int argc, char** argv) {
+  base::AtExitManager at_exit;
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
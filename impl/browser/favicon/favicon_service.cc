@@ -46,6 +46,11 @@ SkBitmap FaviconService::GetBitmapForFaviconURL(const GURL& iconUrl) const {
   return m_database->GetBitmapForFaviconURL(iconUrl);
 }
 
+SkBitmap FaviconService::LoadBitmapForPageURL(const GURL& pageUrl) const {
+  CHECK_OPEN_RET(SkBitmap());
+  return m_database->LoadBitmapForPageURL(pageUrl);
+}
+
 void FaviconService::SetFaviconURLForPageURL(const GURL& iconUrl, const GURL& pageUrl) {
   CHECK_OPEN;
   m_database->SetFaviconURLForPageURL(iconUrl, pageUrl);
@@ -66,6 +71,10 @@ bool FaviconService::ExistsForFaviconURL(const GURL& iconUrl) const {
   return m_database->ExistsForFaviconURL(iconUrl);
 }
 
+FaviconBitmapCache::Stats FaviconService::GetCacheStatistics() const {
+  return m_database->GetCacheStatistics();
+}
+
 void FaviconService::Clear() {
   CHECK_OPEN;
   m_database->Clear();
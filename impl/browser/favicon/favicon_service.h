@@ -5,6 +5,7 @@
 #ifndef FAVICON_SERVICE_H
 #define FAVICON_SERVICE_H
 
+#include "browser/favicon/favicon_bitmap_cache.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "url/gurl.h"
 
@@ -12,7 +13,9 @@ class FaviconDatabase;
 
 // Use this class to store and retrieve icons in/from
 // favicon database.
-// It's methods can hang on mutex.
+// Reads never wait for the database, bitmaps which are not kept in
+// memory any more are only read from it by the Load methods, on the DB
+// thread.
 class FaviconService {
  public:
   FaviconService();
@@ -24,12 +27,14 @@ class FaviconService {
   GURL GetFaviconURLForPageURL(const GURL &pageUrl) const;
   SkBitmap GetBitmapForPageURL(const GURL &pageUrl) const;
   SkBitmap GetBitmapForFaviconURL(const GURL &iconUrl) const;
+  SkBitmap LoadBitmapForPageURL(const GURL &pageUrl) const;
 
   void SetFaviconURLForPageURL(const GURL &iconUrl, const GURL &pageUrl);
   void SetBitmapForFaviconURL(const SkBitmap &bitmap, const GURL &iconUrl);
 
   bool ExistsForPageURL(const GURL &pageUrl) const;
   bool ExistsForFaviconURL(const GURL &iconUrl) const;
+  FaviconBitmapCache::Stats GetCacheStatistics() const;
   void Clear();
 #if defined(OS_TIZEN_TV)
   static FaviconDatabase* GetFaviconDatabase();
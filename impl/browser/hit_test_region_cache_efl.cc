@@ -0,0 +1,107 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "browser/hit_test_region_cache_efl.h"
+
+#include "base/debug/trace_event.h"
+#include "base/metrics/histogram.h"
+
+namespace {
+
+// Points closer than this to the edge of a region are not answered from the
+// cache, regions are rounded to whole CSS pixels.
+const int kRegionEdgeTolerance = 2;
+
+bool IsSameHitTest(const _Ewk_Hit_Test& a, const _Ewk_Hit_Test& b) {
+  return a.context == b.context &&
+         a.linkURI == b.linkURI &&
+         a.imageURI == b.imageURI &&
+         a.mediaURI == b.mediaURI &&
+         a.isEditable == b.isEditable;
+}
+
+} // namespace
+
+HitTestRegionCacheEfl::HitTestRegionCacheEfl() {
+}
+
+HitTestRegionCacheEfl::~HitTestRegionCacheEfl() {
+}
+
+void HitTestRegionCacheEfl::Update(const HitTestRegionsEfl& added,
+                                   const std::vector<int>& removed_ids,
+                                   bool replace,
+                                   const gfx::Vector2d& scroll_offset) {
+  if (replace)
+    regions_.clear();
+
+  for (std::vector<int>::const_iterator it = removed_ids.begin();
+       it != removed_ids.end(); ++it)
+    regions_.erase(*it);
+
+  for (HitTestRegionsEfl::const_iterator it = added.begin();
+       it != added.end(); ++it)
+    regions_[it->id] = *it;
+
+  renderer_scroll_offset_ = scroll_offset;
+}
+
+void HitTestRegionCacheEfl::SetRendererScrollOffset(
+    const gfx::Vector2d& scroll_offset) {
+  renderer_scroll_offset_ = scroll_offset;
+}
+
+void HitTestRegionCacheEfl::Invalidate() {
+  regions_.clear();
+}
+
+const _Ewk_Hit_Test* HitTestRegionCacheEfl::Lookup(
+    const gfx::Point& point, const gfx::Vector2d& scroll_offset,
+    tizen_webview::Hit_Test_Mode mode) {
+  // The point was computed with a scroll offset the renderer no longer (or
+  // not yet) agrees with, e.g. during a fling.
+  if (mode != tizen_webview::TW_HIT_TEST_MODE_DEFAULT ||
+      scroll_offset != renderer_scroll_offset_) {
+    RecordLookup(false);
+    return NULL;
+  }
+
+  const HitTestRegionEfl* match = NULL;
+  for (RegionMap::const_iterator it = regions_.begin();
+       it != regions_.end(); ++it) {
+    gfx::Rect inner = it->second.rect;
+    inner.Inset(kRegionEdgeTolerance, kRegionEdgeTolerance);
+    if (!inner.Contains(point))
+      continue;
+
+    // Overlapping regions which disagree (e.g. an image inside a link or an
+    // editable over a link) can only be resolved by the renderer.
+    if (match && !IsSameHitTest(match->hit_test, it->second.hit_test)) {
+      RecordLookup(false);
+      return NULL;
+    }
+    match = &it->second;
+  }
+
+  RecordLookup(match != NULL);
+  return match ? &match->hit_test : NULL;
+}
+
+void HitTestRegionCacheEfl::RecordMissWaitTime(base::TimeDelta wait) {
+  UMA_HISTOGRAM_TIMES("Efl.HitTest.SyncWaitTime", wait);
+  if (wait > stats_.max_wait) {
+    stats_.max_wait = wait;
+    TRACE_COUNTER1("efl", "HitTestMaxWaitMs", wait.InMilliseconds());
+  }
+}
+
+void HitTestRegionCacheEfl::RecordLookup(bool hit) {
+  UMA_HISTOGRAM_BOOLEAN("Efl.HitTest.CacheHit", hit);
+  if (hit)
+    ++stats_.hits;
+  else
+    ++stats_.misses;
+  TRACE_COUNTER2("efl", "HitTestCache", "hits", stats_.hits,
+                 "misses", stats_.misses);
+}
@@ -0,0 +1,71 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef HIT_TEST_REGION_CACHE_EFL_H_
+#define HIT_TEST_REGION_CACHE_EFL_H_
+
+#include <map>
+#include <vector>
+
+#include "base/time/time.h"
+#include "common/hit_test_params_efl.h"
+#include "tizen_webview/public/tw_hit_test.h"
+#include "ui/gfx/point.h"
+#include "ui/gfx/vector2d.h"
+
+// Browser side copy of the hit test regions pushed by the renderer. Lookups
+// which can be answered from it avoid blocking the UI thread on a
+// synchronous hit test round trip.
+class HitTestRegionCacheEfl {
+ public:
+  struct Stats {
+    Stats() : hits(0), misses(0) {}
+    int hits;
+    int misses;
+    // Longest time the UI thread waited for the renderer on a miss.
+    base::TimeDelta max_wait;
+  };
+
+  HitTestRegionCacheEfl();
+  ~HitTestRegionCacheEfl();
+
+  // Applies an EwkHostMsg_DidUpdateHitTestRegions update.
+  void Update(const HitTestRegionsEfl& added,
+              const std::vector<int>& removed_ids,
+              bool replace,
+              const gfx::Vector2d& scroll_offset);
+
+  // Records the scroll offset the renderer used for a hit test it answered.
+  void SetRendererScrollOffset(const gfx::Vector2d& scroll_offset);
+
+  void Invalidate();
+
+  // Returns the cached result for |point| in document coordinates, or NULL
+  // if the renderer has to be asked. |scroll_offset| is the one |point| was
+  // computed with, nothing is answered unless it matches the latest offset
+  // the renderer sent with a hit test result. Only default mode is served,
+  // node attributes and image data always need the renderer. The result is
+  // valid until the next Update() or Invalidate().
+  const _Ewk_Hit_Test* Lookup(const gfx::Point& point,
+                              const gfx::Vector2d& scroll_offset,
+                              tizen_webview::Hit_Test_Mode mode);
+
+  // Accounts the time spent waiting for the renderer after a miss.
+  void RecordMissWaitTime(base::TimeDelta wait);
+
+  const Stats& stats() const { return stats_; }
+
+ private:
+  typedef std::map<int, HitTestRegionEfl> RegionMap;
+
+  void RecordLookup(bool hit);
+
+  RegionMap regions_;
+  gfx::Vector2d renderer_scroll_offset_;
+  Stats stats_;
+
+  DISALLOW_COPY_AND_ASSIGN(HitTestRegionCacheEfl);
+};
+
+#endif // HIT_TEST_REGION_CACHE_EFL_H_
@@ -0,0 +1,292 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "browser/memory_sampler_efl.h"
+
+#include <string.h>
+
+#include "base/bind.h"
+#include "base/file_util.h"
+#include "base/format_macros.h"
+#include "base/process/process_handle.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/stringprintf.h"
+#include "browser_context_efl.h"
+#include "common/render_messages_efl.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/render_process_host.h"
+#include "eweb_context.h"
+
+using content::BrowserThread;
+using tizen_webview::Memory_Sample;
+
+namespace {
+
+// Renderers which do not answer in time keep their previous figures.
+const int kRendererReplyTimeoutMs = 500;
+const size_t kMaxBufferedSamples = 4096;
+
+Memory_Sample NewSample(tizen_webview::Process_Type type, int pid) {
+  Memory_Sample sample;
+  memset(&sample, 0, sizeof(sample));
+  sample.process_type = type;
+  sample.pid = pid;
+  return sample;
+}
+
+// Sums the Rss, Pss and Private_Dirty lines of all mappings, in kB.
+void ReadSmaps(Memory_Sample* sample) {
+  std::string smaps;
+  base::FilePath path(base::StringPrintf("/proc/%d/smaps", sample->pid));
+  if (!base::ReadFileToString(path, &smaps))
+    return;
+
+  static const struct {
+    const char* prefix;
+    size_t Memory_Sample::*field;
+  } kFields[] = {
+    { "Rss:", &Memory_Sample::rss },
+    { "Pss:", &Memory_Sample::pss },
+    { "Private_Dirty:", &Memory_Sample::private_dirty },
+  };
+
+  std::vector<std::string> lines;
+  base::SplitString(smaps, '\n', &lines);
+  for (size_t i = 0; i < lines.size(); ++i) {
+    for (size_t f = 0; f < arraysize(kFields); ++f) {
+      if (lines[i].compare(0, strlen(kFields[f].prefix), kFields[f].prefix))
+        continue;
+      std::vector<std::string> tokens;
+      base::SplitStringAlongWhitespace(lines[i], &tokens);
+      unsigned kb = 0;
+      if (tokens.size() >= 2 && base::StringToUint(tokens[1], &kb))
+        sample->*kFields[f].field += kb;
+      break;
+    }
+  }
+}
+
+std::vector<Memory_Sample> ReadProcessMemory(
+    std::vector<Memory_Sample> samples) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::FILE));
+  for (size_t i = 0; i < samples.size(); ++i) {
+    samples[i].time = base::Time::Now().ToDoubleT();
+    ReadSmaps(&samples[i]);
+  }
+  return samples;
+}
+
+const char* ProcessTypeName(tizen_webview::Process_Type type) {
+  switch (type) {
+    case tizen_webview::TW_PROCESS_TYPE_BROWSER:
+      return "browser";
+    case tizen_webview::TW_PROCESS_TYPE_RENDERER:
+      return "renderer";
+    case tizen_webview::TW_PROCESS_TYPE_GPU:
+      return "gpu";
+  }
+  return "unknown";
+}
+
+void AppendToDump(const base::FilePath& path,
+                  const std::vector<Memory_Sample>& samples) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::FILE));
+  bool exists = base::PathExists(path);
+  std::string csv;
+  if (!exists) {
+    csv = "time,process,pid,rss_kb,pss_kb,private_dirty_kb,"
+          "web_cache_kb,v8_heap_used_kb,v8_heap_total_kb\n";
+  }
+  for (size_t i = 0; i < samples.size(); ++i) {
+    const Memory_Sample& s = samples[i];
+    base::StringAppendF(&csv,
+        "%.3f,%s,%d,%" PRIuS ",%" PRIuS ",%" PRIuS ",%" PRIuS ",%" PRIuS
+        ",%" PRIuS "\n",
+        s.time, ProcessTypeName(s.process_type), s.pid, s.rss, s.pss,
+        s.private_dirty, s.web_cache, s.v8_heap_used, s.v8_heap_total);
+  }
+
+  int written = exists ?
+      (base::AppendToFile(path, csv.data(), csv.size()) ? csv.size() : -1) :
+      base::WriteFile(path, csv.data(), csv.size());
+  if (written != static_cast<int>(csv.size()))
+    LOG(ERROR) << "[MemorySampler] Can not write to " << path.value();
+}
+
+}  // namespace
+
+MemorySamplerEfl::RendererUsage::RendererUsage()
+    : web_cache(0),
+      v8_heap_used(0),
+      v8_heap_total(0) {
+}
+
+MemorySamplerEfl::MemorySamplerEfl(content::BrowserContext* browser_context)
+    : browser_context_(browser_context),
+      sampling_(false),
+      weak_factory_(this) {
+}
+
+MemorySamplerEfl::~MemorySamplerEfl() {
+}
+
+void MemorySamplerEfl::Start(double interval_seconds) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  if (interval_seconds <= 0)
+    interval_seconds = 1;
+
+  timer_.Start(FROM_HERE,
+               base::TimeDelta::FromMilliseconds(interval_seconds * 1000),
+               this, &MemorySamplerEfl::TakeSample);
+  TakeSample();
+}
+
+void MemorySamplerEfl::Stop() {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  timer_.Stop();
+}
+
+void MemorySamplerEfl::SetDumpPath(const base::FilePath& path) {
+  dump_path_ = path;
+}
+
+void MemorySamplerEfl::GetUsage(
+    tizen_webview::Context_Memory_Usage_Get_Callback callback,
+    void* user_data) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  Request request = { callback, user_data };
+  requests_.push_back(request);
+
+  if (!IsRunning()) {
+    TakeSample();
+    return;
+  }
+  // Never call back from within the request.
+  BrowserThread::PostTask(BrowserThread::UI, FROM_HERE,
+      base::Bind(&MemorySamplerEfl::DeliverSamples,
+                 weak_factory_.GetWeakPtr()));
+}
+
+// static
+void MemorySamplerEfl::RendererUsageReceived(int render_process_id,
+                                             int64 web_cache_bytes,
+                                             int64 v8_heap_used_bytes,
+                                             int64 v8_heap_total_bytes) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  content::RenderProcessHost* host =
+      content::RenderProcessHost::FromID(render_process_id);
+  if (!host)
+    return;
+
+  EWebContext* web_context = static_cast<content::BrowserContextEfl*>(
+      host->GetBrowserContext())->WebContext();
+  if (!web_context)
+    return;
+
+  RendererUsage usage;
+  usage.web_cache = web_cache_bytes / 1024;
+  usage.v8_heap_used = v8_heap_used_bytes / 1024;
+  usage.v8_heap_total = v8_heap_total_bytes / 1024;
+  web_context->memory_sampler()->OnRendererUsage(render_process_id, usage);
+}
+
+void MemorySamplerEfl::TakeSample() {
+  // A slow sample is not stacked onto, the tick is skipped.
+  if (sampling_)
+    return;
+  sampling_ = true;
+
+  pending_sample_.clear();
+  renderer_pids_.clear();
+  awaited_renderers_.clear();
+
+  // The GPU runs in the browser process, its memory is counted there.
+  pending_sample_.push_back(NewSample(tizen_webview::TW_PROCESS_TYPE_BROWSER,
+                                      base::GetCurrentProcId()));
+
+  for (content::RenderProcessHost::iterator i(
+          content::RenderProcessHost::AllHostsIterator());
+       !i.IsAtEnd(); i.Advance()) {
+    content::RenderProcessHost* host = i.GetCurrentValue();
+    if (host->GetBrowserContext() != browser_context_ ||
+        host->GetHandle() == base::kNullProcessHandle)
+      continue;
+    renderer_pids_[host->GetID()] = base::GetProcId(host->GetHandle());
+    awaited_renderers_.insert(host->GetID());
+    host->Send(new EwkViewMsg_GetMemoryUsage());
+  }
+
+  if (awaited_renderers_.empty()) {
+    CollectProcessMemory();
+    return;
+  }
+  renderer_timeout_.Start(FROM_HERE,
+      base::TimeDelta::FromMilliseconds(kRendererReplyTimeoutMs),
+      this, &MemorySamplerEfl::CollectProcessMemory);
+}
+
+void MemorySamplerEfl::OnRendererUsage(int render_process_id,
+                                       const RendererUsage& usage) {
+  renderer_usage_[render_process_id] = usage;
+  if (awaited_renderers_.erase(render_process_id) &&
+      awaited_renderers_.empty())
+    CollectProcessMemory();
+}
+
+void MemorySamplerEfl::CollectProcessMemory() {
+  renderer_timeout_.Stop();
+  awaited_renderers_.clear();
+
+  std::map<int, RendererUsage> alive_usage;
+  for (std::map<int, int>::const_iterator it = renderer_pids_.begin();
+       it != renderer_pids_.end(); ++it) {
+    const RendererUsage& usage = renderer_usage_[it->first];
+    Memory_Sample sample =
+        NewSample(tizen_webview::TW_PROCESS_TYPE_RENDERER, it->second);
+    sample.web_cache = usage.web_cache;
+    sample.v8_heap_used = usage.v8_heap_used;
+    sample.v8_heap_total = usage.v8_heap_total;
+    pending_sample_.push_back(sample);
+    alive_usage[it->first] = usage;
+  }
+  // Forget renderers which are gone.
+  renderer_usage_.swap(alive_usage);
+
+  BrowserThread::PostTaskAndReplyWithResult(
+      BrowserThread::FILE, FROM_HERE,
+      base::Bind(&ReadProcessMemory, pending_sample_),
+      base::Bind(&MemorySamplerEfl::SampleTaken,
+                 weak_factory_.GetWeakPtr()));
+}
+
+void MemorySamplerEfl::SampleTaken(const Samples& samples) {
+  sampling_ = false;
+
+  samples_.insert(samples_.end(), samples.begin(), samples.end());
+  while (samples_.size() > kMaxBufferedSamples)
+    samples_.pop_front();
+
+  if (!dump_path_.empty()) {
+    BrowserThread::PostTask(BrowserThread::FILE, FROM_HERE,
+        base::Bind(&AppendToDump, dump_path_, samples));
+  }
+
+  if (!IsRunning())
+    DeliverSamples();
+}
+
+void MemorySamplerEfl::DeliverSamples() {
+  if (requests_.empty())
+    return;
+
+  Samples samples(samples_.begin(), samples_.end());
+  samples_.clear();
+  std::vector<Request> requests;
+  requests.swap(requests_);
+  for (size_t i = 0; i < requests.size(); ++i) {
+    requests[i].callback(samples.empty() ? NULL : &samples[0],
+                         samples.size(), requests[i].user_data);
+  }
+}
@@ -0,0 +1,97 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MEMORY_SAMPLER_EFL_H_
+#define MEMORY_SAMPLER_EFL_H_
+
+#include <deque>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/files/file_path.h"
+#include "base/memory/weak_ptr.h"
+#include "base/timer/timer.h"
+#include "tizen_webview/public/tw_callbacks.h"
+#include "tizen_webview/public/tw_memory_sample.h"
+
+namespace content {
+class BrowserContext;
+}
+
+// Periodically samples the memory use of the browser and the renderers of
+// one context: RSS, PSS and private dirty pages from /proc, and the Blink
+// memory cache and V8 heap each renderer reports. The GPU runs in the
+// browser process and is counted with it.
+// Samples are buffered until the embedder fetches them and are optionally
+// appended to a CSV file. Lives on the UI thread.
+class MemorySamplerEfl {
+ public:
+  explicit MemorySamplerEfl(content::BrowserContext* browser_context);
+  ~MemorySamplerEfl();
+
+  void Start(double interval_seconds);
+  void Stop();
+  bool IsRunning() const { return timer_.IsRunning(); }
+
+  // Every sample is appended to |path| as well, an empty path stops it.
+  void SetDumpPath(const base::FilePath& path);
+
+  // Calls |callback| with the samples taken since the previous call. If the
+  // sampler is not running a sample is taken first.
+  void GetUsage(tizen_webview::Context_Memory_Usage_Get_Callback callback,
+                void* user_data);
+
+  // Called with the figures of EwkHostMsg_MemoryUsage.
+  static void RendererUsageReceived(int render_process_id,
+                                    int64 web_cache_bytes,
+                                    int64 v8_heap_used_bytes,
+                                    int64 v8_heap_total_bytes);
+
+ private:
+  struct Request {
+    tizen_webview::Context_Memory_Usage_Get_Callback callback;
+    void* user_data;
+  };
+
+  struct RendererUsage {
+    RendererUsage();
+
+    size_t web_cache;
+    size_t v8_heap_used;
+    size_t v8_heap_total;
+  };
+
+  typedef std::vector<tizen_webview::Memory_Sample> Samples;
+
+  void TakeSample();
+  void OnRendererUsage(int render_process_id, const RendererUsage& usage);
+  // Reads /proc once the renderers answered, or gave up answering.
+  void CollectProcessMemory();
+  void SampleTaken(const Samples& samples);
+  void DeliverSamples();
+
+  content::BrowserContext* browser_context_;
+  base::RepeatingTimer<MemorySamplerEfl> timer_;
+  base::OneShotTimer<MemorySamplerEfl> renderer_timeout_;
+  base::FilePath dump_path_;
+
+  // Processes of the sample being taken, renderers by their process id.
+  bool sampling_;
+  Samples pending_sample_;
+  std::map<int, int> renderer_pids_;
+  std::set<int> awaited_renderers_;
+  std::map<int, RendererUsage> renderer_usage_;
+
+  // Samples not fetched yet, the oldest are dropped past a limit.
+  std::deque<tizen_webview::Memory_Sample> samples_;
+  std::vector<Request> requests_;
+
+  base::WeakPtrFactory<MemorySamplerEfl> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(MemorySamplerEfl);
+};
+
+#endif  // MEMORY_SAMPLER_EFL_H_
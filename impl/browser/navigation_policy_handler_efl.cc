@@ -6,17 +6,24 @@
 #include "common/render_messages_efl.h"
 
 #include "content/browser/renderer_host/render_view_host_delegate.h"
+#include "content/public/browser/render_process_host.h"
 #include "content/public/browser/render_view_host.h"
 #include "ipc/ipc_message.h"
 
 NavigationPolicyHandlerEfl::NavigationPolicyHandlerEfl(content::RenderViewHost* rvh, const NavigationPolicyParams& params)
     : rvh_(rvh),
       decision_(Undecied),
+      deferred_(false),
+      reply_request_id_(-1),
+      reply_process_id_(0),
+      reply_routing_id_(0),
       params_(params) {
   DCHECK(rvh);
 }
 
 NavigationPolicyHandlerEfl::~NavigationPolicyHandlerEfl() {
+  // Do not leave the renderer waiting for a decision that will never come.
+  SetDecision(Unhandled);
 }
 
 void NavigationPolicyHandlerEfl::DownloadNavigation() {
@@ -32,8 +39,31 @@ void NavigationPolicyHandlerEfl::DownloadNavigation() {
 bool NavigationPolicyHandlerEfl::SetDecision(NavigationPolicyHandlerEfl::Decision d) {
   if (decision_ == Undecied && d != Undecied) {
     decision_ = d;
+    SendReply();
     return true;
   }
 
   return false;
 }
+
+void NavigationPolicyHandlerEfl::ReplyWhenDecided(int request_id) {
+  DCHECK_EQ(reply_request_id_, -1);
+  deferred_ = true;
+  reply_request_id_ = request_id;
+  reply_process_id_ = rvh_->GetProcess()->GetID();
+  reply_routing_id_ = rvh_->GetRoutingID();
+  SendReply();
+}
+
+void NavigationPolicyHandlerEfl::SendReply() {
+  if (reply_request_id_ < 0 || decision_ == Undecied)
+    return;
+
+  content::RenderViewHost* rvh =
+      content::RenderViewHost::FromID(reply_process_id_, reply_routing_id_);
+  if (rvh) {
+    rvh->Send(new EwkViewMsg_NavigationPolicyDecided(
+        reply_routing_id_, reply_request_id_, decision_ == Handled));
+  }
+  reply_request_id_ = -1;
+}
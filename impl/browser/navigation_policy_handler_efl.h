@@ -28,10 +28,24 @@ class NavigationPolicyHandlerEfl {
   void DownloadNavigation();
   Decision GetDecision() const { return decision_; }
   bool SetDecision(Decision);
+  // Sends the decision for the deferred navigation |request_id| to the
+  // renderer as soon as it is made. A decision which is never made lets
+  // the navigation through.
+  void ReplyWhenDecided(int request_id);
+  // Whether ReplyWhenDecided() was called, otherwise the renderer is blocked
+  // until the decision is read with GetDecision().
+  bool IsDeferred() const { return deferred_; }
 
  private:
+  void SendReply();
+
   content::RenderViewHost* rvh_;
   Decision decision_;
+  bool deferred_;
+  int reply_request_id_;
+  // The host may be gone by the time a suspended decision is made.
+  int reply_process_id_;
+  int reply_routing_id_;
   NavigationPolicyParams params_;
 };
 
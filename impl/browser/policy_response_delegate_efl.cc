@@ -5,36 +5,14 @@
 #include "browser/policy_response_delegate_efl.h"
 
 #include "API/ewk_policy_decision_private.h"
+#include "browser/response_policy_filter_efl.h"
 #include "content/public/browser/browser_thread.h"
-#include "content/public/browser/render_view_host.h"
-#include "content/public/browser/render_frame_host.h"
-#include "content/public/browser/resource_dispatcher_host.h"
 #include "content/public/browser/resource_request_info.h"
-#include "content/public/browser/web_contents.h"
 
 #include "web_contents_delegate_efl.h"
-#include "common/web_contents_utils.h"
 
 using content::BrowserThread;
-using content::RenderViewHost;
-using content::RenderFrameHost;
-using content::ResourceDispatcherHost;
 using content::ResourceRequestInfo;
-using content::WebContents;
-
-using web_contents_utils::WebContentsFromFrameID;
-
-namespace {
-
-static content::WebContentsDelegateEfl* WebContentsDelegateFromFrameId(int render_process_id, int render_frame_id) {
-  WebContents* web_contents = WebContentsFromFrameID(render_process_id, render_frame_id);
-  if (!web_contents)
-    return NULL;
-
-  return static_cast<content::WebContentsDelegateEfl*>(web_contents->GetDelegate());
-}
-
-}
 
 PolicyResponseDelegateEfl::PolicyResponseDelegateEfl(net::URLRequest* request,
     const net::CompletionCallback& callback,
@@ -44,6 +22,7 @@ PolicyResponseDelegateEfl::PolicyResponseDelegateEfl(net::URLRequest* request,
       render_process_id_(0),
       render_frame_id_(0),
       render_view_id_(0),
+      deferred_since_(base::TimeTicks::Now()),
       processed_(false) {
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
 
@@ -63,6 +42,7 @@ PolicyResponseDelegateEfl::PolicyResponseDelegateEfl(net::URLRequest* request,
    */
   //DCHECK(render_process_id_ > 0);
   //DCHECK(render_frame_id_ > 0 || render_view_id_ > 0);
+  view_ = WebViewRegistryEfl::GetInstance()->Lookup(render_process_id_, render_frame_id_);
   BrowserThread::PostTask(BrowserThread::UI, FROM_HERE,
         base::Bind(&PolicyResponseDelegateEfl::HandlePolicyResponseOnUIThread, this));
 }
@@ -72,8 +52,8 @@ void PolicyResponseDelegateEfl::HandlePolicyResponseOnUIThread() {
   DCHECK(policy_decision_.get());
 
   policy_decision_->GetImpl()->InitializeOnUIThread();
-  // Delegate may be retrieved ONLY on UI thread
-  content::WebContentsDelegateEfl *delegate = WebContentsDelegateFromFrameId(render_process_id_, render_frame_id_);
+  // View handle may be dereferenced ONLY on UI thread
+  content::WebContentsDelegateEfl *delegate = view_.Get();
   if (!delegate) {
     UseResponse();
     return;
@@ -100,6 +80,8 @@ void PolicyResponseDelegateEfl::UseResponseOnIOThread() {
   if (processed_)
     return;
 
+  ResponsePolicyFilterEfl::GetInstance()->RecordDeferral(
+      base::TimeTicks::Now() - deferred_since_);
   callback_.Run(net::OK);
   processed_ = true;
 }
@@ -109,6 +91,8 @@ void PolicyResponseDelegateEfl::IgnoreResponseOnIOThread() {
   if (processed_)
     return;
 
+  ResponsePolicyFilterEfl::GetInstance()->RecordDeferral(
+      base::TimeTicks::Now() - deferred_since_);
   callback_.Run(net::ERR_BLOCKED_BY_CLIENT);
   processed_ = true;
 }
@@ -6,6 +6,8 @@
 #define POLICY_RESPONSE_DELEGATE_EFL_H_
 
 #include "base/memory/ref_counted.h"
+#include "base/time/time.h"
+#include "browser/web_view_registry_efl.h"
 #include "net/base/completion_callback.h"
 #include "url/gurl.h"
 
@@ -43,6 +45,9 @@ class PolicyResponseDelegateEfl: public base::RefCountedThreadSafe<PolicyRespons
   int render_process_id_;
   int render_frame_id_;
   int render_view_id_;
+  // Resolved on the IO thread, where the request lives.
+  WebViewRegistryEfl::Handle view_;
+  base::TimeTicks deferred_since_;
   // Should be accessed only on IO thread.
   bool processed_;
 };
@@ -0,0 +1,108 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "browser/renderer_host/frame_timing_recorder_efl.h"
+
+#include "base/debug/trace_event.h"
+#include "base/logging.h"
+
+namespace content {
+
+namespace {
+
+double ToSeconds(const base::TimeTicks& time) {
+  return (time - base::TimeTicks()).InSecondsF();
+}
+
+} // namespace
+
+FrameTimingRecorderEfl::FrameTimingRecorderEfl(size_t capacity)
+    : frames_(capacity),
+      next_index_(0),
+      frame_count_(0),
+      has_pending_frame_(false),
+      pending_dropped_frames_(0),
+      frame_sequence_(0) {
+  DCHECK(capacity);
+}
+
+void FrameTimingRecorderEfl::OnFrameSwapped() {
+  // A frame that was swapped but never presented has been superseded.
+  if (has_pending_frame_) {
+    ++pending_dropped_frames_;
+    TRACE_EVENT_ASYNC_END1("efl", "FrameTimingRecorderEfl::Frame",
+                           frame_sequence_, "dropped", true);
+  }
+
+  ++frame_sequence_;
+  TRACE_EVENT_ASYNC_BEGIN0("efl", "FrameTimingRecorderEfl::Frame",
+                           frame_sequence_);
+  has_pending_frame_ = true;
+  pending_swap_time_ = base::TimeTicks::Now();
+  pending_paint_duration_ = base::TimeDelta();
+}
+
+void FrameTimingRecorderEfl::OnPaintBegin() {
+  paint_begin_time_ = base::TimeTicks::Now();
+  if (has_pending_frame_) {
+    TRACE_EVENT_ASYNC_STEP_INTO0("efl", "FrameTimingRecorderEfl::Frame",
+                                 frame_sequence_, "Paint");
+  }
+}
+
+void FrameTimingRecorderEfl::OnPaintEnd() {
+  if (paint_begin_time_.is_null())
+    return;
+  pending_paint_duration_ += base::TimeTicks::Now() - paint_begin_time_;
+  paint_begin_time_ = base::TimeTicks();
+}
+
+void FrameTimingRecorderEfl::OnFramePresented() {
+  if (!has_pending_frame_)
+    return;
+
+  base::TimeTicks present_time = base::TimeTicks::Now();
+
+  tizen_webview::Frame_Timing& frame = frames_[next_index_];
+  frame.swap_time = ToSeconds(pending_swap_time_);
+  frame.present_time = ToSeconds(present_time);
+  frame.paint_duration = pending_paint_duration_.InSecondsF();
+  frame.dropped_frames = pending_dropped_frames_;
+
+  next_index_ = (next_index_ + 1) % frames_.size();
+  if (frame_count_ < frames_.size())
+    ++frame_count_;
+
+  TRACE_EVENT_ASYNC_END2("efl", "FrameTimingRecorderEfl::Frame",
+                         frame_sequence_,
+                         "paint_us", pending_paint_duration_.InMicroseconds(),
+                         "swap_to_present_us",
+                         (present_time - pending_swap_time_).InMicroseconds());
+  TRACE_COUNTER_ID1("efl", "FrameTimingRecorderEfl::DroppedFrames", this,
+                    pending_dropped_frames_);
+
+  has_pending_frame_ = false;
+  pending_dropped_frames_ = 0;
+  pending_paint_duration_ = base::TimeDelta();
+}
+
+void FrameTimingRecorderEfl::GetTimings(
+    std::vector<tizen_webview::Frame_Timing>* timings) const {
+  DCHECK(timings);
+  timings->clear();
+  timings->reserve(frame_count_);
+  size_t first = (next_index_ + frames_.size() - frame_count_) % frames_.size();
+  for (size_t i = 0; i < frame_count_; ++i)
+    timings->push_back(frames_[(first + i) % frames_.size()]);
+}
+
+void FrameTimingRecorderEfl::Clear() {
+  next_index_ = 0;
+  frame_count_ = 0;
+  has_pending_frame_ = false;
+  pending_dropped_frames_ = 0;
+  pending_paint_duration_ = base::TimeDelta();
+}
+
+} // namespace content
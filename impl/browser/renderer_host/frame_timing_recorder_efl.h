@@ -0,0 +1,55 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FRAME_TIMING_RECORDER_EFL_H
+#define FRAME_TIMING_RECORDER_EFL_H
+
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/time/time.h"
+#include "tizen_webview/public/tw_frame_timing.h"
+
+namespace content {
+
+// Records swap, paint and present timestamps of the frames shown by
+// RenderWidgetHostViewEfl in a fixed size ring buffer. Every presented
+// frame is also emitted as trace events, category "efl".
+class FrameTimingRecorderEfl {
+ public:
+  explicit FrameTimingRecorderEfl(size_t capacity = kDefaultCapacity);
+
+  // A new frame arrived from the GPU process.
+  void OnFrameSwapped();
+  // PaintTextureToSurface started / finished for the pending frame.
+  void OnPaintBegin();
+  void OnPaintEnd();
+  // Evas finished rendering, the pending frame is on screen.
+  void OnFramePresented();
+
+  // Copies recorded frames, oldest first.
+  void GetTimings(std::vector<tizen_webview::Frame_Timing>* timings) const;
+  void Clear();
+
+  static const size_t kDefaultCapacity = 120;
+
+ private:
+  std::vector<tizen_webview::Frame_Timing> frames_;
+  size_t next_index_;
+  size_t frame_count_;
+
+  bool has_pending_frame_;
+  unsigned pending_dropped_frames_;
+  // Identifies the pending frame in trace events.
+  int64 frame_sequence_;
+  base::TimeTicks pending_swap_time_;
+  base::TimeTicks paint_begin_time_;
+  base::TimeDelta pending_paint_duration_;
+
+  DISALLOW_COPY_AND_ASSIGN(FrameTimingRecorderEfl);
+};
+
+} // namespace content
+
+#endif // FRAME_TIMING_RECORDER_EFL_H
@@ -4,17 +4,39 @@
 
 #include "browser/renderer_host/render_message_filter_efl.h"
 
-#include "common/web_contents_utils.h"
+#include "browser/memory_sampler_efl.h"
+#include "browser/web_view_registry_efl.h"
 #include "common/render_messages_efl.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/render_view_host.h"
 #include "content/public/browser/web_contents.h"
+#include "memory_purger.h"
 #include "net/url_request/url_request_context_getter.h"
 #include "web_contents_delegate_efl.h"
 
-using web_contents_utils::WebContentsFromViewID;
 using content::BrowserThread;
 
+namespace {
+
+void DecideNavigationPolicyOnUIThread(scoped_refptr<RenderMessageFilterEfl> filter,
+                                      const WebViewRegistryEfl::Handle& view,
+                                      int request_id,
+                                      const NavigationPolicyParams& params) {
+  if (content::WebContentsDelegateEfl* delegate = view.Get()) {
+    // the decision replies once it is made
+    delegate->web_view()->InvokePolicyNavigationCallbackAsync(
+        delegate->web_contents().GetRenderViewHost(), params, request_id);
+    return;
+  }
+
+  // The renderer holds the navigation back until it gets an answer, let it
+  // through like the sync path does.
+  filter->Send(new EwkViewMsg_NavigationPolicyDecided(
+      params.render_view_id, request_id, false));
+}
+
+} // namespace
+
 RenderMessageFilterEfl::RenderMessageFilterEfl(int render_process_id)
   : BrowserMessageFilter(ChromeMsgStart)
   , render_process_id_(render_process_id) {
@@ -36,6 +58,9 @@ bool RenderMessageFilterEfl::OnMessageReceived(const IPC::Message& message) {
   bool handled = true;
   IPC_BEGIN_MESSAGE_MAP(RenderMessageFilterEfl, message)
     IPC_MESSAGE_HANDLER(EwkHostMsg_DecideNavigationPolicy, OnDecideNavigationPolicy)
+    IPC_MESSAGE_HANDLER(EwkHostMsg_DecideNavigationPolicyAsync, OnDecideNavigationPolicyAsync)
+    IPC_MESSAGE_HANDLER(EwkHostMsg_MemoryPurged, OnMemoryPurged)
+    IPC_MESSAGE_HANDLER(EwkHostMsg_MemoryUsage, OnMemoryUsage)
     IPC_MESSAGE_UNHANDLED(handled = false)
   IPC_END_MESSAGE_MAP()
   return handled;
@@ -44,12 +69,43 @@ bool RenderMessageFilterEfl::OnMessageReceived(const IPC::Message& message) {
 void RenderMessageFilterEfl::OnDecideNavigationPolicy(NavigationPolicyParams params, bool* handled) {
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
 
-  if (content::WebContents* web_contents =
-      WebContentsFromViewID(render_process_id_, params.render_view_id)) {
-    content::WebContentsDelegateEfl* delegate =
-    static_cast<content::WebContentsDelegateEfl*>(web_contents->GetDelegate());
+  if (content::WebContentsDelegateEfl* delegate = WebViewRegistryEfl::GetInstance()->
+      Lookup(render_process_id_, params.render_view_id).Get()) {
     // delegate replies directly
-    delegate->web_view()->InvokePolicyNavigationCallback(web_contents->GetRenderViewHost(), params, handled);
+    delegate->web_view()->InvokePolicyNavigationCallback(
+        delegate->web_contents().GetRenderViewHost(), params, handled);
+  }
+}
+
+void RenderMessageFilterEfl::OnDecideNavigationPolicyAsync(int request_id,
+                                                           NavigationPolicyParams params) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+
+  WebViewRegistryEfl::Handle view = WebViewRegistryEfl::GetInstance()->Lookup(
+      render_process_id_, params.render_view_id);
+  // The renderer may not have heard yet that the application stopped
+  // deciding, let the navigation go without a round trip to the UI thread.
+  if (view.settings() && !view.settings()->navigation_policy_enabled) {
+    Send(new EwkViewMsg_NavigationPolicyDecided(params.render_view_id,
+                                                request_id, false));
+    return;
   }
+
+  // Resolve the view here, the UI thread only has to dereference it.
+  BrowserThread::PostTask(BrowserThread::UI, FROM_HERE,
+      base::Bind(&DecideNavigationPolicyOnUIThread,
+                 make_scoped_refptr(this), view, request_id, params));
 }
 
+void RenderMessageFilterEfl::OnMemoryPurged(int64 bytes) {
+  MemoryPurger::ReportReclaimed(MemoryPurger::STEP_RENDERER, bytes);
+}
+
+void RenderMessageFilterEfl::OnMemoryUsage(int64 web_cache_bytes,
+                                           int64 v8_heap_used_bytes,
+                                           int64 v8_heap_total_bytes) {
+  BrowserThread::PostTask(BrowserThread::UI, FROM_HERE,
+      base::Bind(&MemorySamplerEfl::RendererUsageReceived,
+                 render_process_id_, web_cache_bytes, v8_heap_used_bytes,
+                 v8_heap_total_bytes));
+}
@@ -34,8 +34,12 @@ class RenderMessageFilterEfl : public content::BrowserMessageFilter {
 
  private:
   void OnDecideNavigationPolicy(NavigationPolicyParams, bool* handled);
+  void OnDecideNavigationPolicyAsync(int request_id, NavigationPolicyParams);
   void OnReceivedHitTestData(int view, const _Ewk_Hit_Test& hit_test_data,
       const NodeAttributesMap& node_attributes);
+  void OnMemoryPurged(int64 bytes);
+  void OnMemoryUsage(int64 web_cache_bytes, int64 v8_heap_used_bytes,
+                     int64 v8_heap_total_bytes);
 
   int render_process_id_;
 };
@@ -12,10 +12,12 @@
 #include "base/command_line.h"
 #include "base/debug/trace_event.h"
 #include "base/message_loop/message_loop.h"
+#include "base/metrics/histogram.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/logging.h"
 #include "base/strings/utf_string_conversions.h"
 #include "browser/disambiguation_popup_efl.h"
+#include "browser/renderer_host/frame_timing_recorder_efl.h"
 #include "browser/renderer_host/im_context_efl.h"
 #include "browser/renderer_host/scroll_detector.h"
 #include "browser/renderer_host/web_event_factory_efl.h"
@@ -105,7 +107,11 @@ RenderWidgetHostViewEfl::RenderWidgetHostViewEfl(RenderWidgetHost* widget, EWebV
     next_pixmap_id_(0),
     surface_id_(0),
     is_hw_accelerated_(true),
-    is_modifier_key_(false) {
+    is_modifier_key_(false),
+    is_presenting_directly_(false),
+    direct_presentation_unsupported_(false),
+    last_presented_pixel_count_(0) {
+  memset(&evas_gl_native_surface_, 0, sizeof(evas_gl_native_surface_));
 
 #if defined(OS_TIZEN)
 #if !defined(EWK_BRINGUP)
@@ -134,6 +140,7 @@ RenderWidgetHostViewEfl::RenderWidgetHostViewEfl(RenderWidgetHost* widget, EWebV
 }
 
 RenderWidgetHostViewEfl::~RenderWidgetHostViewEfl() {
+  SetFrameTimingEnabled(false);
   if (im_context_)
     delete im_context_;
 }
@@ -289,12 +296,30 @@ void RenderWidgetHostViewEfl::PaintTextureToSurface(GLuint texture_id) {
   Evas_GL_API* gl_api = evasGlApi();
   DCHECK(gl_api);
 
+  EnsureEvasGLSurface();
+  if (!evas_gl_surface_)
+    return;
+
   evas_gl_make_current(evas_gl_, evas_gl_surface_, evas_gl_context_);
 
   GL_CHECK_STATUS("GL error before texture paint.");
 
   gfx::Rect bounds = GetViewBoundsInPix();
+  gfx::Rect damage = gfx::IntersectRects(pending_damage_rect_,
+                                         gfx::Rect(bounds.size()));
+  bool partial = !damage.IsEmpty() && damage.size() != bounds.size();
+
   GL_CHECK(gl_api->glViewport(0, 0, bounds.width(), bounds.height()));
+  if (partial) {
+    // Only the damaged region changed, the rest of the surface still holds
+    // the previous frame. Scissor is in GL coordinates, origin bottom left.
+    GL_CHECK(gl_api->glEnable(GL_SCISSOR_TEST));
+    GL_CHECK(gl_api->glScissor(damage.x(),
+                               bounds.height() - damage.bottom(),
+                               damage.width(), damage.height()));
+  } else {
+    damage = gfx::Rect(bounds.size());
+  }
   GL_CHECK(gl_api->glClearColor(1.0, 1.0, 1.0, 1.0));
   GL_CHECK(gl_api->glClear(GL_COLOR_BUFFER_BIT));
   GL_CHECK(gl_api->glUseProgram(program_id_));
@@ -330,13 +355,103 @@ void RenderWidgetHostViewEfl::PaintTextureToSurface(GLuint texture_id) {
   GL_CHECK(gl_api->glUniform1i(source_texture_location_, 0));
   GL_CHECK(gl_api->glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, NULL));
 
+  if (partial)
+    GL_CHECK(gl_api->glDisable(GL_SCISSOR_TEST));
+  RecordPresentedPixels(damage);
+
   GL_CHECK(gl_api->glBindTexture(GL_TEXTURE_2D, 0));
   evas_gl_make_current(evas_gl_, 0, 0);
 }
 
 void RenderWidgetHostViewEfl::EvasObjectImagePixelsGetCallback(void* data, Evas_Object* obj) {
   RenderWidgetHostViewEfl* rwhv_efl = reinterpret_cast<RenderWidgetHostViewEfl*>(data);
+  // Only paints for Evas count, not the ones done for readbacks.
+  if (rwhv_efl->frame_timing_recorder_)
+    rwhv_efl->frame_timing_recorder_->OnPaintBegin();
   rwhv_efl->PaintTextureToSurface(rwhv_efl->texture_id_);
+  if (rwhv_efl->frame_timing_recorder_)
+    rwhv_efl->frame_timing_recorder_->OnPaintEnd();
+}
+
+bool RenderWidgetHostViewEfl::CanPresentTextureDirectly(
+    const gfx::Size& texture_size) const {
+  // Evas samples a bound texture as is, so anything the blit path does on
+  // top of a plain copy (rotation, scaling) still has to go through it.
+  if (!texture_size.IsEmpty() &&
+      texture_size != GetViewBoundsInPix().size())
+    return false;
+  return ecore_evas_rotation_get(ecore_evas_ecore_evas_get(evas_)) == 0;
+}
+
+bool RenderWidgetHostViewEfl::PresentTextureDirectly(
+    GLuint texture_id, const gfx::Size& texture_size) {
+  if (!texture_id || direct_presentation_unsupported_ ||
+      !CanPresentTextureDirectly(texture_size))
+    return false;
+
+  gfx::Size size = texture_size.IsEmpty() ?
+      GetViewBoundsInPix().size() : texture_size;
+
+  Evas_Native_Surface native_surface;
+  memset(&native_surface, 0, sizeof(native_surface));
+  native_surface.version = EVAS_NATIVE_SURFACE_VERSION;
+  native_surface.type = EVAS_NATIVE_SURFACE_OPENGL;
+  native_surface.data.opengl.texture_id = texture_id;
+  native_surface.data.opengl.framebuffer_id = 0;
+  native_surface.data.opengl.internal_format = GL_RGBA;
+  native_surface.data.opengl.format = GL_RGBA;
+  native_surface.data.opengl.x = 0;
+  native_surface.data.opengl.y = 0;
+  native_surface.data.opengl.w = size.width();
+  native_surface.data.opengl.h = size.height();
+
+  // Evas keeps the previous native surface if it can not use the new one.
+  evas_object_image_pixels_get_callback_set(content_image_, NULL, NULL);
+  evas_object_image_native_surface_set(content_image_, &native_surface);
+  Evas_Native_Surface* bound =
+      evas_object_image_native_surface_get(content_image_);
+  if (!bound || bound->type != EVAS_NATIVE_SURFACE_OPENGL ||
+      bound->data.opengl.texture_id != texture_id) {
+    // Not tried again until the next surface.
+    LOG(WARNING) << "Direct texture presentation not supported, "
+                 << "falling back to Evas GL surface";
+    direct_presentation_unsupported_ = true;
+    PresentTextureThroughSurface();
+    return false;
+  }
+
+  is_presenting_directly_ = true;
+  return true;
+}
+
+void RenderWidgetHostViewEfl::PresentTextureThroughSurface() {
+  if (!evas_gl_native_surface_.version)
+    return;
+
+  evas_object_image_native_surface_set(content_image_, &evas_gl_native_surface_);
+  evas_object_image_pixels_get_callback_set(content_image_, EvasObjectImagePixelsGetCallback, this);
+  is_presenting_directly_ = false;
+}
+
+void RenderWidgetHostViewEfl::EvasRenderPostCallback(void* data, Evas*, void*) {
+  RenderWidgetHostViewEfl* rwhv_efl = static_cast<RenderWidgetHostViewEfl*>(data);
+  if (rwhv_efl->frame_timing_recorder_)
+    rwhv_efl->frame_timing_recorder_->OnFramePresented();
+}
+
+void RenderWidgetHostViewEfl::SetFrameTimingEnabled(bool enabled) {
+  if (enabled == !!frame_timing_recorder_)
+    return;
+
+  if (enabled) {
+    frame_timing_recorder_.reset(new FrameTimingRecorderEfl());
+    evas_event_callback_add(evas_, EVAS_CALLBACK_RENDER_POST,
+                            EvasRenderPostCallback, this);
+  } else {
+    evas_event_callback_del_full(evas_, EVAS_CALLBACK_RENDER_POST,
+                                 EvasRenderPostCallback, this);
+    frame_timing_recorder_.reset();
+  }
 }
 
 void RenderWidgetHostViewEfl::Init_EvasGL(int width, int height) {
@@ -359,6 +474,15 @@ void RenderWidgetHostViewEfl::Init_EvasGL(int width, int height) {
     LOG(ERROR) << "set_eweb_view -- Create evas gl context Fail";
   }
 
+  CreateEvasGLSurface(width, height);
+  PresentTextureThroughSurface();
+
+  initializeProgram();
+
+  m_IsEvasGLInit = 1;
+}
+
+bool RenderWidgetHostViewEfl::CreateEvasGLSurface(int width, int height) {
   if(width > MAX_SURFACE_WIDTH_EGL)
     width = MAX_SURFACE_WIDTH_EGL;
 
@@ -370,19 +494,53 @@ void RenderWidgetHostViewEfl::Init_EvasGL(int width, int height) {
     LOG(ERROR) << "set_eweb_view -- Create evas gl Surface Fail";
   } else {
     LOG(ERROR) << "set_eweb_view -- Create evas gl Surface Success";
+    evas_gl_surface_size_ = gfx::Size(width, height);
+    direct_presentation_unsupported_ = false;
   }
 
-  Evas_Native_Surface nativeSurface;
-  if (evas_gl_native_surface_get(evas_gl_, evas_gl_surface_, &nativeSurface)) {
-    evas_object_image_native_surface_set(content_image_, &nativeSurface);
-    evas_object_image_pixels_get_callback_set(content_image_, EvasObjectImagePixelsGetCallback, this);
-  } else {
+  if (!evas_gl_native_surface_get(evas_gl_, evas_gl_surface_, &evas_gl_native_surface_)) {
     LOG(ERROR) << "set_eweb_view -- Fail to get Natvie surface";
+    memset(&evas_gl_native_surface_, 0, sizeof(evas_gl_native_surface_));
+    return false;
   }
+  return true;
+}
 
-  initializeProgram();
+void RenderWidgetHostViewEfl::EnsureEvasGLSurface() {
+  if (!m_IsEvasGLInit || evas_gl_surface_)
+    return;
 
-  m_IsEvasGLInit = 1;
+  gfx::Rect bounds = GetViewBoundsInPix();
+  if (bounds.IsEmpty() || !CreateEvasGLSurface(bounds.width(), bounds.height()))
+    return;
+
+  // The last frame is still around, paint it into the new surface.
+  if (!is_presenting_directly_) {
+    PresentTextureThroughSurface();
+    evas_object_image_pixels_dirty_set(content_image_, true);
+  }
+}
+
+size_t RenderWidgetHostViewEfl::ReleaseHiddenGpuResources() {
+  if (!m_IsEvasGLInit || !evas_gl_surface_ || IsShowing())
+    return 0;
+
+  idle_frame_subscriber_textures_.clear();
+
+  if (!is_presenting_directly_) {
+    evas_object_image_pixels_get_callback_set(content_image_, NULL, NULL);
+    evas_object_image_native_surface_set(content_image_, NULL);
+  }
+  evas_gl_make_current(evas_gl_, 0, 0);
+  evas_gl_surface_destroy(evas_gl_, evas_gl_surface_);
+  evas_gl_surface_ = NULL;
+  memset(&evas_gl_native_surface_, 0, sizeof(evas_gl_native_surface_));
+
+  // RGBA color buffer plus the 24 bit depth and 8 bit stencil buffer, an
+  // estimate as drivers may pad or share them.
+  size_t freed = evas_gl_surface_size_.GetArea() * (4 + 4);
+  evas_gl_surface_size_ = gfx::Size();
+  return freed;
 }
 
 void RenderWidgetHostViewEfl::set_eweb_view(EWebView* view) {
@@ -416,9 +574,11 @@ bool RenderWidgetHostViewEfl::OnMessageReceived(const IPC::Message& message) {
     IPC_MESSAGE_HANDLER(EwkHostMsg_OrientationChangeEvent, OnOrientationChangeEvent)
     IPC_MESSAGE_HANDLER(EwkViewMsg_SelectionTextStyleState, OnSelectionTextStyleState)
     IPC_MESSAGE_HANDLER(EwkHostMsg_DidChangeMaxScrollOffset, OnDidChangeMaxScrollOffset)
+    IPC_MESSAGE_HANDLER(EwkHostMsg_DidChangeScrollOffset, OnDidChangeScrollOffset)
     IPC_MESSAGE_HANDLER(EwkHostMsg_ReadMHTMLData, OnMHTMLContentGet)
     IPC_MESSAGE_HANDLER(EwkHostMsg_DidChangePageScaleFactor, OnDidChangePageScaleFactor)
     IPC_MESSAGE_HANDLER(EwkHostMsg_DidChangePageScaleRange, OnDidChangePageScaleRange)
+    IPC_MESSAGE_HANDLER(EwkHostMsg_DidUpdateHitTestRegions, OnDidUpdateHitTestRegions)
 #if !defined(EWK_BRINGUP)
     IPC_MESSAGE_HANDLER(ViewHostMsg_TextInputInFormStateChanged, OnTextInputInFormStateChanged)
 #endif
@@ -497,9 +657,8 @@ void RenderWidgetHostViewEfl::SetBounds(const gfx::Rect& rect) {
 }
 
 gfx::Vector2dF RenderWidgetHostViewEfl::GetLastScrollOffset() const {
-  // FIXME: Aura RWHV sets last_scroll_offset_ in OnSwapCompositorFrame()
-  // Other ways to get scroll offset are already removed.
-  // We need to switch to the ui::Compositor ASAP!
+  // FIXME: Aura RWHV sets last_scroll_offset_ in OnSwapCompositorFrame(),
+  // until we switch to the ui::Compositor the renderer reports it itself.
   return last_scroll_offset_;
 }
 
@@ -525,9 +684,7 @@ gfx::NativeViewAccessible RenderWidgetHostViewEfl::GetNativeViewAccessible() {
 }
 
 bool RenderWidgetHostViewEfl::IsSurfaceAvailableForCopy() const {
-#warning "[M37] GetBackingStore does not exist. backing store removed from chromium"
-  //return !!host_->GetBackingStore(false);
-  return false;
+  return !current_mailbox_.IsZero();
 }
 
 void RenderWidgetHostViewEfl::Show() {
@@ -557,6 +714,7 @@ void RenderWidgetHostViewEfl::UnlockMouse() {
 }
 
 void RenderWidgetHostViewEfl::WasShown() {
+  EnsureEvasGLSurface();
   host_->WasShown(ui::LatencyInfo());
 }
 
@@ -751,14 +909,164 @@ void RenderWidgetHostViewEfl::GetSnapshotForRect(gfx::Rect& rect) {
 }
 #endif
 
+bool RenderWidgetHostViewEfl::ReadPixelsFromSurface(const gfx::Rect& rect,
+                                                    void* pixels,
+                                                    int stride) {
+  if (!m_IsEvasGLInit || rect.IsEmpty())
+    return false;
+
+  EnsureEvasGLSurface();
+  if (!evas_gl_surface_)
+    return false;
+
+  gfx::Rect bounds = GetViewBoundsInPix();
+  if (!gfx::Rect(bounds.size()).Contains(rect))
+    return false;
+
+  // With zero-copy presentation the Evas GL surface does not hold the
+  // frame, render it there first.
+  if (is_presenting_directly_) {
+    pending_damage_rect_ = gfx::Rect();
+    PaintTextureToSurface(texture_id_);
+  }
+
+  Evas_GL_API* gl_api = evasGlApi();
+  evas_gl_make_current(evas_gl_, evas_gl_surface_, evas_gl_context_);
+
+  const int row_bytes = rect.width() * 4;
+  scoped_ptr<GLubyte[]> bits(new GLubyte[row_bytes * rect.height()]);
+  GL_CHECK(gl_api->glReadPixels(rect.x(), bounds.height() - rect.bottom(),
+                                rect.width(), rect.height(),
+                                GL_BGRA, GL_UNSIGNED_BYTE, bits.get()));
+  evas_gl_make_current(evas_gl_, 0, 0);
+
+  // GL rows are bottom-up.
+  unsigned char* dst = static_cast<unsigned char*>(pixels);
+  for (int i = 0; i < rect.height(); ++i) {
+    memcpy(dst + i * stride,
+           bits.get() + (rect.height() - i - 1) * row_bytes, row_bytes);
+  }
+  return true;
+}
+
+void RenderWidgetHostViewEfl::CopyFromPresentedFrame(
+    const gfx::Rect& src_subrect,
+    const gfx::Size& dst_size,
+    const base::Callback<void(bool, const SkBitmap&)>& callback,
+    const SkColorType color_type) {
+  base::ScopedClosureRunner scoped_callback_runner(
+      base::Bind(callback, false, SkBitmap()));
+
+  if (current_mailbox_.IsZero() || dst_size.IsEmpty())
+    return;
+
+  gfx::Rect src = gfx::IntersectRects(src_subrect,
+                                      gfx::Rect(current_surface_size_));
+  if (src.IsEmpty())
+    return;
+
+  GLHelper* gl_helper = ImageTransportFactory::GetInstance()->GetGLHelper();
+  if (!gl_helper || !gl_helper->IsReadbackConfigSupported(color_type))
+    return;
+
+  scoped_ptr<SkBitmap> bitmap(new SkBitmap);
+  if (!bitmap->tryAllocPixels(SkImageInfo::Make(dst_size.width(),
+                                                dst_size.height(),
+                                                color_type,
+                                                kPremul_SkAlphaType)))
+    return;
+
+  scoped_ptr<SkAutoLockPixels> bitmap_pixels_lock(
+      new SkAutoLockPixels(*bitmap));
+  uint8* pixels = static_cast<uint8*>(bitmap->getPixels());
+
+  // The frame texture is bottom-up; the scaler flips it while scaling, so
+  // the source rect has to be given in GL coordinates.
+  gfx::Rect src_in_texture(src.x(),
+                           current_surface_size_.height() - src.bottom(),
+                           src.width(), src.height());
+
+  ignore_result(scoped_callback_runner.Release());
+  gl_helper->CropScaleReadbackAndCleanMailbox(
+      current_mailbox_,
+      0,
+      current_surface_size_,
+      src_in_texture,
+      dst_size,
+      pixels,
+      color_type,
+      base::Bind(&RenderWidgetHostViewEfl::CopyFromPresentedFrameFinished,
+                 callback,
+                 base::Passed(&bitmap),
+                 base::Passed(&bitmap_pixels_lock)),
+      GLHelper::SCALER_QUALITY_FAST);
+}
+
+// static
+void RenderWidgetHostViewEfl::CopyFromPresentedFrameFinished(
+    const base::Callback<void(bool, const SkBitmap&)>& callback,
+    scoped_ptr<SkBitmap> bitmap,
+    scoped_ptr<SkAutoLockPixels> bitmap_pixels_lock,
+    bool result) {
+  bitmap_pixels_lock.reset();
+  callback.Run(result, result ? *bitmap : SkBitmap());
+}
+
 void RenderWidgetHostViewEfl::CopyFromCompositingSurface(
   const gfx::Rect& src_subrect,
-  const gfx::Size& /* dst_size */,
+  const gfx::Size& dst_size,
   const base::Callback<void(bool, const SkBitmap&)>& callback,
   const SkColorType color_type) {
-  // FIXME: should find a way to do it effectively.
-#warning "[M37] host_ does not have GetSnapshotFromRenderer function anymore"
-  // host_->GetSnapshotFromRenderer(src_subrect, callback);
+  // There is no browser side cc::Layer tree to attach a cc::CopyOutputRequest
+  // to, the frame comes from the GPU process as a mailbox. Scale it down on
+  // the GPU so only |dst_size| pixels are read back.
+  if (!IsSurfaceAvailableForCopy()) {
+    callback.Run(false, SkBitmap());
+    return;
+  }
+
+  gfx::Rect src_subrect_in_pixel =
+      ConvertRectToPixel(device_scale_factor_, src_subrect);
+  if (src_subrect_in_pixel.IsEmpty())
+    src_subrect_in_pixel = gfx::Rect(current_surface_size_);
+  gfx::Size dst_size_in_pixel =
+      ConvertRectToPixel(device_scale_factor_, gfx::Rect(dst_size)).size();
+  if (dst_size_in_pixel.IsEmpty())
+    dst_size_in_pixel = src_subrect_in_pixel.size();
+
+  static int copy_request_id = 0;
+  int request_id = ++copy_request_id;
+  TRACE_EVENT_ASYNC_BEGIN2("efl",
+      "RenderWidgetHostViewEfl::CopyFromCompositingSurface", request_id,
+      "src_pixels", src_subrect_in_pixel.size().GetArea(),
+      "dst_pixels", dst_size_in_pixel.GetArea());
+
+  CopyFromPresentedFrame(src_subrect_in_pixel, dst_size_in_pixel,
+      base::Bind(&RenderWidgetHostViewEfl::CopyFromCompositingSurfaceFinished,
+                 AsWeakPtr(), callback, request_id, base::TimeTicks::Now()),
+      color_type);
+}
+
+// static
+void RenderWidgetHostViewEfl::CopyFromCompositingSurfaceFinished(
+    base::WeakPtr<RenderWidgetHostViewEfl> rwhvefl,
+    const base::Callback<void(bool, const SkBitmap&)>& callback,
+    int request_id,
+    base::TimeTicks start_time,
+    bool result,
+    const SkBitmap& bitmap) {
+  base::TimeDelta readback_time = base::TimeTicks::Now() - start_time;
+  TRACE_EVENT_ASYNC_END2("efl",
+      "RenderWidgetHostViewEfl::CopyFromCompositingSurface", request_id,
+      "success", result,
+      "readback_us", readback_time.InMicroseconds());
+  UMA_HISTOGRAM_TIMES("Efl.CopyFromCompositingSurface.ReadbackTime",
+                      readback_time);
+  if (!rwhvefl) {
+    callback.Run(false, SkBitmap());
+    return;
+  }
+  callback.Run(result, bitmap);
 }
 
 // CopyFromCompositingSurfaceToVideoFrame implementation borrowed from Aura port
@@ -991,17 +1299,7 @@ extern GLuint GetTextureIdFromTexture(gpu::gles2::Texture* texture);
 void RenderWidgetHostViewEfl::AcceleratedSurfaceBuffersSwapped(
   const GpuHostMsg_AcceleratedSurfaceBuffersSwapped_Params& params,
   int gpu_host_id) {
-
-  if (m_IsEvasGLInit) {
-    gpu::gles2::MailboxManager* manager =
-        GLSharedContextEfl::GetMailboxManager();
-
-    gpu::gles2::Texture* texture =
-        manager->ConsumeTexture(GL_TEXTURE_2D, params.mailbox);
-
-    texture_id_ = GetTextureIdFromTexture(texture);
-    evas_object_image_pixels_dirty_set(content_image_, true);
-  }
+  PresentMailbox(params.mailbox, params.size, gfx::Rect(params.size));
 
   AcceleratedSurfaceMsg_BufferPresented_Params ack_params;
   ack_params.sync_point = 0;
@@ -1012,7 +1310,67 @@ void RenderWidgetHostViewEfl::AcceleratedSurfaceBuffersSwapped(
 void RenderWidgetHostViewEfl::AcceleratedSurfacePostSubBuffer(
   const GpuHostMsg_AcceleratedSurfacePostSubBuffer_Params& params,
   int gpu_host_id) {
-  NOTIMPLEMENTED();
+  // Sub buffer rect comes in GL coordinates, origin at the bottom left.
+  gfx::Rect damage(params.x,
+                   params.surface_size.height() - params.y - params.height,
+                   params.width, params.height);
+  PresentMailbox(params.mailbox, params.surface_size, damage);
+
+  AcceleratedSurfaceMsg_BufferPresented_Params ack_params;
+  ack_params.sync_point = 0;
+  RenderWidgetHostImpl::AcknowledgeBufferPresent(
+    params.route_id, gpu_host_id, ack_params);
+}
+
+void RenderWidgetHostViewEfl::PresentMailbox(const gpu::Mailbox& mailbox,
+                                             const gfx::Size& surface_size,
+                                             const gfx::Rect& damage_rect) {
+  if (!m_IsEvasGLInit)
+    return;
+
+  gpu::gles2::MailboxManager* manager =
+      GLSharedContextEfl::GetMailboxManager();
+
+  gpu::gles2::Texture* texture =
+      manager->ConsumeTexture(GL_TEXTURE_2D, mailbox);
+
+  if (frame_timing_recorder_)
+    frame_timing_recorder_->OnFrameSwapped();
+
+  texture_id_ = GetTextureIdFromTexture(texture);
+  current_mailbox_ = mailbox;
+  current_surface_size_ = surface_size;
+
+  // Prefer handing the compositor texture straight to Evas; the Evas GL
+  // surface blit in PaintTextureToSurface costs a full-viewport draw.
+  if (!PresentTextureDirectly(texture_id_, surface_size) &&
+      is_presenting_directly_)
+    PresentTextureThroughSurface();
+
+  gfx::Rect bounds(GetViewBoundsInPix().size());
+  gfx::Rect damage = gfx::IntersectRects(damage_rect, bounds);
+  // Rotated output does not map damage one to one, repaint everything.
+  if (ecore_evas_rotation_get(ecore_evas_ecore_evas_get(evas_)) ||
+      damage.IsEmpty())
+    damage = bounds;
+
+  // Damage accumulates until Evas asks for the pixels, so swaps that land
+  // between two Evas renders are not lost.
+  pending_damage_rect_.Union(damage);
+
+  evas_object_image_pixels_dirty_set(content_image_, true);
+  evas_object_image_data_update_add(content_image_, damage.x(), damage.y(),
+                                    damage.width(), damage.height());
+
+  if (is_presenting_directly_)
+    RecordPresentedPixels(damage);
+}
+
+void RenderWidgetHostViewEfl::RecordPresentedPixels(const gfx::Rect& rect) {
+  last_presented_pixel_count_ = rect.size().GetArea();
+  TRACE_COUNTER_ID1("efl", "RenderWidgetHostViewEfl::PresentedPixels", this,
+                    last_presented_pixel_count_);
+  pending_damage_rect_ = gfx::Rect();
 }
 
 void RenderWidgetHostViewEfl::AcceleratedSurfaceSuspend() {
@@ -1072,6 +1430,7 @@ void RenderWidgetHostViewEfl::RenderProcessGone(base::TerminationStatus, int err
 }
 
 void RenderWidgetHostViewEfl::HandleShow() {
+  EnsureEvasGLSurface();
   host_->WasShown(ui::LatencyInfo());
 }
 
@@ -1455,6 +1814,10 @@ void RenderWidgetHostViewEfl::OnDidChangeMaxScrollOffset(int maxScrollX, int max
   scroll_detector_->SetMaxScroll(maxScrollX, maxScrollY);
 }
 
+void RenderWidgetHostViewEfl::OnDidChangeScrollOffset(int scrollX, int scrollY) {
+  last_scroll_offset_ = gfx::Vector2dF(scrollX, scrollY);
+}
+
 void RenderWidgetHostViewEfl::SelectRange(const gfx::Point& start, const gfx::Point& end) {
   RenderViewHost* rvh =  RenderViewHost::From(host_);
   WebContentsImpl* wci = static_cast<WebContentsImpl*>(
@@ -1479,6 +1842,13 @@ void RenderWidgetHostViewEfl::OnDidChangePageScaleRange(double min_scale, double
   eweb_view()->DidChangePageScaleRange(min_scale, max_scale);
 }
 
+void RenderWidgetHostViewEfl::OnDidUpdateHitTestRegions(const HitTestRegionsEfl& added,
+                                                        const std::vector<int>& removed_ids,
+                                                        bool replace,
+                                                        const gfx::Vector2d& scroll_offset) {
+  eweb_view()->UpdateHitTestRegions(added, removed_ids, replace, scroll_offset);
+}
+
 SelectionControllerEfl* RenderWidgetHostViewEfl::GetSelectionController() {
   return web_view_->GetSelectionController();
 }
@@ -51,6 +51,7 @@ class ScrollDetector;
 namespace content {
 
 class DisambiguationPopupEfl;
+class FrameTimingRecorderEfl;
 class IMContextEfl;
 class RenderWidgetHostImpl;
 class RenderWidgetHostView;
@@ -168,6 +169,7 @@ class RenderWidgetHostViewEfl
 
   void OnSelectionTextStyleState(const SelectionStylePrams& params);
   void OnDidChangeMaxScrollOffset(int maxScrollX, int maxScrollY);
+  void OnDidChangeScrollOffset(int scrollX, int scrollY);
 
 #ifdef OS_TIZEN
   void FilterInputMotion(const blink::WebGestureEvent& gesture_event);
@@ -185,6 +187,10 @@ class RenderWidgetHostViewEfl
   void set_magnifier(bool status);
 
   void Init_EvasGL(int width, int height);
+  // Frees the Evas GL surface of a hidden view, it is created again when the
+  // view is shown. Returns an estimate of the bytes freed, computed from the
+  // surface size and format, what the driver allocated on top is unknown.
+  size_t ReleaseHiddenGpuResources();
 
   void set_eweb_view(EWebView*);
   EWebView* eweb_view() const { return web_view_; }
@@ -216,7 +222,29 @@ class RenderWidgetHostViewEfl
   void MoveCaret(const gfx::Point& point);
   void OnMHTMLContentGet(const std::string& mhtml_content, int callback_id);
 
+  // Reads |rect| (view pixels, origin at the top left) of the presented
+  // frame into |pixels| as top-down rows of |stride| bytes. Blocks on the
+  // GPU, prefer CopyFromPresentedFrame.
+  bool ReadPixelsFromSurface(const gfx::Rect& rect, void* pixels, int stride);
+
+  // Asynchronously copies |src_subrect| (view pixels, origin at the top
+  // left) of the presented frame into a bitmap of |dst_size|. Scaling and
+  // the vertical flip are done on the GPU and the pixels come back through
+  // transfer buffers, so the calling thread never waits on glReadPixels.
+  void CopyFromPresentedFrame(
+      const gfx::Rect& src_subrect,
+      const gfx::Size& dst_size,
+      const base::Callback<void(bool, const SkBitmap&)>& callback,
+      const SkColorType color_type);
+
+  // Opt-in per frame timing, see FrameTimingRecorderEfl.
+  void SetFrameTimingEnabled(bool enabled);
+  FrameTimingRecorderEfl* frame_timing_recorder() const {
+    return frame_timing_recorder_.get();
+  }
+
   Evas_GL_API* evasGlApi() { return evas_gl_api_; }
+  int last_presented_pixel_count() const { return last_presented_pixel_count_; }
   gfx::Point ConvertPointInViewPix(gfx::Point point);
   gfx::Rect GetViewBoundsInPix() const;
 
@@ -234,6 +262,10 @@ class RenderWidgetHostViewEfl
   void OnOrientationChangeEvent(int);
   void OnDidChangePageScaleFactor(double);
   void OnDidChangePageScaleRange(double, double);
+  void OnDidUpdateHitTestRegions(const HitTestRegionsEfl& added,
+                                 const std::vector<int>& removed_ids,
+                                 bool replace,
+                                 const gfx::Vector2d& scroll_offset);
 
   SelectionControllerEfl* GetSelectionController();
 
@@ -254,7 +286,23 @@ class RenderWidgetHostViewEfl
       scoped_refptr<OwnedMailbox> subscriber_texture,
       uint32 sync_point);
 
+  // Static so that the callbacks run even once the view is gone, this one
+  // then reports a failure.
+  static void CopyFromCompositingSurfaceFinished(
+      base::WeakPtr<RenderWidgetHostViewEfl> rwhvefl,
+      const base::Callback<void(bool, const SkBitmap&)>& callback,
+      int request_id,
+      base::TimeTicks start_time,
+      bool result,
+      const SkBitmap& bitmap);
+  static void CopyFromPresentedFrameFinished(
+      const base::Callback<void(bool, const SkBitmap&)>& callback,
+      scoped_ptr<SkBitmap> bitmap,
+      scoped_ptr<SkAutoLockPixels> bitmap_pixels_lock,
+      bool result);
+
   static void EvasObjectImagePixelsGetCallback(void*, Evas_Object*);
+  static void EvasRenderPostCallback(void*, Evas*, void*);
   void initializeProgram();
 
   Ecore_X_Window GetEcoreXWindow() const;
@@ -267,6 +315,23 @@ class RenderWidgetHostViewEfl
 
   void PaintTextureToSurface(GLuint texture_id);
 
+  // Zero-copy presentation: binds the compositor texture as the native
+  // surface of |content_image_|. Returns false when the texture can not be
+  // shown as is, in which case the Evas GL surface path has to be used.
+  bool CanPresentTextureDirectly(const gfx::Size& texture_size) const;
+  bool PresentTextureDirectly(GLuint texture_id, const gfx::Size& texture_size);
+  void PresentTextureThroughSurface();
+
+  // Consumes |mailbox| and schedules |damage_rect| (view pixels, origin at
+  // the top left) of it for presentation on the next Evas render.
+  void PresentMailbox(const gpu::Mailbox& mailbox,
+                      const gfx::Size& surface_size,
+                      const gfx::Rect& damage_rect);
+  void RecordPresentedPixels(const gfx::Rect& rect);
+  bool CreateEvasGLSurface(int width, int height);
+  // Creates the surface again if ReleaseHiddenGpuResources() freed it.
+  void EnsureEvasGLSurface();
+
   RenderWidgetHostImpl* host_;
   EWebView* web_view_;
   IMContextEfl* im_context_;
@@ -312,6 +377,8 @@ class RenderWidgetHostViewEfl
   Evas_GL_Context* evas_gl_context_;
   Evas_GL_Surface* evas_gl_surface_;
   Evas_GL_Config* evas_gl_config_;
+  Evas_Native_Surface evas_gl_native_surface_;
+  gfx::Size evas_gl_surface_size_;
 
   GLuint program_id_;
   GLint source_texture_location_;
@@ -324,6 +391,21 @@ class RenderWidgetHostViewEfl
   int surface_id_;
   bool is_hw_accelerated_;
   bool is_modifier_key_;
+  bool is_presenting_directly_;
+  // Evas refused the compositor texture as native surface of the current
+  // surface.
+  bool direct_presentation_unsupported_;
+
+  // Mailbox and size of the last presented frame, kept for readbacks.
+  gpu::Mailbox current_mailbox_;
+  gfx::Size current_surface_size_;
+
+  // Damage collected from swaps since the last paint of the Evas GL surface.
+  gfx::Rect pending_damage_rect_;
+  // Number of pixels updated by the last presented frame.
+  int last_presented_pixel_count_;
+
+  scoped_ptr<FrameTimingRecorderEfl> frame_timing_recorder_;
   GLuint vertex_buffer_obj_;
   GLuint vertex_buffer_obj_270_;
   GLuint vertex_buffer_obj_90_;
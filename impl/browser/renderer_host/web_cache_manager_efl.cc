@@ -4,26 +4,63 @@
 
 #include "browser/renderer_host/web_cache_manager_efl.h"
 #include "common/render_messages_efl.h"
-#include "cache_params_efl.h"
+
+#include <algorithm>
 
 #include "base/logging.h"
 #include "base/sys_info.h"
+#include "browser_context_efl.h"
 #include "content/public/browser/browser_context.h"
+#include "content/public/browser/notification_details.h"
 #include "content/public/browser/notification_service.h"
 #include "content/public/browser/notification_source.h"
 #include "content/public/browser/notification_types.h"
 #include "content/public/browser/render_process_host.h"
+#include "content/public/browser/render_widget_host.h"
+#include "url_request_context_getter_efl.h"
 
 using namespace tizen_webview;
 
+namespace {
+
+// A hidden renderer counts as recently active for this long.
+const int kRecentlyActiveSeconds = 5 * 60;
+// The budget stays reduced for this long after the last memory pressure.
+const int kPressureRecoverySeconds = 2 * 60;
+
+// Shares of the budget per renderer.
+const int kVisibleWeight = 4;
+const int kRecentlyActiveWeight = 2;
+const int kIdleWeight = 1;
+
+bool SameParams(const CacheParamsEfl& a, const CacheParamsEfl& b) {
+  return a.cache_total_capacity == b.cache_total_capacity &&
+         a.cache_min_dead_capacity == b.cache_min_dead_capacity &&
+         a.cache_max_dead_capacity == b.cache_max_dead_capacity;
+}
+
+}  // namespace
+
+WebCacheManagerEfl::RendererState::RendererState()
+    : params_sent(false) {
+}
+
 WebCacheManagerEfl::WebCacheManagerEfl(content::BrowserContext* browser_context)
     : browser_context_(browser_context),
-      cache_model_(TW_CACHE_MODEL_DOCUMENT_VIEWER)
+      cache_model_(TW_CACHE_MODEL_DOCUMENT_VIEWER),
+      url_cache_memory_capacity_(0),
+      url_cache_disk_capacity_(0),
+      pressure_divisor_(1)
 {
   registrar_.Add(this, content::NOTIFICATION_RENDERER_PROCESS_CREATED,
                  content::NotificationService::AllBrowserContextsAndSources());
   registrar_.Add(this, content::NOTIFICATION_RENDERER_PROCESS_TERMINATED,
                  content::NotificationService::AllBrowserContextsAndSources());
+  registrar_.Add(this, content::NOTIFICATION_RENDER_WIDGET_VISIBILITY_CHANGED,
+                 content::NotificationService::AllBrowserContextsAndSources());
+  registrar_.Add(this, content::NOTIFICATION_RENDER_WIDGET_HOST_DESTROYED,
+                 content::NotificationService::AllBrowserContextsAndSources());
+  UpdateCacheSizes();
 }
 
 WebCacheManagerEfl::~WebCacheManagerEfl() { }
@@ -32,6 +69,20 @@ void WebCacheManagerEfl::Observe(int type,
                               const content::NotificationSource& source,
                               const content::NotificationDetails& details)
 {
+  switch (type) {
+    case content::NOTIFICATION_RENDER_WIDGET_VISIBILITY_CHANGED: {
+      OnWidgetVisibilityChanged(
+          content::Source<content::RenderWidgetHost>(source).ptr(),
+          *content::Details<bool>(details).ptr());
+      return;
+    }
+    case content::NOTIFICATION_RENDER_WIDGET_HOST_DESTROYED: {
+      OnWidgetVisibilityChanged(
+          content::Source<content::RenderWidgetHost>(source).ptr(), false);
+      return;
+    }
+  }
+
   content::RenderProcessHost* process =
             content::Source<content::RenderProcessHost>(source).ptr();
   DCHECK(process);
@@ -41,8 +92,7 @@ void WebCacheManagerEfl::Observe(int type,
   int renderer_id = process->GetID();
   switch (type) {
     case content::NOTIFICATION_RENDERER_PROCESS_CREATED: {
-      renderers_.insert(renderer_id);
-      SetRenderProcessCacheModel(cache_model_, renderer_id);
+      renderers_[renderer_id].last_active = base::TimeTicks::Now();
       break;
     }
     case content::NOTIFICATION_RENDERER_PROCESS_TERMINATED: {
@@ -53,79 +103,195 @@ void WebCacheManagerEfl::Observe(int type,
       NOTREACHED();
       break;
   }
+  Rebalance();
+}
+
+void WebCacheManagerEfl::OnWidgetVisibilityChanged(
+    content::RenderWidgetHost* widget, bool visible)
+{
+  content::RenderProcessHost* process = widget->GetProcess();
+  if (!process || process->GetBrowserContext() != browser_context_)
+    return;
+
+  std::map<int, RendererState>::iterator it =
+      renderers_.find(process->GetID());
+  if (it == renderers_.end())
+    return;
+
+  RendererState& state = it->second;
+  bool was_visible = !state.visible_widgets.empty();
+  if (visible)
+    state.visible_widgets.insert(widget);
+  else
+    state.visible_widgets.erase(widget);
+  bool is_visible = !state.visible_widgets.empty();
+
+  // A renderer stays active until its last view is hidden.
+  if (was_visible || is_visible)
+    state.last_active = base::TimeTicks::Now();
+  if (was_visible != is_visible)
+    Rebalance();
 }
 
 void WebCacheManagerEfl::ClearCache()
 {
-  for (std::set<int>::const_iterator iter = renderers_.begin();
+  for (std::map<int, RendererState>::const_iterator iter = renderers_.begin();
       iter != renderers_.end(); ++iter) {
-    content::RenderProcessHost* host = content::RenderProcessHost::FromID(*iter);
+    content::RenderProcessHost* host =
+        content::RenderProcessHost::FromID(iter->first);
     if (host)
       host->Send(new EflViewMsg_ClearCache());
   }
 }
 
-void WebCacheManagerEfl::SetRenderProcessCacheModel(Cache_Model model, int render_process_id)
+void WebCacheManagerEfl::SetCacheModel(Cache_Model model)
 {
-  DCHECK(render_process_id);
-  DCHECK(renderers_.find(render_process_id) != renderers_.end());
-  content::RenderProcessHost* host = content::RenderProcessHost::FromID(render_process_id);
-  if (host)
-    host->Send(new EflViewMsg_SetCache(GetCacheParamsFromModel(model)));
+  cache_model_ = model;
+  UpdateCacheSizes();
+  Rebalance();
+  ApplyHttpCacheSizes();
 }
 
-void WebCacheManagerEfl::SetCacheModel(Cache_Model model)
+void WebCacheManagerEfl::OnMemoryPressure(MemoryPurger::Level level)
 {
-  cache_model_ = model;
-  CacheParamsEfl cache_params = GetCacheParamsFromModel(model);
-  for (std::set<int>::const_iterator iter = renderers_.begin();
-          iter != renderers_.end(); ++iter) {
-    content::RenderProcessHost* host = content::RenderProcessHost::FromID(*iter);
-    if (host)
-      host->Send(new EflViewMsg_SetCache(cache_params));
-  }
+  int divisor = level == MemoryPurger::LEVEL_CRITICAL ? 4 : 2;
+  // A moderate warning does not lift a critical one.
+  if (pressure_timer_.IsRunning())
+    divisor = std::max(divisor, pressure_divisor_);
+  pressure_timer_.Start(FROM_HERE,
+      base::TimeDelta::FromSeconds(kPressureRecoverySeconds),
+      this, &WebCacheManagerEfl::PressureRelieved);
+
+  if (divisor == pressure_divisor_)
+    return;
+  pressure_divisor_ = divisor;
+  Rebalance();
+}
+
+void WebCacheManagerEfl::PressureRelieved()
+{
+  pressure_divisor_ = 1;
+  Rebalance();
 }
 
-CacheParamsEfl WebCacheManagerEfl::GetCacheParamsFromModel(Cache_Model cache_model)
+void WebCacheManagerEfl::ApplyHttpCacheSizes()
 {
-  int64 mem_size = base::SysInfo::AmountOfPhysicalMemory();
+  if (!browser_context_)
+    return;
+  content::URLRequestContextGetterEfl* getter =
+      static_cast<content::BrowserContextEfl*>(browser_context_)->
+          GetRequestContextEfl();
+  // The request context picks the sizes up when it is created.
+  if (!getter)
+    return;
+  getter->SetHttpCacheSizes(static_cast<int>(url_cache_memory_capacity_),
+                            static_cast<int>(url_cache_disk_capacity_));
+}
+
+void WebCacheManagerEfl::UpdateCacheSizes()
+{
+  // The WK2 table is indexed by megabytes.
+  int64 mem_size = base::SysInfo::AmountOfPhysicalMemoryMB();
   // in chromium the limiting parameter is max file size of network cache
   // which is set at the time of creation of backend.
   // backend could be completely in-memory as well.
   // in WK2/Tizen, it is free space on disk
   // So, we are using free space available on browser_context path
-  // we dont set it on renderer side anyway.
-  int64 disk_free_size = base::SysInfo::AmountOfFreeDiskSpace(browser_context_->GetPath());
+  int64 disk_free_size = 0;
+  if (browser_context_ && !browser_context_->GetPath().empty()) {
+    disk_free_size = base::SysInfo::AmountOfFreeDiskSpace(
+        browser_context_->GetPath()) / (1024 * 1024);
+  }
   int64 cache_min_dead_capacity = 0;
   int64 cache_max_dead_capacity = 0;
   int64 cache_total_capacity = 0;
   double dead_decoded_data_deletion_interval = 0;
   int64 page_cache_capacity = 0;
 
-  int64 url_cache_memory_capacity = 0;
-  int64 url_cache_disk_capacity = 0;
-
   // We have taken this calculation from WK2.
   // Except that, we are using pointers instead of reference for output.
   // We don't use page_cache_capacity. NavigationControllerImpl has
   // kMaxSessionHistoryEntries = 50 for back/forward list.
-  // url_cache_memory_capacity, url_cache_disk_capacity seem to be parts of
-  // network layer. disk_cache::CreateCacheBackend gets size while creation.
-  // Could not find anything to modify it on-the-fly.
   // m_deadDecodedDataDeletionInterval is unused variable in MemoryCache.cpp in
   // WK2 CachedResource uses this to start timer.
-  // So, We are using only cache_total_capacity, cache_min_dead_capacity, and
-  // cache_max_dead_capacity. This is same as Chromium cache manager implementation
-  // But we are using following calculation instead of dynamic strategy used in Chromium.
-  CalculateCacheSizes(cache_model, mem_size, disk_free_size,
+  // The object cache capacities are the budget of all renderers together,
+  // the URL cache capacities size the HTTP cache backend.
+  CalculateCacheSizes(cache_model_, mem_size, disk_free_size,
                       &cache_total_capacity, &cache_min_dead_capacity, &cache_max_dead_capacity,
                       &dead_decoded_data_deletion_interval, &page_cache_capacity,
-                      &url_cache_memory_capacity, &url_cache_disk_capacity);
-  CacheParamsEfl cache_params;
-  cache_params.cache_max_dead_capacity = cache_max_dead_capacity;
-  cache_params.cache_min_dead_capacity = cache_min_dead_capacity;
-  cache_params.cache_total_capacity = cache_total_capacity;
-  return cache_params;
+                      &url_cache_memory_capacity_, &url_cache_disk_capacity_);
+  model_params_.cache_max_dead_capacity = cache_max_dead_capacity;
+  model_params_.cache_min_dead_capacity = cache_min_dead_capacity;
+  model_params_.cache_total_capacity = cache_total_capacity;
+}
+
+int WebCacheManagerEfl::GetRendererWeight(const RendererState& state,
+                                          base::TimeTicks now) const
+{
+  if (!state.visible_widgets.empty())
+    return kVisibleWeight;
+  if (now - state.last_active <
+      base::TimeDelta::FromSeconds(kRecentlyActiveSeconds))
+    return kRecentlyActiveWeight;
+  return kIdleWeight;
+}
+
+void WebCacheManagerEfl::Rebalance()
+{
+  rebalance_timer_.Stop();
+  if (renderers_.empty())
+    return;
+
+  base::TimeTicks now = base::TimeTicks::Now();
+  int total_weight = 0;
+  base::TimeTicks next_demotion;
+  for (std::map<int, RendererState>::const_iterator iter = renderers_.begin();
+      iter != renderers_.end(); ++iter) {
+    int weight = GetRendererWeight(iter->second, now);
+    total_weight += weight;
+    if (weight != kRecentlyActiveWeight)
+      continue;
+    base::TimeTicks demotion = iter->second.last_active +
+        base::TimeDelta::FromSeconds(kRecentlyActiveSeconds);
+    if (next_demotion.is_null() || demotion < next_demotion)
+      next_demotion = demotion;
+  }
+
+  int64 budget = model_params_.cache_total_capacity / pressure_divisor_;
+  for (std::map<int, RendererState>::iterator iter = renderers_.begin();
+      iter != renderers_.end(); ++iter) {
+    int weight = GetRendererWeight(iter->second, now);
+    CacheParamsEfl params;
+    params.cache_total_capacity = budget * weight / total_weight;
+    // Dead resources keep the proportion the model gives them, idle
+    // renderers keep none while memory is short.
+    if (model_params_.cache_total_capacity &&
+        (pressure_divisor_ == 1 || weight != kIdleWeight)) {
+      params.cache_min_dead_capacity = model_params_.cache_min_dead_capacity *
+          params.cache_total_capacity / model_params_.cache_total_capacity;
+      params.cache_max_dead_capacity = model_params_.cache_max_dead_capacity *
+          params.cache_total_capacity / model_params_.cache_total_capacity;
+    } else {
+      params.cache_min_dead_capacity = 0;
+      params.cache_max_dead_capacity = 0;
+    }
+
+    RendererState& state = iter->second;
+    if (state.params_sent && SameParams(state.sent_params, params))
+      continue;
+    content::RenderProcessHost* host =
+        content::RenderProcessHost::FromID(iter->first);
+    if (!host)
+      continue;
+    host->Send(new EflViewMsg_SetCache(params));
+    state.params_sent = true;
+    state.sent_params = params;
+  }
+
+  if (!next_demotion.is_null()) {
+    rebalance_timer_.Start(FROM_HERE, next_demotion - now,
+                           this, &WebCacheManagerEfl::Rebalance);
+  }
 }
 
 // taken from WK2/Tizen
@@ -5,19 +5,30 @@
 #ifndef WEB_CACHE_MANAGER_EFL_H
 #define WEB_CACHE_MANAGER_EFL_H
 
+#include <map>
 #include <set>
 
 #include "base/compiler_specific.h"
 #include "base/memory/singleton.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "cache_params_efl.h"
 #include "content/public/browser/notification_observer.h"
 #include "content/public/browser/notification_registrar.h"
+#include "memory_purger.h"
 #include "tizen_webview/public/tw_cache_model.h"
 
 namespace content {
 class BrowserContext;
+class RenderWidgetHost;
 }
-struct CacheParamsEfl;
 
+// Sizes the caches of one context from its cache model. The Blink memory
+// cache budget of the model is shared by all renderers of the context:
+// renderers showing a view get the biggest share, renderers hidden only
+// recently a smaller one and idle renderers the rest. The budget shrinks
+// for a while after memory pressure. The URL cache sizes of the model are
+// applied to the HTTP cache backend.
 class WebCacheManagerEfl : public content::NotificationObserver {
  public:
   explicit WebCacheManagerEfl(content::BrowserContext* browser_context);
@@ -32,22 +43,58 @@ class WebCacheManagerEfl : public content::NotificationObserver {
   tizen_webview::Cache_Model GetCacheModel() const { return cache_model_; }
   void SetBrowserContext(content::BrowserContext* browser_context);
 
+  // Shrinks the Blink cache budget of all renderers until the pressure has
+  // been gone for a while.
+  void OnMemoryPressure(MemoryPurger::Level level);
+
+  // Passes the URL cache sizes of the cache model on to the HTTP cache of
+  // the context, once its request context exists.
+  void ApplyHttpCacheSizes();
+
  private:
+  struct RendererState {
+    RendererState();
+
+    std::set<content::RenderWidgetHost*> visible_widgets;
+    // When the renderer last showed a view.
+    base::TimeTicks last_active;
+    bool params_sent;
+    CacheParamsEfl sent_params;
+  };
+
   static void CalculateCacheSizes(tizen_webview::Cache_Model cache_model, int64 memory_size, int64 disk_free_size,
       int64* cache_total_capacity, int64* cache_min_dead_capacity,
       int64* cache_max_dead_capacity, double* dead_decoded_data_deletion_interval,
       int64* page_cache_capacity, int64* url_cache_memory_capacity,
       int64* url_cache_disk_capacity);
 
-  CacheParamsEfl GetCacheParamsFromModel(tizen_webview::Cache_Model);
-  void SetRenderProcessCacheModel(tizen_webview::Cache_Model model, int render_process_id);
+  void UpdateCacheSizes();
+  void OnWidgetVisibilityChanged(content::RenderWidgetHost* widget,
+                                 bool visible);
+  int GetRendererWeight(const RendererState& state,
+                        base::TimeTicks now) const;
+  // Splits the budget among the renderers and sends the shares which
+  // changed.
+  void Rebalance();
+  void PressureRelieved();
 
   content::NotificationRegistrar registrar_;
-  std::set<int> renderers_;
+  std::map<int, RendererState> renderers_;
   content::BrowserContext* browser_context_;
   tizen_webview::Cache_Model cache_model_;
+
+  // Sizes of the cache model, for all renderers together.
+  CacheParamsEfl model_params_;
+  int64 url_cache_memory_capacity_;
+  int64 url_cache_disk_capacity_;
+
+  // Divides the budget while memory is short.
+  int pressure_divisor_;
+  base::OneShotTimer<WebCacheManagerEfl> pressure_timer_;
+  // Fires when a hidden renderer stops counting as recently active.
+  base::OneShotTimer<WebCacheManagerEfl> rebalance_timer_;
+
   DISALLOW_COPY_AND_ASSIGN(WebCacheManagerEfl);
 };
 
 #endif
-
@@ -11,29 +11,27 @@
 #include "net/http/http_response_headers.h"
 #include "browser/login_delegate_efl.h"
 #include "browser_context_efl.h"
-#include "common/web_contents_utils.h"
+#include "browser/web_view_registry_efl.h"
 #include "eweb_context.h"
-
-using web_contents_utils::WebContentsFromFrameID;
+#include "web_contents_delegate_efl.h"
 
 namespace content {
 
 namespace {
 
 void TriggerNewDownloadStartCallbackOnUIThread(
-    int render_process_id, int render_frame_id,
+    const WebViewRegistryEfl::Handle& view,
     const GURL& url,
     const std::string& /*user_agent*/,
     const std::string& /*content_disposition*/,
     const std::string& /*mime_type*/,
     int64 /*content_length*/) {
-  WebContents* web_contents = WebContentsFromFrameID(
-      render_process_id, render_frame_id);
-  if (!web_contents)
+  WebContentsDelegateEfl* delegate = view.Get();
+  if (!delegate)
     return;
 
   BrowserContextEfl* browser_context = static_cast<BrowserContextEfl*>(
-      web_contents->GetBrowserContext());
+      delegate->web_contents().GetBrowserContext());
   if (!browser_context)
     return;
 
@@ -46,6 +44,24 @@ void TriggerNewDownloadStartCallbackOnUIThread(
   start_download_callback->TriggerCallback(url.spec());
 }
 
+// Requests no view is known for use the context's headers.
+const HTTPCustomHeadersEflMap* CustomHeadersForContext(ResourceContext* resource_context) {
+  BrowserContextEfl::ResourceContextEfl *resource_context_efl =
+      static_cast<BrowserContextEfl::ResourceContextEfl*>(resource_context);
+  if (!resource_context_efl)
+    return NULL;
+
+  BrowserContextEfl *browser_context = resource_context_efl->getBrowserContext();
+  if (!browser_context)
+    return NULL;
+
+  EWebContext* eweb_context = browser_context->WebContext();
+  if (!eweb_context)
+    return NULL;
+
+  return &eweb_context->GetHTTPCustomHeadersEflMap();
+}
+
 }
 
 void ResourceDispatcherHostDelegateEfl::RequestBeginning(
@@ -54,21 +70,27 @@ void ResourceDispatcherHostDelegateEfl::RequestBeginning(
     AppCacheService* appcache_service,
     ResourceType resource_type,
     ScopedVector<ResourceThrottle>* throttles) {
-  BrowserContextEfl::ResourceContextEfl *resource_context_efl =
-      static_cast<BrowserContextEfl::ResourceContextEfl*>(resource_context);
-  if (!resource_context_efl)
-    return;
+  const HTTPCustomHeadersEflMap* header_map = NULL;
 
-  BrowserContextEfl *browser_context = resource_context_efl->getBrowserContext();
-  if (!browser_context)
-    return;
+  // Requests of a known view use the headers it published.
+  int render_process_id = -1;
+  int render_frame_id = -1;
+  WebViewRegistryEfl::Handle view;
+  if (ResourceRequestInfo::GetRenderFrameForRequest(
+      request, &render_process_id, &render_frame_id)) {
+    view = WebViewRegistryEfl::GetInstance()->Lookup(render_process_id,
+                                                     render_frame_id);
+    if (view.settings())
+      header_map = &view.settings()->custom_headers;
+  }
 
-  EWebContext* eweb_context = browser_context->WebContext();
-  if (!eweb_context)
+  if (!header_map)
+    header_map = CustomHeadersForContext(resource_context);
+  if (!header_map)
     return;
 
-  HTTPCustomHeadersEflMap header_map = eweb_context->GetHTTPCustomHeadersEflMap();
-  for (HTTPCustomHeadersEflMap::iterator it = header_map.begin(); it != header_map.end(); ++it)
+  for (HTTPCustomHeadersEflMap::const_iterator it = header_map->begin();
+       it != header_map->end(); ++it)
     request->SetExtraRequestHeaderByName(it->first, it->second, true);
 }
 
@@ -130,13 +152,18 @@ void ResourceDispatcherHostDelegateEfl::TriggerNewDownloadStartCallback(
   if (render_process_id == -1 || render_frame_id == -1)
     return;
 
+  WebViewRegistryEfl::Handle view = WebViewRegistryEfl::GetInstance()->Lookup(
+      render_process_id, render_frame_id);
+  // Nobody to tell, the context has no callback.
+  if (view.settings() && !view.settings()->download_start_callback)
+    return;
+
   // Since called by IO thread callback trigger needs to
   // be posted to UI thread so that IO thread is unblocked
   BrowserThread::PostTask(
     BrowserThread::UI, FROM_HERE,
     base::Bind(TriggerNewDownloadStartCallbackOnUIThread,
-               render_process_id,
-               render_frame_id,
+               view,
                request->url(),
                user_agent,
                content_disposition,
@@ -0,0 +1,85 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "browser/response_policy_filter_efl.h"
+
+#include "base/debug/trace_event.h"
+#include "base/memory/singleton.h"
+#include "base/metrics/histogram.h"
+#include "base/strings/string_util.h"
+#include "browser/web_view_registry_efl.h"
+#include "url/gurl.h"
+
+namespace {
+
+bool MatchesAny(const std::vector<std::string>& patterns,
+                const std::string& value) {
+  if (patterns.empty())
+    return true;
+
+  for (size_t i = 0; i < patterns.size(); ++i) {
+    if (MatchPattern(value, patterns[i]))
+      return true;
+  }
+  return false;
+}
+
+} // namespace
+
+ResponsePolicyFilterEfl::Filter::Filter()
+    : enabled(true) {
+}
+
+ResponsePolicyFilterEfl::Filter::~Filter() {
+}
+
+// static
+ResponsePolicyFilterEfl* ResponsePolicyFilterEfl::GetInstance() {
+  return Singleton<ResponsePolicyFilterEfl>::get();
+}
+
+ResponsePolicyFilterEfl::ResponsePolicyFilterEfl() {
+}
+
+ResponsePolicyFilterEfl::~ResponsePolicyFilterEfl() {
+}
+
+bool ResponsePolicyFilterEfl::ShouldAsk(int render_process_id,
+                                        int render_view_id,
+                                        const GURL& url,
+                                        const std::string& mime_type) const {
+  WebViewRegistryEfl::Handle view = WebViewRegistryEfl::GetInstance()->Lookup(
+      render_process_id, render_view_id);
+  if (!view.settings())
+    return true;
+
+  const Filter& filter = view.settings()->response_policy_filter;
+  return filter.enabled &&
+         MatchesAny(filter.mime_types, mime_type) &&
+         MatchesAny(filter.url_patterns, url.spec());
+}
+
+void ResponsePolicyFilterEfl::RecordSynchronousResume() {
+  UMA_HISTOGRAM_BOOLEAN("Efl.ResponsePolicy.Deferred", false);
+  base::AutoLock locker(lock_);
+  ++stats_.resumed_synchronously;
+}
+
+void ResponsePolicyFilterEfl::RecordDeferral(base::TimeDelta time) {
+  UMA_HISTOGRAM_BOOLEAN("Efl.ResponsePolicy.Deferred", true);
+  UMA_HISTOGRAM_TIMES("Efl.ResponsePolicy.DeferTime", time);
+
+  base::AutoLock locker(lock_);
+  ++stats_.deferred;
+  stats_.total_defer_time += time;
+  if (time > stats_.max_defer_time) {
+    stats_.max_defer_time = time;
+    TRACE_COUNTER1("efl", "ResponsePolicyMaxDeferMs", time.InMilliseconds());
+  }
+}
+
+ResponsePolicyFilterEfl::Stats ResponsePolicyFilterEfl::GetStats() const {
+  base::AutoLock locker(lock_);
+  return stats_;
+}
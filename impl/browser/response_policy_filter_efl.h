@@ -0,0 +1,69 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RESPONSE_POLICY_FILTER_EFL_H_
+#define RESPONSE_POLICY_FILTER_EFL_H_
+
+#include <string>
+#include <vector>
+
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+
+template <typename T> struct DefaultSingletonTraits;
+
+class GURL;
+
+// Tells which views ask for the policy of the responses they receive. Each
+// view publishes its filter with its WebViewRegistryEfl settings, which the
+// IO thread consults to let responses nobody asks about through without a
+// round trip to the UI thread.
+class ResponsePolicyFilterEfl {
+ public:
+  struct Filter {
+    Filter();
+    ~Filter();
+
+    bool enabled;
+    // Empty lists match every response. Entries may use * and ? wildcards,
+    // e.g. "video/*" or "http://*.example.com/*".
+    std::vector<std::string> mime_types;
+    std::vector<std::string> url_patterns;
+  };
+
+  struct Stats {
+    Stats() : deferred(0), resumed_synchronously(0) {}
+    // Responses held back until the application decided.
+    int deferred;
+    // Responses let through on the IO thread.
+    int resumed_synchronously;
+    base::TimeDelta total_defer_time;
+    base::TimeDelta max_defer_time;
+  };
+
+  static ResponsePolicyFilterEfl* GetInstance();
+
+  // Called on the IO thread. Views the IO thread does not know yet are
+  // always asked.
+  bool ShouldAsk(int render_process_id, int render_view_id,
+                 const GURL& url, const std::string& mime_type) const;
+
+  void RecordSynchronousResume();
+  void RecordDeferral(base::TimeDelta time);
+  Stats GetStats() const;
+
+ private:
+  friend struct DefaultSingletonTraits<ResponsePolicyFilterEfl>;
+
+  ResponsePolicyFilterEfl();
+  ~ResponsePolicyFilterEfl();
+
+  // Guards |stats_|, which the IO and the UI thread update.
+  mutable base::Lock lock_;
+  Stats stats_;
+
+  DISALLOW_COPY_AND_ASSIGN(ResponsePolicyFilterEfl);
+};
+
+#endif // RESPONSE_POLICY_FILTER_EFL_H_
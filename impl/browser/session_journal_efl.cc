@@ -0,0 +1,485 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "browser/session_journal_efl.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "base/memory/scoped_ptr.h"
+#include "base/pickle.h"
+#include "components/sessions/serialized_navigation_entry.h"
+#include "content/public/browser/navigation_controller.h"
+#include "content/public/browser/navigation_details.h"
+#include "content/public/browser/navigation_entry.h"
+#include "content/public/browser/notification_service.h"
+#include "content/public/browser/notification_types.h"
+#include "content/public/browser/web_contents.h"
+
+using content::NavigationController;
+using content::NavigationEntry;
+using sessions::SerializedNavigationEntry;
+
+namespace {
+
+const int kMaxSessionEntrySize = std::numeric_limits<int>::max();
+
+// Snapshots start with their entry count, which is never negative.
+const int kCheckpointTag = -0x4a524e4c;
+
+// Extra data key SerializedNavigationEntry keeps the search terms under.
+const char kSearchTermsKey[] = "search_terms";
+
+std::string SerializeEntry(const SerializedNavigationEntry& navigation) {
+  Pickle pickle;
+  navigation.WriteToPickle(kMaxSessionEntrySize, &pickle);
+  // Only the payload is kept, it is spliced into snapshots and checkpoints
+  // exactly as if the entry was written to them directly.
+  const char* payload =
+      static_cast<const char*>(pickle.data()) + sizeof(Pickle::Header);
+  return std::string(payload, pickle.size() - sizeof(Pickle::Header));
+}
+
+}  // namespace
+
+SessionJournalEfl::ParsedSession::ParsedSession()
+    : current_index(0),
+      sequence(-1),
+      pruned_total(0) {
+}
+
+SessionJournalEfl::ParsedSession::~ParsedSession() {
+}
+
+SessionJournalEfl::SessionJournalEfl(content::WebContents* web_contents)
+    : content::WebContentsObserver(web_contents),
+      controller_(web_contents->GetController()),
+      checkpoint_sequence_(-1),
+      checkpoint_current_index_(-1),
+      checkpoint_pruned_total_(0),
+      pruned_from_front_(0),
+      weak_factory_(this) {
+  content::Source<NavigationController> controller_source(&controller_);
+  registrar_.Add(this, content::NOTIFICATION_NAV_ENTRY_CHANGED,
+      controller_source);
+  registrar_.Add(this, content::NOTIFICATION_NAV_ENTRY_COMMITTED,
+      controller_source);
+  registrar_.Add(this, content::NOTIFICATION_NAV_LIST_PRUNED,
+      controller_source);
+  registrar_.Add(this, content::NOTIFICATION_WEB_CONTENTS_TITLE_UPDATED,
+      content::Source<content::WebContents>(web_contents));
+}
+
+SessionJournalEfl::~SessionJournalEfl() {
+}
+
+void SessionJournalEfl::WriteSnapshot(Pickle* pickle) {
+  const int entry_count = controller_.GetEntryCount();
+  pickle->WriteInt(entry_count);
+  pickle->WriteInt(controller_.GetCurrentEntryIndex());
+
+  for (int i = 0; i < entry_count; ++i) {
+    const std::string& serialized = SerializedEntryAt(i);
+    pickle->WriteBytes(serialized.data(), serialized.size());
+  }
+
+  // Where the checkpoints stand, those written after the snapshot apply on
+  // top of it. Readers of older snapshots find neither.
+  pickle->WriteInt(checkpoint_sequence_);
+  pickle->WriteInt(checkpoint_pruned_total_ + PrunedSinceBaseline());
+
+  ForgetDroppedEntries();
+}
+
+bool SessionJournalEfl::WriteCheckpoint(Pickle* pickle) {
+  const bool has_baseline = checkpoint_sequence_ >= 0;
+  const int pruned = PrunedSinceBaseline();
+  checkpoint_entry_ids_.erase(checkpoint_entry_ids_.begin(),
+                              checkpoint_entry_ids_.begin() + pruned);
+  pruned_from_front_ = 0;
+
+  const int entry_count = controller_.GetEntryCount();
+  const int current_index = controller_.GetCurrentEntryIndex();
+
+  // Entries which moved to another index are written again as well, the
+  // controller drops forward entries and removes entries without telling.
+  std::vector<int> changed_indexes;
+  for (int i = 0; i < entry_count; ++i) {
+    int unique_id = controller_.GetEntryAtIndex(i)->GetUniqueID();
+    if (!has_baseline ||
+        static_cast<size_t>(i) >= checkpoint_entry_ids_.size() ||
+        checkpoint_entry_ids_[i] != unique_id ||
+        changed_entry_ids_.count(unique_id))
+      changed_indexes.push_back(i);
+  }
+
+  if (has_baseline && !pruned && changed_indexes.empty() &&
+      entry_count == static_cast<int>(checkpoint_entry_ids_.size()) &&
+      current_index == checkpoint_current_index_)
+    return false;
+
+  // Readers may hold a snapshot taken since the previous checkpoint, so
+  // the entries pruned are counted from the first checkpoint on.
+  const int sequence = checkpoint_sequence_ + 1;
+  const int pruned_total = checkpoint_pruned_total_ + pruned;
+  pickle->WriteInt(kCheckpointTag);
+  pickle->WriteInt(sequence);
+  pickle->WriteInt(pruned_total);
+  pickle->WriteInt(entry_count);
+  pickle->WriteInt(current_index);
+  pickle->WriteInt(changed_indexes.size());
+  for (size_t i = 0; i < changed_indexes.size(); ++i) {
+    const std::string& serialized = SerializedEntryAt(changed_indexes[i]);
+    pickle->WriteInt(changed_indexes[i]);
+    pickle->WriteBytes(serialized.data(), serialized.size());
+  }
+
+  ResetBaseline(sequence, pruned_total);
+  ForgetDroppedEntries();
+  return true;
+}
+
+// static
+bool SessionJournalEfl::Parse(const char* data,
+                              unsigned length,
+                              ParsedSession* session) {
+  SerializedEntries& entries = session->entries;
+  int current_index = 0;
+  int sequence = -1;
+  int pruned_total = 0;
+
+  // Snapshots and checkpoints are pickles of their own, the data is the
+  // concatenation of all of them.
+  const char* end = data + length;
+  for (const char* chunk = data; chunk < end;) {
+    const char* next = Pickle::FindNext(sizeof(Pickle::Header), chunk, end);
+    if (!next)
+      return false;
+
+    Pickle pickle(chunk, next - chunk);
+    PickleIterator iterator(pickle);
+    int tag;
+    if (!iterator.ReadInt(&tag))
+      return false;
+
+    if (tag == kCheckpointTag) {
+      if (!ReadCheckpoint(&iterator, &sequence, &pruned_total, &entries,
+                          &current_index))
+        return false;
+    } else {
+      if (!ReadSnapshot(&iterator, tag, &entries, &current_index, &sequence,
+                        &pruned_total))
+        return false;
+    }
+    chunk = next;
+  }
+
+  if (current_index < 0)
+    current_index = 0;
+
+  if (!entries.empty() && current_index >= static_cast<int>(entries.size()))
+    current_index = entries.size() - 1;
+
+  session->current_index = current_index;
+  session->sequence = sequence;
+  session->pruned_total = pruned_total;
+  return true;
+}
+
+bool SessionJournalEfl::Restore(const char* data, unsigned length) {
+  ParsedSession session;
+  if (!Parse(data, length, &session))
+    return false;
+
+  return Restore(session, true);
+}
+
+bool SessionJournalEfl::Restore(const ParsedSession& session,
+                                bool complete_current_entry) {
+  // NavigationController::Restore() only takes a view without history.
+  if (controller_.GetEntryCount())
+    return false;
+
+  const SerializedEntries& entries = session.entries;
+  if (entries.empty())
+    return true;
+
+  // Only the current entry is loaded right away. The others are created
+  // with what the back forward list shows, page state and post data are
+  // read again from the journal if the entry is ever navigated to.
+  content::BrowserContext* browser_context = controller_.GetBrowserContext();
+  std::vector<NavigationEntry*> navigation_entries;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    if (complete_current_entry &&
+        static_cast<int>(i) == session.current_index) {
+      navigation_entries.push_back(
+          entries[i].ToNavigationEntry(i, browser_context).release());
+    } else {
+      navigation_entries.push_back(CreateStub(entries[i], i));
+    }
+  }
+
+  controller_.Restore(session.current_index,
+                      NavigationController::RESTORE_LAST_SESSION_EXITED_CLEANLY,
+                      &navigation_entries);
+
+  for (size_t i = 0; i < entries.size(); ++i) {
+    int unique_id = controller_.GetEntryAtIndex(i)->GetUniqueID();
+    serialized_entries_[unique_id] = SerializeEntry(entries[i]);
+    if (!complete_current_entry ||
+        static_cast<int>(i) != session.current_index)
+      stubs_.insert(unique_id);
+  }
+
+  // Checkpoints written from now on continue the restored data.
+  ResetBaseline(session.sequence, session.pruned_total);
+  ForgetDroppedEntries();
+  return true;
+}
+
+base::WeakPtr<SessionJournalEfl> SessionJournalEfl::AsWeakPtr() {
+  return weak_factory_.GetWeakPtr();
+}
+
+void SessionJournalEfl::AboutToNavigateRenderView(
+    content::RenderViewHost* render_view_host) {
+  MaterializeEntry(controller_.GetPendingEntry());
+}
+
+void SessionJournalEfl::Observe(int type,
+                                const content::NotificationSource& source,
+                                const content::NotificationDetails& details) {
+  switch (static_cast<content::NotificationType>(type)) {
+    case content::NOTIFICATION_NAV_ENTRY_COMMITTED: {
+      content::Details<content::LoadCommittedDetails> d = details;
+      EntryChanged(d->entry);
+      break;
+    }
+    case content::NOTIFICATION_NAV_LIST_PRUNED: {
+      content::Details<content::PrunedDetails> d = details;
+      // Entries pruned from the back only shorten the list, which the next
+      // checkpoint notices on its own.
+      if (d->from_front)
+        pruned_from_front_ += d->count;
+      break;
+    }
+    case content::NOTIFICATION_NAV_ENTRY_CHANGED: {
+      content::Details<content::EntryChangedDetails> d = details;
+      EntryChanged(d->changed_entry);
+      break;
+    }
+    case content::NOTIFICATION_WEB_CONTENTS_TITLE_UPDATED: {
+      content::Details<std::pair<NavigationEntry*, bool> > d = details;
+      EntryChanged(d->first);
+      break;
+    }
+    default: {
+      return;
+    }
+  }
+}
+
+// static
+bool SessionJournalEfl::ReadSnapshot(PickleIterator* iterator,
+                                     int entry_count,
+                                     SerializedEntries* entries,
+                                     int* current_index,
+                                     int* sequence,
+                                     int* pruned_total) {
+  if (entry_count < 0 || !iterator->ReadInt(current_index))
+    return false;
+
+  entries->clear();
+  for (int i = 0; i < entry_count; ++i) {
+    SerializedNavigationEntry navigation;
+    if (!navigation.ReadFromPickle(iterator))
+      return false;
+    entries->push_back(navigation);
+  }
+
+  // Snapshots written before they recorded the checkpoints made the
+  // checkpoints written after them start over.
+  if (!iterator->ReadInt(sequence) || !iterator->ReadInt(pruned_total)) {
+    *sequence = 0;
+    *pruned_total = 0;
+  }
+  return *sequence >= -1 && *pruned_total >= 0;
+}
+
+// static
+bool SessionJournalEfl::ReadCheckpoint(PickleIterator* iterator,
+                                       int* last_sequence,
+                                       int* pruned_total,
+                                       SerializedEntries* entries,
+                                       int* current_index) {
+  int sequence;
+  int total;
+  int entry_count;
+  int changed_count;
+  if (!iterator->ReadInt(&sequence) ||
+      !iterator->ReadInt(&total) ||
+      !iterator->ReadInt(&entry_count) ||
+      !iterator->ReadInt(current_index) ||
+      !iterator->ReadInt(&changed_count))
+    return false;
+
+  // The first checkpoint holds all entries, any other one is only valid on
+  // top of the one written before it, or of a snapshot taken after that.
+  if (sequence == 0) {
+    entries->clear();
+    *pruned_total = total;
+  } else if (sequence != *last_sequence + 1) {
+    return false;
+  }
+
+  const int pruned = total - *pruned_total;
+  if (pruned < 0 || pruned > static_cast<int>(entries->size()))
+    return false;
+  entries->erase(entries->begin(), entries->begin() + pruned);
+
+  const int kept = std::min(static_cast<int>(entries->size()), entry_count);
+  if (entry_count < 0 || changed_count < 0 ||
+      entry_count - kept > changed_count)
+    return false;
+  entries->resize(entry_count);
+
+  std::vector<bool> written(entry_count, false);
+  for (int i = 0; i < changed_count; ++i) {
+    int index;
+    if (!iterator->ReadInt(&index) || index < 0 || index >= entry_count)
+      return false;
+    if (!(*entries)[index].ReadFromPickle(iterator))
+      return false;
+    written[index] = true;
+  }
+
+  // Entries added since the previous checkpoint must all be in this one.
+  for (int i = kept; i < entry_count; ++i) {
+    if (!written[i])
+      return false;
+  }
+
+  *last_sequence = sequence;
+  *pruned_total = total;
+  return true;
+}
+
+NavigationEntry* SessionJournalEfl::CreateStub(
+    const SerializedNavigationEntry& navigation,
+    int page_id) const {
+  NavigationEntry* stub = NavigationController::CreateNavigationEntry(
+      navigation.virtual_url(), content::Referrer(),
+      navigation.transition_type(), false, std::string(),
+      controller_.GetBrowserContext());
+  stub->SetTitle(navigation.title());
+  stub->SetPageID(page_id);
+  return stub;
+}
+
+const std::string& SessionJournalEfl::SerializedEntryAt(int index) {
+  NavigationEntry* entry = controller_.GetEntryAtIndex(index);
+  std::string& serialized = serialized_entries_[entry->GetUniqueID()];
+  if (serialized.empty()) {
+    serialized = SerializeEntry(
+        SerializedNavigationEntry::FromNavigationEntry(index, *entry));
+  }
+  return serialized;
+}
+
+void SessionJournalEfl::EntryChanged(const NavigationEntry* entry) {
+  if (!entry)
+    return;
+
+  // A stub serialized again would lose what it was restored with.
+  int index = controller_.GetIndexOfEntry(entry);
+  if (index >= 0)
+    MaterializeEntry(controller_.GetEntryAtIndex(index));
+
+  serialized_entries_.erase(entry->GetUniqueID());
+  changed_entry_ids_.insert(entry->GetUniqueID());
+}
+
+void SessionJournalEfl::MaterializeEntry(NavigationEntry* entry) {
+  if (!entry)
+    return;
+
+  std::set<int>::iterator stub = stubs_.find(entry->GetUniqueID());
+  if (stub == stubs_.end())
+    return;
+  stubs_.erase(stub);
+
+  std::map<int, std::string>::const_iterator serialized =
+      serialized_entries_.find(entry->GetUniqueID());
+  if (serialized == serialized_entries_.end())
+    return;
+
+  Pickle pickle;
+  pickle.WriteBytes(serialized->second.data(), serialized->second.size());
+  PickleIterator iterator(pickle);
+  SerializedNavigationEntry navigation;
+  if (!navigation.ReadFromPickle(&iterator))
+    return;
+
+  // Everything ToNavigationEntry() sets, the stub has to end up as if it
+  // was restored complete.
+  scoped_ptr<NavigationEntry> restored(navigation.ToNavigationEntry(
+      entry->GetPageID(), controller_.GetBrowserContext()));
+  entry->SetVirtualURL(restored->GetVirtualURL());
+  entry->SetReferrer(restored->GetReferrer());
+  entry->SetTitle(restored->GetTitle());
+  entry->SetTransitionType(restored->GetTransitionType());
+  entry->SetPageState(restored->GetPageState());
+  entry->SetHasPostData(restored->GetHasPostData());
+  entry->SetPostID(restored->GetPostID());
+  entry->SetOriginalRequestURL(restored->GetOriginalRequestURL());
+  entry->SetIsOverridingUserAgent(restored->GetIsOverridingUserAgent());
+  entry->SetTimestamp(restored->GetTimestamp());
+  entry->SetHttpStatusCode(restored->GetHttpStatusCode());
+  entry->SetRedirectChain(restored->GetRedirectChain());
+  entry->GetFavicon() = restored->GetFavicon();
+
+  base::string16 search_terms;
+  if (restored->GetExtraData(kSearchTermsKey, &search_terms))
+    entry->SetExtraData(kSearchTermsKey, search_terms);
+}
+
+int SessionJournalEfl::PrunedSinceBaseline() const {
+  // Entries added after the last checkpoint are not in it, dropping them
+  // does not concern its readers.
+  if (checkpoint_sequence_ < 0)
+    return 0;
+  return std::min(pruned_from_front_,
+                  static_cast<int>(checkpoint_entry_ids_.size()));
+}
+
+void SessionJournalEfl::ResetBaseline(int sequence, int pruned_total) {
+  checkpoint_sequence_ = sequence;
+  checkpoint_pruned_total_ = pruned_total;
+  checkpoint_current_index_ = controller_.GetCurrentEntryIndex();
+  changed_entry_ids_.clear();
+  pruned_from_front_ = 0;
+
+  checkpoint_entry_ids_.clear();
+  const int entry_count = controller_.GetEntryCount();
+  for (int i = 0; i < entry_count; ++i)
+    checkpoint_entry_ids_.push_back(
+        controller_.GetEntryAtIndex(i)->GetUniqueID());
+}
+
+void SessionJournalEfl::ForgetDroppedEntries() {
+  std::set<int> live_ids;
+  const int entry_count = controller_.GetEntryCount();
+  for (int i = 0; i < entry_count; ++i)
+    live_ids.insert(controller_.GetEntryAtIndex(i)->GetUniqueID());
+
+  for (std::map<int, std::string>::iterator it = serialized_entries_.begin();
+       it != serialized_entries_.end();) {
+    if (live_ids.count(it->first)) {
+      ++it;
+    } else {
+      stubs_.erase(it->first);
+      serialized_entries_.erase(it++);
+    }
+  }
+}
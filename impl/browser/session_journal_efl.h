@@ -0,0 +1,150 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SESSION_JOURNAL_EFL_H_
+#define SESSION_JOURNAL_EFL_H_
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/memory/weak_ptr.h"
+#include "components/sessions/serialized_navigation_entry.h"
+#include "content/public/browser/notification_observer.h"
+#include "content/public/browser/notification_registrar.h"
+#include "content/public/browser/web_contents_observer.h"
+
+class Pickle;
+class PickleIterator;
+
+namespace content {
+class NavigationController;
+class NavigationEntry;
+}
+
+// Keeps the serialized form of every navigation entry of a view, so session
+// data is written without serializing entries which did not change again.
+//
+// Besides the full snapshot RestoreFromSessionData always accepted, it writes
+// checkpoints holding only the entries changed since the previous one. The
+// embedder appends them to its stored session, a snapshot followed by any
+// number of checkpoints restores like a single snapshot. Snapshots do not
+// interrupt the checkpoints, one taken between two checkpoints records where
+// it stands so that the checkpoints written after it apply on top of it.
+//
+// Restored entries other than the current one stay stubs holding only what
+// the back forward list shows, the rest is filled in from the journal when
+// they are navigated to.
+class SessionJournalEfl : public content::WebContentsObserver,
+                          public content::NotificationObserver {
+ public:
+  // Entries read from session data, not bound to any view yet.
+  struct ParsedSession {
+    ParsedSession();
+    ~ParsedSession();
+
+    std::vector<sessions::SerializedNavigationEntry> entries;
+    int current_index;
+    // Sequence of the checkpoint the data ends with, -1 if the next
+    // checkpoint has to hold all entries.
+    int sequence;
+    // Entries dropped from the front since the first checkpoint.
+    int pruned_total;
+  };
+
+  explicit SessionJournalEfl(content::WebContents* web_contents);
+  virtual ~SessionJournalEfl();
+
+  // Reads a snapshot optionally followed by checkpoints, or checkpoints
+  // alone if the first one was written before any snapshot. Touches no
+  // view, so it can be called on any thread.
+  static bool Parse(const char* data, unsigned length, ParsedSession* session);
+
+  // Writes all entries to |pickle|. Checkpoints are not affected, the next
+  // one still holds the changes since the previous checkpoint and can be
+  // appended to this snapshot as well.
+  void WriteSnapshot(Pickle* pickle);
+  // Writes the entries changed since the previous checkpoint to |pickle|. Returns false, leaving |pickle| untouched, if nothing changed.
+  bool WriteCheckpoint(Pickle* pickle);
+
+  // Parses |data| and restores it with the current entry complete.
+  bool Restore(const char* data, unsigned length);
+  // Restores the parsed entries into the view. Returns false, restoring
+  // nothing, if the view has history already. Unless
+  // |complete_current_entry| is set, the current entry is a stub too, for
+  // views which are not shown yet.
+  bool Restore(const ParsedSession& session, bool complete_current_entry);
+
+  base::WeakPtr<SessionJournalEfl> AsWeakPtr();
+
+  // content::WebContentsObserver implementation.
+  virtual void AboutToNavigateRenderView(
+      content::RenderViewHost* render_view_host) override;
+
+  // content::NotificationObserver implementation.
+  virtual void Observe(int type,
+                       const content::NotificationSource& source,
+                       const content::NotificationDetails& details) override;
+
+ private:
+  typedef std::vector<sessions::SerializedNavigationEntry> SerializedEntries;
+
+  // Creates an entry holding only what the back forward list shows.
+  content::NavigationEntry* CreateStub(
+      const sessions::SerializedNavigationEntry& navigation,
+      int page_id) const;
+  static bool ReadSnapshot(PickleIterator* iterator,
+                           int entry_count,
+                           SerializedEntries* entries,
+                           int* current_index,
+                           int* sequence,
+                           int* pruned_total);
+  static bool ReadCheckpoint(PickleIterator* iterator,
+                             int* last_sequence,
+                             int* pruned_total,
+                             SerializedEntries* entries,
+                             int* current_index);
+
+  // Returns the serialized entry at |index|, serializing it only if it is new
+  // or changed since it was last serialized.
+  const std::string& SerializedEntryAt(int index);
+  void EntryChanged(const content::NavigationEntry* entry);
+  // Completes a stub left by Restore() with the data kept in the journal.
+  void MaterializeEntry(content::NavigationEntry* entry);
+  // Entries dropped from the front since the last checkpoint which it held.
+  int PrunedSinceBaseline() const;
+  // Makes the current entries the base of the next checkpoint.
+  void ResetBaseline(int sequence, int pruned_total);
+  // Forgets the serialized form of entries the controller dropped.
+  void ForgetDroppedEntries();
+
+  content::NavigationController& controller_;
+  content::NotificationRegistrar registrar_;
+
+  // Serialized entries by unique id.
+  std::map<int, std::string> serialized_entries_;
+  // Unique ids of restored entries not completed yet.
+  std::set<int> stubs_;
+
+  // State of the entries when the last checkpoint was written.
+  // The sequence is -1 until the first one, the next checkpoint then holds
+  // all entries.
+  int checkpoint_sequence_;
+  std::vector<int> checkpoint_entry_ids_;
+  int checkpoint_current_index_;
+  // Entries dropped from the front before the last checkpoint, since the
+  // first one. Checkpoints and snapshots record it so that readers know
+  // how many of the entries they hold are gone.
+  int checkpoint_pruned_total_;
+  // Changes since the last checkpoint.
+  std::set<int> changed_entry_ids_;
+  int pruned_from_front_;
+
+  base::WeakPtrFactory<SessionJournalEfl> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(SessionJournalEfl);
+};
+
+#endif  // SESSION_JOURNAL_EFL_H_
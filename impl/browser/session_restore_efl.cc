@@ -0,0 +1,120 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "browser/session_restore_efl.h"
+
+#include "base/bind.h"
+#include "base/metrics/histogram.h"
+#include "base/threading/worker_pool.h"
+#include "content/public/browser/browser_thread.h"
+#include "eweb_view.h"
+
+using content::BrowserThread;
+
+SessionRestoreEfl::ViewSession::ViewSession()
+    : evas_object(NULL),
+      parsed(false),
+      valid(false),
+      restored(false) {
+}
+
+SessionRestoreEfl::ViewSession::~ViewSession() {
+}
+
+// static
+void SessionRestoreEfl::Start(
+    const std::vector<EWebView*>& views,
+    const std::vector<std::string>& data,
+    size_t foreground_index,
+    tizen_webview::Context_Session_Restore_Callback callback,
+    void* user_data) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  DCHECK_EQ(views.size(), data.size());
+
+  scoped_refptr<SessionRestoreEfl> restore(
+      new SessionRestoreEfl(foreground_index, callback, user_data));
+
+  for (size_t i = 0; i < views.size(); ++i) {
+    ViewSession* view = new ViewSession;
+    view->journal = views[i]->session_journal()->AsWeakPtr();
+    view->evas_object = views[i]->evas_object();
+    view->data = data[i];
+    restore->views_.push_back(view);
+  }
+
+  // Views are not added once the tasks are posted, the worker pool only
+  // touches the view it was given.
+  for (size_t i = 0; i < restore->views_.size(); ++i) {
+    ViewSession* view = restore->views_[i];
+    bool posted = base::WorkerPool::PostTaskAndReply(FROM_HERE,
+        base::Bind(&SessionRestoreEfl::ParseSession, base::Unretained(view)),
+        base::Bind(&SessionRestoreEfl::OnSessionParsed, restore, i),
+        false);
+    if (!posted) {
+      ParseSession(view);
+      restore->OnSessionParsed(i);
+    }
+  }
+}
+
+SessionRestoreEfl::SessionRestoreEfl(
+    size_t foreground_index,
+    tizen_webview::Context_Session_Restore_Callback callback,
+    void* user_data)
+    : foreground_index_(foreground_index),
+      foreground_restored_(false),
+      start_time_(base::TimeTicks::Now()),
+      callback_(callback),
+      user_data_(user_data) {
+}
+
+SessionRestoreEfl::~SessionRestoreEfl() {
+}
+
+// static
+void SessionRestoreEfl::ParseSession(ViewSession* view) {
+  view->valid = SessionJournalEfl::Parse(view->data.data(), view->data.size(),
+                                         &view->session);
+  std::string().swap(view->data);
+}
+
+void SessionRestoreEfl::OnSessionParsed(size_t index) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  ViewSession* view = views_[index];
+  view->parsed = true;
+
+  if (foreground_index_ >= views_.size())
+    foreground_restored_ = true;
+
+  if (index == foreground_index_) {
+    RestoreView(view, true);
+    foreground_restored_ = true;
+    UMA_HISTOGRAM_TIMES("Efl.SessionRestore.ForegroundTime",
+                        base::TimeTicks::Now() - start_time_);
+
+    for (size_t i = 0; i < views_.size(); ++i) {
+      if (views_[i]->parsed && !views_[i]->restored)
+        RestoreView(views_[i], false);
+    }
+    return;
+  }
+
+  if (foreground_restored_)
+    RestoreView(view, false);
+}
+
+void SessionRestoreEfl::RestoreView(ViewSession* view,
+                                    bool complete_current_entry) {
+  view->restored = true;
+  // The view may have navigated while its session was read.
+  if (view->valid && view->journal &&
+      !view->journal->Restore(view->session, complete_current_entry))
+    view->valid = false;
+
+  // Not needed anymore, the journal keeps what it restored.
+  view->session.entries.clear();
+
+  if (view->journal && callback_)
+    callback_(view->evas_object, view->valid, user_data_);
+}
@@ -0,0 +1,74 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SESSION_RESTORE_EFL_H_
+#define SESSION_RESTORE_EFL_H_
+
+#include <string>
+#include <vector>
+
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_vector.h"
+#include "base/time/time.h"
+#include "browser/session_journal_efl.h"
+#include "tizen_webview/public/tw_callbacks.h"
+
+class EWebView;
+
+// Restores the sessions of several views at once. The session data of each
+// view is parsed and validated on the worker pool, in parallel, and applied
+// on the UI thread. The foreground view is restored first and completely,
+// the other views only get stub entries and load nothing until shown.
+class SessionRestoreEfl
+    : public base::RefCountedThreadSafe<SessionRestoreEfl> {
+ public:
+  // |views| must not have any history yet and must not repeat. |callback| is
+  // called once for every view still alive when its session was read, with
+  // failure if the view navigated in the meantime.
+  static void Start(const std::vector<EWebView*>& views,
+                    const std::vector<std::string>& data,
+                    size_t foreground_index,
+                    tizen_webview::Context_Session_Restore_Callback callback,
+                    void* user_data);
+
+ private:
+  friend class base::RefCountedThreadSafe<SessionRestoreEfl>;
+
+  struct ViewSession {
+    ViewSession();
+    ~ViewSession();
+
+    base::WeakPtr<SessionJournalEfl> journal;
+    Evas_Object* evas_object;
+    // Released once parsed.
+    std::string data;
+    SessionJournalEfl::ParsedSession session;
+    bool parsed;
+    bool valid;
+    bool restored;
+  };
+
+  SessionRestoreEfl(size_t foreground_index,
+                    tizen_webview::Context_Session_Restore_Callback callback,
+                    void* user_data);
+  ~SessionRestoreEfl();
+
+  // Called on the worker pool.
+  static void ParseSession(ViewSession* view);
+
+  void OnSessionParsed(size_t index);
+  void RestoreView(ViewSession* view, bool complete_current_entry);
+
+  ScopedVector<ViewSession> views_;
+  size_t foreground_index_;
+  // Background views are held back until the foreground view is restored.
+  bool foreground_restored_;
+  base::TimeTicks start_time_;
+  tizen_webview::Context_Session_Restore_Callback callback_;
+  void* user_data_;
+
+  DISALLOW_COPY_AND_ASSIGN(SessionRestoreEfl);
+};
+
+#endif  // SESSION_RESTORE_EFL_H_
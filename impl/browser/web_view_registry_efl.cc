@@ -0,0 +1,185 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "browser/web_view_registry_efl.h"
+
+#include "base/bind.h"
+#include "base/memory/singleton.h"
+#include "content/public/browser/browser_thread.h"
+
+using content::BrowserThread;
+using content::WebContentsDelegateEfl;
+
+WebViewRegistryEfl::Settings::Settings()
+    : navigation_policy_enabled(true),
+      download_start_callback(false) {
+}
+
+WebViewRegistryEfl::Settings::~Settings() {
+}
+
+WebViewRegistryEfl::Handle::Handle()
+    : render_process_id_(0),
+      routing_id_(0),
+      resolved_(false) {
+}
+
+WebViewRegistryEfl::Handle::~Handle() {
+}
+
+WebContentsDelegateEfl* WebViewRegistryEfl::Handle::Get() const {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  if (resolved_)
+    return delegate_.get();
+
+  // The IO thread did not know the id yet, the UI thread map is always
+  // up to date.
+  Handle handle = WebViewRegistryEfl::GetInstance()->Lookup(
+      render_process_id_, routing_id_);
+  return handle.delegate_.get();
+}
+
+const WebViewRegistryEfl::Settings*
+WebViewRegistryEfl::Handle::settings() const {
+  return settings_.get() ? &settings_->data : NULL;
+}
+
+WebViewRegistryEfl::Entry::Entry() {
+}
+
+WebViewRegistryEfl::Entry::~Entry() {
+}
+
+// static
+WebViewRegistryEfl* WebViewRegistryEfl::GetInstance() {
+  // Leaky, IO thread tasks may still reference it during shutdown.
+  return Singleton<WebViewRegistryEfl,
+                   LeakySingletonTraits<WebViewRegistryEfl> >::get();
+}
+
+WebViewRegistryEfl::WebViewRegistryEfl() {
+}
+
+WebViewRegistryEfl::~WebViewRegistryEfl() {
+}
+
+void WebViewRegistryEfl::Register(
+    int render_process_id, int routing_id,
+    const base::WeakPtr<WebContentsDelegateEfl>& delegate) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  RoutingKey key(render_process_id, routing_id);
+  Entry& entry = ui_handles_[key];
+  entry.delegate = delegate;
+  SettingsMap::const_iterator settings = ui_settings_.find(delegate.get());
+  entry.settings = settings != ui_settings_.end() ? settings->second : NULL;
+
+  BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+      base::Bind(&WebViewRegistryEfl::RegisterOnIOThread,
+                 base::Unretained(this), key, entry));
+}
+
+void WebViewRegistryEfl::Unregister(int render_process_id, int routing_id) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  RoutingKey key(render_process_id, routing_id);
+  if (!ui_handles_.erase(key))
+    return;
+
+  BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+      base::Bind(&WebViewRegistryEfl::UnregisterOnIOThread,
+                 base::Unretained(this), key));
+}
+
+void WebViewRegistryEfl::UnregisterAll(const WebContentsDelegateEfl* delegate) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  ui_settings_.erase(delegate);
+
+  HandleMap::iterator it = ui_handles_.begin();
+  while (it != ui_handles_.end()) {
+    HandleMap::iterator current = it++;
+    if (current->second.delegate.get() &&
+        current->second.delegate.get() != delegate)
+      continue;
+
+    BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+        base::Bind(&WebViewRegistryEfl::UnregisterOnIOThread,
+                   base::Unretained(this), current->first));
+    ui_handles_.erase(current);
+  }
+}
+
+void WebViewRegistryEfl::PublishSettings(const WebContentsDelegateEfl* delegate,
+                                         const Settings& settings) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  DCHECK(delegate);
+  scoped_refptr<SettingsSnapshot> snapshot(new SettingsSnapshot(settings));
+  ui_settings_[delegate] = snapshot;
+
+  std::vector<RoutingKey> keys;
+  for (HandleMap::iterator it = ui_handles_.begin();
+       it != ui_handles_.end(); ++it) {
+    if (it->second.delegate.get() != delegate)
+      continue;
+    it->second.settings = snapshot;
+    keys.push_back(it->first);
+  }
+
+  if (keys.empty())
+    return;
+
+  BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+      base::Bind(&WebViewRegistryEfl::PublishSettingsOnIOThread,
+                 base::Unretained(this), keys, snapshot));
+}
+
+WebViewRegistryEfl::Handle WebViewRegistryEfl::Lookup(int render_process_id,
+                                                      int routing_id) const {
+  Handle handle;
+  handle.render_process_id_ = render_process_id;
+  handle.routing_id_ = routing_id;
+
+  const HandleMap* handles = MapForCurrentThread();
+  HandleMap::const_iterator it =
+      handles->find(RoutingKey(render_process_id, routing_id));
+  if (it != handles->end()) {
+    handle.delegate_ = it->second.delegate;
+    handle.settings_ = it->second.settings;
+    handle.resolved_ = true;
+  } else {
+    // Unknown on the UI thread means gone, there is nothing to retry.
+    handle.resolved_ = BrowserThread::CurrentlyOn(BrowserThread::UI);
+  }
+  return handle;
+}
+
+void WebViewRegistryEfl::RegisterOnIOThread(const RoutingKey& key,
+                                            const Entry& entry) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  io_handles_[key] = entry;
+}
+
+void WebViewRegistryEfl::UnregisterOnIOThread(const RoutingKey& key) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  io_handles_.erase(key);
+}
+
+void WebViewRegistryEfl::PublishSettingsOnIOThread(
+    const std::vector<RoutingKey>& keys,
+    const scoped_refptr<SettingsSnapshot>& settings) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  for (size_t i = 0; i < keys.size(); ++i) {
+    HandleMap::iterator it = io_handles_.find(keys[i]);
+    // Unregistered since, the removal is already queued behind us.
+    if (it != io_handles_.end())
+      it->second.settings = settings;
+  }
+}
+
+const WebViewRegistryEfl::HandleMap*
+WebViewRegistryEfl::MapForCurrentThread() const {
+  if (BrowserThread::CurrentlyOn(BrowserThread::UI))
+    return &ui_handles_;
+
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  return &io_handles_;
+}
@@ -0,0 +1,129 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef WEB_VIEW_REGISTRY_EFL_H_
+#define WEB_VIEW_REGISTRY_EFL_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "browser/response_policy_filter_efl.h"
+
+template <typename T> struct LeakySingletonTraits;
+
+namespace content {
+class WebContentsDelegateEfl;
+}
+
+// Maps the routing ids of render views and render frames to the view which
+// owns them, together with the settings of that view requests depend on.
+// WebContentsDelegateEfl keeps it up to date on the UI thread and mirrors
+// every change to the IO thread, so requests can find their view and decide
+// what to do with them where they live, without a lock and without hopping
+// to the UI thread.
+class WebViewRegistryEfl {
+ public:
+  // Per-view settings read on the IO thread. A published copy is never
+  // modified, the UI thread publishes a new one instead.
+  struct Settings {
+    Settings();
+    ~Settings();
+
+    // Whether the application decides on navigations.
+    bool navigation_policy_enabled;
+    // Which responses the application decides on.
+    ResponsePolicyFilterEfl::Filter response_policy_filter;
+    // Whether the context has a download start callback to run.
+    bool download_start_callback;
+    // Added to every request of the view.
+    std::map<std::string, std::string> custom_headers;
+  };
+
+  // Weak reference to a view. It can be looked up and passed around on the
+  // IO thread, but only dereferenced on the UI thread.
+  class Handle {
+   public:
+    Handle();
+    ~Handle();
+
+    // Returns NULL once the view is gone. UI thread only.
+    content::WebContentsDelegateEfl* Get() const;
+
+    // The settings the view had when the handle was looked up, NULL if the
+    // calling thread did not know the ids. Any thread.
+    const Settings* settings() const;
+
+   private:
+    friend class WebViewRegistryEfl;
+
+    int render_process_id_;
+    int routing_id_;
+    // Set when the lookup was answered from the calling thread's map.
+    bool resolved_;
+    base::WeakPtr<content::WebContentsDelegateEfl> delegate_;
+    scoped_refptr<base::RefCountedData<Settings> > settings_;
+  };
+
+  static WebViewRegistryEfl* GetInstance();
+
+  // Called on the UI thread. |routing_id| may be a render view or a render
+  // frame routing id, both are allocated from the same per process space.
+  // The id gets the settings |delegate| published last.
+  void Register(int render_process_id, int routing_id,
+                const base::WeakPtr<content::WebContentsDelegateEfl>& delegate);
+  void Unregister(int render_process_id, int routing_id);
+  // Drops every id of |delegate|, which is being destroyed.
+  void UnregisterAll(const content::WebContentsDelegateEfl* delegate);
+
+  // Called on the UI thread whenever a setting of |delegate|'s view
+  // changes. Applies to the ids already registered and to later ones.
+  void PublishSettings(const content::WebContentsDelegateEfl* delegate,
+                       const Settings& settings);
+
+  // Called on the UI or the IO thread. Ids the IO thread does not know yet
+  // are resolved again on the UI thread by Handle::Get().
+  Handle Lookup(int render_process_id, int routing_id) const;
+
+ private:
+  friend struct LeakySingletonTraits<WebViewRegistryEfl>;
+
+  typedef std::pair<int, int> RoutingKey;
+  typedef base::RefCountedData<Settings> SettingsSnapshot;
+
+  struct Entry {
+    Entry();
+    ~Entry();
+
+    base::WeakPtr<content::WebContentsDelegateEfl> delegate;
+    scoped_refptr<SettingsSnapshot> settings;
+  };
+
+  typedef std::map<RoutingKey, Entry> HandleMap;
+  typedef std::map<const content::WebContentsDelegateEfl*,
+                   scoped_refptr<SettingsSnapshot> > SettingsMap;
+
+  WebViewRegistryEfl();
+  ~WebViewRegistryEfl();
+
+  void RegisterOnIOThread(const RoutingKey& key, const Entry& entry);
+  void UnregisterOnIOThread(const RoutingKey& key);
+  void PublishSettingsOnIOThread(const std::vector<RoutingKey>& keys,
+                                 const scoped_refptr<SettingsSnapshot>& settings);
+
+  const HandleMap* MapForCurrentThread() const;
+
+  // Each map is only touched on its own thread.
+  HandleMap ui_handles_;
+  HandleMap io_handles_;
+  // Latest settings of each view, for the ids it registers later. UI
+  // thread only.
+  SettingsMap ui_settings_;
+
+  DISALLOW_COPY_AND_ASSIGN(WebViewRegistryEfl);
+};
+
+#endif // WEB_VIEW_REGISTRY_EFL_H_
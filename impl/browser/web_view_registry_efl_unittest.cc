@@ -0,0 +1,182 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Tests for the settings WebViewRegistryEfl publishes to the IO thread: what
+// the UI thread publishes is what IO lookups see, ids registered later get
+// the latest settings, unknown ids have none, and a looked up snapshot does
+// not change under its reader.
+
+#include "browser/web_view_registry_efl.h"
+
+#include "base/at_exit.h"
+#include "base/bind.h"
+#include "base/bind_helpers.h"
+#include "base/memory/weak_ptr.h"
+#include "base/run_loop.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/test/test_browser_thread_bundle.h"
+#include "gtest/gtest.h"
+#include "url/gurl.h"
+
+using content::BrowserThread;
+using content::WebContentsDelegateEfl;
+
+namespace {
+
+// The registry is a singleton, every test uses a process id of its own.
+int g_next_process_id = 1000;
+
+// Views are only compared, never dereferenced.
+WebContentsDelegateEfl* FakeDelegate(int i) {
+  return reinterpret_cast<WebContentsDelegateEfl*>(0x1000 + i * 0x10);
+}
+
+void LookupOnIOThread(int render_process_id, int routing_id,
+                      WebViewRegistryEfl::Handle* handle) {
+  *handle = WebViewRegistryEfl::GetInstance()->Lookup(render_process_id,
+                                                      routing_id);
+}
+
+void ShouldAskOnIOThread(int render_process_id, int routing_id,
+                         const GURL& url, const std::string& mime_type,
+                         bool* ask) {
+  *ask = ResponsePolicyFilterEfl::GetInstance()->ShouldAsk(
+      render_process_id, routing_id, url, mime_type);
+}
+
+} // namespace
+
+class WebViewRegistryEflTest : public testing::Test {
+ protected:
+  WebViewRegistryEflTest()
+    : thread_bundle_(content::TestBrowserThreadBundle::REAL_IO_THREAD),
+      process_id_(g_next_process_id++),
+      delegate_(FakeDelegate(process_id_)) {
+  }
+
+  virtual ~WebViewRegistryEflTest() {
+    registry()->UnregisterAll(delegate_.GetWeakPtr().get());
+    // Lets the IO thread drop the ids before the bundle goes away.
+    RunOnIOThread(base::Bind(&base::DoNothing));
+  }
+
+  WebViewRegistryEfl* registry() { return WebViewRegistryEfl::GetInstance(); }
+
+  void Register(int routing_id) {
+    registry()->Register(process_id_, routing_id, delegate_.GetWeakPtr());
+  }
+
+  void Publish(const WebViewRegistryEfl::Settings& settings) {
+    registry()->PublishSettings(delegate_.GetWeakPtr().get(), settings);
+  }
+
+  // Runs |task| on the IO thread after everything already posted to it.
+  void RunOnIOThread(const base::Closure& task) {
+    base::RunLoop run_loop;
+    BrowserThread::PostTaskAndReply(BrowserThread::IO, FROM_HERE, task,
+                                    run_loop.QuitClosure());
+    run_loop.Run();
+  }
+
+  WebViewRegistryEfl::Handle LookupOnIO(int routing_id) {
+    WebViewRegistryEfl::Handle handle;
+    RunOnIOThread(base::Bind(&LookupOnIOThread, process_id_, routing_id,
+                             &handle));
+    return handle;
+  }
+
+  bool ShouldAskOnIO(int routing_id, const std::string& mime_type) {
+    bool ask = false;
+    RunOnIOThread(base::Bind(&ShouldAskOnIOThread, process_id_, routing_id,
+                             GURL("http://example.com/file"), mime_type,
+                             &ask));
+    return ask;
+  }
+
+  content::TestBrowserThreadBundle thread_bundle_;
+  int process_id_;
+  base::WeakPtrFactory<WebContentsDelegateEfl> delegate_;
+};
+
+TEST_F(WebViewRegistryEflTest, IOThreadSeesPublishedSettings) {
+  Register(1);
+  Register(2);
+
+  WebViewRegistryEfl::Settings settings;
+  settings.navigation_policy_enabled = false;
+  settings.download_start_callback = true;
+  settings.custom_headers["X-Test"] = "1";
+  Publish(settings);
+
+  for (int routing_id = 1; routing_id <= 2; ++routing_id) {
+    WebViewRegistryEfl::Handle handle = LookupOnIO(routing_id);
+    ASSERT_TRUE(handle.settings());
+    EXPECT_FALSE(handle.settings()->navigation_policy_enabled);
+    EXPECT_TRUE(handle.settings()->download_start_callback);
+    ASSERT_EQ(1u, handle.settings()->custom_headers.size());
+    EXPECT_EQ("1", handle.settings()->custom_headers.find("X-Test")->second);
+  }
+}
+
+TEST_F(WebViewRegistryEflTest, LaterIdsGetLatestSettings) {
+  WebViewRegistryEfl::Settings settings;
+  settings.navigation_policy_enabled = false;
+  Publish(settings);
+
+  // E.g. a subframe created after the view published its settings.
+  Register(3);
+  WebViewRegistryEfl::Handle handle = LookupOnIO(3);
+  ASSERT_TRUE(handle.settings());
+  EXPECT_FALSE(handle.settings()->navigation_policy_enabled);
+}
+
+TEST_F(WebViewRegistryEflTest, UnknownIdsHaveNoSettings) {
+  EXPECT_FALSE(LookupOnIO(1).settings());
+
+  Register(1);
+  Publish(WebViewRegistryEfl::Settings());
+  EXPECT_TRUE(LookupOnIO(1).settings());
+
+  registry()->Unregister(process_id_, 1);
+  EXPECT_FALSE(LookupOnIO(1).settings());
+}
+
+TEST_F(WebViewRegistryEflTest, HandlesKeepTheirSnapshot) {
+  Register(1);
+  WebViewRegistryEfl::Settings settings;
+  settings.custom_headers["X-Test"] = "old";
+  Publish(settings);
+  WebViewRegistryEfl::Handle old_handle = LookupOnIO(1);
+
+  settings.custom_headers["X-Test"] = "new";
+  Publish(settings);
+  WebViewRegistryEfl::Handle new_handle = LookupOnIO(1);
+
+  ASSERT_TRUE(old_handle.settings());
+  ASSERT_TRUE(new_handle.settings());
+  EXPECT_EQ("old", old_handle.settings()->custom_headers.find("X-Test")->second);
+  EXPECT_EQ("new", new_handle.settings()->custom_headers.find("X-Test")->second);
+}
+
+TEST_F(WebViewRegistryEflTest, ResponsePolicyFollowsPublishedFilter) {
+  // Views the IO thread does not know are always asked.
+  EXPECT_TRUE(ShouldAskOnIO(1, "text/html"));
+
+  Register(1);
+  WebViewRegistryEfl::Settings settings;
+  settings.response_policy_filter.mime_types.push_back("application/*");
+  Publish(settings);
+  EXPECT_TRUE(ShouldAskOnIO(1, "application/pdf"));
+  EXPECT_FALSE(ShouldAskOnIO(1, "text/html"));
+
+  settings.response_policy_filter.enabled = false;
+  Publish(settings);
+  EXPECT_FALSE(ShouldAskOnIO(1, "application/pdf"));
+}
+
+int main(int argc, char** argv) {
+  base::AtExitManager at_exit;
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -109,6 +109,9 @@ net::URLRequestContextGetter* BrowserContextEfl::CreateRequestContext(
       protocol_handlers,
       request_interceptors.Pass(),
       NULL);
+  // The HTTP cache backend is sized by the cache model of the context.
+  if (web_context_->web_cache_manager())
+    web_context_->web_cache_manager()->ApplyHttpCacheSizes();
   GetRequestContext();
   resource_context_->set_url_request_context_getter(request_context_getter_.get());
   return request_context_getter_.get();
@@ -46,6 +46,7 @@
       '<(chrome_src_dir)/content/content.gyp:content_app_browser',
       '<(chrome_src_dir)/content/content_shell_and_tests.gyp:content_shell_resources',
       '<(chrome_src_dir)/content/content_shell_and_tests.gyp:content_shell_pak',
+      '<(chrome_src_dir)/net/net.gyp:net_with_v8',
       '<(chrome_src_dir)/components/components.gyp:visitedlink_browser',
       '<(chrome_src_dir)/components/components.gyp:visitedlink_renderer',
       '<(chrome_src_dir)/third_party/icu/icu.gyp:icuuc',
@@ -92,6 +93,8 @@
       'API/ewk_window_features_private.h',
       'EdgeEffect.cpp',
       'EdgeEffect.h',
+      'browser/async_hit_test_queue_efl.cc',
+      'browser/async_hit_test_queue_efl.h',
       'browser/autofill/autofill_manager_delegate_efl.cc',
       'browser/autofill/autofill_manager_delegate_efl.h',
       'browser/autofill/personal_data_manager_factory.cc',
@@ -103,6 +106,8 @@
       'browser/disambiguation_popup_efl.h',
       'browser/download_manager_delegate_efl.cc',
       'browser/download_manager_delegate_efl.h',
+      'browser/favicon/favicon_bitmap_cache.cc',
+      'browser/favicon/favicon_bitmap_cache.h',
       'browser/favicon/favicon_commands.cc',
       'browser/favicon/favicon_commands.h',
       'browser/favicon/favicon_database.cc',
@@ -111,6 +116,8 @@
       'browser/favicon/favicon_database_p.h',
       'browser/favicon/favicon_downloader.cc',
       'browser/favicon/favicon_downloader.h',
+      'browser/favicon/favicon_fetch_scheduler.cc',
+      'browser/favicon/favicon_fetch_scheduler.h',
       'browser/favicon/favicon_service.cc',
       'browser/favicon/favicon_service.h',
       'browser/geolocation/access_token_store_efl.cc',
@@ -120,6 +127,8 @@
       #'browser/geolocation/geolocation_permission_context_efl.h',
       'browser/geolocation/location_provider_efl.cc',
       'browser/geolocation/location_provider_efl.h',
+      'browser/hit_test_region_cache_efl.cc',
+      'browser/hit_test_region_cache_efl.h',
       'browser/inputpicker/InputPicker.cc',
       'browser/inputpicker/InputPicker.h',
       'browser/inputpicker/color_chooser_efl.cc',
@@ -130,6 +139,8 @@
       'browser/javascript_modal_dialog_efl.h',
       'browser/login_delegate_efl.cc',
       'browser/login_delegate_efl.h',
+      'browser/memory_sampler_efl.cc',
+      'browser/memory_sampler_efl.h',
       'browser/motion/wkext_motion.cc',
       'browser/motion/wkext_motion.h',
       'browser/motion/MotionUI.cc',
@@ -159,6 +170,8 @@
       'browser/policy_response_delegate_efl.h',
       'browser/renderer_host/browsing_data_remover_efl.cc',
       'browser/renderer_host/browsing_data_remover_efl.h',
+      'browser/renderer_host/frame_timing_recorder_efl.cc',
+      'browser/renderer_host/frame_timing_recorder_efl.h',
       'browser/renderer_host/im_context_efl.cc',
       'browser/renderer_host/im_context_efl.h',
       'browser/renderer_host/native_web_keyboard_event_efl.cc',
@@ -174,7 +187,13 @@
       'browser/renderer_host/web_cache_manager_efl.h',
       'browser/renderer_host/web_event_factory_efl.cc',
       'browser/renderer_host/web_event_factory_efl.h',
+      'browser/response_policy_filter_efl.cc',
+      'browser/response_policy_filter_efl.h',
       'browser/scoped_wait_for_ewk.h',
+      'browser/session_journal_efl.cc',
+      'browser/session_journal_efl.h',
+      'browser/session_restore_efl.cc',
+      'browser/session_restore_efl.h',
       'browser/selectpicker/WebPopupItem.cc',
       'browser/selectpicker/WebPopupItem.h',
       'browser/selectpicker/popup_menu_item.cc',
@@ -190,6 +209,8 @@
       'browser/web_contents/web_contents_view_efl.h',
       'browser/web_contents/web_drag_dest_efl.cc',
       'browser/web_contents/web_drag_dest_efl.h',
+      'browser/web_view_registry_efl.cc',
+      'browser/web_view_registry_efl.h',
       'browser/webdata/web_data_service.cc',
       'browser/webdata/web_data_service.h',
       'browser/webdata/web_data_service_factory.h',
@@ -204,6 +225,7 @@
 
       'common/content_client_efl.cc',
       'common/content_client_efl.h',
+      'common/hit_test_params_efl.h',
       'common/message_generator_efl.cc',
       'common/message_generator_efl.h',
       'common/render_messages_efl.h',
@@ -254,6 +276,8 @@
       'gl/gl_shared_context_efl.h',
       'gpu/gpu_thread_override_efl.cc',
       'gpu/gpu_thread_override_efl.h',
+      'http_cache_hot_tier_efl.cc',
+      'http_cache_hot_tier_efl.h',
       'http_user_agent_settings_efl.cc',
       'http_user_agent_settings_efl.h',
       'memory_purger.cc',
@@ -267,8 +291,12 @@
       'paths_efl.h',
       'popup_controller_efl.cc',
       'popup_controller_efl.h',
+      'proxy_config_service_efl.cc',
+      'proxy_config_service_efl.h',
       'renderer/content_renderer_client_efl.cc',
       'renderer/content_renderer_client_efl.h',
+      'renderer/navigation_policy_client_efl.cc',
+      'renderer/navigation_policy_client_efl.h',
       'renderer/print_pages_params.cc',
       'renderer/print_pages_params.h',
       'renderer/print_web_view_helper_efl.cc',
@@ -306,10 +334,14 @@
       'tizen_webview/public/tw_context_menu_controller.cc',
       'tizen_webview/public/tw_custom_handlers.h',
       'tizen_webview/public/tw_custom_handlers.cc',
+      'tizen_webview/public/tw_favicon_cache_statistics.h',
       'tizen_webview/public/tw_frame.h',
+      'tizen_webview/public/tw_frame_timing.h',
       'tizen_webview/public/tw_frame.cc',
       'tizen_webview/public/tw_hit_test.h',
       'tizen_webview/public/tw_hit_test.cc',
+      'tizen_webview/public/tw_http_cache_statistics.h',
+      'tizen_webview/public/tw_memory_sample.h',
       'tizen_webview/public/tw_notification.cc',
       'tizen_webview/public/tw_notification.h',
       'tizen_webview/public/tw_policy_decision.h',
@@ -456,5 +488,108 @@
       'chromium-efl',
     ],
   },
+  {
+    'target_name': 'efl_message_pump_unittests',
+    'type': '<(gtest_target_type)',
+    'include_dirs': [
+      '.',
+      '<(chrome_src_dir)',
+    ],
+    'sources': [
+      'message_pump_for_ui_efl.cc',
+      'message_pump_for_ui_efl.h',
+      'message_pump_for_ui_efl_unittest.cc',
+    ],
+    'dependencies': [
+      'chromium-efl-deps.gyp:efl',
+      '<(chrome_src_dir)/base/base.gyp:base',
+      '<(chrome_src_dir)/testing/gtest.gyp:gtest',
+    ],
+  },
+  {
+    'target_name': 'efl_favicon_database_perftests',
+    'type': '<(gtest_target_type)',
+    'include_dirs': [
+      '.',
+      '<(chrome_src_dir)',
+    ],
+    'sources': [
+      'browser/favicon/favicon_bitmap_cache.cc',
+      'browser/favicon/favicon_bitmap_cache.h',
+      'browser/favicon/favicon_commands.cc',
+      'browser/favicon/favicon_commands.h',
+      'browser/favicon/favicon_database.cc',
+      'browser/favicon/favicon_database.h',
+      'browser/favicon/favicon_database_p.cc',
+      'browser/favicon/favicon_database_p.h',
+      'browser/favicon/favicon_database_perftest.cc',
+    ],
+    'dependencies': [
+      '<(chrome_src_dir)/base/base.gyp:base',
+      '<(chrome_src_dir)/content/content.gyp:content_browser',
+      '<(chrome_src_dir)/skia/skia.gyp:skia',
+      '<(chrome_src_dir)/testing/gtest.gyp:gtest',
+      '<(chrome_src_dir)/third_party/sqlite/sqlite.gyp:sqlite',
+      '<(chrome_src_dir)/ui/gfx/gfx.gyp:gfx',
+      '<(chrome_src_dir)/url/url.gyp:url_lib',
+    ],
+  },
+  {
+    'target_name': 'efl_favicon_fetch_scheduler_unittests',
+    'type': '<(gtest_target_type)',
+    'include_dirs': [
+      '.',
+      '<(chrome_src_dir)',
+    ],
+    'sources': [
+      'browser/favicon/favicon_bitmap_cache.cc',
+      'browser/favicon/favicon_bitmap_cache.h',
+      'browser/favicon/favicon_commands.cc',
+      'browser/favicon/favicon_commands.h',
+      'browser/favicon/favicon_database.cc',
+      'browser/favicon/favicon_database.h',
+      'browser/favicon/favicon_database_p.cc',
+      'browser/favicon/favicon_database_p.h',
+      'browser/favicon/favicon_downloader.cc',
+      'browser/favicon/favicon_downloader.h',
+      'browser/favicon/favicon_fetch_scheduler.cc',
+      'browser/favicon/favicon_fetch_scheduler.h',
+      'browser/favicon/favicon_fetch_scheduler_unittest.cc',
+      'browser/favicon/favicon_service.cc',
+      'browser/favicon/favicon_service.h',
+    ],
+    'dependencies': [
+      '<(chrome_src_dir)/base/base.gyp:base',
+      '<(chrome_src_dir)/content/content.gyp:content_browser',
+      '<(chrome_src_dir)/content/content_shell_and_tests.gyp:test_support_content',
+      '<(chrome_src_dir)/skia/skia.gyp:skia',
+      '<(chrome_src_dir)/testing/gtest.gyp:gtest',
+      '<(chrome_src_dir)/third_party/sqlite/sqlite.gyp:sqlite',
+      '<(chrome_src_dir)/ui/gfx/gfx.gyp:gfx',
+      '<(chrome_src_dir)/url/url.gyp:url_lib',
+    ],
+  },
+  {
+    'target_name': 'efl_web_view_registry_unittests',
+    'type': '<(gtest_target_type)',
+    'include_dirs': [
+      '.',
+      '<(chrome_src_dir)',
+    ],
+    'sources': [
+      'browser/response_policy_filter_efl.cc',
+      'browser/response_policy_filter_efl.h',
+      'browser/web_view_registry_efl.cc',
+      'browser/web_view_registry_efl.h',
+      'browser/web_view_registry_efl_unittest.cc',
+    ],
+    'dependencies': [
+      '<(chrome_src_dir)/base/base.gyp:base',
+      '<(chrome_src_dir)/content/content.gyp:content_browser',
+      '<(chrome_src_dir)/content/content_shell_and_tests.gyp:test_support_content',
+      '<(chrome_src_dir)/testing/gtest.gyp:gtest',
+      '<(chrome_src_dir)/url/url.gyp:url_lib',
+    ],
+  },
   ],
 }
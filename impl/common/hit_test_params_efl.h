@@ -0,0 +1,51 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef HIT_TEST_PARAMS_EFL_H_
+#define HIT_TEST_PARAMS_EFL_H_
+
+#include <vector>
+
+#include "API/ewk_hit_test_private.h"
+#include "tizen_webview/public/tw_hit_test.h"
+#include "ui/gfx/point.h"
+#include "ui/gfx/rect.h"
+
+// One point of a batched EwkViewMsg_DoHitTestAsync request, |point| is in
+// view coordinates.
+struct HitTestAsyncQueryEfl {
+  int query_id;
+  gfx::Point point;
+  tizen_webview::Hit_Test_Mode mode;
+};
+
+// Renderer answer for one HitTestAsyncQueryEfl, |hit_test| and
+// |node_attributes| are only set if |valid|.
+struct HitTestAsyncResultEfl {
+  HitTestAsyncResultEfl() : query_id(0), valid(false) {}
+
+  int query_id;
+  bool valid;
+  _Ewk_Hit_Test hit_test;
+  NodeAttributesMap node_attributes;
+};
+
+// Area of the page (link, image or editable element) for which the renderer
+// already knows the TW_HIT_TEST_MODE_DEFAULT hit test result. |rect| is in
+// document coordinates, i.e. CSS pixels relative to the top left corner of
+// the main frame's contents. |id| is picked by the renderer, which uses it
+// to drop regions from the browser's copy one by one.
+struct HitTestRegionEfl {
+  HitTestRegionEfl() : id(0) {}
+
+  int id;
+  gfx::Rect rect;
+  _Ewk_Hit_Test hit_test;
+};
+
+typedef std::vector<HitTestAsyncQueryEfl> HitTestAsyncQueriesEfl;
+typedef std::vector<HitTestAsyncResultEfl> HitTestAsyncResultsEfl;
+typedef std::vector<HitTestRegionEfl> HitTestRegionsEfl;
+
+#endif // HIT_TEST_PARAMS_EFL_H_
@@ -13,6 +13,7 @@
 #include "API/ewk_hit_test_private.h"
 #include "API/ewk_text_style_private.h"
 #include "cache_params_efl.h"
+#include "common/hit_test_params_efl.h"
 #include "navigation_policy_params.h"
 #include "renderer/print_pages_params.h"
 #include "third_party/WebKit/public/web/WebNavigationPolicy.h"
@@ -113,6 +114,25 @@ IPC_STRUCT_TRAITS_BEGIN(_Ewk_Hit_Test)
 #endif
 IPC_STRUCT_TRAITS_END()
 
+IPC_STRUCT_TRAITS_BEGIN(HitTestRegionEfl)
+  IPC_STRUCT_TRAITS_MEMBER(id)
+  IPC_STRUCT_TRAITS_MEMBER(rect)
+  IPC_STRUCT_TRAITS_MEMBER(hit_test)
+IPC_STRUCT_TRAITS_END()
+
+IPC_STRUCT_TRAITS_BEGIN(HitTestAsyncQueryEfl)
+  IPC_STRUCT_TRAITS_MEMBER(query_id)
+  IPC_STRUCT_TRAITS_MEMBER(point)
+  IPC_STRUCT_TRAITS_MEMBER(mode)
+IPC_STRUCT_TRAITS_END()
+
+IPC_STRUCT_TRAITS_BEGIN(HitTestAsyncResultEfl)
+  IPC_STRUCT_TRAITS_MEMBER(query_id)
+  IPC_STRUCT_TRAITS_MEMBER(valid)
+  IPC_STRUCT_TRAITS_MEMBER(hit_test)
+  IPC_STRUCT_TRAITS_MEMBER(node_attributes)
+IPC_STRUCT_TRAITS_END()
+
 IPC_STRUCT_TRAITS_BEGIN(DidPrintPagesParams)
   IPC_STRUCT_TRAITS_MEMBER(metafile_data_handle)
   IPC_STRUCT_TRAITS_MEMBER(data_size)
@@ -139,8 +159,15 @@ IPC_MESSAGE_CONTROL1(EflViewMsg_SetCache,
 // Tells the renderer to dump as much memory as it can, perhaps because we
 // have memory pressure or the renderer is (or will be) paged out.  This
 // should only result in purging objects we can recalculate, e.g. caches or
-// JS garbage, not in purging irreplaceable objects.
-IPC_MESSAGE_CONTROL0(EwkViewMsg_PurgeMemory)
+// JS garbage, not in purging irreplaceable objects. Under moderate pressure
+// only dead resources are dropped, under critical pressure fonts and the JS
+// heap are purged too.
+IPC_MESSAGE_CONTROL1(EwkViewMsg_PurgeMemory,
+                     bool /* critical */)
+
+// Asks the renderer for the memory its caches and JS heap use, for the
+// memory sampler.
+IPC_MESSAGE_CONTROL0(EwkViewMsg_GetMemoryUsage)
 
 IPC_MESSAGE_CONTROL4(EwkViewMsg_SetWidgetInfo,
                      int,            // result: widgetHandle
@@ -166,11 +193,15 @@ IPC_MESSAGE_ROUTED3(EwkViewMsg_DoHitTest,
                     int, /* vertical position */
                     tizen_webview::Hit_Test_Mode /* mode */)
 
-IPC_MESSAGE_ROUTED4(EwkViewMsg_DoHitTestAsync,
-                    int, /* horizontal position */
-                    int, /* vertical position */
-                    tizen_webview::Hit_Test_Mode, /* mode */
-                    int64_t /* request id */)
+IPC_MESSAGE_ROUTED1(EwkViewMsg_DoHitTestAsync,
+                    HitTestAsyncQueriesEfl /* batched queries */)
+
+IPC_MESSAGE_ROUTED2(EwkViewMsg_NavigationPolicyDecided,
+                    int, /* request id */
+                    bool /* handled */)
+
+IPC_MESSAGE_ROUTED1(EwkViewMsg_SetNavigationPolicyEnabled,
+                    bool /* enabled */)
 
 IPC_MESSAGE_ROUTED3(EwkViewMsg_PrintToPdf,
                     int, /* width */
@@ -186,6 +217,22 @@ IPC_SYNC_MESSAGE_CONTROL1_1(EwkHostMsg_DecideNavigationPolicy,
                            NavigationPolicyParams,
                            bool /*handled*/)
 
+// Deferred variant of EwkHostMsg_DecideNavigationPolicy, the renderer holds
+// the navigation back until EwkViewMsg_NavigationPolicyDecided arrives.
+IPC_MESSAGE_CONTROL2(EwkHostMsg_DecideNavigationPolicyAsync,
+                     int, /* request id */
+                     NavigationPolicyParams)
+
+// Reply to EwkViewMsg_PurgeMemory.
+IPC_MESSAGE_CONTROL1(EwkHostMsg_MemoryPurged,
+                     int64 /* bytes reclaimed */)
+
+// Reply to EwkViewMsg_GetMemoryUsage.
+IPC_MESSAGE_CONTROL3(EwkHostMsg_MemoryUsage,
+                     int64 /* web cache bytes */,
+                     int64 /* v8 heap used bytes */,
+                     int64 /* v8 heap total bytes */)
+
 IPC_SYNC_MESSAGE_ROUTED0_2(EwkHostMsg_GetContentSecurityPolicy,
                            std::string, /* policy */
                            tizen_webview::ContentSecurityPolicyType /* header type */)
@@ -224,16 +271,31 @@ IPC_MESSAGE_ROUTED2(EwkHostMsg_DidChangeMaxScrollOffset,
                     int, /*max scrollX*/
                     int  /*max scrollY*/)
 
-IPC_MESSAGE_CONTROL3(EwkViewHostMsg_HitTestReply,
-                    int, /* render_view_id */
-                    _Ewk_Hit_Test, /* Ewk Hit test data without node map */
-                    NodeAttributesMap /* node attributes */)
+// Sent at most about once per frame while the main frame scrolls, the last
+// one carries the offset it stopped at.
+IPC_MESSAGE_ROUTED2(EwkHostMsg_DidChangeScrollOffset,
+                    int, /*scrollX*/
+                    int  /*scrollY*/)
 
-IPC_MESSAGE_CONTROL4(EwkViewHostMsg_HitTestAsyncReply,
+IPC_MESSAGE_CONTROL4(EwkViewHostMsg_HitTestReply,
                     int, /* render_view_id */
                     _Ewk_Hit_Test, /* Ewk Hit test data without node map */
                     NodeAttributesMap, /* node attributes */
-                    int64_t /* request id */)
+                    gfx::Vector2d /* scroll offset used for the hit test */)
+
+IPC_MESSAGE_CONTROL2(EwkViewHostMsg_HitTestAsyncReply,
+                    int, /* render_view_id */
+                    HitTestAsyncResultsEfl /* one result per query */)
+
+// Changes to the hit test regions of the visible links, images and editable
+// elements, sent after layout and when scrolling stops so most hit tests can
+// be answered without a round trip to the renderer. The browser drops the
+// regions it has first if |replace| is set, e.g. for a new document.
+IPC_MESSAGE_ROUTED4(EwkHostMsg_DidUpdateHitTestRegions,
+                    HitTestRegionsEfl, /* added regions */
+                    std::vector<int>, /* ids of the removed regions */
+                    bool, /* replace */
+                    gfx::Vector2d /* scroll offset the regions were made at */)
 
 IPC_MESSAGE_ROUTED1(EwkViewMsg_GetMHTMLData,
                     int /* callback id */)
@@ -4,12 +4,18 @@
 
 #include "cookie_manager.h"
 
+#include <algorithm>
 #include "utility"
 
+#include "base/base64.h"
 #include "base/bind.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/stl_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/values.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/synchronization/waitable_event.h"
 #include "content/public/browser/browser_thread.h"
@@ -18,6 +24,7 @@
 #include "net/base/net_errors.h"
 #include "net/base/static_cookie_policy.h"
 #include "net/cookies/canonical_cookie.h"
+#include "net/cookies/cookie_constants.h"
 #include "net/cookies/cookie_util.h"
 #include "net/cookies/parsed_cookie.h"
 #include "net/cookies/cookie_monster.h"
@@ -39,6 +46,9 @@ using namespace tizen_webview;
 
 namespace {
 
+// Cookies per chunk of an export, lines per batch of an import.
+const size_t kCookiesPerChunk = 256;
+
 void TriggerHostPolicyGetCallbackAsyncOnUIThread(tizen_webview::Cookie_Accept_Policy policy,
                                                  CookieManager::AsyncPolicyGetCb callback,
                                                  void *data) {
@@ -75,6 +85,216 @@ class CookieManager::EwkGetHostCallback {
     void* user_data_;
 };
 
+// Lives on the IO thread, but for handing chunks to the UI thread.
+class CookieManager::CookieExportJob
+    : public base::RefCountedThreadSafe<CookieExportJob> {
+ public:
+  CookieExportJob(AsyncCookiesExportCb callback, void* user_data)
+    : callback_(callback),
+      user_data_(user_data),
+      next_(0) {}
+
+  void CookiesFetched(const net::CookieList& cookies) {
+    DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+    cookies_ = cookies;
+    SerializeNextChunk();
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<CookieExportJob>;
+  ~CookieExportJob() {}
+
+  void SerializeNextChunk() {
+    DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+    std::string chunk;
+    size_t end = std::min(next_ + kCookiesPerChunk, cookies_.size());
+    for (; next_ < end; ++next_) {
+      const net::CanonicalCookie& cookie = cookies_[next_];
+      base::DictionaryValue line;
+      // Names and values are arbitrary bytes, JSON strings only hold UTF-8.
+      std::string name, value;
+      base::Base64Encode(cookie.Name(), &name);
+      base::Base64Encode(cookie.Value(), &value);
+      line.SetString("name", name);
+      line.SetString("value", value);
+      line.SetString("domain", cookie.Domain());
+      line.SetString("path", cookie.Path());
+      // Times are kept exact, JSON numbers can not hold them.
+      line.SetString("creation",
+          base::Int64ToString(cookie.CreationDate().ToInternalValue()));
+      line.SetString("expiry",
+          base::Int64ToString(cookie.ExpiryDate().ToInternalValue()));
+      line.SetBoolean("secure", cookie.IsSecure());
+      line.SetBoolean("httponly", cookie.IsHttpOnly());
+      line.SetString("priority", net::CookiePriorityToString(cookie.Priority()));
+
+      std::string json;
+      base::JSONWriter::Write(&line, &json);
+      chunk.append(json);
+      chunk.push_back('\n');
+    }
+    bool finished = next_ == cookies_.size();
+    if (finished)
+      cookies_.clear();
+    BrowserThread::PostTask(BrowserThread::UI, FROM_HERE,
+                            base::Bind(&CookieExportJob::DeliverChunk, this,
+                                       chunk, finished));
+  }
+
+  void DeliverChunk(const std::string& chunk, bool finished) {
+    DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+    Eina_Bool go_on = (*callback_)(chunk.data(), chunk.size(), finished,
+                                   user_data_);
+    if (finished)
+      return;
+    if (go_on) {
+      BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+                              base::Bind(&CookieExportJob::SerializeNextChunk,
+                                         this));
+    } else {
+      BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+                              base::Bind(&CookieExportJob::Cancel, this));
+    }
+  }
+
+  void Cancel() {
+    DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+    cookies_.clear();
+  }
+
+  AsyncCookiesExportCb callback_;
+  void* user_data_;
+  net::CookieList cookies_;
+  size_t next_;
+};
+
+// Lives on the IO thread, but for the final callback.
+class CookieManager::CookieImportJob
+    : public base::RefCountedThreadSafe<CookieImportJob> {
+ public:
+  CookieImportJob(const std::string& lines,
+                  AsyncCookiesImportCb callback,
+                  void* user_data)
+    : lines_(lines),
+      callback_(callback),
+      user_data_(user_data),
+      next_(0),
+      parsed_(false),
+      pending_(0),
+      imported_(0),
+      rejected_(0) {}
+
+  void Start(scoped_refptr<net::CookieMonster> cookie_monster) {
+    DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+    cookie_monster_ = cookie_monster;
+    ParseNextBatch();
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<CookieImportJob>;
+  ~CookieImportJob() {}
+
+  // Other IO thread tasks run between batches.
+  void ParseNextBatch() {
+    DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+    for (size_t i = 0; i < kCookiesPerChunk && next_ < lines_.size(); ++i) {
+      size_t end = lines_.find('\n', next_);
+      if (end == std::string::npos)
+        end = lines_.size();
+      std::string line(lines_, next_, end - next_);
+      next_ = end + 1;
+      if (line.empty())
+        continue;
+      if (!cookie_monster_.get() || !SetCookie(line))
+        ++rejected_;
+    }
+
+    if (next_ < lines_.size()) {
+      BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+                              base::Bind(&CookieImportJob::ParseNextBatch,
+                                         this));
+      return;
+    }
+    lines_.clear();
+    parsed_ = true;
+    MaybeFinish();
+  }
+
+  bool SetCookie(const std::string& json) {
+    scoped_ptr<base::Value> value(base::JSONReader::Read(json));
+    base::DictionaryValue* line = NULL;
+    if (!value || !value->GetAsDictionary(&line))
+      return false;
+
+    std::string encoded_name, encoded_value;
+    std::string name, cookie_value, domain, path, expiry, priority;
+    bool secure = false;
+    bool http_only = false;
+    int64 expiry_value = 0;
+    if (!line->GetString("name", &encoded_name) ||
+        !line->GetString("value", &encoded_value) ||
+        !base::Base64Decode(encoded_name, &name) ||
+        !base::Base64Decode(encoded_value, &cookie_value) ||
+        !line->GetString("domain", &domain) ||
+        !line->GetString("path", &path) ||
+        !line->GetString("expiry", &expiry) ||
+        !base::StringToInt64(expiry, &expiry_value) ||
+        domain.empty())
+      return false;
+    line->GetBoolean("secure", &secure);
+    line->GetBoolean("httponly", &http_only);
+    line->GetString("priority", &priority);
+
+    // Domain cookies start with a dot, host cookies are set without a
+    // domain.
+    bool is_domain_cookie = domain[0] == '.';
+    GURL url((secure ? "https://" : "http://") +
+             (is_domain_cookie ? domain.substr(1) : domain) + path);
+    if (!url.is_valid())
+      return false;
+
+    ++pending_;
+    cookie_monster_->SetCookieWithDetailsAsync(
+        url, name, cookie_value, is_domain_cookie ? domain : std::string(),
+        path, base::Time::FromInternalValue(expiry_value), secure, http_only,
+        net::StringToCookiePriority(priority),
+        base::Bind(&CookieImportJob::CookieSet, this));
+    return true;
+  }
+
+  void CookieSet(bool success) {
+    DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+    --pending_;
+    if (success)
+      ++imported_;
+    else
+      ++rejected_;
+    MaybeFinish();
+  }
+
+  void MaybeFinish() {
+    if (pending_ || !parsed_)
+      return;
+    cookie_monster_ = NULL;
+    if (callback_) {
+      BrowserThread::PostTask(BrowserThread::UI, FROM_HERE,
+                              base::Bind(callback_, imported_, rejected_,
+                                         user_data_));
+    }
+  }
+
+  std::string lines_;
+  AsyncCookiesImportCb callback_;
+  void* user_data_;
+  scoped_refptr<net::CookieMonster> cookie_monster_;
+  size_t next_;
+  bool parsed_;
+  // Cookies handed to the cookie monster which did not call back yet.
+  unsigned pending_;
+  unsigned imported_;
+  unsigned rejected_;
+};
+
 CookieManager::CookieManager(content::URLRequestContextGetterEfl* request_context_getter)
     : is_clearing_(false),
       request_context_getter_(request_context_getter),
@@ -146,6 +366,53 @@ void CookieManager::GetHostNamesWithCookiesAsync(AsyncHostnamesGetCb callback, v
   BrowserThread::PostTask(BrowserThread::IO, FROM_HERE, base::Bind(&CookieManager::FetchCookiesOnIOThread, this));
 }
 
+void CookieManager::ExportCookiesAsync(AsyncCookiesExportCb callback,
+                                       void *data) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+                          base::Bind(&CookieManager::ExportCookiesOnIOThread,
+                                     this,
+                                     make_scoped_refptr(
+                                         new CookieExportJob(callback, data))));
+}
+
+void CookieManager::ImportCookiesAsync(const std::string& lines,
+                                       AsyncCookiesImportCb callback,
+                                       void *data) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  BrowserThread::PostTask(BrowserThread::IO, FROM_HERE,
+                          base::Bind(&CookieManager::ImportCookiesOnIOThread,
+                                     this,
+                                     make_scoped_refptr(
+                                         new CookieImportJob(lines, callback,
+                                                             data))));
+}
+
+scoped_refptr<net::CookieMonster> CookieManager::GetCookieMonsterOnIOThread() {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  if (!request_context_getter_.get())
+    return NULL;
+  return request_context_getter_->GetURLRequestContext()->
+      cookie_store()->GetCookieMonster();
+}
+
+void CookieManager::ExportCookiesOnIOThread(
+    scoped_refptr<CookieExportJob> job) {
+  scoped_refptr<net::CookieMonster> cookie_monster =
+      GetCookieMonsterOnIOThread();
+  if (cookie_monster.get()) {
+    cookie_monster->GetAllCookiesAsync(
+        base::Bind(&CookieExportJob::CookiesFetched, job));
+  } else {
+    job->CookiesFetched(net::CookieList());
+  }
+}
+
+void CookieManager::ImportCookiesOnIOThread(
+    scoped_refptr<CookieImportJob> job) {
+  job->Start(GetCookieMonsterOnIOThread());
+}
+
 void CookieManager::FetchCookiesOnIOThread() {
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
   if (!request_context_getter_.get()) {
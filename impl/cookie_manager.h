@@ -24,6 +24,10 @@ namespace content {
 class ResourceContext;
 }
 
+namespace net {
+class CookieMonster;
+}
+
 struct _Ewk_Error;
 
 class CookieManager 
@@ -32,6 +36,9 @@ class CookieManager
   typedef void (*AsyncPolicyGetCb)(tizen_webview::Cookie_Accept_Policy,
                                    void *);
   typedef void (*AsyncHostnamesGetCb)(Eina_List*, _Ewk_Error*, void *);
+  typedef Eina_Bool (*AsyncCookiesExportCb)(const char*, size_t, Eina_Bool,
+                                            void *);
+  typedef void (*AsyncCookiesImportCb)(unsigned, unsigned, void *);
 
   explicit CookieManager(
       content::URLRequestContextGetterEfl* request_context_getter);
@@ -57,6 +64,16 @@ class CookieManager
   void GetAcceptPolicyAsync(AsyncPolicyGetCb callback, void *data);
   //get host name asynchronous
   void GetHostNamesWithCookiesAsync(AsyncHostnamesGetCb callback, void *data);
+  // Hands all cookies to |callback| in chunks of lines, one JSON object per
+  // cookie. The cookies are serialized on the IO thread, a chunk is only
+  // built once |callback| returned for the previous one. Returning false
+  // from |callback| stops the export.
+  void ExportCookiesAsync(AsyncCookiesExportCb callback, void *data);
+  // Sets the cookies of |lines|, as written by ExportCookiesAsync. Lines
+  // are parsed on the IO thread in batches. |callback| may be null.
+  void ImportCookiesAsync(const std::string& lines,
+                          AsyncCookiesImportCb callback,
+                          void *data);
 
   // These manage the global access state shared across requests regardless of
   // source (i.e. network or JavaScript).
@@ -97,6 +114,8 @@ class CookieManager
 
  private:
   struct EwkGetHostCallback;
+  class CookieExportJob;
+  class CookieImportJob;
 
   // Deletes cookie having host name. This must be called in IO thread.
   void DeleteCookiesOnIOThread(const std::string& url,
@@ -110,6 +129,11 @@ class CookieManager
   // Fetch the cookies. This must be called in the IO thread.
   void FetchCookiesOnIOThread();
   void OnFetchComplete(const net::CookieList& cookies);
+  // Returns null if there is no cookie store. This must be called in the IO
+  // thread.
+  scoped_refptr<net::CookieMonster> GetCookieMonsterOnIOThread();
+  void ExportCookiesOnIOThread(scoped_refptr<CookieExportJob> job);
+  void ImportCookiesOnIOThread(scoped_refptr<CookieImportJob> job);
 
   void GetCookieValueOnIOThread(const GURL& host,
                                 std::string* result,
@@ -4,21 +4,27 @@
 
 #include "eweb_context.h"
 
-#include "base/synchronization/waitable_event.h"
+#include <set>
+
 #include "components/autofill/content/browser/content_autofill_driver.h"
+#include "base/strings/string_tokenizer.h"
+#include "base/strings/string_util.h"
 #include "content/public/browser/appcache_service.h"
 #include "content/public/browser/browser_context.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/storage_partition.h"
 #include "content/public/browser/render_process_host.h"
+#include "content/public/browser/render_widget_host.h"
+#include "content/public/browser/render_widget_host_iterator.h"
 #include "content/public/browser/local_storage_usage_info.h"
 #include "content/public/browser/dom_storage_context.h"
+#include "browser/favicon/favicon_fetch_scheduler.h"
 #include "browser/favicon/favicon_service.h"
+#include "browser/memory_sampler_efl.h"
 #include "browser/webdata/web_data_service_factory.h"
 #include "gl/gl_shared_context_efl.h"
 #include "net/http/http_cache.h"
-#include "net/proxy/proxy_config_service_fixed.h"
-#include "net/proxy/proxy_service.h"
+#include "net/proxy/proxy_config.h"
 #include "storage/browser/database/database_quota_client.h"
 #include "storage/browser/fileapi/file_system_quota_client.h"
 #include "storage/browser/quota/quota_manager.h"
@@ -33,16 +39,23 @@
 #include "browser/password_manager/password_manager.h"
 #include "browser/password_manager/password_store_factory.h"
 #include "browser/renderer_host/browsing_data_remover_efl.h"
+#include "browser/renderer_host/render_widget_host_view_efl.h"
+#include "browser/session_restore_efl.h"
 #include "browser/vibration/vibration_provider_client.h"
 #include "common/render_messages_efl.h"
 
+#include "eweb_view.h"
+#include "tizen_webview/public/tw_favicon_cache_statistics.h"
+#include "tizen_webview/public/tw_http_cache_statistics.h"
 #include "tizen_webview/public/tw_security_origin.h"
+#include "tizen_webview/public/tw_webview.h"
 #include "tizen_webview/public/tw_wrt.h"
 #include "tizen_webview/tw_misc_utility.h"
 
 using content::BrowserThread;
 using content::BrowserContext;
 using content::BrowserContextEfl;
+using content::RenderWidgetHostViewEfl;
 
 using std::string;
 using std::pair;
@@ -58,6 +71,10 @@ tizen_webview::Mime_Override_Callback EWebContext::mime_override_callback_ = 0;
 
 namespace {
 
+// A low memory notification arriving this soon after the previous one means
+// the moderate purge did not help, purge everything.
+const int kLowMemoryEscalationSeconds = 10;
+
 /**
  * @brief Helper class for obtaining WebStorage origins
  */
@@ -90,14 +107,23 @@ private:
   void* user_data_;
 };
 
-void SetProxyConfigCallbackOnIOThread(base::WaitableEvent* done,
-                            net::URLRequestContextGetter* url_request_context_getter,
-                            const net::ProxyConfig& proxy_config) {
-  net::ProxyService* proxy_service =
-      url_request_context_getter->GetURLRequestContext()->proxy_service();
-  proxy_service->ResetConfigService(
-      new net::ProxyConfigServiceFixed(proxy_config));
-  done->Signal();
+void OnProxyConfigSet(tizen_webview::Context_Proxy_Set_Callback callback,
+                      void* user_data) {
+  if (callback)
+    callback(user_data);
+}
+
+// Unlike ProxyBypassRules::ParseFromString(), fails on rules it can not
+// read instead of skipping them.
+bool ParseProxyBypassRules(const string& raw, net::ProxyBypassRules* rules) {
+  base::StringTokenizer entries(raw, ",;");
+  while (entries.GetNext()) {
+    string entry;
+    base::TrimWhitespaceASCII(entries.token(), base::TRIM_ALL, &entry);
+    if (!entry.empty() && !rules->AddRuleFromString(entry))
+      return false;
+  }
+  return true;
 }
 
 void OnOriginsWithApplicationCacheObtained(tizen_webview::Web_Application_Cache_Origins_Get_Callback callback,
@@ -181,6 +207,56 @@ void GetFileSystemOriginsOnFILEThread(tizen_webview::Web_Database_Origins_Get_Ca
                             base::Bind(&OnGetFileSystemOrigins, callback, user_data));
 }
 
+void OnGetHttpCacheStatistics(
+    tizen_webview::Context_Http_Cache_Statistics_Get_Callback callback,
+    void* user_data,
+    const net::HttpCacheHotTierEfl::Stats& stats) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  tizen_webview::Http_Cache_Statistics statistics;
+  statistics.memory_hits = stats.memory_hits;
+  statistics.memory_misses = stats.memory_misses;
+  statistics.disk_hits = stats.disk_hits;
+  statistics.disk_misses = stats.disk_misses;
+  statistics.memory_size = stats.memory_size;
+  statistics.memory_capacity = stats.memory_capacity;
+  callback(&statistics, user_data);
+}
+
+SkBitmap GetFaviconBitmapOnDBThread(const GURL& page_url) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::DB));
+  FaviconService fs;
+  return fs.LoadBitmapForPageURL(page_url);
+}
+
+Evas_Object* CreateFaviconObject(const SkBitmap& bitmap, Evas* canvas) {
+  if (bitmap.isNull()) {
+    return NULL;
+  }
+
+  Evas_Object *favicon = evas_object_image_filled_add(canvas);
+  evas_object_image_size_set(favicon, bitmap.width(), bitmap.height());
+  evas_object_image_colorspace_set(favicon, EVAS_COLORSPACE_ARGB8888);
+  evas_object_image_fill_set(favicon, 0, 0, bitmap.width(), bitmap.height());
+  evas_object_image_filled_set(favicon, EINA_TRUE);
+  evas_object_image_alpha_set(favicon, EINA_TRUE);
+  void* pixels = evas_object_image_data_get(favicon, EINA_TRUE);
+  if (pixels) {
+    bitmap.copyPixelsTo(pixels, bitmap.getSize());
+    evas_object_image_data_set(favicon, pixels);
+  }
+
+  return favicon;
+}
+
+void OnFaviconBitmapGot(
+    Evas* canvas,
+    tizen_webview::Context_Favicon_Object_Add_Callback callback,
+    void* user_data,
+    const SkBitmap& bitmap) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  callback(CreateFaviconObject(bitmap, canvas), user_data);
+}
+
 } // namespace
 
 void EwkDidStartDownloadCallback::TriggerCallback(const string& url) {
@@ -231,10 +307,13 @@ bool EWebContext::ShouldOverrideMimeForURL(
 EWebContext::EWebContext(bool incognito)
     : m_pixmap(0),
       initialized_(false),
-      incognito_(incognito) {
+      incognito_(incognito),
+      memory_saving_mode_(false) {
   EwkGlobalData::Ensure();
 
   browser_context_.reset(new BrowserContextEfl(this));
+  memory_sampler_.reset(new MemorySamplerEfl(browser_context_.get()));
+  favicon_fetch_scheduler_.reset(new FaviconFetchScheduler);
   // Notification Service gets init in BrowserMainRunner init,
   // so cache manager can register for notifications only after that.
   web_cache_manager_.reset(new WebCacheManagerEfl(browser_context_.get()));
@@ -272,6 +351,20 @@ Cache_Model EWebContext::GetCacheModel() const {
   return web_cache_manager_->GetCacheModel();
 }
 
+void EWebContext::GetHttpCacheStatistics(
+    tizen_webview::Context_Http_Cache_Statistics_Get_Callback callback,
+    void* user_data) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  // Every request context of a BrowserContextEfl is an efl one.
+  scoped_refptr<content::URLRequestContextGetterEfl> getter(
+      static_cast<content::URLRequestContextGetterEfl*>(
+          browser_context_->GetRequestContext()));
+  BrowserThread::PostTaskAndReplyWithResult(BrowserThread::IO, FROM_HERE,
+      base::Bind(&content::URLRequestContextGetterEfl::GetHttpCacheStatistics,
+                 getter),
+      base::Bind(&OnGetHttpCacheStatistics, callback, user_data));
+}
+
 void EWebContext::SetNetworkCacheEnable(bool enable) {
   net::URLRequestContext* url_context = browser_context_->GetRequestContext()->GetURLRequestContext();
   if (!url_context)
@@ -303,15 +396,21 @@ bool EWebContext::GetNetworkCacheEnable() const {
 bool EWebContext::HTTPCustomHeaderAdd(const char* name, const char* value) {
   pair<map<string, string>::iterator,bool> ret;
   ret = http_custom_headers_.insert(std::make_pair(string(name), string(value)));
+  if (ret.second)
+    PublishViewSettings();
   return ret.second;
 }
 
 bool EWebContext::HTTPCustomHeaderRemove(const char* name) {
-  return http_custom_headers_.erase(string(name));
+  if (!http_custom_headers_.erase(string(name)))
+    return false;
+  PublishViewSettings();
+  return true;
 }
 
 void EWebContext::HTTPCustomHeaderClear() {
   http_custom_headers_.clear();
+  PublishViewSettings();
 }
 
 const HTTPCustomHeadersEflMap& EWebContext::GetHTTPCustomHeadersEflMap() const {
@@ -329,32 +428,110 @@ void EWebContext::SetCertificate(const char* certificate_file) {
 }
 
 void EWebContext::NotifyLowMemory() {
-  MemoryPurger::PurgeAll(browser_context_.get());
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  base::TimeTicks now = base::TimeTicks::Now();
+  bool repeated = !last_low_memory_notification_.is_null() &&
+      now - last_low_memory_notification_ <
+          base::TimeDelta::FromSeconds(kLowMemoryEscalationSeconds);
+  last_low_memory_notification_ = now;
+
+  MemoryPurger::Level level = memory_saving_mode_ || repeated ?
+      MemoryPurger::LEVEL_CRITICAL : MemoryPurger::LEVEL_MODERATE;
+  MemoryPurger::Purge(browser_context_.get(), level);
+  // Keep the renderers from refilling their caches right away.
+  web_cache_manager_->OnMemoryPressure(level);
+}
+
+void EWebContext::SetMemorySavingMode(bool enable) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  if (memory_saving_mode_ == enable)
+    return;
+
+  memory_saving_mode_ = enable;
+  // Start saving right away rather than at the next low memory warning.
+  if (memory_saving_mode_)
+    MemoryPurger::Purge(browser_context_.get(), MemoryPurger::LEVEL_MODERATE);
 }
 
 void EWebContext::SetProxyUri(const char* uri) {
-  proxy_uri_ = string(uri);
+  SetProxy(uri, NULL, NULL, NULL);
+}
+
+bool EWebContext::SetProxy(const char* uri, const char* bypass_rule,
+                           tizen_webview::Context_Proxy_Set_Callback callback,
+                           void* user_data) {
   net::ProxyConfig config;
-  config.proxy_rules().ParseFromString(proxy_uri_);
-  base::WaitableEvent done(false, false);
-  BrowserThread::PostTask(
-      BrowserThread::IO, FROM_HERE,
-      base::Bind(&SetProxyConfigCallbackOnIOThread, &done,
-                 make_scoped_refptr(browser_context()->GetRequestContext()),
-                 config));
-  done.Wait();
+  if (uri && *uri) {
+    config.proxy_rules().ParseFromString(uri);
+    // Rules naming no proxy would silently connect directly.
+    if (config.proxy_rules().empty())
+      return false;
+  }
+  if (bypass_rule &&
+      !ParseProxyBypassRules(bypass_rule, &config.proxy_rules().bypass_rules))
+    return false;
+
+  proxy_uri_ = uri ? string(uri) : string();
+  SetProxyConfig(config, callback, user_data);
+  return true;
+}
+
+bool EWebContext::SetProxyPacUrl(const char* pac_url,
+    tizen_webview::Context_Proxy_Set_Callback callback, void* user_data) {
+  GURL url(pac_url && *pac_url ? pac_url : "");
+  if (pac_url && *pac_url && !url.is_valid())
+    return false;
+
+  proxy_uri_.clear();
+  SetProxyConfig(url.is_valid() ?
+                     net::ProxyConfig::CreateFromCustomPacURL(url) :
+                     net::ProxyConfig::CreateDirect(),
+                 callback, user_data);
+  return true;
+}
+
+void EWebContext::SetProxyConfig(const net::ProxyConfig& config,
+    tizen_webview::Context_Proxy_Set_Callback callback, void* user_data) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  // Every request context of a BrowserContextEfl is an efl one.
+  scoped_refptr<content::URLRequestContextGetterEfl> getter(
+      static_cast<content::URLRequestContextGetterEfl*>(
+          browser_context_->GetRequestContext()));
+  BrowserThread::PostTaskAndReply(BrowserThread::IO, FROM_HERE,
+      base::Bind(&content::URLRequestContextGetterEfl::SetProxyConfig,
+                 getter, config),
+      base::Bind(&OnProxyConfigSet, callback, user_data));
 }
 
 void EWebContext::SetDidStartDownloadCallback(tizen_webview::Context_Did_Start_Download_Callback callback,
                                               void* user_data) {
   DCHECK(start_download_callback_.get() == NULL);
   start_download_callback_.reset(new EwkDidStartDownloadCallback(callback,user_data));
+  PublishViewSettings();
 }
 
 EwkDidStartDownloadCallback* EWebContext::DidStartDownloadCallback() {
   return start_download_callback_.get();
 }
 
+void EWebContext::PublishViewSettings() {
+  std::set<EWebView*> web_views;
+  scoped_ptr<content::RenderWidgetHostIterator> widgets(
+      content::RenderWidgetHost::GetRenderWidgetHosts());
+  while (content::RenderWidgetHost* widget = widgets->GetNextHost()) {
+    if (widget->GetProcess()->GetBrowserContext() != browser_context_.get())
+      continue;
+    RenderWidgetHostViewEfl* view =
+        static_cast<RenderWidgetHostViewEfl*>(widget->GetView());
+    if (view && view->eweb_view())
+      web_views.insert(view->eweb_view());
+  }
+
+  for (std::set<EWebView*>::const_iterator it = web_views.begin();
+       it != web_views.end(); ++it)
+    (*it)->PublishSettings();
+}
+
 Ewk_Cookie_Manager* EWebContext::ewkCookieManager() {
   if (!ewk_cookie_manager_)
     ewk_cookie_manager_.reset(Ewk_Cookie_Manager::create(browser_context_->GetRequestContextEfl()));
@@ -475,32 +652,71 @@ Evas_Object *EWebContext::AddFaviconObject(const char* uri, Evas* canvas) const
     return NULL;
   }
   FaviconService fs;
-  SkBitmap bitmap = fs.GetBitmapForPageURL(GURL(uri));
-  if (bitmap.isNull()) {
-    return NULL;
-  }
+  return CreateFaviconObject(fs.GetBitmapForPageURL(GURL(uri)), canvas);
+}
 
-  Evas_Object *favicon = evas_object_image_filled_add(canvas);
-  evas_object_image_size_set(favicon, bitmap.width(), bitmap.height());
-  evas_object_image_colorspace_set(favicon, EVAS_COLORSPACE_ARGB8888);
-  evas_object_image_fill_set(favicon, 0, 0, bitmap.width(), bitmap.height());
-  evas_object_image_filled_set(favicon, EINA_TRUE);
-  evas_object_image_alpha_set(favicon, EINA_TRUE);
-  void* pixels = evas_object_image_data_get(favicon, EINA_TRUE);
-  if (pixels) {
-    bitmap.copyPixelsTo(pixels, bitmap.getSize());
-    evas_object_image_data_set(favicon, pixels);
-  }
+void EWebContext::AddFaviconObjectAsync(
+    const char* uri, Evas* canvas,
+    tizen_webview::Context_Favicon_Object_Add_Callback callback,
+    void* user_data) const {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  // Bitmaps which are not in memory any more are read from the database.
+  BrowserThread::PostTaskAndReplyWithResult(BrowserThread::DB, FROM_HERE,
+      base::Bind(&GetFaviconBitmapOnDBThread, GURL(uri)),
+      base::Bind(&OnFaviconBitmapGot, canvas, callback, user_data));
+}
 
-  return favicon;
+void EWebContext::GetFaviconCacheStatistics(
+    tizen_webview::Favicon_Cache_Statistics* statistics) const {
+  FaviconService fs;
+  FaviconBitmapCache::Stats stats = fs.GetCacheStatistics();
+  statistics->hits = stats.hits;
+  statistics->misses = stats.misses;
+  statistics->evictions = stats.evictions;
+  statistics->evicted_size = stats.evictedSize;
+  statistics->count = stats.count;
+  statistics->size = stats.size;
+  statistics->capacity = stats.capacity;
 }
 
-void EWebContext::StartMemorySampler(double timerInterval) const {
-  LOG(INFO) << "Memory Sampler deprecated";
+void EWebContext::StartMemorySampler(double timerInterval) {
+  memory_sampler_->Start(timerInterval);
 }
 
-void EWebContext::StopMemorySampler() const {
-  LOG(INFO) << "Memory Sampler deprecated";
+void EWebContext::StopMemorySampler() {
+  memory_sampler_->Stop();
+}
+
+void EWebContext::SetMemorySamplerDumpPath(const char* path) {
+  memory_sampler_->SetDumpPath(path ? base::FilePath(path) : base::FilePath());
+}
+
+void EWebContext::GetMemoryUsage(
+    tizen_webview::Context_Memory_Usage_Get_Callback callback,
+    void* user_data) {
+  memory_sampler_->GetUsage(callback, user_data);
+}
+
+bool EWebContext::RestoreSessions(
+    const std::vector<tizen_webview::WebView*>& views,
+    const std::vector<std::string>& data,
+    size_t foreground_index,
+    tizen_webview::Context_Session_Restore_Callback callback,
+    void* user_data) {
+  std::vector<EWebView*> impls;
+  std::set<EWebView*> unique_impls;
+  for (size_t i = 0; i < views.size(); ++i) {
+    EWebView* impl = views[i]->GetImpl();
+    // Sessions are only restored into new views of this context, once.
+    if (impl->context()->GetImpl() != this ||
+        impl->web_contents().GetController().GetEntryCount() ||
+        !unique_impls.insert(impl).second)
+      return false;
+    impls.push_back(impl);
+  }
+
+  SessionRestoreEfl::Start(impls, data, foreground_index, callback, user_data);
+  return true;
 }
 
 void EWebContext::ClearCandidateData() {
@@ -5,8 +5,11 @@
 #ifndef EWEB_CONTEXT_H
 #define EWEB_CONTEXT_H
 
+#include <vector>
+
 #include "API/ewk_cookie_manager_private.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/time/time.h"
 #include "browser/renderer_host/web_cache_manager_efl.h"
 #include "tizen_webview/public/tw_cache_model.h"
 #include "tizen_webview/public/tw_callbacks.h"
@@ -14,12 +17,16 @@
 namespace tizen_webview {
 class URL;
 class WebContext;
+class WebView;
 class WrtIpcMessageData;
+struct Favicon_Cache_Statistics;
 }
 
 typedef std::map<std::string, std::string> HTTPCustomHeadersEflMap;
 
 class CookieManager;
+class FaviconFetchScheduler;
+class MemorySamplerEfl;
 #if defined(OS_TIZEN_TV)
 class FaviconDatabase;
 #endif
@@ -28,6 +35,10 @@ namespace content {
 class BrowserContextEfl;
 }
 
+namespace net {
+class ProxyConfig;
+}
+
 class EwkDidStartDownloadCallback {
  public:
   EwkDidStartDownloadCallback(tizen_webview::Context_Did_Start_Download_Callback callback,
@@ -51,6 +62,9 @@ class EWebContext {
 
   void SetCacheModel(tizen_webview::Cache_Model);
   tizen_webview::Cache_Model GetCacheModel() const;
+  void GetHttpCacheStatistics(
+      tizen_webview::Context_Http_Cache_Statistics_Get_Callback callback,
+      void* user_data);
   void SetNetworkCacheEnable(bool enable);
   bool GetNetworkCacheEnable() const;
   bool HTTPCustomHeaderAdd(const char* name, const char* value);
@@ -59,12 +73,22 @@ class EWebContext {
   const HTTPCustomHeadersEflMap& GetHTTPCustomHeadersEflMap() const;
 
   void NotifyLowMemory();
+  void SetMemorySavingMode(bool enable);
   Ewk_Cookie_Manager* ewkCookieManager();
   CookieManager* cookieManager()
   { return ewkCookieManager()->cookieManager(); }
+  // Proxy changes apply to requests started once |callback| is called.
   void SetProxyUri(const char* uri);
   const char* GetProxyUri() const
   { return proxy_uri_.c_str(); }
+  // Return false, changing nothing, if the proxy, the bypass rules or the
+  // PAC URL can not be parsed.
+  bool SetProxy(const char* uri, const char* bypass_rule,
+                tizen_webview::Context_Proxy_Set_Callback callback,
+                void* user_data);
+  bool SetProxyPacUrl(const char* pac_url,
+                      tizen_webview::Context_Proxy_Set_Callback callback,
+                      void* user_data);
   //download start callback handlers
   void SetDidStartDownloadCallback(tizen_webview::Context_Did_Start_Download_Callback callback,
                                    void* user_data);
@@ -87,8 +111,29 @@ class EWebContext {
   void GetAllOriginsWithFileSystem(tizen_webview::Local_File_System_Origins_Get_Callback callback, void* user_data) const;
   bool SetFaviconDatabasePath(const char *path);
   Evas_Object *AddFaviconObject(const char *uri, Evas *canvas) const;
-  void StartMemorySampler(double timerInterval) const;
-  void StopMemorySampler() const;
+  void AddFaviconObjectAsync(
+      const char *uri, Evas *canvas,
+      tizen_webview::Context_Favicon_Object_Add_Callback callback,
+      void* user_data) const;
+  void GetFaviconCacheStatistics(
+      tizen_webview::Favicon_Cache_Statistics* statistics) const;
+  void StartMemorySampler(double timerInterval);
+  void StopMemorySampler();
+  void SetMemorySamplerDumpPath(const char* path);
+  void GetMemoryUsage(tizen_webview::Context_Memory_Usage_Get_Callback callback,
+                      void* user_data);
+  MemorySamplerEfl* memory_sampler() const { return memory_sampler_.get(); }
+  FaviconFetchScheduler* favicon_fetch_scheduler() const {
+    return favicon_fetch_scheduler_.get();
+  }
+  WebCacheManagerEfl* web_cache_manager() const {
+    return web_cache_manager_.get();
+  }
+  bool RestoreSessions(const std::vector<tizen_webview::WebView*>& views,
+                       const std::vector<std::string>& data,
+                       size_t foreground_index,
+                       tizen_webview::Context_Session_Restore_Callback callback,
+                       void* user_data);
 
   void SendWidgetInfo(int widget_id, double scale, const std::string &theme, const std::string &encoded_bundle);
   void SendWrtMessage(const tizen_webview::WrtIpcMessageData& message);
@@ -111,10 +156,19 @@ class EWebContext {
   ~EWebContext();
   friend class tizen_webview::WebContext;
 
+  void SetProxyConfig(const net::ProxyConfig& config,
+                      tizen_webview::Context_Proxy_Set_Callback callback,
+                      void* user_data);
+  // Views read the headers and the download callback on the IO thread
+  // through their published settings.
+  void PublishViewSettings();
+
   static EWebContext* default_context_;
   static tizen_webview::Mime_Override_Callback mime_override_callback_;
   scoped_ptr<WebCacheManagerEfl> web_cache_manager_;
   scoped_ptr<content::BrowserContextEfl> browser_context_;
+  scoped_ptr<MemorySamplerEfl> memory_sampler_;
+  scoped_ptr<FaviconFetchScheduler> favicon_fetch_scheduler_;
   HTTPCustomHeadersEflMap http_custom_headers_;
   scoped_ptr<Ewk_Cookie_Manager> ewk_cookie_manager_;
   std::string proxy_uri_;
@@ -122,6 +176,8 @@ class EWebContext {
   int m_pixmap;
   bool initialized_;
   bool incognito_;
+  bool memory_saving_mode_;
+  base::TimeTicks last_low_memory_notification_;
 };
 
 #endif
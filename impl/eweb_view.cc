@@ -8,16 +8,18 @@
 #include "base/pickle.h"
 #include "base/threading/thread_restrictions.h"
 #include "browser/navigation_policy_handler_efl.h"
+#include "browser/renderer_host/frame_timing_recorder_efl.h"
 #include "browser/renderer_host/render_widget_host_view_efl.h"
 #include "browser/renderer_host/web_event_factory_efl.h"
+#include "browser/session_journal_efl.h"
 #include "common/render_messages_efl.h"
 #include "common/version_info.h"
-#include "components/sessions/serialized_navigation_entry.h"
 #include "API/ewk_policy_decision_private.h"
 #include "API/ewk_settings_private.h"
 #include "API/ewk_text_style_private.h"
 #include "web_contents_delegate_efl.h"
 #include "public/platform/WebString.h"
+#include "base/bind.h"
 #include "base/command_line.h"
 #include "base/files/file_path.h"
 #include "base/logging.h"
@@ -29,6 +31,7 @@
 #include "content/public/browser/browser_message_filter.h"
 #include "content/public/browser/navigation_controller.h"
 #include "content/public/browser/navigation_entry.h"
+#include "content/public/browser/render_process_host.h"
 #include "content/public/browser/resource_dispatcher_host.h"
 #include "content/public/common/content_client.h"
 #include "content/public/common/user_agent.h"
@@ -39,6 +42,8 @@
 #include "ui/events/event_switches.h"
 #include "browser/motion/wkext_motion.h"
 #include "ui/base/l10n/l10n_util.h"
+#include "ui/gfx/size_conversions.h"
+#include "ui/gfx/vector2d_conversions.h"
 #include "devtools_delegate_efl.h"
 
 #include "tizen_webview/public/tw_hit_test.h"
@@ -109,6 +114,29 @@ void GetEinaRectFromGfxRect(const gfx::Rect& gfx_rect, Eina_Rectangle* eina_rect
   eina_rect->h = gfx_rect.height();
 }
 
+typedef IDMap<tizen_webview::PolicyDecision, IDMapOwnPointer> PolicyDecisionMap;
+
+// Drops the suspended decisions the application has made since.
+void RemoveDecidedPolicies(PolicyDecisionMap* decisions)
+{
+  std::vector<PolicyDecisionMap::KeyType> decided;
+  for (PolicyDecisionMap::iterator it(decisions); !it.IsAtEnd(); it.Advance()) {
+    if (it.GetCurrentValue()->isDecided())
+      decided.push_back(it.GetCurrentKey());
+  }
+  for (size_t i = 0; i < decided.size(); ++i)
+    decisions->Remove(decided[i]);
+}
+
+void IgnoreUndecidedPolicies(PolicyDecisionMap* decisions)
+{
+  for (PolicyDecisionMap::iterator it(decisions); !it.IsAtEnd(); it.Advance()) {
+    if (!it.GetCurrentValue()->isDecided())
+      it.GetCurrentValue()->Ignore();
+  }
+  decisions->Clear();
+}
+
 } // namespace
 
 class WebViewBrowserMessageFilter: public content::BrowserMessageFilter {
@@ -142,18 +170,17 @@ class WebViewBrowserMessageFilter: public content::BrowserMessageFilter {
 
  private:
   void OnReceivedHitTestData(int render_view, const _Ewk_Hit_Test& hit_test_data,
-      const NodeAttributesMap& node_attributes) {
+      const NodeAttributesMap& node_attributes, const gfx::Vector2d& scroll_offset) {
     DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
 
     RenderViewHost* render_view_host= web_view_->web_contents().GetRenderViewHost();
     CHECK(render_view_host);
 
     if (render_view_host && render_view_host->GetRoutingID() == render_view)
-      web_view_->UpdateHitTestData(hit_test_data, node_attributes);
+      web_view_->UpdateHitTestData(hit_test_data, node_attributes, scroll_offset);
   }
 
-  void OnReceivedHitTestAsyncData(int render_view, const _Ewk_Hit_Test& hit_test_data,
-                                  const NodeAttributesMap& node_attributes, int64_t request_id)
+  void OnReceivedHitTestAsyncData(int render_view, const HitTestAsyncResultsEfl& results)
   {
     DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
     WebContents* contents = GetWebContents();
@@ -163,7 +190,7 @@ class WebViewBrowserMessageFilter: public content::BrowserMessageFilter {
     CHECK(render_view_host);
 
     if (render_view_host->GetRoutingID() == render_view) {
-      web_view_->DispatchAsyncHitTestData(hit_test_data, node_attributes, request_id);
+      web_view_->DispatchAsyncHitTestData(results);
     }
   }
 
@@ -178,31 +205,6 @@ private:
   EWebView* web_view_;
 };
 
-class AsyncHitTestRequest
-{
- public:
-  AsyncHitTestRequest(int x, int y, tizen_webview::Hit_Test_Mode mode, tizen_webview::View_Hit_Test_Request_Callback callback, void* user_data)
-    : m_x(x)
-    , m_y(y)
-    , m_mode(mode)
-    , m_callback(callback)
-    , m_user_data(user_data)
-  { }
-
-  void Run(tizen_webview::Hit_Test *hit_test, Evas_Object* web_view)
-  {
-    DCHECK(m_callback);
-    m_callback(web_view, m_x, m_y, m_mode, hit_test, m_user_data);
-  }
-
- private:
-  int m_x;
-  int m_y;
-  tizen_webview::Hit_Test_Mode m_mode;
-  tizen_webview::View_Hit_Test_Request_Callback m_callback;
-  void* m_user_data;
-};
-
 class WebViewGeolocationPermissionCallback {
  public:
   WebViewGeolocationPermissionCallback(tizen_webview::View_Geolocation_Permission_Callback cb, void* data)
@@ -254,6 +256,9 @@ RenderWidgetHostViewEfl* EWebView::rwhv() const {
 }
 
 void EWebView::set_renderer_crashed() {
+  InvalidateHitTestRegions();
+  // The renderer will not answer the queries already sent.
+  CancelAsyncHitTests();
 #ifndef NDEBUG
   DCHECK(!renderer_crashed_);
   renderer_crashed_ = true;
@@ -268,6 +273,7 @@ EWebView::EWebView(tizen_webview::WebView* owner, tizen_webview::WebContext* con
       touch_events_enabled_(false),
       mouse_events_enabled_(false),
       text_zoom_factor_(1.0),
+      navigation_policy_enabled_(true),
       current_find_request_id_(find_request_id_counter_++),
       progress_(0.0),
       hit_test_completion_(false, false),
@@ -276,10 +282,14 @@ EWebView::EWebView(tizen_webview::WebView* owner, tizen_webview::WebContext* con
       max_page_scale_factor_(-1.0),
       inspector_server_(NULL),
       message_filter_(NULL),
+      async_hit_test_queue_(object,
+                            base::Bind(&EWebView::SendAsyncHitTestQueries,
+                                       base::Unretained(this))),
 #ifndef NDEBUG
       renderer_crashed_(false),
 #endif
-      is_initialized_(false) {
+      is_initialized_(false),
+      weak_ptr_factory_(this) {
   context->GetImpl()->InitializeGLSharedContext(object);
 }
 
@@ -308,6 +318,7 @@ void EWebView::Initialize() {
   web_contents_->SetDelegate(web_contents_delegate_.get());
   back_forward_list_.reset(new tizen_webview::BackForwardList(
       web_contents_->GetController()));
+  session_journal_.reset(new SessionJournalEfl(web_contents_.get()));
 
   // Activate Event handler
   evas_event_handler_->BindFocusEventHandlers();
@@ -356,6 +367,10 @@ EWebView::~EWebView()
   context_menu_.reset();
   mhtml_callback_map_.Clear();
 
+  // Nobody is left to decide on what the application suspended.
+  IgnoreUndecidedPolicies(&suspended_navigation_policies_);
+  IgnoreUndecidedPolicies(&suspended_response_policies_);
+
 #if defined(OS_TIZEN)
   void* item;
   EINA_LIST_FREE(popupMenuItems_, item);
@@ -564,12 +579,17 @@ void EWebView::InvokeAuthCallback(LoginDelegateEfl* login_delegate,
 }
 
 void EWebView::InvokePolicyResponseCallback(tizen_webview::PolicyDecision* policy_decision) {
-  set_policy_decision(policy_decision);
-  SmartCallback<EWebViewCallbacks::PolicyResponseDecide>().call(policy_decision_.get());
+  RemoveDecidedPolicies(&suspended_response_policies_);
+
+  scoped_ptr<tizen_webview::PolicyDecision> decision(policy_decision);
+  SmartCallback<EWebViewCallbacks::PolicyResponseDecide>().call(decision.get());
 
   // if app has not decided nor suspended, we act as if it was accepted.
-  if (!policy_decision_->isDecided() && !policy_decision_->isSuspended())
-    policy_decision_->Use();
+  if (!decision->isDecided() && !decision->isSuspended())
+    decision->Use();
+
+  if (!decision->isDecided())
+    suspended_response_policies_.Add(decision.release());
 }
 
 void EWebView::InvokePolicyNavigationCallback(RenderViewHost* rvh,
@@ -578,15 +598,77 @@ void EWebView::InvokePolicyNavigationCallback(RenderViewHost* rvh,
 
   SmartCallback<EWebViewCallbacks::SaveSessionData>().call();
 
-  policy_decision_.reset(new tizen_webview::PolicyDecision(params, rvh));
+  // The renderer is blocked on the answer, the decision cannot outlive the
+  // callback. It refuses to be suspended for that reason.
+  tizen_webview::PolicyDecision decision(params, rvh);
+
+  SmartCallback<EWebViewCallbacks::NavigationPolicyDecision>().call(&decision);
+
+  // if app has not decided, we act as if it was accepted.
+  DCHECK(!decision.isSuspended());
+  if (!decision.isDecided())
+    decision.Use();
+
+  *handled = decision.GetImpl()->GetNavigationPolicyHandler()->GetDecision() == NavigationPolicyHandlerEfl::Handled;
+}
+
+void EWebView::InvokePolicyNavigationCallbackAsync(RenderViewHost* rvh,
+    const NavigationPolicyParams params, int request_id) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+
+  RemoveDecidedPolicies(&suspended_navigation_policies_);
+
+  SmartCallback<EWebViewCallbacks::SaveSessionData>().call();
+
+  scoped_ptr<tizen_webview::PolicyDecision> decision(
+      new tizen_webview::PolicyDecision(params, rvh));
+  decision->GetImpl()->GetNavigationPolicyHandler()->ReplyWhenDecided(request_id);
 
-  SmartCallback<EWebViewCallbacks::NavigationPolicyDecision>().call(policy_decision_.get());
+  SmartCallback<EWebViewCallbacks::NavigationPolicyDecision>().call(decision.get());
 
   // if app has not decided nor suspended, we act as if it was accepted.
-  if (!policy_decision_->isDecided() && !policy_decision_->isSuspended())
-    policy_decision_->Use();
+  if (!decision->isDecided() && !decision->isSuspended())
+    decision->Use();
+
+  if (decision->isDecided())
+    return;
+
+  // A renderer which went away and came back may reuse the id, the old
+  // navigation is gone with it.
+  if (tizen_webview::PolicyDecision* stale =
+          suspended_navigation_policies_.Lookup(request_id)) {
+    stale->Ignore();
+    suspended_navigation_policies_.Remove(request_id);
+  }
+  suspended_navigation_policies_.AddWithID(decision.release(), request_id);
+}
+
+void EWebView::SetNavigationPolicyEnabled(bool enabled) {
+  if (navigation_policy_enabled_ == enabled)
+    return;
 
-  *handled = policy_decision_->GetImpl()->GetNavigationPolicyHandler()->GetDecision() == NavigationPolicyHandlerEfl::Handled;
+  navigation_policy_enabled_ = enabled;
+  RenderViewHost* rvh = web_contents_->GetRenderViewHost();
+  if (rvh)
+    rvh->Send(new EwkViewMsg_SetNavigationPolicyEnabled(rvh->GetRoutingID(), enabled));
+  PublishSettings();
+}
+
+void EWebView::SetResponsePolicyEnabled(bool enabled) {
+  response_policy_filter_.enabled = enabled;
+  PublishSettings();
+}
+
+void EWebView::SetResponsePolicyFilter(const std::vector<std::string>& mime_types,
+                                       const std::vector<std::string>& url_patterns) {
+  response_policy_filter_.mime_types = mime_types;
+  response_policy_filter_.url_patterns = url_patterns;
+  PublishSettings();
+}
+
+void EWebView::PublishSettings() {
+  if (web_contents_delegate_)
+    web_contents_delegate_->PublishSettings();
 }
 
 void EWebView::HandleTouchEvents(tizen_webview::Touch_Event_Type type, const Eina_List *points, const Evas_Modifier *modifiers)
@@ -1214,7 +1296,6 @@ tizen_webview::Hit_Test* EWebView::RequestHitTestDataAt(int x, int y, tizen_webv
 
 Eina_Bool EWebView::AsyncRequestHitTestDataAt(int x, int y, tizen_webview::Hit_Test_Mode mode, tizen_webview::View_Hit_Test_Request_Callback callback, void* user_data)
 {
-  static int64_t request_id = 1;
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
   // TODO: this calculations should be moved outside and reused everywhere it's required
   Evas_Coord tmpX, tmpY;
@@ -1225,6 +1306,13 @@ Eina_Bool EWebView::AsyncRequestHitTestDataAt(int x, int y, tizen_webview::Hit_T
   view_x /= rwhv()->device_scale_factor();
   view_y /= rwhv()->device_scale_factor();
 
+  async_hit_test_queue_.Add(gfx::Point(view_x, view_y), mode,
+      new AsyncHitTestRequest(x, y, mode, callback, user_data));
+  return EINA_TRUE;
+}
+
+void EWebView::SendAsyncHitTestQueries(const HitTestAsyncQueriesEfl& queries)
+{
   // WebViewBrowserMessageFilter requires RenderProcessHost to be already created.
   // In EWebView constructor we have no guarantee that related RenderProcessHost is already created
   // We do not destroy message_filter_ manualy as it is managed by RenderProcessHost after setting it as filter
@@ -1238,30 +1326,47 @@ Eina_Bool EWebView::AsyncRequestHitTestDataAt(int x, int y, tizen_webview::Hit_T
   content::RenderProcessHost* render_process_host = web_contents_->GetRenderProcessHost();
   CHECK(render_process_host);
 
-  render_view_host->Send(new EwkViewMsg_DoHitTestAsync(render_view_host->GetRoutingID(), view_x, view_y, mode, request_id));
-  m_pendingAsyncHitTests[request_id] = new AsyncHitTestRequest(x, y, mode, callback, user_data);
-  ++request_id;
-  return EINA_TRUE;
+  render_view_host->Send(new EwkViewMsg_DoHitTestAsync(render_view_host->GetRoutingID(), queries));
 }
 
-void EWebView::DispatchAsyncHitTestData(const _Ewk_Hit_Test& hit_test_data, const NodeAttributesMap& node_attributes, int64_t request_id)
+void EWebView::DispatchAsyncHitTestData(const HitTestAsyncResultsEfl& results)
 {
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
 
-  std::map<int64_t, AsyncHitTestRequest*>::iterator it = m_pendingAsyncHitTests.find(request_id);
-  if (it == m_pendingAsyncHitTests.end())
-      return;
+  for (size_t i = 0; i < results.size(); ++i) {
+    if (!results[i].valid) {
+      async_hit_test_queue_.Dispatch(results[i].query_id, NULL);
+      continue;
+    }
+    tizen_webview::Hit_Test data(results[i].hit_test);
+    data.impl->nodeData.PopulateNodeAtributes(results[i].node_attributes);
+    async_hit_test_queue_.Dispatch(results[i].query_id, &data);
+  }
+}
 
-  tizen_webview::Hit_Test data(hit_test_data);
-  data.impl->nodeData.PopulateNodeAtributes(node_attributes);
-  it->second->Run(&data, evas_object_);
-  delete it->second;
-  m_pendingAsyncHitTests.erase(it);
+void EWebView::CancelAsyncHitTests()
+{
+  async_hit_test_queue_.CancelAll();
 }
 
 tizen_webview::Hit_Test* EWebView::RequestHitTestDataAtBlinkCoords(int x, int y, tizen_webview::Hit_Test_Mode mode) {
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
 
+  // Regions are kept in document coordinates, using the scroll offset the
+  // renderer reported.
+  if (rwhv()) {
+    const gfx::Vector2d scroll_offset =
+        gfx::ToFlooredVector2d(rwhv()->GetLastScrollOffset());
+    const double scale = page_scale_factor_ > 0 ? page_scale_factor_ : 1.0;
+    const gfx::Point document_point(
+        static_cast<int>(scroll_offset.x() + x / scale),
+        static_cast<int>(scroll_offset.y() + y / scale));
+    const _Ewk_Hit_Test* cached =
+        hit_test_region_cache_.Lookup(document_point, scroll_offset, mode);
+    if (cached)
+      return new tizen_webview::Hit_Test(*cached);
+  }
+
   // WebViewBrowserMessageFilter requires RenderProcessHost to be already created.
   // In EWebView constructor we have no guarantee that related RenderProcessHost is already created
   // We do not destroy message_filter_ manualy as it is managed by RenderProcessHost after setting it as filter
@@ -1280,21 +1385,36 @@ tizen_webview::Hit_Test* EWebView::RequestHitTestDataAtBlinkCoords(int x, int y,
 #if !defined(EWK_BRINGUP)
     base::ThreadRestrictions::ScopedAllowWait allow_wait;
 #endif
+    base::TimeTicks wait_start = base::TimeTicks::Now();
     render_view_host->Send(new EwkViewMsg_DoHitTest(render_view_host->GetRoutingID(), x, y, mode));
     hit_test_completion_.Wait();
+    hit_test_region_cache_.RecordMissWaitTime(base::TimeTicks::Now() - wait_start);
+    hit_test_region_cache_.SetRendererScrollOffset(hit_test_scroll_offset_);
     return new tizen_webview::Hit_Test(hit_test_data_);
   }
 
   return NULL;
 }
 
-void EWebView::UpdateHitTestData(const _Ewk_Hit_Test& hit_test_data, const NodeAttributesMap& node_attributes) {
+void EWebView::UpdateHitTestData(const _Ewk_Hit_Test& hit_test_data, const NodeAttributesMap& node_attributes, const gfx::Vector2d& scroll_offset) {
   DCHECK(content::BrowserThread::CurrentlyOn(content::BrowserThread::IO));
   hit_test_data_ = hit_test_data;
   hit_test_data_.nodeData.PopulateNodeAtributes(node_attributes);
+  hit_test_scroll_offset_ = scroll_offset;
   hit_test_completion_.Signal();
 }
 
+void EWebView::UpdateHitTestRegions(const HitTestRegionsEfl& added,
+                                    const std::vector<int>& removed_ids,
+                                    bool replace,
+                                    const gfx::Vector2d& scroll_offset) {
+  hit_test_region_cache_.Update(added, removed_ids, replace, scroll_offset);
+}
+
+void EWebView::InvalidateHitTestRegions() {
+  hit_test_region_cache_.Invalidate();
+}
+
 void EWebView::OnCopyFromBackingStore(bool success, const SkBitmap& bitmap) {
   if (selection_controller_->GetSelectionStatus() ||
       selection_controller_->GetCaretSelectionStatus())
@@ -1329,39 +1449,95 @@ void EWebView::GetSnapShotForRect(gfx::Rect& rect) {
 Evas_Object* EWebView::GetSnapshot(Eina_Rectangle rect) {
   Evas_Object* image = NULL;
 #ifdef OS_TIZEN
-  int width = rect.w;
-  int height = rect.h;
-
-  if (width > rwhv()->GetViewBoundsInPix().width() - rect.x)
-    width = rwhv()->GetViewBoundsInPix().width() - rect.x;
-  if (height > rwhv()->GetViewBoundsInPix().height() - rect.y)
-    height = rwhv()->GetViewBoundsInPix().height() - rect.y;
-
-  int x = rect.x;
-  int y = rwhv()->GetViewBoundsInPix().height() - height + rect.y;
-
-  Evas_GL_API* gl_api = rwhv()->evasGlApi();
-  DCHECK(gl_api);
-  int size = width * height;
-
-  GLubyte tmp[size*4];
-  GLubyte bits[size*4];
-  gl_api->glReadPixels(x, y, width, height, GL_BGRA, GL_UNSIGNED_BYTE, bits);
+  gfx::Rect snapshot_rect = ClampSnapshotRect(rect);
+  if (snapshot_rect.IsEmpty())
+    return NULL;
 
-  //flip data after reading
-  for (int i=0; i < height; i++)
-    memcpy(&tmp[i*width*4], &bits[(height-i-1)*width*4], width*4*sizeof(unsigned char));
   image = evas_object_image_filled_add(rwhv()->evas());
   if (image) {
-    evas_object_image_size_set(image, width, height);
+    evas_object_image_size_set(image, snapshot_rect.width(), snapshot_rect.height());
     evas_object_image_alpha_set(image, EINA_TRUE);
-    evas_object_image_data_copy_set(image, tmp);
-    evas_object_resize(image, width, height);
+    // Read straight into the image buffer, no intermediate copies.
+    void* pixels = evas_object_image_data_get(image, EINA_TRUE);
+    int stride = evas_object_image_stride_get(image);
+    bool read = pixels && rwhv()->ReadPixelsFromSurface(snapshot_rect, pixels, stride);
+    evas_object_image_data_set(image, pixels);
+    if (!read) {
+      evas_object_del(image);
+      return NULL;
+    }
+    evas_object_image_data_update_add(image, 0, 0, snapshot_rect.width(), snapshot_rect.height());
+    evas_object_resize(image, snapshot_rect.width(), snapshot_rect.height());
   }
 #endif
   return image;
 }
 
+bool EWebView::GetSnapshotAsync(Eina_Rectangle rect, float scale_factor, Evas* canvas,
+    tizen_webview::Web_App_Screenshot_Captured_Callback callback, void* user_data) {
+  if (!rwhv() || !canvas || scale_factor <= 0)
+    return false;
+
+  gfx::Rect snapshot_rect = ClampSnapshotRect(rect);
+  if (snapshot_rect.IsEmpty())
+    return false;
+
+  gfx::Size dst_size = gfx::ToFlooredSize(
+      gfx::ScaleSize(snapshot_rect.size(), scale_factor));
+  if (dst_size.IsEmpty())
+    return false;
+
+  scoped_ptr<ScreenshotCapturedCallback> captured_callback(
+      new ScreenshotCapturedCallback(callback, user_data));
+  // The readback may finish after this view is gone, the callback runs
+  // anyway.
+  rwhv()->CopyFromPresentedFrame(snapshot_rect, dst_size,
+      base::Bind(&EWebView::OnSnapshotCaptured,
+                 weak_ptr_factory_.GetWeakPtr(), canvas,
+                 base::Passed(&captured_callback)),
+      kN32_SkColorType);
+  return true;
+}
+
+// static
+void EWebView::OnSnapshotCaptured(base::WeakPtr<EWebView> view, Evas* canvas,
+                                  scoped_ptr<ScreenshotCapturedCallback> callback,
+                                  bool success, const SkBitmap& bitmap) {
+  Evas_Object* image = NULL;
+  if (view && success && !bitmap.isNull()) {
+    image = evas_object_image_filled_add(canvas);
+    if (image) {
+      SkAutoLockPixels bitmap_lock(bitmap);
+      evas_object_image_size_set(image, bitmap.width(), bitmap.height());
+      evas_object_image_alpha_set(image, EINA_TRUE);
+      evas_object_image_data_copy_set(image, bitmap.getPixels());
+      evas_object_resize(image, bitmap.width(), bitmap.height());
+    }
+  }
+  callback->Run(image);
+}
+
+bool EWebView::SetFrameTimingEnabled(bool enabled) {
+  if (!rwhv())
+    return false;
+  rwhv()->SetFrameTimingEnabled(enabled);
+  return true;
+}
+
+bool EWebView::GetFrameTimings(std::vector<tizen_webview::Frame_Timing>* timings) const {
+  if (!rwhv() || !rwhv()->frame_timing_recorder())
+    return false;
+  rwhv()->frame_timing_recorder()->GetTimings(timings);
+  return true;
+}
+
+gfx::Rect EWebView::ClampSnapshotRect(const Eina_Rectangle& rect) const {
+  if (!rwhv())
+    return gfx::Rect();
+  gfx::Rect view_rect(rwhv()->GetViewBoundsInPix().size());
+  return gfx::IntersectRects(gfx::Rect(rect.x, rect.y, rect.w, rect.h), view_rect);
+}
+
 void EWebView::BackForwardListClear() {
   content::NavigationController& controller = web_contents_->GetController();
 
@@ -1598,62 +1774,29 @@ void EWebView::SetDrawsTransparentBackground(bool enabled) {
 }
 
 void EWebView::GetSessionData(const char **data, unsigned *length) const {
-  static const int MAX_SESSION_ENTRY_SIZE = std::numeric_limits<int>::max();
-
-  NavigationController &navigationController = web_contents_->GetController();
   Pickle sessionPickle;
-  const int itemCount = navigationController.GetEntryCount();
-
-  sessionPickle.WriteInt(itemCount);
-  sessionPickle.WriteInt(navigationController.GetCurrentEntryIndex());
-
-  for (int i = 0; i < itemCount; i++) {
-    NavigationEntry *navigationEntry = navigationController.GetEntryAtIndex(i);
-    sessions::SerializedNavigationEntry serializedEntry =
-      sessions::SerializedNavigationEntry::FromNavigationEntry(i, *navigationEntry);
-    serializedEntry.WriteToPickle(MAX_SESSION_ENTRY_SIZE, &sessionPickle);
-  }
+  session_journal_->WriteSnapshot(&sessionPickle);
 
   *data = static_cast<char *>(malloc(sizeof(char) * sessionPickle.size()));
   memcpy(const_cast<char *>(*data), sessionPickle.data(), sessionPickle.size());
   *length = sessionPickle.size();
 }
 
-bool EWebView::RestoreFromSessionData(const char *data, unsigned length) {
-  Pickle sessionPickle(data, length);
-  PickleIterator pickleIterator(sessionPickle);
-  int entryCount;
-  int currentEntry;
-
-  if (!pickleIterator.ReadInt(&entryCount))
-    return false;
-  if (!pickleIterator.ReadInt(&currentEntry))
-    return false;
-
-  std::vector<sessions::SerializedNavigationEntry> serializedEntries;
-  serializedEntries.resize(entryCount);
-  for (int i = 0; i < entryCount; ++i) {
-    if (!serializedEntries.at(i).ReadFromPickle(&pickleIterator))
-      return false;
+void EWebView::GetSessionCheckpoint(const char **data, unsigned *length) const {
+  Pickle checkpointPickle;
+  if (!session_journal_->WriteCheckpoint(&checkpointPickle)) {
+    *data = NULL;
+    *length = 0;
+    return;
   }
 
-  if (!entryCount)
-    return true;
-
-  std::vector<NavigationEntry *> navigationEntries =
-    sessions::SerializedNavigationEntry::ToNavigationEntries(serializedEntries, context()->browser_context());
-  NavigationController &navigationController = web_contents_->GetController();
-
-  if (currentEntry < 0)
-    currentEntry = 0;
-
-  if (currentEntry >= static_cast<int>(navigationEntries.size()))
-    currentEntry = navigationEntries.size() - 1;
+  *data = static_cast<char *>(malloc(sizeof(char) * checkpointPickle.size()));
+  memcpy(const_cast<char *>(*data), checkpointPickle.data(), checkpointPickle.size());
+  *length = checkpointPickle.size();
+}
 
-  navigationController.Restore(currentEntry,
-                               NavigationController::RESTORE_LAST_SESSION_EXITED_CLEANLY,
-                               &navigationEntries);
-  return true;
+bool EWebView::RestoreFromSessionData(const char *data, unsigned length) {
+  return session_journal_->Restore(data, length);
 }
 
 void EWebView::SetBrowserFont() {
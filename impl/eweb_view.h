@@ -14,11 +14,13 @@
 #endif
 
 #include <map>
+#include <vector>
 #include <string>
 #include <Evas.h>
 #include <locale.h>
 
 #include "base/memory/scoped_ptr.h"
+#include "base/memory/weak_ptr.h"
 #include "base/synchronization/waitable_event.h"
 #include "content/public/common/context_menu_params.h"
 #include "content/public/common/file_chooser_params.h"
@@ -32,6 +34,9 @@
 #include "API/ewk_auth_challenge_private.h"
 #include "API/ewk_settings_private.h"
 #include "API/ewk_web_application_icon_data_private.h"
+#include "browser/async_hit_test_queue_efl.h"
+#include "browser/hit_test_region_cache_efl.h"
+#include "browser/response_policy_filter_efl.h"
 #include "eweb_view_callbacks.h"
 #include "selection_controller_efl.h"
 #include "web_contents_delegate_efl.h"
@@ -62,6 +67,7 @@
 #include "tizen_webview/public/tw_callbacks.h"
 #include "tizen_webview/public/tw_content_security_policy.h"
 #include "tizen_webview/public/tw_frame.h"
+#include "tizen_webview/public/tw_frame_timing.h"
 #include "tizen_webview/public/tw_input_type.h"
 #include "tizen_webview/public/tw_find_options.h"
 #include "tizen_webview/public/tw_touch_event.h"
@@ -182,8 +188,24 @@ class WebApplicationCapableGetCallback {
   void *user_data_;
 };
 
-class AsyncHitTestRequest;
+class ScreenshotCapturedCallback {
+ public:
+  ScreenshotCapturedCallback(tizen_webview::Web_App_Screenshot_Captured_Callback func, void *user_data)
+    : func_(func), user_data_(user_data)
+  {}
+  void Run(Evas_Object* image) {
+    if (func_) {
+      (func_)(image, user_data_);
+    }
+  }
+
+ private:
+  tizen_webview::Web_App_Screenshot_Captured_Callback func_;
+  void *user_data_;
+};
+
 class JavaScriptDialogManagerEfl;
+class SessionJournalEfl;
 class WebViewBrowserMessageFilter;
 class WebViewGeolocationPermissionCallback;
 
@@ -300,18 +322,54 @@ class EWebView {
    * @note ownership of snapshot is passed to caller
   */
   Evas_Object* GetSnapshot(Eina_Rectangle rect);
+
+  /**
+   * Asynchronous version of GetSnapshot. The readback and scaling by
+   * |scale_factor| run on the GPU, |callback| receives the image (created
+   * on |canvas|) or NULL on failure, ownership is passed to the callee.
+   *
+   * @return false if the request could not be started
+  */
+  bool GetSnapshotAsync(Eina_Rectangle rect, float scale_factor, Evas* canvas,
+      tizen_webview::Web_App_Screenshot_Captured_Callback callback, void* user_data);
+
+  // Per frame timing of the compositor output, off by default.
+  bool SetFrameTimingEnabled(bool enabled);
+  bool GetFrameTimings(std::vector<tizen_webview::Frame_Timing>* timings) const;
+
   void set_policy_decision(tizen_webview::PolicyDecision* pr) { policy_decision_.reset(pr); }
   tizen_webview::PolicyDecision* get_policy_decision() const { return policy_decision_.get(); }
   void InvokePolicyResponseCallback(tizen_webview::PolicyDecision* policy_decision);
   void InvokePolicyNavigationCallback(content::RenderViewHost* rvh,
       NavigationPolicyParams params, bool* handled);
+  // The renderer holds the navigation back until the decision is made, which
+  // lets the application suspend it.
+  void InvokePolicyNavigationCallbackAsync(content::RenderViewHost* rvh,
+      NavigationPolicyParams params, int request_id);
+  // Navigations are not offered to the application when disabled.
+  bool NavigationPolicyEnabled() const { return navigation_policy_enabled_; }
+  void SetNavigationPolicyEnabled(bool enabled);
+  // Responses are offered to the application only while enabled and when
+  // they match the filter, the others are let through on the IO thread.
+  void SetResponsePolicyEnabled(bool enabled);
+  void SetResponsePolicyFilter(const std::vector<std::string>& mime_types,
+                               const std::vector<std::string>& url_patterns);
+  const ResponsePolicyFilterEfl::Filter& response_policy_filter() const {
+    return response_policy_filter_;
+  }
+  // Makes the settings above, and those of the context requests depend on,
+  // visible to the IO thread.
+  void PublishSettings();
   void UseSettingsFont();
 
   tizen_webview::Hit_Test* RequestHitTestDataAt(int x, int y, tizen_webview::Hit_Test_Mode mode);
   Eina_Bool AsyncRequestHitTestDataAt(int x, int y, tizen_webview::Hit_Test_Mode mode, tizen_webview::View_Hit_Test_Request_Callback, void* user_data);
   tizen_webview::Hit_Test* RequestHitTestDataAtBlinkCoords(int x, int y, tizen_webview::Hit_Test_Mode mode);
-  void DispatchAsyncHitTestData(const _Ewk_Hit_Test& hit_test_data, const NodeAttributesMap& node_attributes, int64_t request_id);
-  void UpdateHitTestData(const _Ewk_Hit_Test& hit_test_data, const NodeAttributesMap& node_attributes);
+  void DispatchAsyncHitTestData(const HitTestAsyncResultsEfl& results);
+  void CancelAsyncHitTests();
+  void UpdateHitTestData(const _Ewk_Hit_Test& hit_test_data, const NodeAttributesMap& node_attributes, const gfx::Vector2d& scroll_offset);
+  void UpdateHitTestRegions(const HitTestRegionsEfl& added, const std::vector<int>& removed_ids, bool replace, const gfx::Vector2d& scroll_offset);
+  void InvalidateHitTestRegions();
 
   int current_find_request_id() const { return current_find_request_id_; }
   bool PlainTextGet(tizen_webview::View_Plain_Text_Get_Callback callback, void* user_data);
@@ -329,6 +387,7 @@ class EWebView {
   bool SaveAsPdf(int width, int height, const std::string& file_name);
   void BackForwardListClear();
   tizen_webview::BackForwardList* GetBackForwardList() const;
+  SessionJournalEfl* session_journal() const { return session_journal_.get(); }
   void InvokeBackForwardListChangedCallback();
   tizen_webview::BackForwardHistory* GetBackForwardHistory() const;
   bool WebAppCapableGet(tizen_webview::Web_App_Capable_Get_Callback callback, void *userData);
@@ -355,6 +414,7 @@ class EWebView {
   void DidChangePageScaleRange(double min_scale, double max_scale);
   void SetDrawsTransparentBackground(bool enabled);
   void GetSessionData(const char **data, unsigned *length) const;
+  void GetSessionCheckpoint(const char **data, unsigned *length) const;
   bool RestoreFromSessionData(const char *data, unsigned length);
   void ShowFileChooser(const content::FileChooserParams&);
   void DidChangeContentsArea(int width, int height);
@@ -415,6 +475,12 @@ class EWebView {
 #endif
   content::RenderWidgetHostViewEfl* rwhv() const;
   JavaScriptDialogManagerEfl* GetJavaScriptDialogManagerEfl();
+  gfx::Rect ClampSnapshotRect(const Eina_Rectangle& rect) const;
+  // Always runs |callback|, with NULL if |view| is gone or the copy failed.
+  static void OnSnapshotCaptured(base::WeakPtr<EWebView> view, Evas* canvas,
+                                 scoped_ptr<ScreenshotCapturedCallback> callback,
+                                 bool success, const SkBitmap& bitmap);
+  void SendAsyncHitTestQueries(const HitTestAsyncQueriesEfl& queries);
 
   // For popup windows the WebContents is created internally and we need to associate it with the
   // new view created by the embedder. We set this before calling the "create,window" callback and
@@ -441,6 +507,12 @@ class EWebView {
   mutable std::string selected_text_;
   scoped_ptr<_Ewk_Auth_Challenge> auth_challenge_;
   scoped_ptr<tizen_webview::PolicyDecision> policy_decision_;
+  // Decisions the application suspended, they stay valid until decided.
+  // Deferred navigations are keyed by their request id.
+  IDMap<tizen_webview::PolicyDecision, IDMapOwnPointer> suspended_navigation_policies_;
+  IDMap<tizen_webview::PolicyDecision, IDMapOwnPointer> suspended_response_policies_;
+  bool navigation_policy_enabled_;
+  ResponsePolicyFilterEfl::Filter response_policy_filter_;
 #if defined(OS_TIZEN)
   Eina_List* popupMenuItems_;
   Popup_Picker* popupPicker_;
@@ -467,7 +539,9 @@ class EWebView {
   double progress_;
   mutable std::string title_;
   _Ewk_Hit_Test hit_test_data_;
+  gfx::Vector2d hit_test_scroll_offset_;
   base::WaitableEvent hit_test_completion_;
+  HitTestRegionCacheEfl hit_test_region_cache_;
   IDMap<MHTMLCallbackDetails, IDMapOwnPointer> mhtml_callback_map_;
   double page_scale_factor_;
   double min_page_scale_factor_;
@@ -483,6 +557,7 @@ class EWebView {
   scoped_refptr<EdgeEffect> edge_effect_;
 #endif
   WebViewBrowserMessageFilter* message_filter_;
+  AsyncHitTestQueueEfl async_hit_test_queue_;
 
 #ifndef NDEBUG
   bool renderer_crashed_;
@@ -492,8 +567,10 @@ class EWebView {
 #endif
   bool is_initialized_;
 
-  std::map<int64_t, AsyncHitTestRequest*> m_pendingAsyncHitTests;
   scoped_ptr<tizen_webview::BackForwardList> back_forward_list_;
+  scoped_ptr<SessionJournalEfl> session_journal_;
+
+  base::WeakPtrFactory<EWebView> weak_ptr_factory_;
 
 private:
   // only tizen_webview::WebView can create and delete this
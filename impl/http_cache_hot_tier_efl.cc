@@ -0,0 +1,521 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "http_cache_hot_tier_efl.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "base/bind.h"
+#include "base/strings/string_number_conversions.h"
+#include "net/base/io_buffer.h"
+#include "net/base/net_errors.h"
+
+namespace net {
+
+namespace {
+
+// Streams of a disk cache entry: response info, body and metadata.
+const int kStreamCount = 3;
+const int kDefaultCapacity = 2 * 1024 * 1024;
+// An entry is copied to memory the time it is opened again.
+const int kPromoteAfterOpens = 2;
+const size_t kMaxTrackedKeys = 1024;
+
+void DiskBackendCreated(scoped_ptr<disk_cache::Backend>* disk_backend,
+                        int capacity,
+                        scoped_ptr<disk_cache::Backend>* backend,
+                        const CompletionCallback& callback,
+                        int rv) {
+  if (rv == OK)
+    backend->reset(new HttpCacheHotTierEfl(disk_backend->Pass(), capacity));
+  callback.Run(rv);
+}
+
+}  // namespace
+
+// Reads the streams of an entry from memory when it is hot, and copies them
+// while they are read when it is about to become hot. Shared by all
+// transactions reading the entry, like the disk entry it wraps.
+class HttpCacheHotTierEfl::HotEntry : public disk_cache::Entry {
+ public:
+  HotEntry(base::WeakPtr<HttpCacheHotTierEfl> tier,
+           disk_cache::Entry* entry,
+           HotObject* object,
+           bool capture)
+      : tier_(tier),
+        entry_(entry),
+        object_(object),
+        capture_(capture),
+        weak_factory_(this) {
+  }
+
+  // disk_cache::Entry implementation.
+  virtual void Doom() override {
+    if (tier_)
+      tier_->Drop(entry_->GetKey());
+    object_ = NULL;
+    StopCapture();
+    entry_->Doom();
+  }
+
+  virtual void Close() override {
+    if (capture_ && tier_ && CaptureComplete()) {
+      scoped_refptr<HotObject> object(new HotObject);
+      for (int i = 0; i < kStreamCount; ++i)
+        object->data[i].swap(captured_[i]);
+      tier_->Insert(entry_->GetKey(), object);
+    }
+    entry_->Close();
+    delete this;
+  }
+
+  virtual std::string GetKey() const override {
+    return entry_->GetKey();
+  }
+
+  virtual base::Time GetLastUsed() const override {
+    return entry_->GetLastUsed();
+  }
+
+  virtual base::Time GetLastModified() const override {
+    return entry_->GetLastModified();
+  }
+
+  virtual int32 GetDataSize(int index) const override {
+    return entry_->GetDataSize(index);
+  }
+
+  virtual int ReadData(int index, int offset, IOBuffer* buf, int buf_len,
+                       const CompletionCallback& callback) override {
+    if (object_.get() && index >= 0 && index < kStreamCount) {
+      if (offset < 0 || buf_len < 0)
+        return ERR_INVALID_ARGUMENT;
+      const std::string& data = object_->data[index];
+      if (offset >= static_cast<int>(data.size()))
+        return 0;
+      int len = std::min(buf_len, static_cast<int>(data.size()) - offset);
+      memcpy(buf->data(), data.data() + offset, len);
+      return len;
+    }
+    if (!capture_)
+      return entry_->ReadData(index, offset, buf, buf_len, callback);
+
+    int rv = entry_->ReadData(index, offset, buf, buf_len,
+        base::Bind(&HotEntry::DataRead, weak_factory_.GetWeakPtr(), index,
+                   offset, make_scoped_refptr(buf), callback));
+    if (rv != ERR_IO_PENDING)
+      Capture(index, offset, buf, rv);
+    return rv;
+  }
+
+  virtual int WriteData(int index, int offset, IOBuffer* buf, int buf_len,
+                        const CompletionCallback& callback,
+                        bool truncate) override {
+    StopCapture();
+    if (!object_.get())
+      return entry_->WriteData(index, offset, buf, buf_len, callback, truncate);
+
+    // Revalidations rewrite the response info as a whole, the copy follows.
+    // Anything else drops it.
+    if (index < 0 || index >= kStreamCount || offset || !truncate) {
+      DropObject();
+      return entry_->WriteData(index, offset, buf, buf_len, callback, truncate);
+    }
+
+    std::string data(buf->data(), buf_len);
+    int rv = entry_->WriteData(index, offset, buf, buf_len,
+        base::Bind(&HotEntry::DataWritten, weak_factory_.GetWeakPtr(), index,
+                   data, callback),
+        truncate);
+    if (rv != ERR_IO_PENDING)
+      Written(index, data, rv);
+    return rv;
+  }
+
+  virtual int ReadSparseData(int64 offset, IOBuffer* buf, int buf_len,
+                             const CompletionCallback& callback) override {
+    return entry_->ReadSparseData(offset, buf, buf_len, callback);
+  }
+
+  virtual int WriteSparseData(int64 offset, IOBuffer* buf, int buf_len,
+                              const CompletionCallback& callback) override {
+    StopCapture();
+    DropObject();
+    return entry_->WriteSparseData(offset, buf, buf_len, callback);
+  }
+
+  virtual int GetAvailableRange(int64 offset, int len, int64* start,
+                                const CompletionCallback& callback) override {
+    return entry_->GetAvailableRange(offset, len, start, callback);
+  }
+
+  virtual bool CouldBeSparse() const override {
+    return entry_->CouldBeSparse();
+  }
+
+  virtual void CancelSparseIO() override {
+    entry_->CancelSparseIO();
+  }
+
+  virtual int ReadyForSparseIO(const CompletionCallback& callback) override {
+    return entry_->ReadyForSparseIO(callback);
+  }
+
+ private:
+  virtual ~HotEntry() {}
+
+  // The callers are called back even after the entry is closed.
+  static void DataRead(base::WeakPtr<HotEntry> entry,
+                       int index,
+                       int offset,
+                       scoped_refptr<IOBuffer> buf,
+                       const CompletionCallback& callback,
+                       int rv) {
+    if (entry)
+      entry->Capture(index, offset, buf.get(), rv);
+    callback.Run(rv);
+  }
+
+  static void DataWritten(base::WeakPtr<HotEntry> entry,
+                          int index,
+                          const std::string& data,
+                          const CompletionCallback& callback,
+                          int rv) {
+    if (entry)
+      entry->Written(index, data, rv);
+    callback.Run(rv);
+  }
+
+  // Transactions sharing the entry may read the same bytes again, only a
+  // gap stops the copy.
+  void Capture(int index, int offset, IOBuffer* buf, int rv) {
+    if (!capture_)
+      return;
+    if (index < 0 || index >= kStreamCount || rv < 0 ||
+        offset > static_cast<int>(captured_[index].size())) {
+      StopCapture();
+      return;
+    }
+    int captured = static_cast<int>(captured_[index].size());
+    if (offset + rv > captured) {
+      captured_[index].append(buf->data() + captured - offset,
+                              offset + rv - captured);
+    }
+  }
+
+  bool CaptureComplete() const {
+    for (int i = 0; i < kStreamCount; ++i) {
+      if (static_cast<int>(captured_[i].size()) != entry_->GetDataSize(i))
+        return false;
+    }
+    return true;
+  }
+
+  void StopCapture() {
+    capture_ = false;
+    for (int i = 0; i < kStreamCount; ++i)
+      captured_[i].clear();
+  }
+
+  void Written(int index, const std::string& data, int rv) {
+    if (!object_.get())
+      return;
+    if (rv != static_cast<int>(data.size())) {
+      DropObject();
+      return;
+    }
+    if (tier_)
+      tier_->StreamWritten(entry_->GetKey(), object_.get(), index, data);
+    else
+      object_->data[index] = data;
+  }
+
+  void DropObject() {
+    if (object_.get() && tier_)
+      tier_->Drop(entry_->GetKey());
+    object_ = NULL;
+  }
+
+  base::WeakPtr<HttpCacheHotTierEfl> tier_;
+  disk_cache::Entry* entry_;
+  scoped_refptr<HotObject> object_;
+  bool capture_;
+  std::string captured_[kStreamCount];
+
+  base::WeakPtrFactory<HotEntry> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(HotEntry);
+};
+
+HttpCacheHotTierEfl::Stats::Stats()
+    : memory_hits(0),
+      memory_misses(0),
+      disk_hits(0),
+      disk_misses(0),
+      memory_size(0),
+      memory_capacity(0) {
+}
+
+HttpCacheHotTierEfl::Factory::Factory(HttpCache::BackendFactory* disk_factory,
+                                      int capacity)
+    : disk_factory_(disk_factory),
+      capacity_(capacity) {
+}
+
+HttpCacheHotTierEfl::Factory::~Factory() {
+}
+
+int HttpCacheHotTierEfl::Factory::CreateBackend(
+    NetLog* net_log,
+    scoped_ptr<disk_cache::Backend>* backend,
+    const CompletionCallback& callback) {
+  // Owned by the callback, the HTTP cache may be gone before it runs.
+  scoped_ptr<disk_cache::Backend>* disk_backend =
+      new scoped_ptr<disk_cache::Backend>;
+  CompletionCallback created = base::Bind(&DiskBackendCreated,
+      base::Owned(disk_backend), capacity_, backend, callback);
+  int rv = disk_factory_->CreateBackend(net_log, disk_backend, created);
+  if (rv == OK)
+    backend->reset(new HttpCacheHotTierEfl(disk_backend->Pass(), capacity_));
+  return rv;
+}
+
+int64 HttpCacheHotTierEfl::HotObject::Size() const {
+  int64 size = 0;
+  for (int i = 0; i < kStreamCount; ++i)
+    size += data[i].size();
+  return size;
+}
+
+HttpCacheHotTierEfl::HttpCacheHotTierEfl(
+    scoped_ptr<disk_cache::Backend> disk_backend, int capacity)
+    : disk_backend_(disk_backend.Pass()),
+      capacity_(capacity > 0 ? capacity : kDefaultCapacity),
+      size_(0),
+      weak_factory_(this) {
+}
+
+HttpCacheHotTierEfl::~HttpCacheHotTierEfl() {
+}
+
+void HttpCacheHotTierEfl::SetCapacity(int capacity) {
+  capacity_ = capacity > 0 ? capacity : kDefaultCapacity;
+  Trim(capacity_);
+}
+
+void HttpCacheHotTierEfl::Trim(int64 size) {
+  while (size_ > size && !lru_.empty())
+    Drop(lru_.back());
+}
+
+HttpCacheHotTierEfl::Stats HttpCacheHotTierEfl::GetStatistics() const {
+  Stats stats = stats_;
+  stats.memory_size = size_;
+  stats.memory_capacity = capacity_;
+  return stats;
+}
+
+CacheType HttpCacheHotTierEfl::GetCacheType() const {
+  return disk_backend_->GetCacheType();
+}
+
+int32 HttpCacheHotTierEfl::GetEntryCount() const {
+  return disk_backend_->GetEntryCount();
+}
+
+int HttpCacheHotTierEfl::OpenEntry(const std::string& key,
+                                   disk_cache::Entry** entry,
+                                   const CompletionCallback& callback) {
+  disk_cache::Entry** disk_entry = new disk_cache::Entry*(NULL);
+  CompletionCallback opened = base::Bind(
+      &HttpCacheHotTierEfl::DiskEntryOpened, weak_factory_.GetWeakPtr(), key,
+      base::Owned(disk_entry), entry, callback);
+  int rv = disk_backend_->OpenEntry(key, disk_entry, opened);
+  if (rv != ERR_IO_PENDING)
+    EntryOpened(key, *disk_entry, entry, rv);
+  return rv;
+}
+
+// static
+void HttpCacheHotTierEfl::DiskEntryOpened(
+    base::WeakPtr<HttpCacheHotTierEfl> tier,
+    const std::string& key,
+    disk_cache::Entry** disk_entry,
+    disk_cache::Entry** entry,
+    const CompletionCallback& callback,
+    int rv) {
+  if (!tier) {
+    if (rv == OK)
+      (*disk_entry)->Close();
+    return;
+  }
+  tier->EntryOpened(key, *disk_entry, entry, rv);
+  callback.Run(rv);
+}
+
+void HttpCacheHotTierEfl::EntryOpened(const std::string& key,
+                                      disk_cache::Entry* disk_entry,
+                                      disk_cache::Entry** entry,
+                                      int rv) {
+  if (rv != OK) {
+    // The disk cache evicted it.
+    Drop(key);
+    ++stats_.memory_misses;
+    ++stats_.disk_misses;
+    return;
+  }
+
+  scoped_refptr<HotObject> object;
+  SlotMap::iterator it = slots_.find(key);
+  if (it != slots_.end()) {
+    object = it->second.object;
+    for (int i = 0; i < kStreamCount; ++i) {
+      if (disk_entry->GetDataSize(i) !=
+          static_cast<int32>(object->data[i].size())) {
+        object = NULL;
+        break;
+      }
+    }
+    if (object.get())
+      lru_.splice(lru_.begin(), lru_, it->second.lru_position);
+    else
+      Drop(key);
+  }
+
+  if (object.get()) {
+    ++stats_.memory_hits;
+  } else {
+    ++stats_.memory_misses;
+    ++stats_.disk_hits;
+  }
+  bool capture = !object.get() && ShouldPromote(key, disk_entry);
+  *entry = new HotEntry(weak_factory_.GetWeakPtr(), disk_entry, object.get(),
+                        capture);
+}
+
+bool HttpCacheHotTierEfl::ShouldPromote(const std::string& key,
+                                        disk_cache::Entry* disk_entry) {
+  // Range requests keep their data apart.
+  if (disk_entry->CouldBeSparse())
+    return false;
+
+  int64 size = 0;
+  for (int i = 0; i < kStreamCount; ++i)
+    size += disk_entry->GetDataSize(i);
+  if (size > MaxObjectSize())
+    return false;
+
+  if (open_counts_.size() >= kMaxTrackedKeys)
+    open_counts_.clear();
+  return ++open_counts_[key] >= kPromoteAfterOpens;
+}
+
+int HttpCacheHotTierEfl::CreateEntry(const std::string& key,
+                                     disk_cache::Entry** entry,
+                                     const CompletionCallback& callback) {
+  Drop(key);
+  return disk_backend_->CreateEntry(key, entry, callback);
+}
+
+int HttpCacheHotTierEfl::DoomEntry(const std::string& key,
+                                   const CompletionCallback& callback) {
+  Drop(key);
+  return disk_backend_->DoomEntry(key, callback);
+}
+
+int HttpCacheHotTierEfl::DoomAllEntries(const CompletionCallback& callback) {
+  DropAll();
+  return disk_backend_->DoomAllEntries(callback);
+}
+
+int HttpCacheHotTierEfl::DoomEntriesBetween(
+    base::Time initial_time,
+    base::Time end_time,
+    const CompletionCallback& callback) {
+  DropAll();
+  return disk_backend_->DoomEntriesBetween(initial_time, end_time, callback);
+}
+
+int HttpCacheHotTierEfl::DoomEntriesSince(
+    base::Time initial_time,
+    const CompletionCallback& callback) {
+  DropAll();
+  return disk_backend_->DoomEntriesSince(initial_time, callback);
+}
+
+scoped_ptr<disk_cache::Backend::Iterator>
+HttpCacheHotTierEfl::CreateIterator() {
+  return disk_backend_->CreateIterator();
+}
+
+void HttpCacheHotTierEfl::GetStats(
+    std::vector<std::pair<std::string, std::string> >* stats) {
+  disk_backend_->GetStats(stats);
+  Stats statistics = GetStatistics();
+  stats->push_back(std::make_pair(std::string("Hot tier hits"),
+      base::Int64ToString(statistics.memory_hits)));
+  stats->push_back(std::make_pair(std::string("Hot tier misses"),
+      base::Int64ToString(statistics.memory_misses)));
+  stats->push_back(std::make_pair(std::string("Hot tier size"),
+      base::Int64ToString(statistics.memory_size)));
+  stats->push_back(std::make_pair(std::string("Hot tier capacity"),
+      base::Int64ToString(statistics.memory_capacity)));
+}
+
+void HttpCacheHotTierEfl::OnExternalCacheHit(const std::string& key) {
+  disk_backend_->OnExternalCacheHit(key);
+}
+
+void HttpCacheHotTierEfl::Insert(const std::string& key,
+                                 scoped_refptr<HotObject> object) {
+  open_counts_.erase(key);
+  if (object->Size() > MaxObjectSize())
+    return;
+
+  Drop(key);
+  lru_.push_front(key);
+  Slot& slot = slots_[key];
+  slot.object = object;
+  slot.lru_position = lru_.begin();
+  size_ += object->Size();
+  Trim(capacity_);
+}
+
+void HttpCacheHotTierEfl::StreamWritten(const std::string& key,
+                                        HotObject* object,
+                                        int index,
+                                        const std::string& data) {
+  SlotMap::iterator it = slots_.find(key);
+  bool held = it != slots_.end() && it->second.object.get() == object;
+  if (held)
+    size_ -= object->Size();
+  object->data[index] = data;
+  if (!held)
+    return;
+
+  size_ += object->Size();
+  if (object->Size() > MaxObjectSize())
+    Drop(key);
+  else
+    Trim(capacity_);
+}
+
+void HttpCacheHotTierEfl::Drop(const std::string& key) {
+  SlotMap::iterator it = slots_.find(key);
+  if (it == slots_.end())
+    return;
+  size_ -= it->second.object->Size();
+  lru_.erase(it->second.lru_position);
+  slots_.erase(it);
+}
+
+void HttpCacheHotTierEfl::DropAll() {
+  slots_.clear();
+  lru_.clear();
+  size_ = 0;
+}
+
+}  // namespace net
@@ -0,0 +1,155 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef HTTP_CACHE_HOT_TIER_EFL_H_
+#define HTTP_CACHE_HOT_TIER_EFL_H_
+
+#include <list>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "net/disk_cache/disk_cache.h"
+#include "net/http/http_cache.h"
+
+namespace net {
+
+// Keeps the small disk cache entries which are opened over and over, such as
+// the scripts and style sheets of a web app, in memory. Entries are still
+// opened on disk, the disk cache stays the reference for what is cached,
+// but their data is read from memory. The data is copied while the HTTP
+// cache reads it, promoting an entry costs no extra disk reads. Writes go to
+// disk and update or drop the copy. Lives on the IO thread.
+class HttpCacheHotTierEfl : public disk_cache::Backend {
+ public:
+  struct Stats {
+    Stats();
+
+    // Every opened entry counts once per tier it was looked up in.
+    int64 memory_hits;
+    int64 memory_misses;
+    int64 disk_hits;
+    int64 disk_misses;
+    // In bytes.
+    int64 memory_size;
+    int64 memory_capacity;
+  };
+
+  // Wraps the backend |disk_factory| creates.
+  class Factory : public HttpCache::BackendFactory {
+   public:
+    Factory(HttpCache::BackendFactory* disk_factory, int capacity);
+    virtual ~Factory();
+
+    // HttpCache::BackendFactory implementation.
+    virtual int CreateBackend(NetLog* net_log,
+                              scoped_ptr<disk_cache::Backend>* backend,
+                              const CompletionCallback& callback) override;
+
+   private:
+    scoped_ptr<HttpCache::BackendFactory> disk_factory_;
+    int capacity_;
+
+    DISALLOW_COPY_AND_ASSIGN(Factory);
+  };
+
+  // A |capacity| of 0 picks a default.
+  HttpCacheHotTierEfl(scoped_ptr<disk_cache::Backend> disk_backend,
+                      int capacity);
+  virtual ~HttpCacheHotTierEfl();
+
+  disk_cache::Backend* disk_backend() const { return disk_backend_.get(); }
+
+  // Drops the least recently used entries which no longer fit.
+  void SetCapacity(int capacity);
+  // Drops the least recently used entries until at most |size| bytes stay.
+  void Trim(int64 size);
+  Stats GetStatistics() const;
+
+  // disk_cache::Backend implementation.
+  virtual CacheType GetCacheType() const override;
+  virtual int32 GetEntryCount() const override;
+  virtual int OpenEntry(const std::string& key, disk_cache::Entry** entry,
+                        const CompletionCallback& callback) override;
+  virtual int CreateEntry(const std::string& key, disk_cache::Entry** entry,
+                          const CompletionCallback& callback) override;
+  virtual int DoomEntry(const std::string& key,
+                        const CompletionCallback& callback) override;
+  virtual int DoomAllEntries(const CompletionCallback& callback) override;
+  virtual int DoomEntriesBetween(base::Time initial_time,
+                                 base::Time end_time,
+                                 const CompletionCallback& callback) override;
+  virtual int DoomEntriesSince(base::Time initial_time,
+                               const CompletionCallback& callback) override;
+  virtual scoped_ptr<Iterator> CreateIterator() override;
+  virtual void GetStats(
+      std::vector<std::pair<std::string, std::string> >* stats) override;
+  virtual void OnExternalCacheHit(const std::string& key) override;
+
+ private:
+  class HotEntry;
+
+  // The streams of one entry, shared with the entries reading it.
+  struct HotObject : public base::RefCounted<HotObject> {
+    std::string data[3];
+    int64 Size() const;
+
+   private:
+    friend class base::RefCounted<HotObject>;
+    ~HotObject() {}
+  };
+
+  typedef std::list<std::string> LruList;
+  struct Slot {
+    scoped_refptr<HotObject> object;
+    LruList::iterator lru_position;
+  };
+  typedef std::map<std::string, Slot> SlotMap;
+
+  static void DiskEntryOpened(base::WeakPtr<HttpCacheHotTierEfl> tier,
+                              const std::string& key,
+                              disk_cache::Entry** disk_entry,
+                              disk_cache::Entry** entry,
+                              const CompletionCallback& callback,
+                              int rv);
+  void EntryOpened(const std::string& key,
+                   disk_cache::Entry* disk_entry,
+                   disk_cache::Entry** entry,
+                   int rv);
+  // Whether the data of |disk_entry| should be copied while it is read.
+  bool ShouldPromote(const std::string& key, disk_cache::Entry* disk_entry);
+  int64 MaxObjectSize() const { return capacity_ / 8; }
+
+  // Called by HotEntry.
+  void Insert(const std::string& key, scoped_refptr<HotObject> object);
+  void StreamWritten(const std::string& key,
+                     HotObject* object,
+                     int index,
+                     const std::string& data);
+  void Drop(const std::string& key);
+  void DropAll();
+
+  scoped_ptr<disk_cache::Backend> disk_backend_;
+  int64 capacity_;
+  int64 size_;
+  SlotMap slots_;
+  // Most recently used first.
+  LruList lru_;
+  // Times keys were opened, to tell the hot ones.
+  std::map<std::string, int> open_counts_;
+  Stats stats_;
+
+  base::WeakPtrFactory<HttpCacheHotTierEfl> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(HttpCacheHotTierEfl);
+};
+
+}  // namespace net
+
+#endif  // HTTP_CACHE_HOT_TIER_EFL_H_
@@ -5,22 +5,51 @@
 
 #include "memory_purger.h"
 
+#include <algorithm>
 #include <set>
 
 #include "base/allocator/allocator_extension.h"
 #include "base/bind.h"
+#include "base/metrics/histogram.h"
+#include "base/process/process_metrics.h"
 #include "base/threading/thread.h"
+#include "browser/favicon/favicon_database.h"
+#include "browser/renderer_host/render_widget_host_view_efl.h"
 #include "common/render_messages_efl.h"
 #include "content/public/browser/render_process_host.h"
 #include "content/public/browser/render_widget_host.h"
+#include "content/public/browser/render_widget_host_iterator.h"
 #include "content/public/browser/browser_thread.h"
-#include "net/proxy/proxy_resolver.h"
-#include "net/proxy/proxy_service.h"
+#include "net/base/net_errors.h"
+#include "net/disk_cache/disk_cache.h"
+#include "net/http/http_cache.h"
+#include "net/http/http_transaction_factory.h"
 #include "net/url_request/url_request_context.h"
 #include "net/url_request/url_request_context_getter.h"
+#include "url_request_context_getter_efl.h"
 
 using content::BrowserContext;
 using content::BrowserThread;
+using content::RenderWidgetHostViewEfl;
+
+namespace {
+
+// Under moderate pressure HTTP memory cache entries last used more recently
+// than this are kept.
+const int kModerateHttpCacheKeepMinutes = 5;
+
+int64 GetResidentBytes() {
+  scoped_ptr<base::ProcessMetrics> metrics(
+      base::ProcessMetrics::CreateProcessMetrics(
+          base::GetCurrentProcessHandle()));
+  return metrics->GetWorkingSetSize();
+}
+
+void ReportFaviconsTrimmed(size_t bytes) {
+  MemoryPurger::ReportReclaimed(MemoryPurger::STEP_FAVICONS, bytes);
+}
+
+}  // namespace
 
 // PurgeMemoryHelper -----------------------------------------------------------
 
@@ -30,11 +59,13 @@ using content::BrowserThread;
 class PurgeMemoryIOHelper
     : public base::RefCountedThreadSafe<PurgeMemoryIOHelper> {
  public:
-  PurgeMemoryIOHelper() {
+  explicit PurgeMemoryIOHelper(MemoryPurger::Level level)
+      : level_(level) {
   }
 
   void AddRequestContextGetter(
-      scoped_refptr<net::URLRequestContextGetter> request_context_getter);
+      scoped_refptr<content::URLRequestContextGetterEfl>
+          request_context_getter);
 
   void PurgeMemoryOnIOThread();
 
@@ -43,55 +74,129 @@ class PurgeMemoryIOHelper
 
   virtual ~PurgeMemoryIOHelper() {}
 
-  typedef scoped_refptr<net::URLRequestContextGetter> RequestContextGetter;
+  // Disk caches only keep their index and hot tier in memory.
+  void PurgeHttpMemoryCache(
+      content::URLRequestContextGetterEfl* request_context_getter);
+  void HttpMemoryCachePurged(int64 resident_before, int rv);
+
+  typedef scoped_refptr<content::URLRequestContextGetterEfl>
+      RequestContextGetter;
   std::vector<RequestContextGetter> request_context_getters_;
+  MemoryPurger::Level level_;
 
   DISALLOW_COPY_AND_ASSIGN(PurgeMemoryIOHelper);
 };
 
 void PurgeMemoryIOHelper::AddRequestContextGetter(
-    scoped_refptr<net::URLRequestContextGetter> request_context_getter) {
+    scoped_refptr<content::URLRequestContextGetterEfl>
+        request_context_getter) {
   request_context_getters_.push_back(request_context_getter);
 }
 
 void PurgeMemoryIOHelper::PurgeMemoryOnIOThread() {
-  // Ask ProxyServices to purge any memory they can (generally garbage in the
-  // wrapped ProxyResolver's JS engine).
-#warning "[M37] Fix memory purge"
-#if 0
-  for (size_t i = 0; i < request_context_getters_.size(); ++i) {
-    request_context_getters_[i]->GetURLRequestContext()->proxy_service()->
-        PurgeMemory();
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  for (size_t i = 0; i < request_context_getters_.size(); ++i)
+    PurgeHttpMemoryCache(request_context_getters_[i].get());
+}
+
+void PurgeMemoryIOHelper::PurgeHttpMemoryCache(
+    content::URLRequestContextGetterEfl* request_context_getter) {
+  if (net::HttpCacheHotTierEfl* hot_tier =
+          request_context_getter->http_cache_hot_tier()) {
+    int64 held = hot_tier->GetStatistics().memory_size;
+    hot_tier->Trim(level_ == MemoryPurger::LEVEL_CRITICAL ? 0 : held / 2);
+    MemoryPurger::ReportReclaimed(
+        MemoryPurger::STEP_HTTP_CACHE,
+        held - hot_tier->GetStatistics().memory_size);
+    return;
+  }
+
+  net::URLRequestContext* context =
+      request_context_getter->GetURLRequestContext();
+  if (!context || !context->http_transaction_factory())
+    return;
+
+  net::HttpCache* http_cache =
+      context->http_transaction_factory()->GetCache();
+  disk_cache::Backend* backend =
+      http_cache ? http_cache->GetCurrentBackend() : NULL;
+  if (!backend || backend->GetCacheType() != net::MEMORY_CACHE)
+    return;
+
+  // Entries hold no count of their bytes, measure what leaving them frees.
+  net::CompletionCallback done =
+      base::Bind(&PurgeMemoryIOHelper::HttpMemoryCachePurged, this,
+                 GetResidentBytes());
+  int rv;
+  if (level_ == MemoryPurger::LEVEL_CRITICAL) {
+    rv = backend->DoomAllEntries(done);
+  } else {
+    base::Time keep_since = base::Time::Now() -
+        base::TimeDelta::FromMinutes(kModerateHttpCacheKeepMinutes);
+    rv = backend->DoomEntriesBetween(base::Time(), keep_since, done);
   }
-#endif
+  if (rv != net::ERR_IO_PENDING)
+    done.Run(rv);
+}
+
+void PurgeMemoryIOHelper::HttpMemoryCachePurged(int64 resident_before,
+                                                int rv) {
+  base::allocator::ReleaseFreeMemory();
+  MemoryPurger::ReportReclaimed(
+      MemoryPurger::STEP_HTTP_CACHE,
+      std::max<int64>(resident_before - GetResidentBytes(), 0));
 }
 
 // -----------------------------------------------------------------------------
 
 // static
-void MemoryPurger::PurgeAll(BrowserContext* browser_context) {
-  PurgeBrowser(browser_context);
-  PurgeRenderers();
+void MemoryPurger::Purge(BrowserContext* browser_context, Level level) {
+  PurgeBrowser(browser_context, level);
+  PurgeRenderers(level);
   // TODO(pk):
   // * Tell the plugin processes to release their free memory?  Other stuff?
   // * Enumerate what other processes exist and what to do for them.
 }
 
 // static
-void MemoryPurger::PurgeBrowser(BrowserContext* browser_context) {
-  // Dump the backing stores.
-#warning "[M37] backing stores were removed, so the code below is probably safe to remove, check this."
-  //content::RenderWidgetHost::RemoveAllBackingStores();
+void MemoryPurger::PurgeBrowser(BrowserContext* browser_context, Level level) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  bool critical = level == LEVEL_CRITICAL;
+
   scoped_refptr<PurgeMemoryIOHelper> purge_memory_io_helper(
-      new PurgeMemoryIOHelper());
+      new PurgeMemoryIOHelper(level));
+  // Every context is a BrowserContextEfl.
   purge_memory_io_helper->AddRequestContextGetter(
-        make_scoped_refptr(browser_context->GetRequestContext()));
-#warning "[M37] Another non existing function"
-  //BrowserContext::PurgeMemory(browser_context);
+        make_scoped_refptr(static_cast<content::URLRequestContextGetterEfl*>(
+            browser_context->GetRequestContext())));
   BrowserThread::PostTask(
       BrowserThread::IO, FROM_HERE,
       base::Bind(&PurgeMemoryIOHelper::PurgeMemoryOnIOThread,
                  purge_memory_io_helper.get()));
+
+  // The favicon database syncs on the DB thread, trimming has to wait for
+  // pending changes to reach sqlite.
+  BrowserThread::PostTaskAndReplyWithResult(
+      BrowserThread::DB, FROM_HERE,
+      base::Bind(&FaviconDatabase::TrimMemory,
+                 base::Unretained(FaviconDatabase::Instance()), critical),
+      base::Bind(&ReportFaviconsTrimmed));
+
+  // Hidden views of this context give up their Evas GL surface.
+  int64 gpu_bytes = 0;
+  scoped_ptr<content::RenderWidgetHostIterator> widgets(
+      content::RenderWidgetHost::GetRenderWidgetHosts());
+  while (content::RenderWidgetHost* widget = widgets->GetNextHost()) {
+    if (widget->GetProcess()->GetBrowserContext() != browser_context)
+      continue;
+    RenderWidgetHostViewEfl* view =
+        static_cast<RenderWidgetHostViewEfl*>(widget->GetView());
+    if (!view)
+      continue;
+    gpu_bytes += view->ReleaseHiddenGpuResources();
+  }
+  ReportReclaimed(STEP_GPU_SURFACES, gpu_bytes);
+
   // Tell our allocator to release any free pages it's still holding.
   //
   // TODO(pk): A lot of the above calls kick off actions on other threads.
@@ -101,7 +206,7 @@ void MemoryPurger::PurgeBrowser(BrowserContext* browser_context) {
 }
 
 // static
-void MemoryPurger::PurgeRenderers() {
+void MemoryPurger::PurgeRenderers(Level level) {
   // Direct all renderers to free everything they can.
   //
   // Concern: Telling a bunch of renderer processes to destroy their data may
@@ -110,13 +215,39 @@ void MemoryPurger::PurgeRenderers() {
   for (content::RenderProcessHost::iterator i(
           content::RenderProcessHost::AllHostsIterator());
        !i.IsAtEnd(); i.Advance())
-    PurgeRendererForHost(i.GetCurrentValue());
+    PurgeRendererForHost(i.GetCurrentValue(), level);
 }
 
 // static
-void MemoryPurger::PurgeRendererForHost(content::RenderProcessHost* host) {
-#if !defined(EWK_BRINGUP)
-  // Direct the renderer to free everything it can.
-  host->Send(new EwkViewMsg_PurgeMemory());
-#endif
+void MemoryPurger::PurgeRendererForHost(content::RenderProcessHost* host,
+                                        Level level) {
+  // The renderer answers with EwkHostMsg_MemoryPurged.
+  host->Send(new EwkViewMsg_PurgeMemory(level == LEVEL_CRITICAL));
+}
+
+// static
+void MemoryPurger::ReportReclaimed(Step step, int64 bytes) {
+  // Histogram names have to be constant at each call site.
+  int kb = static_cast<int>(bytes / 1024);
+  const char* name = NULL;
+  switch (step) {
+    case STEP_HTTP_CACHE:
+      name = "HttpCache";
+      UMA_HISTOGRAM_MEMORY_KB("Efl.MemoryPurger.HttpCache", kb);
+      break;
+    case STEP_FAVICONS:
+      name = "Favicons";
+      UMA_HISTOGRAM_MEMORY_KB("Efl.MemoryPurger.Favicons", kb);
+      break;
+    case STEP_GPU_SURFACES:
+      name = "GpuSurfaces";
+      UMA_HISTOGRAM_MEMORY_KB("Efl.MemoryPurger.GpuSurfaces", kb);
+      break;
+    case STEP_RENDERER:
+      name = "Renderer";
+      UMA_HISTOGRAM_MEMORY_KB("Efl.MemoryPurger.Renderer", kb);
+      break;
+  }
+  LOG(INFO) << "[MemoryPurger] " << name << " reclaimed " << bytes
+            << " bytes";
 }
@@ -3,13 +3,13 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
-// MemoryPurger provides static APIs to purge as much memory as possible from
-// all processes.  These can be hooked to various signals to try and balance
-// memory consumption, speed, page swapping, etc.
+// MemoryPurger provides static APIs to purge memory from all processes.
+// These can be hooked to various signals to try and balance memory
+// consumption, speed, page swapping, etc.
 //
-// This was implemented in an attempt to speed up suspend-to-disk by throwing
-// away any cached data that can be recomputed.  Memory use will rapidly
-// re-expand after this purge is run.
+// Purging is tiered: under moderate pressure only data which is cheap to
+// rebuild is dropped, under critical pressure everything that can be
+// recomputed goes. Memory use will re-expand after a purge is run.
 
 #ifndef MEMORY_PURGER_H_
 #define MEMORY_PURGER_H_
@@ -23,11 +23,34 @@ class RenderProcessHost;
 
 class MemoryPurger {
  public:
+  enum Level {
+    // Drops unreferenced and stale data: old HTTP memory cache entries, the
+    // colder half of the HTTP cache hot tier, favicons no page uses, the GPU
+    // surfaces of hidden views and dead renderer resources.
+    LEVEL_MODERATE,
+    // Additionally drops the whole HTTP memory cache and hot tier, all
+    // favicon bitmaps, renderer fonts and JS garbage.
+    LEVEL_CRITICAL,
+  };
+
+  // Places memory is reclaimed from, each one reports what it freed.
+  enum Step {
+    STEP_HTTP_CACHE,
+    STEP_FAVICONS,
+    STEP_GPU_SURFACES,
+    STEP_RENDERER,
+  };
+
   // Call any of these on the UI thread to purge memory from the named places.
-  static void PurgeAll(content::BrowserContext* browser_context);
-  static void PurgeBrowser(content::BrowserContext* browser_context);
-  static void PurgeRenderers();
-  static void PurgeRendererForHost(content::RenderProcessHost* host);
+  static void Purge(content::BrowserContext* browser_context, Level level);
+  static void PurgeBrowser(content::BrowserContext* browser_context,
+                           Level level);
+  static void PurgeRenderers(Level level);
+  static void PurgeRendererForHost(content::RenderProcessHost* host,
+                                   Level level);
+
+  // Logs and records the bytes |step| reclaimed. Called on any thread.
+  static void ReportReclaimed(Step step, int64 bytes);
 
  private:
   DISALLOW_IMPLICIT_CONSTRUCTORS(MemoryPurger);
@@ -7,21 +7,47 @@
 #define private public
 #include "base/run_loop.h"
 #undef private
-#include "base/time/time.h"
+#include "base/debug/trace_event.h"
+#include "base/logging.h"
+#include "base/posix/eintr_wrapper.h"
 #include <Ecore.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
 
 namespace base {
 
 namespace {
-static const char dummy_pipe_message[] = "W";
-static const int dummy_pipe_message_size = 1;
-}
+
+// How long the delayed work timer waits while no deadline is pending.
+const double kIdleTimerInterval = 3600;
+
+} // namespace
 
 MessagePumpForUIEfl::MessagePumpForUIEfl()
-  : pipe_(ecore_pipe_add(&PipeCallback, this))
-  , delegate_(base::MessageLoopForUI::current())
-  , run_loop_(new RunLoop())
-  , work_scheduled_(false) {
+  : wakeup_fd_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+  , wakeup_handler_(NULL)
+  , work_scheduled_(0)
+  , delayed_work_timer_(NULL)
+  , delegate_(NULL)
+  , run_loop_(NULL)
+  , run_state_(NULL)
+  , wakeups_requested_(0)
+  , wakeups_signaled_(0)
+  , timers_created_(0)
+  , timers_armed_(0)
+  , timers_skipped_(0) {
+  PCHECK(wakeup_fd_ >= 0);
+  wakeup_handler_ = ecore_main_fd_handler_add(
+      wakeup_fd_, ECORE_FD_READ, &WakeupCallback, this, NULL, NULL);
+  DCHECK(wakeup_handler_);
+
+  if (!base::MessageLoop::current())
+    return;
+
+  // The embedder spins the Ecore main loop itself and never calls Run(), so
+  // pretend the MessageLoop is running for the lifetime of the pump.
+  delegate_ = base::MessageLoopForUI::current();
+  run_loop_ = new RunLoop();
   // Since the RunLoop was just created above, BeforeRun should be guaranteed to
   // return true (it only returns false if the RunLoop has been Quit already).
   bool result = run_loop_->BeforeRun();
@@ -29,43 +55,98 @@ MessagePumpForUIEfl::MessagePumpForUIEfl()
 }
 
 MessagePumpForUIEfl::~MessagePumpForUIEfl() {
-  for (std::unordered_set<TimerPair*>::iterator it = pending_timers_.begin();
-       it != pending_timers_.end(); ++it) {
-    ecore_timer_del((*it)->second);
-    delete *it;
+  ShutDown();
+  if (wakeup_fd_ >= 0) {
+    IGNORE_EINTR(close(wakeup_fd_));
+    wakeup_fd_ = -1;
   }
 }
 
-// FIXME: need to be implemented for tests.
 void MessagePumpForUIEfl::Run(base::MessagePump::Delegate* delegate) {
-  NOTREACHED();
+  DCHECK(wakeup_handler_);
+  TRACE_EVENT0("efl", "MessagePumpForUIEfl::Run");
+
+  RunState state;
+  state.delegate = delegate;
+  state.should_quit = false;
+  state.previous_state = run_state_;
+  run_state_ = &state;
+
+  // Work may have been posted before Run() and the pending wakeup may
+  // belong to the outer loop, make sure the delegate gets a chance to run.
+  base::subtle::Release_Store(&work_scheduled_, 0);
+  ScheduleWork();
+
+  // Ecore supports nesting, ecore_main_loop_quit() only leaves the innermost
+  // ecore_main_loop_begin(). Someone else quitting our level of the Ecore
+  // loop must not end the Run() though.
+  while (!state.should_quit)
+    ecore_main_loop_begin();
+
+  run_state_ = state.previous_state;
+
+  // The outer loop may have work which was not dispatched while nested.
+  if (run_state_ || delegate_)
+    ScheduleWork();
 }
 
-// FIXME: need to be implemented for tests.
 void MessagePumpForUIEfl::Quit() {
+  if (run_state_) {
+    run_state_->should_quit = true;
+    ecore_main_loop_quit();
+    return;
+  }
+
   // RunLoop must be destroyed before chromium cleanup
-  ecore_pipe_del(pipe_);
+  ShutDown();
+  if (!run_loop_)
+    return;
   DCHECK(run_loop_->running());
   run_loop_->AfterRun();
   delete run_loop_;
   run_loop_ = NULL;
-  pipe_ = NULL;
 }
 
-void MessagePumpForUIEfl::ScheduleWork() {
-  {
-    base::AutoLock locker(schedule_work_lock_);
-    if (work_scheduled_)
-      return;
-    work_scheduled_ = true;
+void MessagePumpForUIEfl::ShutDown() {
+  if (delayed_work_timer_) {
+    ecore_timer_del(delayed_work_timer_);
+    delayed_work_timer_ = NULL;
   }
+  delayed_work_time_ = base::TimeTicks();
+  // The eventfd stays open: a late ScheduleWork() from another thread
+  // writes to it without anyone reading, instead of to a recycled fd.
+  if (wakeup_handler_) {
+    ecore_main_fd_handler_del(wakeup_handler_);
+    wakeup_handler_ = NULL;
+  }
+}
+
+void MessagePumpForUIEfl::ScheduleWork() {
+  base::subtle::NoBarrier_AtomicIncrement(&wakeups_requested_, 1);
+  if (wakeup_fd_ < 0)
+    return;
 
-  DCHECK(pipe_);
-  bool ok = ecore_pipe_write(pipe_, dummy_pipe_message, dummy_pipe_message_size);
-  DCHECK(ok);
+  // Only the first caller after the pump last ran has to wake it up.
+  if (base::subtle::Acquire_CompareAndSwap(&work_scheduled_, 0, 1) != 0)
+    return;
+
+  base::subtle::NoBarrier_AtomicIncrement(&wakeups_signaled_, 1);
+  const uint64_t value = 1;
+  ssize_t written = HANDLE_EINTR(write(wakeup_fd_, &value, sizeof(value)));
+  DPCHECK(written == static_cast<ssize_t>(sizeof(value)));
 }
 
 void MessagePumpForUIEfl::ScheduleDelayedWork(const base::TimeTicks& delayed_work_time) {
+  if (!wakeup_handler_)
+    return;
+
+  // The pending timer fires first and will ask the delegate for the next
+  // deadline anyway, there is nothing to do for a later one.
+  if (!delayed_work_time_.is_null() && delayed_work_time >= delayed_work_time_) {
+    ++timers_skipped_;
+    return;
+  }
+
   base::TimeTicks now = base::TimeTicks::Now();
   double delay;
   if (delayed_work_time < now)
@@ -73,43 +154,83 @@ void MessagePumpForUIEfl::ScheduleDelayedWork(const base::TimeTicks& delayed_wor
   else
     delay = base::TimeDelta(delayed_work_time - now).InSecondsF();
 
-  TimerPair* new_pair = new TimerPair();
-  new_pair->first = this;
-  new_pair->second = ecore_timer_add(delay, &TimerCallback, new_pair);
-  pending_timers_.insert(new_pair);
+  delayed_work_time_ = delayed_work_time;
+  ++timers_armed_;
+  if (!delayed_work_timer_) {
+    ++timers_created_;
+    delayed_work_timer_ = ecore_timer_add(delay, &TimerCallback, this);
+    return;
+  }
+  ecore_timer_interval_set(delayed_work_timer_, delay);
+  ecore_timer_reset(delayed_work_timer_);
+}
+
+MessagePumpForUIEfl::Stats MessagePumpForUIEfl::GetStats() const {
+  Stats stats;
+  stats.wakeups_requested = base::subtle::NoBarrier_Load(&wakeups_requested_);
+  stats.wakeups_signaled = base::subtle::NoBarrier_Load(&wakeups_signaled_);
+  stats.timers_created = timers_created_;
+  stats.timers_armed = timers_armed_;
+  stats.timers_skipped = timers_skipped_;
+  return stats;
 }
 
-void MessagePumpForUIEfl::PipeCallback(void *data, void*, unsigned int) {
+MessagePump::Delegate* MessagePumpForUIEfl::delegate() const {
+  return run_state_ ? run_state_->delegate : delegate_;
+}
+
+bool MessagePumpForUIEfl::ShouldQuit() const {
+  return run_state_ && run_state_->should_quit;
+}
+
+Eina_Bool MessagePumpForUIEfl::WakeupCallback(void* data, Ecore_Fd_Handler*) {
   static_cast<MessagePumpForUIEfl*>(data)->DoWork();
+  return ECORE_CALLBACK_RENEW;
 }
 
 Eina_Bool MessagePumpForUIEfl::TimerCallback(void* data) {
-  TimerPair* current_timer_pair = static_cast<TimerPair*>(data);
-  current_timer_pair->first->DoDelayedWork();
-  current_timer_pair->first->pending_timers_.erase(current_timer_pair);
-
-  delete current_timer_pair;
-  return false;
+  MessagePumpForUIEfl* pump = static_cast<MessagePumpForUIEfl*>(data);
+  // Ecore reschedules the timer one interval after it returns, whatever was
+  // armed meanwhile. So the delayed work runs from DoWork(), where the next
+  // deadline re-arms the timer, and the timer idles until then. This also
+  // keeps nested loops run by delayed tasks out of the timer callback.
+  pump->delayed_work_time_ = base::TimeTicks();
+  ecore_timer_interval_set(pump->delayed_work_timer_, kIdleTimerInterval);
+  pump->ScheduleWork();
+  return ECORE_CALLBACK_RENEW;
 }
 
 void MessagePumpForUIEfl::DoWork() {
-  {
-    base::AutoLock locker(schedule_work_lock_);
-    DCHECK(work_scheduled_);
-    work_scheduled_ = false;
-  }
+  TRACE_EVENT0("efl", "MessagePumpForUIEfl::DoWork");
 
-  bool more_work_is_plausible = delegate_->DoWork();
+  // Drain the eventfd, then allow new wakeups before running the tasks.
+  uint64_t value;
+  HANDLE_EINTR(read(wakeup_fd_, &value, sizeof(value)));
+  base::subtle::Release_Store(&work_scheduled_, 0);
+  base::subtle::MemoryBarrier();
+
+  Delegate* delegate = this->delegate();
+  if (!delegate || ShouldQuit())
+    return;
+
+  bool more_work_is_plausible = delegate->DoWork();
+  if (ShouldQuit())
+    return;
 
   base::TimeTicks delayed_work_time;
-  more_work_is_plausible |= delegate_->DoDelayedWork(&delayed_work_time);
+  more_work_is_plausible |= delegate->DoDelayedWork(&delayed_work_time);
+  if (ShouldQuit())
+    return;
 
   if (more_work_is_plausible) {
     ScheduleWork();
     return;
   }
 
-  more_work_is_plausible |= delegate_->DoIdleWork();
+  more_work_is_plausible |= delegate->DoIdleWork();
+  if (ShouldQuit())
+    return;
+
   if (more_work_is_plausible) {
     ScheduleWork();
     return;
@@ -119,12 +240,4 @@ void MessagePumpForUIEfl::DoWork() {
     ScheduleDelayedWork(delayed_work_time);
 }
 
-void MessagePumpForUIEfl::DoDelayedWork() {
-  base::TimeTicks next_delayed_work_time;
-  delegate_->DoDelayedWork(&next_delayed_work_time);
-
-  if (!next_delayed_work_time.is_null())
-    ScheduleDelayedWork(next_delayed_work_time);
-}
-
 }
@@ -5,19 +5,29 @@
 #ifndef MESSAGE_PUMP_FOR_UI_EFL
 #define MESSAGE_PUMP_FOR_UI_EFL
 
+#include "base/atomicops.h"
 #include "base/message_loop/message_pump.h"
-#include "base/synchronization/lock.h"
+#include "base/time/time.h"
 #include <Ecore.h>
 #include <Eina.h>
-#include <unordered_set>
 
 namespace base {
 
 class RunLoop;
-class TimeTicks;
-class MessagePumpForUIEfl;
-typedef std::pair<MessagePumpForUIEfl*, Ecore_Timer*> TimerPair;
 
+// Drives chromium's UI message loop from the Ecore main loop.
+//
+// Wakeups go through an eventfd watched by the Ecore main loop. A lock-free
+// flag coalesces them so that at most one write is in flight no matter how
+// many tasks are posted before the pump gets to run. Delayed work uses a
+// single Ecore timer, created once and idling while no deadline is pending.
+// It is only re-armed when the requested deadline is earlier than the one
+// already pending.
+//
+// When created on a thread with a MessageLoop the pump is attached to it and
+// driven by the embedder's Ecore main loop, Run() is then only used for
+// nested loops. Without a MessageLoop the pump can be run directly with any
+// Delegate, which is what the headless tests do.
 class BASE_EXPORT MessagePumpForUIEfl : public base::MessagePump {
  public:
   MessagePumpForUIEfl();
@@ -28,18 +38,56 @@ class BASE_EXPORT MessagePumpForUIEfl : public base::MessagePump {
   virtual void ScheduleWork() override;
   virtual void ScheduleDelayedWork(const base::TimeTicks&) override;
 
+  // Counters for the wakeup and timer traffic of the pump.
+  struct Stats {
+    Stats()
+      : wakeups_requested(0), wakeups_signaled(0),
+        timers_created(0), timers_armed(0), timers_skipped(0) {}
+    int wakeups_requested; // ScheduleWork calls
+    int wakeups_signaled;  // eventfd writes after coalescing
+    int timers_created;    // Ecore timers added for delayed work
+    int timers_armed;      // delayed work timer (re)armed
+    int timers_skipped;    // deadline not earlier than the pending one
+  };
+  Stats GetStats() const;
+
  private:
-  static void PipeCallback(void*, void*, unsigned int);
+  static Eina_Bool WakeupCallback(void*, Ecore_Fd_Handler*);
   static Eina_Bool TimerCallback(void*);
+  struct RunState {
+    Delegate* delegate;
+    bool should_quit;
+    RunState* previous_state;
+  };
+
+  Delegate* delegate() const;
+  bool ShouldQuit() const;
   void DoWork();
-  void DoDelayedWork();
+  void ShutDown();
+
+  // Only closed by the destructor, other threads may still schedule work
+  // after Quit().
+  int wakeup_fd_;
+  Ecore_Fd_Handler* wakeup_handler_;
+  // Set while a wakeup is pending, cleared on the UI thread before running
+  // the work so that tasks posted meanwhile signal a new wakeup.
+  base::subtle::Atomic32 work_scheduled_;
+
+  // Created on the first delayed work, idles while none is pending.
+  Ecore_Timer* delayed_work_timer_;
+  // Deadline the timer is armed for, null while it idles.
+  base::TimeTicks delayed_work_time_;
 
-  std::unordered_set<TimerPair*> pending_timers_;
-  Ecore_Pipe* pipe_;
   Delegate* delegate_;
   RunLoop* run_loop_;
-  base::Lock schedule_work_lock_;
-  bool work_scheduled_;
+  // Innermost Run() invocation, NULL outside of Run().
+  RunState* run_state_;
+
+  base::subtle::Atomic32 wakeups_requested_;
+  base::subtle::Atomic32 wakeups_signaled_;
+  int timers_created_;
+  int timers_armed_;
+  int timers_skipped_;
 
   DISALLOW_COPY_AND_ASSIGN(MessagePumpForUIEfl);
 };
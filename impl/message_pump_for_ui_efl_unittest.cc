@@ -0,0 +1,599 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Headless tests for MessagePumpForUIEfl. The pump is driven directly with a
+// test Delegate, so neither a display nor a MessageLoop is required. The Perf*
+// cases additionally print task latency, delayed task accuracy and idle work
+// figures under synthetic load in the chromium perf result format, and compare
+// post-task throughput and timer churn with the Ecore pipe based pump which
+// was used before.
+
+#include "message_pump_for_ui_efl.h"
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <set>
+#include <vector>
+
+#include <Ecore.h>
+
+#include "base/at_exit.h"
+#include "base/bind.h"
+#include "base/bind_helpers.h"
+#include "base/location.h"
+#include "base/message_loop/message_loop.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/thread.h"
+#include "gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+// Minimal MessagePump::Delegate with an immediate queue which can be fed from
+// any thread, a delayed queue for the pump thread and an optional idle task.
+class TestDelegate : public MessagePump::Delegate {
+ public:
+  explicit TestDelegate(MessagePump* pump)
+    : pump_(pump)
+    , idle_work_count_(0) {
+  }
+
+  void PostTask(const Closure& task) {
+    {
+      AutoLock locker(lock_);
+      work_queue_.push_back(task);
+    }
+    pump_->ScheduleWork();
+  }
+
+  void PostDelayedTask(const Closure& task, TimeDelta delay) {
+    delayed_work_queue_.insert(std::make_pair(TimeTicks::Now() + delay, task));
+    pump_->ScheduleDelayedWork(delayed_work_queue_.begin()->first);
+  }
+
+  void set_idle_task(const Closure& task) { idle_task_ = task; }
+  int idle_work_count() const { return idle_work_count_; }
+
+  virtual bool DoWork() override {
+    // Like MessageLoop, report more work whenever a task was run.
+    Closure task;
+    {
+      AutoLock locker(lock_);
+      if (work_queue_.empty())
+        return false;
+      task = work_queue_.front();
+      work_queue_.pop_front();
+    }
+    task.Run();
+    return true;
+  }
+
+  virtual bool DoDelayedWork(TimeTicks* next_delayed_work_time) override {
+    *next_delayed_work_time = TimeTicks();
+    if (delayed_work_queue_.empty())
+      return false;
+
+    DelayedQueue::iterator next = delayed_work_queue_.begin();
+    if (next->first > TimeTicks::Now()) {
+      *next_delayed_work_time = next->first;
+      return false;
+    }
+
+    Closure task = next->second;
+    delayed_work_queue_.erase(next);
+    task.Run();
+
+    if (!delayed_work_queue_.empty())
+      *next_delayed_work_time = delayed_work_queue_.begin()->first;
+    return true;
+  }
+
+  virtual bool DoIdleWork() override {
+    ++idle_work_count_;
+    if (!idle_task_.is_null())
+      idle_task_.Run();
+    return false;
+  }
+
+ private:
+  typedef std::multimap<TimeTicks, Closure> DelayedQueue;
+
+  MessagePump* pump_;
+  Lock lock_;
+  std::deque<Closure> work_queue_;
+  DelayedQueue delayed_work_queue_;
+  Closure idle_task_;
+  int idle_work_count_;
+};
+
+// The pump as it was before the eventfd and single timer: every wakeup goes
+// through a locked flag and an Ecore pipe, and every ScheduleDelayedWork adds
+// another Ecore timer. Kept as the reference for the comparison benchmarks.
+class PipePump : public MessagePump {
+ public:
+  PipePump()
+    : pipe_(ecore_pipe_add(&PipeCallback, this))
+    , delegate_(NULL)
+    , should_quit_(false)
+    , work_scheduled_(false)
+    , timers_added_(0)
+    , timers_fired_(0) {
+  }
+
+  virtual ~PipePump() {
+    for (std::set<Timer*>::iterator it = timers_.begin();
+         it != timers_.end(); ++it) {
+      ecore_timer_del((*it)->timer);
+      delete *it;
+    }
+    ecore_pipe_del(pipe_);
+  }
+
+  virtual void Run(Delegate* delegate) override {
+    delegate_ = delegate;
+    should_quit_ = false;
+    ScheduleWork();
+    while (!should_quit_)
+      ecore_main_loop_begin();
+    delegate_ = NULL;
+  }
+
+  virtual void Quit() override {
+    should_quit_ = true;
+    ecore_main_loop_quit();
+  }
+
+  virtual void ScheduleWork() override {
+    {
+      AutoLock locker(lock_);
+      if (work_scheduled_)
+        return;
+      work_scheduled_ = true;
+    }
+    ecore_pipe_write(pipe_, "W", 1);
+  }
+
+  virtual void ScheduleDelayedWork(const TimeTicks& delayed_work_time) override {
+    TimeDelta delay = delayed_work_time - TimeTicks::Now();
+    Timer* timer = new Timer;
+    timer->pump = this;
+    timer->timer = ecore_timer_add(std::max(delay.InSecondsF(), 0.0),
+                                   &TimerCallback, timer);
+    timers_.insert(timer);
+    ++timers_added_;
+  }
+
+  int timers_added() const { return timers_added_; }
+  int timers_fired() const { return timers_fired_; }
+
+ private:
+  struct Timer {
+    PipePump* pump;
+    Ecore_Timer* timer;
+  };
+
+  static void PipeCallback(void* data, void*, unsigned int) {
+    PipePump* pump = static_cast<PipePump*>(data);
+    {
+      AutoLock locker(pump->lock_);
+      pump->work_scheduled_ = false;
+    }
+    if (!pump->delegate_ || pump->should_quit_)
+      return;
+
+    bool more_work_is_plausible = pump->delegate_->DoWork();
+    TimeTicks delayed_work_time;
+    more_work_is_plausible |=
+        pump->delegate_->DoDelayedWork(&delayed_work_time);
+    if (!more_work_is_plausible)
+      more_work_is_plausible = pump->delegate_->DoIdleWork();
+    if (pump->should_quit_)
+      return;
+
+    if (more_work_is_plausible)
+      pump->ScheduleWork();
+    else if (!delayed_work_time.is_null())
+      pump->ScheduleDelayedWork(delayed_work_time);
+  }
+
+  static Eina_Bool TimerCallback(void* data) {
+    Timer* timer = static_cast<Timer*>(data);
+    PipePump* pump = timer->pump;
+    pump->timers_.erase(timer);
+    delete timer;
+    ++pump->timers_fired_;
+
+    if (pump->delegate_ && !pump->should_quit_) {
+      TimeTicks next_delayed_work_time;
+      pump->delegate_->DoDelayedWork(&next_delayed_work_time);
+      if (!next_delayed_work_time.is_null())
+        pump->ScheduleDelayedWork(next_delayed_work_time);
+    }
+    return ECORE_CALLBACK_CANCEL;
+  }
+
+  Ecore_Pipe* pipe_;
+  Delegate* delegate_;
+  bool should_quit_;
+  Lock lock_;
+  bool work_scheduled_;
+  std::set<Timer*> timers_;
+  int timers_added_;
+  int timers_fired_;
+};
+
+void PrintResult(const char* measurement, const char* trace,
+                 double value, const char* units) {
+  printf("*RESULT efl_message_pump_%s: %s= %f %s\n",
+         measurement, trace, value, units);
+  fflush(stdout);
+}
+
+void RecordRun(std::vector<int>* order, int id) {
+  order->push_back(id);
+}
+
+void RecordRunTime(TimeTicks deadline, std::vector<TimeDelta>* lateness) {
+  lateness->push_back(TimeTicks::Now() - deadline);
+}
+
+// Posts the next delayed task from within a delayed task, which re-arms the
+// timer from its own callback.
+void PostChainedDelayedTask(TestDelegate* delegate, TimeDelta delay,
+                            std::vector<TimeDelta>* lateness) {
+  delegate->PostDelayedTask(
+      Bind(&RecordRunTime, TimeTicks::Now() + delay, lateness), delay);
+}
+
+void QuitPump(MessagePump* pump) {
+  pump->Quit();
+}
+
+void QuitPumpAfter(MessagePump* pump, int* remaining) {
+  if (--*remaining == 0)
+    pump->Quit();
+}
+
+void RunNested(MessagePumpForUIEfl* pump, TestDelegate* delegate,
+               std::vector<int>* order) {
+  order->push_back(1);
+  delegate->PostTask(Bind(&RecordRun, order, 2));
+  delegate->PostTask(Bind(&QuitPump, pump));
+  pump->Run(delegate);
+  order->push_back(3);
+  // Quits the outer loop, which has to resume after the nested one.
+  delegate->PostTask(Bind(&QuitPump, pump));
+}
+
+void PostFromThread(TestDelegate* delegate, const Closure& task) {
+  delegate->PostTask(task);
+}
+
+void RecordLatency(TimeTicks posted, std::vector<TimeDelta>* latencies) {
+  latencies->push_back(TimeTicks::Now() - posted);
+}
+
+void PostLatencyTask(TestDelegate* delegate,
+                     std::vector<TimeDelta>* latencies) {
+  delegate->PostTask(Bind(&RecordLatency, TimeTicks::Now(), latencies));
+}
+
+void PrintTimings(const char* measurement, std::vector<TimeDelta>* values) {
+  ASSERT_FALSE(values->empty());
+  std::sort(values->begin(), values->end());
+  TimeDelta total;
+  for (size_t i = 0; i < values->size(); ++i)
+    total += (*values)[i];
+  PrintResult(measurement, "mean",
+              total.InMicrosecondsF() / values->size(), "us");
+  PrintResult(measurement, "p95",
+              (*values)[values->size() * 95 / 100].InMicrosecondsF(), "us");
+  PrintResult(measurement, "max", values->back().InMicrosecondsF(), "us");
+}
+
+// Keeps the pump busy with self reposting tasks to simulate load.
+void GenerateLoad(TestDelegate* delegate, int* remaining) {
+  if (--*remaining > 0)
+    delegate->PostTask(Bind(&GenerateLoad, delegate, remaining));
+}
+
+void RecordIdle(MessagePumpForUIEfl* pump, int* load_remaining,
+                TimeTicks* first_idle) {
+  if (*load_remaining > 0)
+    return;
+  if (first_idle->is_null())
+    *first_idle = TimeTicks::Now();
+  pump->Quit();
+}
+
+// Posts |count| tasks to |delegate| from |thread| and returns how long the
+// pump took to run them all.
+TimeDelta MeasurePostTaskThroughput(MessagePump* pump, TestDelegate* delegate,
+                                    Thread* thread, int count) {
+  int remaining = count;
+  TimeTicks start = TimeTicks::Now();
+  for (int i = 0; i < count; ++i) {
+    thread->message_loop()->PostTask(FROM_HERE,
+        Bind(&PostFromThread, delegate,
+             Bind(&QuitPumpAfter, pump, &remaining)));
+  }
+  pump->Run(delegate);
+  return TimeTicks::Now() - start;
+}
+
+// Keeps reposting a task while delayed tasks with staggered deadlines are
+// pending, which is what makes the pipe based pump add a timer per pass.
+void PostDelayedChurn(TestDelegate* delegate, int count) {
+  for (int i = 1; i <= count; ++i) {
+    delegate->PostDelayedTask(Bind(&DoNothing),
+                              TimeDelta::FromMilliseconds(i));
+  }
+}
+
+} // namespace
+
+class MessagePumpForUIEflTest : public testing::Test {
+ protected:
+  MessagePumpForUIEflTest()
+    : delegate_(&pump_) {
+  }
+
+  MessagePumpForUIEfl pump_;
+  TestDelegate delegate_;
+};
+
+TEST_F(MessagePumpForUIEflTest, RunsPostedTaskAndQuits) {
+  std::vector<int> order;
+  delegate_.PostTask(Bind(&RecordRun, &order, 1));
+  delegate_.PostTask(Bind(&QuitPump, &pump_));
+  pump_.Run(&delegate_);
+  ASSERT_EQ(1u, order.size());
+  EXPECT_EQ(1, order[0]);
+}
+
+TEST_F(MessagePumpForUIEflTest, RunsIdleWorkWhenQueueIsEmpty) {
+  delegate_.set_idle_task(Bind(&QuitPump, &pump_));
+  pump_.Run(&delegate_);
+  EXPECT_EQ(1, delegate_.idle_work_count());
+}
+
+TEST_F(MessagePumpForUIEflTest, CoalescesWakeups) {
+  const int kTasks = 1000;
+  std::vector<int> order;
+  for (int i = 0; i < kTasks; ++i)
+    delegate_.PostTask(Bind(&RecordRun, &order, i));
+
+  MessagePumpForUIEfl::Stats stats = pump_.GetStats();
+  EXPECT_EQ(kTasks, stats.wakeups_requested);
+  EXPECT_EQ(1, stats.wakeups_signaled);
+
+  delegate_.set_idle_task(Bind(&QuitPump, &pump_));
+  pump_.Run(&delegate_);
+  EXPECT_EQ(static_cast<size_t>(kTasks), order.size());
+}
+
+TEST_F(MessagePumpForUIEflTest, SkipsLaterDeadlinesAndRunsInOrder) {
+  std::vector<int> order;
+  int remaining = 3;
+  delegate_.PostDelayedTask(Bind(&RecordRun, &order, 2),
+                            TimeDelta::FromMilliseconds(40));
+  delegate_.PostDelayedTask(Bind(&RecordRun, &order, 3),
+                            TimeDelta::FromMilliseconds(80));
+  delegate_.PostDelayedTask(Bind(&RecordRun, &order, 1),
+                            TimeDelta::FromMilliseconds(20));
+
+  MessagePumpForUIEfl::Stats stats = pump_.GetStats();
+  EXPECT_EQ(2, stats.timers_armed);
+  EXPECT_EQ(1, stats.timers_skipped);
+
+  for (int i = 0; i < 3; ++i) {
+    delegate_.PostDelayedTask(Bind(&QuitPumpAfter, &pump_, &remaining),
+                              TimeDelta::FromMilliseconds(100));
+  }
+  pump_.Run(&delegate_);
+
+  ASSERT_EQ(3u, order.size());
+  EXPECT_EQ(1, order[0]);
+  EXPECT_EQ(2, order[1]);
+  EXPECT_EQ(3, order[2]);
+}
+
+TEST_F(MessagePumpForUIEflTest, ReusesDelayedWorkTimer) {
+  std::vector<int> order;
+  int remaining = 1;
+  // Each deadline is only armed once the previous one fired.
+  delegate_.PostDelayedTask(Bind(&RecordRun, &order, 1),
+                            TimeDelta::FromMilliseconds(10));
+  delegate_.PostDelayedTask(Bind(&RecordRun, &order, 2),
+                            TimeDelta::FromMilliseconds(30));
+  delegate_.PostDelayedTask(Bind(&QuitPumpAfter, &pump_, &remaining),
+                            TimeDelta::FromMilliseconds(50));
+  pump_.Run(&delegate_);
+
+  ASSERT_EQ(2u, order.size());
+  MessagePumpForUIEfl::Stats stats = pump_.GetStats();
+  EXPECT_EQ(3, stats.timers_armed);
+  EXPECT_EQ(1, stats.timers_created);
+}
+
+TEST_F(MessagePumpForUIEflTest, DelayedWorkDoesNotRunEarly) {
+  std::vector<TimeDelta> lateness;
+  const TimeDelta delay = TimeDelta::FromMilliseconds(30);
+  delegate_.PostDelayedTask(
+      Bind(&RecordRunTime, TimeTicks::Now() + delay, &lateness), delay);
+  delegate_.PostDelayedTask(Bind(&QuitPump, &pump_), delay * 2);
+  pump_.Run(&delegate_);
+
+  ASSERT_EQ(1u, lateness.size());
+  EXPECT_GE(lateness[0].InMicroseconds(), 0);
+}
+
+TEST_F(MessagePumpForUIEflTest, DelayedWorkRunsWithinBoundOfDelay) {
+  std::vector<TimeDelta> lateness;
+  const TimeDelta delay = TimeDelta::FromMilliseconds(50);
+  delegate_.PostDelayedTask(
+      Bind(&PostChainedDelayedTask, &delegate_, delay, &lateness), delay);
+  delegate_.PostDelayedTask(Bind(&QuitPump, &pump_), delay * 4);
+  pump_.Run(&delegate_);
+
+  // A timer rescheduled on top of its own re-arming would be a whole delay
+  // late.
+  ASSERT_EQ(1u, lateness.size());
+  EXPECT_GE(lateness[0].InMicroseconds(), 0);
+  EXPECT_LT(lateness[0], delay / 2);
+}
+
+TEST_F(MessagePumpForUIEflTest, SupportsNestedRun) {
+  std::vector<int> order;
+  delegate_.PostTask(Bind(&RunNested, &pump_, &delegate_, &order));
+  pump_.Run(&delegate_);
+
+  ASSERT_EQ(3u, order.size());
+  EXPECT_EQ(1, order[0]);
+  EXPECT_EQ(2, order[1]);
+  EXPECT_EQ(3, order[2]);
+}
+
+TEST_F(MessagePumpForUIEflTest, WakesUpFromOtherThread) {
+  Thread thread("EflPumpTestPoster");
+  ASSERT_TRUE(thread.Start());
+
+  std::vector<int> order;
+  thread.message_loop()->PostTask(FROM_HERE,
+      Bind(&PostFromThread, &delegate_, Bind(&RecordRun, &order, 1)));
+  thread.message_loop()->PostTask(FROM_HERE,
+      Bind(&PostFromThread, &delegate_, Bind(&QuitPump, &pump_)));
+  pump_.Run(&delegate_);
+  thread.Stop();
+
+  ASSERT_EQ(1u, order.size());
+  EXPECT_EQ(1, order[0]);
+}
+
+TEST_F(MessagePumpForUIEflTest, PerfCrossThreadTaskLatency) {
+  const int kTasks = 5000;
+  Thread thread("EflPumpTestPoster");
+  ASSERT_TRUE(thread.Start());
+
+  std::vector<TimeDelta> latencies;
+  latencies.reserve(kTasks);
+  for (int i = 0; i < kTasks; ++i) {
+    thread.message_loop()->PostTask(FROM_HERE,
+        Bind(&PostLatencyTask, &delegate_, &latencies));
+  }
+  thread.message_loop()->PostTask(FROM_HERE,
+      Bind(&PostFromThread, &delegate_, Bind(&QuitPump, &pump_)));
+  pump_.Run(&delegate_);
+  thread.Stop();
+
+  EXPECT_EQ(static_cast<size_t>(kTasks), latencies.size());
+  PrintTimings("task_latency", &latencies);
+
+  MessagePumpForUIEfl::Stats stats = pump_.GetStats();
+  PrintResult("wakeups", "requested", stats.wakeups_requested, "count");
+  PrintResult("wakeups", "signaled", stats.wakeups_signaled, "count");
+}
+
+TEST_F(MessagePumpForUIEflTest, PerfDelayedTaskAccuracyUnderLoad) {
+  const int kDelayedTasks = 50;
+  int load_remaining = 20000;
+  std::vector<TimeDelta> lateness;
+
+  delegate_.PostTask(Bind(&GenerateLoad, &delegate_, &load_remaining));
+  for (int i = 1; i <= kDelayedTasks; ++i) {
+    TimeDelta delay = TimeDelta::FromMilliseconds(2 * i);
+    delegate_.PostDelayedTask(
+        Bind(&RecordRunTime, TimeTicks::Now() + delay, &lateness), delay);
+  }
+  delegate_.PostDelayedTask(Bind(&QuitPump, &pump_),
+                            TimeDelta::FromMilliseconds(2 * kDelayedTasks + 20));
+  pump_.Run(&delegate_);
+
+  EXPECT_EQ(static_cast<size_t>(kDelayedTasks), lateness.size());
+  PrintTimings("delayed_task_lateness", &lateness);
+
+  MessagePumpForUIEfl::Stats stats = pump_.GetStats();
+  PrintResult("timers", "armed", stats.timers_armed, "count");
+  PrintResult("timers", "skipped", stats.timers_skipped, "count");
+}
+
+TEST_F(MessagePumpForUIEflTest, PerfIdleWorkAfterLoad) {
+  int load_remaining = 20000;
+  TimeTicks load_start = TimeTicks::Now();
+  TimeTicks first_idle;
+
+  delegate_.PostTask(Bind(&GenerateLoad, &delegate_, &load_remaining));
+  delegate_.set_idle_task(
+      Bind(&RecordIdle, &pump_, &load_remaining, &first_idle));
+  pump_.Run(&delegate_);
+
+  ASSERT_FALSE(first_idle.is_null());
+  // Idle work must not be run while immediate work is still queued.
+  EXPECT_EQ(1, delegate_.idle_work_count());
+  PrintResult("idle_work", "time_to_idle",
+              (first_idle - load_start).InMillisecondsF(), "ms");
+}
+
+TEST_F(MessagePumpForUIEflTest, PerfPostTaskThroughputAgainstPipePump) {
+  const int kTasks = 20000;
+  Thread thread("EflPumpTestPoster");
+  ASSERT_TRUE(thread.Start());
+
+  TimeDelta eventfd_time =
+      MeasurePostTaskThroughput(&pump_, &delegate_, &thread, kTasks);
+
+  PipePump pipe_pump;
+  TestDelegate pipe_delegate(&pipe_pump);
+  TimeDelta pipe_time =
+      MeasurePostTaskThroughput(&pipe_pump, &pipe_delegate, &thread, kTasks);
+  thread.Stop();
+
+  PrintResult("post_task_throughput", "eventfd",
+              kTasks / eventfd_time.InMillisecondsF(), "tasks/ms");
+  PrintResult("post_task_throughput", "pipe",
+              kTasks / pipe_time.InMillisecondsF(), "tasks/ms");
+
+  MessagePumpForUIEfl::Stats stats = pump_.GetStats();
+  PrintResult("post_task_wakeups", "eventfd", stats.wakeups_signaled, "count");
+}
+
+TEST_F(MessagePumpForUIEflTest, PerfTimerChurnAgainstPipePump) {
+  const int kDelayedTasks = 50;
+  const TimeDelta kQuitDelay = TimeDelta::FromMilliseconds(kDelayedTasks + 20);
+
+  PostDelayedChurn(&delegate_, kDelayedTasks);
+  int load_remaining = 5000;
+  delegate_.PostTask(Bind(&GenerateLoad, &delegate_, &load_remaining));
+  delegate_.PostDelayedTask(Bind(&QuitPump, &pump_), kQuitDelay);
+  pump_.Run(&delegate_);
+
+  PipePump pipe_pump;
+  TestDelegate pipe_delegate(&pipe_pump);
+  PostDelayedChurn(&pipe_delegate, kDelayedTasks);
+  load_remaining = 5000;
+  pipe_delegate.PostTask(Bind(&GenerateLoad, &pipe_delegate, &load_remaining));
+  pipe_delegate.PostDelayedTask(Bind(&QuitPump, &pipe_pump), kQuitDelay);
+  pipe_pump.Run(&pipe_delegate);
+
+  MessagePumpForUIEfl::Stats stats = pump_.GetStats();
+  PrintResult("timer_churn", "eventfd_armed", stats.timers_armed, "count");
+  PrintResult("timer_churn", "pipe_added", pipe_pump.timers_added(), "count");
+  PrintResult("timer_churn", "pipe_fired", pipe_pump.timers_fired(), "count");
+  EXPECT_LE(stats.timers_armed, pipe_pump.timers_added());
+}
+
+} // namespace base
+
+int main(int argc, char** argv) {
+  base::AtExitManager at_exit;
+  ecore_init();
+
+  testing::InitGoogleTest(&argc, argv);
+  int retval = RUN_ALL_TESTS();
+
+  ecore_shutdown();
+  return retval;
+}
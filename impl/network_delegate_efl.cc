@@ -6,10 +6,12 @@
 #include "network_delegate_efl.h"
 
 #include "content/public/browser/browser_thread.h"
+#include "content/public/browser/resource_request_info.h"
 #include "net/base/net_errors.h"
 #include "net/http/http_response_headers.h"
 
 #include "API/ewk_policy_decision_private.h"
+#include "browser/response_policy_filter_efl.h"
 
 namespace net {
 
@@ -63,6 +65,20 @@ int NetworkDelegateEfl::OnHeadersReceived(URLRequest* request,
   if(!ShouldInvokeResponseCallback(original_response_headers))
     return OK;
 
+  // Let the response through right away if its view does not ask for it.
+  const content::ResourceRequestInfo* info =
+      content::ResourceRequestInfo::ForRequest(request);
+  if (info) {
+    std::string mime_type;
+    original_response_headers->GetMimeType(&mime_type);
+    ResponsePolicyFilterEfl* filter = ResponsePolicyFilterEfl::GetInstance();
+    if (!filter->ShouldAsk(info->GetChildID(), info->GetRouteID(),
+                           request->url(), mime_type)) {
+      filter->RecordSynchronousResume();
+      return OK;
+    }
+  }
+
   scoped_refptr<PolicyResponseDelegateEfl> policy_delegate =
       new PolicyResponseDelegateEfl(request, callback, original_response_headers);
   policy_response_delegate_map_.insert(
@@ -0,0 +1,82 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "proxy_config_service_efl.h"
+
+#include "net/proxy/proxy_resolver_v8.h"
+
+namespace net {
+
+ProxyConfigServiceEfl::ProxyConfigServiceEfl(
+    ProxyConfigService* system_service)
+    : system_service_(system_service),
+      observing_system_service_(false),
+      has_config_(false) {
+}
+
+ProxyConfigServiceEfl::~ProxyConfigServiceEfl() {
+  if (observing_system_service_)
+    system_service_->RemoveObserver(this);
+}
+
+void ProxyConfigServiceEfl::SetProxyConfig(const ProxyConfig& config) {
+  has_config_ = true;
+  config_ = config;
+  PrepareConfig(config_);
+  FOR_EACH_OBSERVER(ProxyConfigService::Observer, observers_,
+                    OnProxyConfigChanged(config_, CONFIG_VALID));
+}
+
+void ProxyConfigServiceEfl::AddObserver(
+    ProxyConfigService::Observer* observer) {
+  // The system service is observed from the thread the proxy service uses.
+  if (!observing_system_service_) {
+    system_service_->AddObserver(this);
+    observing_system_service_ = true;
+  }
+  observers_.AddObserver(observer);
+}
+
+void ProxyConfigServiceEfl::RemoveObserver(
+    ProxyConfigService::Observer* observer) {
+  observers_.RemoveObserver(observer);
+}
+
+ProxyConfigService::ConfigAvailability
+    ProxyConfigServiceEfl::GetLatestProxyConfig(ProxyConfig* config) {
+  if (!has_config_) {
+    ConfigAvailability availability =
+        system_service_->GetLatestProxyConfig(config);
+    if (availability == CONFIG_VALID)
+      PrepareConfig(*config);
+    return availability;
+  }
+  *config = config_;
+  return CONFIG_VALID;
+}
+
+void ProxyConfigServiceEfl::OnLazyPoll() {
+  if (!has_config_)
+    system_service_->OnLazyPoll();
+}
+
+void ProxyConfigServiceEfl::OnProxyConfigChanged(
+    const ProxyConfig& config, ConfigAvailability availability) {
+  // The configuration of the embedder wins over system changes.
+  if (has_config_)
+    return;
+  if (availability == CONFIG_VALID)
+    PrepareConfig(config);
+  FOR_EACH_OBSERVER(ProxyConfigService::Observer, observers_,
+                    OnProxyConfigChanged(config, availability));
+}
+
+// static
+void ProxyConfigServiceEfl::PrepareConfig(const ProxyConfig& config) {
+  // The proxy service reads the script only after it got the configuration.
+  if (config.HasAutomaticSettings())
+    ProxyResolverV8::EnsureIsolateCreated();
+}
+
+}  // namespace net
@@ -0,0 +1,57 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PROXY_CONFIG_SERVICE_EFL_H_
+#define PROXY_CONFIG_SERVICE_EFL_H_
+
+#include "base/basictypes.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/observer_list.h"
+#include "net/proxy/proxy_config.h"
+#include "net/proxy/proxy_config_service.h"
+
+namespace net {
+
+// Reports the system proxy configuration until the embedder sets one. A
+// configuration set later replaces it without recreating the proxy
+// service: requests started afterwards use it, connections already
+// established keep their proxy. Lives on the IO thread once created.
+//
+// PAC scripts run in V8, its isolate is only created once a configuration
+// using a script is reported, most devices never need one.
+class ProxyConfigServiceEfl : public ProxyConfigService,
+                              public ProxyConfigService::Observer {
+ public:
+  // Takes ownership of |system_service|.
+  explicit ProxyConfigServiceEfl(ProxyConfigService* system_service);
+  virtual ~ProxyConfigServiceEfl();
+
+  void SetProxyConfig(const ProxyConfig& config);
+
+  // ProxyConfigService implementation.
+  virtual void AddObserver(ProxyConfigService::Observer* observer) override;
+  virtual void RemoveObserver(ProxyConfigService::Observer* observer) override;
+  virtual ConfigAvailability GetLatestProxyConfig(ProxyConfig* config) override;
+  virtual void OnLazyPoll() override;
+
+  // ProxyConfigService::Observer implementation, for |system_service_|.
+  virtual void OnProxyConfigChanged(const ProxyConfig& config,
+                                    ConfigAvailability availability) override;
+
+ private:
+  // Creates the V8 isolate if |config| needs a PAC script.
+  static void PrepareConfig(const ProxyConfig& config);
+
+  scoped_ptr<ProxyConfigService> system_service_;
+  bool observing_system_service_;
+  bool has_config_;
+  ProxyConfig config_;
+  ObserverList<ProxyConfigService::Observer, true> observers_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProxyConfigServiceEfl);
+};
+
+}  // namespace net
+
+#endif  // PROXY_CONFIG_SERVICE_EFL_H_
@@ -14,6 +14,7 @@
 #include "content/public/renderer/render_thread.h"
 #include "content/public/renderer/render_view.h"
 #include "content/child/request_extra_data.h"
+#include "renderer/navigation_policy_client_efl.h"
 #include "renderer/render_view_observer_efl.h"
 #include "content/public/renderer/content_renderer_client.h"
 #include "third_party/WebKit/public/platform/WebURLError.h"
@@ -34,7 +35,6 @@
 #endif
 
 #include "renderer/content_renderer_client_efl.h"
-#include "navigation_policy_params.h"
 #include "wrt/wrtwidget.h"
 
 #ifdef TIZEN_AUTOFILL_SUPPORT
@@ -62,6 +62,7 @@ void ContentRendererClientEfl::RenderThreadStarted()
 void ContentRendererClientEfl::RenderViewCreated(content::RenderView* render_view) {
   // Deletes itself when render_view is destroyed.
   new RenderViewObserverEfl(render_view);
+  new NavigationPolicyClientEfl(render_view);
   new editing::EditorClientAgent(render_view);
 
 #ifdef TIZEN_AUTOFILL_SUPPORT
@@ -84,32 +85,15 @@ bool ContentRendererClientEfl::HandleNavigation(content::RenderFrame* render_fra
                                                 blink::WebNavigationType type,
                                                 blink::WebNavigationPolicy default_policy,
                                                 bool is_redirect) {
-  const content::RenderView* render_view =
+  content::RenderView* render_view =
       content::RenderView::FromWebView(frame->view());
-  bool result = false;
-  GURL referrer_url(GURL(request.httpHeaderField(blink::WebString::fromUTF8("Referer"))));
-  blink::WebReferrerPolicy referrer_policy =  
-      request.isNull() ? frame->document().referrerPolicy() : request.referrerPolicy();
-  int render_view_id = render_view->GetRoutingID();
-
-  NavigationPolicyParams params;
-  params.render_view_id = render_view_id;
-  params.url = request.url();
-  params.referrer = content::Referrer(referrer_url, referrer_policy);
-  params.auth = request.httpHeaderField(blink::WebString::fromUTF8("Authorization"));
-  params.policy = default_policy;
-  params.is_main_frame = (frame->view()->mainFrame() == frame);
-  params.type = type;
-  params.is_redirect = is_redirect;
-
-  blink::WebDataSource* ds = frame->provisionalDataSource();
-  params.should_replace_current_entry = (ds ? ds->replacesCurrentHistoryItem() : false);
-
-  // Sync message, renderer is blocked here.
-  content::RenderThread::Get()->Send(new EwkHostMsg_DecideNavigationPolicy(
-      params, &result));
-
-  return result;
+  NavigationPolicyClientEfl* policy_client =
+      NavigationPolicyClientEfl::Get(render_view);
+  if (!policy_client)
+    return false;
+
+  return policy_client->HandleNavigation(document_state, frame, request, type,
+                                         default_policy, is_redirect);
 }
 #endif
 
@@ -0,0 +1,216 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "renderer/navigation_policy_client_efl.h"
+
+#include "base/auto_reset.h"
+#include "base/memory/scoped_ptr.h"
+#include "common/render_messages_efl.h"
+#include "content/public/renderer/document_state.h"
+#include "content/public/renderer/navigation_state.h"
+#include "content/public/renderer/render_frame.h"
+#include "content/public/renderer/render_thread.h"
+#include "content/public/renderer/render_view.h"
+#include "navigation_policy_params.h"
+#include "third_party/WebKit/public/platform/WebString.h"
+#include "third_party/WebKit/public/web/WebDataSource.h"
+#include "third_party/WebKit/public/web/WebDocument.h"
+#include "third_party/WebKit/public/web/WebFrame.h"
+#include "third_party/WebKit/public/web/WebLocalFrame.h"
+#include "third_party/WebKit/public/web/WebScopedUserGesture.h"
+#include "third_party/WebKit/public/web/WebView.h"
+#include "ui/base/page_transition_types.h"
+
+namespace {
+
+// Fragment navigations stay within the loaded document, the browser has
+// nothing to decide for them.
+bool IsSameDocumentNavigation(blink::WebFrame* frame,
+                              const blink::WebURLRequest& request,
+                              blink::WebNavigationType type) {
+  if (type != blink::WebNavigationTypeLinkClicked &&
+      type != blink::WebNavigationTypeOther)
+    return false;
+
+  GURL url(request.url());
+  if (!url.has_ref() || request.httpMethod().utf8() != "GET")
+    return false;
+
+  GURL document_url(frame->document().url());
+  GURL::Replacements strip_ref;
+  strip_ref.ClearRef();
+  return url.ReplaceComponents(strip_ref) ==
+      document_url.ReplaceComponents(strip_ref);
+}
+
+// Only navigations which loading the same request again reproduces exactly
+// can be deferred. Navigations started by the browser, reloads, history
+// navigations and navigations replacing the current entry keep asking
+// synchronously.
+bool CanDeferNavigation(content::DocumentState* document_state,
+                        const NavigationPolicyParams& params) {
+  if (!document_state ||
+      !document_state->navigation_state()->is_content_initiated())
+    return false;
+
+  if (params.policy != blink::WebNavigationPolicyCurrentTab ||
+      params.should_replace_current_entry || params.is_redirect)
+    return false;
+
+  return params.type == blink::WebNavigationTypeLinkClicked ||
+         params.type == blink::WebNavigationTypeFormSubmitted ||
+         params.type == blink::WebNavigationTypeOther;
+}
+
+}  // namespace
+
+NavigationPolicyClientEfl::NavigationPolicyClientEfl(
+    content::RenderView* render_view)
+    : content::RenderViewObserver(render_view),
+      content::RenderViewObserverTracker<NavigationPolicyClientEfl>(
+          render_view),
+      policy_enabled_(true),
+      reissuing_navigation_(false) {
+}
+
+NavigationPolicyClientEfl::~NavigationPolicyClientEfl() {
+}
+
+bool NavigationPolicyClientEfl::OnMessageReceived(const IPC::Message& message) {
+  bool handled = true;
+  IPC_BEGIN_MESSAGE_MAP(NavigationPolicyClientEfl, message)
+    IPC_MESSAGE_HANDLER(EwkViewMsg_NavigationPolicyDecided,
+                        OnNavigationPolicyDecided)
+    IPC_MESSAGE_HANDLER(EwkViewMsg_SetNavigationPolicyEnabled,
+                        OnSetNavigationPolicyEnabled)
+    IPC_MESSAGE_UNHANDLED(handled = false)
+  IPC_END_MESSAGE_MAP()
+  return handled;
+}
+
+bool NavigationPolicyClientEfl::HandleNavigation(
+    content::DocumentState* document_state,
+    blink::WebFrame* frame,
+    const blink::WebURLRequest& request,
+    blink::WebNavigationType type,
+    blink::WebNavigationPolicy default_policy,
+    bool is_redirect) {
+  if (reissuing_navigation_ || !policy_enabled_)
+    return false;
+
+  if (IsSameDocumentNavigation(frame, request, type))
+    return false;
+
+  NavigationPolicyParams params;
+  BuildParams(frame, request, type, default_policy, is_redirect, &params);
+
+  content::RenderFrame* render_frame =
+      content::RenderFrame::FromWebFrame(frame);
+  if (!render_frame || !CanDeferNavigation(document_state, params)) {
+    bool result = false;
+    // Sync message, renderer is blocked here.
+    content::RenderThread::Get()->Send(
+        new EwkHostMsg_DecideNavigationPolicy(params, &result));
+    return result;
+  }
+
+  int frame_routing_id = render_frame->GetRoutingID();
+  CancelPendingNavigation(frame_routing_id);
+
+  PendingNavigation* pending = new PendingNavigation;
+  pending->frame_routing_id = frame_routing_id;
+  pending->request = request;
+  pending->type = type;
+  int request_id = pending_navigations_.Add(pending);
+
+  content::RenderThread::Get()->Send(
+      new EwkHostMsg_DecideNavigationPolicyAsync(request_id, params));
+
+  // Blink drops the navigation, it is started again if the browser does not
+  // handle it.
+  return true;
+}
+
+void NavigationPolicyClientEfl::OnNavigationPolicyDecided(int request_id,
+                                                          bool handled) {
+  PendingNavigation* pending = pending_navigations_.Lookup(request_id);
+  if (!pending)
+    return;
+
+  int frame_routing_id = pending->frame_routing_id;
+  blink::WebURLRequest request = pending->request;
+  blink::WebNavigationType type = pending->type;
+  pending_navigations_.Remove(request_id);
+
+  if (handled)
+    return;
+
+  content::RenderFrame* render_frame =
+      content::RenderFrame::FromRoutingID(frame_routing_id);
+  if (!render_frame)
+    return;
+
+  base::AutoReset<bool> reissuing(&reissuing_navigation_, true);
+  // Popups, downloads and external protocols the navigation starts are
+  // allowed as if the user had just clicked.
+  scoped_ptr<blink::WebScopedUserGesture> user_gesture;
+  if (request.hasUserGesture())
+    user_gesture.reset(new blink::WebScopedUserGesture);
+
+  // The request keeps the method and the body of a form submission, blink
+  // then treats it as one again.
+  blink::WebFrame* frame = render_frame->GetWebFrame();
+  frame->loadRequest(request);
+
+  // The browser is told the navigation was a link click or a form
+  // submission, loadRequest() alone reports neither.
+  blink::WebDataSource* ds = frame->provisionalDataSource();
+  if (!ds)
+    return;
+
+  content::NavigationState* navigation_state =
+      content::DocumentState::FromDataSource(ds)->navigation_state();
+  if (type == blink::WebNavigationTypeFormSubmitted)
+    navigation_state->set_transition_type(ui::PAGE_TRANSITION_FORM_SUBMIT);
+  else if (type == blink::WebNavigationTypeLinkClicked)
+    navigation_state->set_transition_type(ui::PAGE_TRANSITION_LINK);
+}
+
+void NavigationPolicyClientEfl::OnSetNavigationPolicyEnabled(bool enabled) {
+  policy_enabled_ = enabled;
+}
+
+void NavigationPolicyClientEfl::BuildParams(
+    blink::WebFrame* frame,
+    const blink::WebURLRequest& request,
+    blink::WebNavigationType type,
+    blink::WebNavigationPolicy default_policy,
+    bool is_redirect,
+    NavigationPolicyParams* params) const {
+  GURL referrer_url(GURL(request.httpHeaderField(blink::WebString::fromUTF8("Referer"))));
+  blink::WebReferrerPolicy referrer_policy =
+      request.isNull() ? frame->document().referrerPolicy() : request.referrerPolicy();
+
+  params->render_view_id = routing_id();
+  params->url = request.url();
+  params->referrer = content::Referrer(referrer_url, referrer_policy);
+  params->auth = request.httpHeaderField(blink::WebString::fromUTF8("Authorization"));
+  params->policy = default_policy;
+  params->is_main_frame = (frame->view()->mainFrame() == frame);
+  params->type = type;
+  params->is_redirect = is_redirect;
+
+  blink::WebDataSource* ds = frame->provisionalDataSource();
+  params->should_replace_current_entry = (ds ? ds->replacesCurrentHistoryItem() : false);
+}
+
+void NavigationPolicyClientEfl::CancelPendingNavigation(int frame_routing_id) {
+  for (IDMap<PendingNavigation, IDMapOwnPointer>::iterator it(&pending_navigations_);
+       !it.IsAtEnd(); it.Advance()) {
+    if (it.GetCurrentValue()->frame_routing_id == frame_routing_id) {
+      pending_navigations_.Remove(it.GetCurrentKey());
+      return;
+    }
+  }
+}
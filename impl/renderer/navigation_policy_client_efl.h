@@ -0,0 +1,78 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NAVIGATION_POLICY_CLIENT_EFL_H_
+#define NAVIGATION_POLICY_CLIENT_EFL_H_
+
+#include "base/id_map.h"
+#include "content/public/renderer/render_view_observer.h"
+#include "content/public/renderer/render_view_observer_tracker.h"
+#include "third_party/WebKit/public/platform/WebURLRequest.h"
+#include "third_party/WebKit/public/web/WebNavigationPolicy.h"
+#include "third_party/WebKit/public/web/WebNavigationType.h"
+
+namespace blink {
+class WebFrame;
+}
+
+namespace content {
+class DocumentState;
+}
+
+struct NavigationPolicyParams;
+
+// Asks the browser for the navigation policy of every navigation started in
+// a view. Navigations that can be re-issued unchanged are held back while the
+// browser decides, instead of blocking the renderer on a sync message, and
+// are loaded again once the browser lets them through, with the user gesture
+// and the navigation type of the original one.
+class NavigationPolicyClientEfl
+    : public content::RenderViewObserver,
+      public content::RenderViewObserverTracker<NavigationPolicyClientEfl> {
+ public:
+  explicit NavigationPolicyClientEfl(content::RenderView* render_view);
+  virtual ~NavigationPolicyClientEfl();
+
+  // Returns true if the navigation was handled (ignored or deferred) and
+  // must not be started by blink.
+  bool HandleNavigation(content::DocumentState* document_state,
+                        blink::WebFrame* frame,
+                        const blink::WebURLRequest& request,
+                        blink::WebNavigationType type,
+                        blink::WebNavigationPolicy default_policy,
+                        bool is_redirect);
+
+  // content::RenderViewObserver implementation.
+  virtual bool OnMessageReceived(const IPC::Message& message) override;
+
+ private:
+  struct PendingNavigation {
+    int frame_routing_id;
+    blink::WebURLRequest request;
+    blink::WebNavigationType type;
+  };
+
+  void OnNavigationPolicyDecided(int request_id, bool handled);
+  void OnSetNavigationPolicyEnabled(bool enabled);
+
+  void BuildParams(blink::WebFrame* frame,
+                   const blink::WebURLRequest& request,
+                   blink::WebNavigationType type,
+                   blink::WebNavigationPolicy default_policy,
+                   bool is_redirect,
+                   NavigationPolicyParams* params) const;
+  // Forgets a navigation of |frame_routing_id| still waiting for a decision,
+  // a newer navigation of the same frame supersedes it.
+  void CancelPendingNavigation(int frame_routing_id);
+
+  IDMap<PendingNavigation, IDMapOwnPointer> pending_navigations_;
+  // False when the embedder does not listen for navigation policy decisions.
+  bool policy_enabled_;
+  // Set while a navigation allowed by the browser is being started again.
+  bool reissuing_navigation_;
+
+  DISALLOW_COPY_AND_ASSIGN(NavigationPolicyClientEfl);
+};
+
+#endif  // NAVIGATION_POLICY_CLIENT_EFL_H_
@@ -4,6 +4,8 @@
 
 #include "renderer/render_process_observer_efl.h"
 
+#include <algorithm>
+
 #include "base/allocator/allocator_extension.h"
 #include "content/public/renderer/render_thread.h"
 #include "third_party/WebKit/public/web/WebCache.h"
@@ -27,6 +29,7 @@ bool RenderProcessObserverEfl::OnControlMessageReceived(const IPC::Message& mess
     IPC_MESSAGE_HANDLER(EflViewMsg_ClearCache, OnClearCache)
     IPC_MESSAGE_HANDLER(EflViewMsg_SetCache, OnSetCache)
     IPC_MESSAGE_HANDLER(EwkViewMsg_PurgeMemory, OnPurgeMemory)
+    IPC_MESSAGE_HANDLER(EwkViewMsg_GetMemoryUsage, OnGetMemoryUsage)
     IPC_MESSAGE_HANDLER(EwkViewMsg_SetWidgetInfo, OnWidgetInfo)
     IPC_MESSAGE_HANDLER(EwkViewMsg_SendWrtMessage, OnWrtMessage)
     IPC_MESSAGE_UNHANDLED(handled = false)
@@ -68,20 +71,68 @@ void RenderProcessObserverEfl::OnSetCache(const CacheParamsEfl& params)
     static_cast<size_t>(params.cache_total_capacity));
 }
 
-void RenderProcessObserverEfl::OnPurgeMemory()
+void RenderProcessObserverEfl::OnPurgeMemory(bool critical)
 {
   RenderThread::Get()->EnsureWebKitInitialized();
-  // Clear the object cache (as much as possible; some live objects cannot be
-  // freed).
-  OnClearCache();
-  // Clear the font/glyph cache.
-  blink::FontCache::fontCache()->invalidate();
-  // TODO(pk): currently web process not linking sqlite. when used this should enable
-  // Release all freeable memory from the SQLite process-global page cache (a
-  // low-level object which backs the Connection-specific page caches).
-  //while (sqlite3_release_memory(std::numeric_limits<int>::max()) > 0) {
-  //}
-  v8::Isolate::GetCurrent()->LowMemoryNotification();
+  int64 before = GetPurgeableMemoryUsage();
+  if (!critical) {
+    PruneDeadResources();
+  } else {
+    // Clear the object cache (as much as possible; some live objects cannot
+    // be freed).
+    OnClearCache();
+    // Clear the font/glyph cache.
+    blink::FontCache::fontCache()->invalidate();
+    // TODO(pk): currently web process not linking sqlite. when used this should enable
+    // Release all freeable memory from the SQLite process-global page cache (a
+    // low-level object which backs the Connection-specific page caches).
+    //while (sqlite3_release_memory(std::numeric_limits<int>::max()) > 0) {
+    //}
+    v8::Isolate::GetCurrent()->LowMemoryNotification();
+  }
   // Tell our allocator to release any free pages it's still holding.
   base::allocator::ReleaseFreeMemory();
+
+  int64 reclaimed = std::max<int64>(before - GetPurgeableMemoryUsage(), 0);
+  RenderThread::Get()->Send(new EwkHostMsg_MemoryPurged(reclaimed));
+}
+
+void RenderProcessObserverEfl::OnGetMemoryUsage()
+{
+  int64 web_cache = 0;
+  int64 heap_used = 0;
+  int64 heap_total = 0;
+  // Nothing to report before blink ran, and no reason to start it for this.
+  if (webkit_initialized_) {
+    WebCache::UsageStats cache_stats;
+    WebCache::getUsageStats(&cache_stats);
+    web_cache = cache_stats.liveSize + cache_stats.deadSize;
+    v8::HeapStatistics heap_stats;
+    v8::Isolate::GetCurrent()->GetHeapStatistics(&heap_stats);
+    heap_used = heap_stats.used_heap_size();
+    heap_total = heap_stats.total_heap_size();
+  }
+  RenderThread::Get()->Send(
+      new EwkHostMsg_MemoryUsage(web_cache, heap_used, heap_total));
+}
+
+void RenderProcessObserverEfl::PruneDeadResources()
+{
+  // Without room for them the cache drops its dead resources right away.
+  // The capacities are put back after.
+  WebCache::UsageStats stats;
+  WebCache::getUsageStats(&stats);
+  WebCache::setCapacities(0, 0, stats.capacity);
+  WebCache::setCapacities(stats.minDeadCapacity, stats.maxDeadCapacity,
+    stats.capacity);
+}
+
+int64 RenderProcessObserverEfl::GetPurgeableMemoryUsage() const
+{
+  WebCache::UsageStats cache_stats;
+  WebCache::getUsageStats(&cache_stats);
+  v8::HeapStatistics heap_stats;
+  v8::Isolate::GetCurrent()->GetHeapStatistics(&heap_stats);
+  return static_cast<int64>(cache_stats.liveSize + cache_stats.deadSize) +
+         static_cast<int64>(heap_stats.total_heap_size());
 }
@@ -25,7 +25,7 @@ public:
   virtual bool OnControlMessageReceived(const IPC::Message& message) override;
   virtual void WebKitInitialized() override;
   void OnClearCache();
-  void OnPurgeMemory();
+  void OnPurgeMemory(bool critical);
   
 private:
   void OnWidgetInfo(int widget_id,
@@ -34,6 +34,13 @@ private:
                     const std::string &encoded_bundle);
   void OnSetCache(const CacheParamsEfl& params);
   void OnWrtMessage(const tizen_webview::WrtIpcMessageData& data);
+  void OnGetMemoryUsage();
+  // Drops the resources no page uses from the object cache, the live ones
+  // stay.
+  void PruneDeadResources();
+  // Memory held by the object cache and the JS heap, the caches
+  // OnPurgeMemory() can shrink.
+  int64 GetPurgeableMemoryUsage() const;
   ContentRendererClientEfl* content_client_;
   bool webkit_initialized_;
   CacheParamsEfl pending_cache_params_;
@@ -18,6 +18,7 @@
 #include "third_party/WebKit/public/platform/WebPoint.h"
 #include "third_party/WebKit/public/platform/WebSize.h"
 #include "third_party/WebKit/public/platform/WebString.h"
+#include "third_party/WebKit/public/platform/WebVector.h"
 #include "third_party/WebKit/public/web/WebDocument.h"
 #include "third_party/WebKit/public/web/WebFormElement.h"
 #include "third_party/WebKit/public/web/WebFrame.h"
@@ -26,6 +27,7 @@
 #include "third_party/WebKit/public/web/WebPageSerializer.h"
 #include "third_party/WebKit/public/web/WebView.h"
 #include "third_party/WebKit/public/web/WebNodeList.h"
+#include "ui/gfx/rect_conversions.h"
 
 // XXX: config.h needs to be included before internal blink headers.
 //      It'd be great if we did not include not internal blibk headers.
@@ -36,6 +38,26 @@ using namespace tizen_webview;
 
 namespace {
 
+// Elements whose hit test results are pushed to the browser.
+const char kHitTestRegionSelector[] =
+    "a[href], area[href], img, input, textarea, [contenteditable]";
+// Upper bound for a single update, hit testing every region has a cost.
+const size_t kMaxHitTestRegions = 256;
+// Layout notifications come in bursts, only collect after them.
+const int kHitTestRegionsUpdateDelayMs = 100;
+// About once per frame.
+const int kScrollOffsetUpdateIntervalMs = 16;
+
+bool IsSameHitTestRegion(const HitTestRegionEfl& a, const HitTestRegionEfl& b)
+{
+  return a.rect == b.rect &&
+         a.hit_test.context == b.hit_test.context &&
+         a.hit_test.linkURI == b.hit_test.linkURI &&
+         a.hit_test.imageURI == b.hit_test.imageURI &&
+         a.hit_test.mediaURI == b.hit_test.mediaURI &&
+         a.hit_test.isEditable == b.hit_test.isEditable;
+}
+
 bool GetGRBAValuesFromString(const std::string& input, int* r, int* g, int* b, int* a)
 {
   bool parsing_status = false;
@@ -120,7 +142,10 @@ void PopulateNodeAttributesMapFromHitTest(const blink::WebHitTestResult& web_hit
 RenderViewObserverEfl::RenderViewObserverEfl(content::RenderView* render_view)
   : content::RenderViewObserver(render_view),
     cached_min_page_scale_factor_(-1.0),
-    cached_max_page_scale_factor_(-1.0)
+    cached_max_page_scale_factor_(-1.0),
+    scroll_offset_changed_(false),
+    next_hit_test_region_id_(1),
+    hit_test_regions_reset_(true)
 {
 }
 
@@ -156,6 +181,17 @@ bool RenderViewObserverEfl::OnMessageReceived(const IPC::Message& message)
   return handled;
 }
 
+void RenderViewObserverEfl::DidCommitProvisionalLoad(blink::WebLocalFrame* frame,
+                                                     bool is_new_navigation)
+{
+  // The browser drops its hit test regions when the main frame commits.
+  if (frame == render_view()->GetWebView()->mainFrame()) {
+    sent_hit_test_regions_.clear();
+    hit_test_regions_reset_ = true;
+    ScheduleHitTestRegionsUpdate();
+  }
+}
+
 void RenderViewObserverEfl::DidCreateDocumentElement(blink::WebLocalFrame* frame)
 {
   std::string policy;
@@ -223,6 +259,17 @@ void RenderViewObserverEfl::DidChangeScrollOffset(blink::WebLocalFrame* frame)
   if (!frame || (render_view()->GetWebView()->mainFrame() != frame))
     return;
 
+  // Scrolling, flings in particular, reports every step. The browser gets
+  // the first one right away and then the latest one once per frame.
+  if (scroll_offset_timer_.IsRunning()) {
+    scroll_offset_changed_ = true;
+  } else {
+    SendScrollOffset();
+    scroll_offset_timer_.Start(FROM_HERE,
+        base::TimeDelta::FromMilliseconds(kScrollOffsetUpdateIntervalMs), this,
+        &RenderViewObserverEfl::OnScrollOffsetTimer);
+  }
+
   if (max_scroll_offset_ != frame->maximumScrollOffset()) { //Check for change in MaxScrollOffset
     max_scroll_offset_ = frame->maximumScrollOffset();
     Send(new EwkHostMsg_DidChangeMaxScrollOffset(render_view()->GetRoutingID(),
@@ -282,18 +329,26 @@ void RenderViewObserverEfl::OnDoHitTest(int view_x, int view_y, tizen_webview::H
   NodeAttributesMap attributes;
 
   if (DoHitTest(view_x, view_y, mode, &hit_test_result, &attributes)) {
-    Send(new EwkViewHostMsg_HitTestReply(routing_id(), hit_test_result, attributes));
+    // The browser only answers from its regions at this scroll offset.
+    const blink::WebSize scroll_offset =
+        render_view()->GetWebView()->mainFrame()->scrollOffset();
+    Send(new EwkViewHostMsg_HitTestReply(routing_id(), hit_test_result, attributes,
+        gfx::Vector2d(scroll_offset.width, scroll_offset.height)));
   }
 }
 
-void RenderViewObserverEfl::OnDoHitTestAsync(int view_x, int view_y, tizen_webview::Hit_Test_Mode mode, int64_t request_id)
+void RenderViewObserverEfl::OnDoHitTestAsync(const HitTestAsyncQueriesEfl& queries)
 {
-  _Ewk_Hit_Test hit_test_result;
-  NodeAttributesMap attributes;
-
-  if (DoHitTest(view_x, view_y, mode, &hit_test_result, &attributes)) {
-    Send(new EwkViewHostMsg_HitTestAsyncReply(routing_id(), hit_test_result, attributes, request_id));
+  HitTestAsyncResultsEfl results(queries.size());
+  for (size_t i = 0; i < queries.size(); ++i) {
+    results[i].query_id = queries[i].query_id;
+    // The browser waits for every query it sent, failed ones included.
+    results[i].valid = DoHitTest(queries[i].point.x(), queries[i].point.y(),
+                                 queries[i].mode, &results[i].hit_test,
+                                 &results[i].node_attributes);
   }
+
+  Send(new EwkViewHostMsg_HitTestAsyncReply(routing_id(), results));
 }
 
 bool RenderViewObserverEfl::DoHitTest(int view_x, int view_y, tizen_webview::Hit_Test_Mode mode, _Ewk_Hit_Test* hit_test_result, NodeAttributesMap* attributes)
@@ -358,6 +413,8 @@ void RenderViewObserverEfl::DidUpdateLayout()
   if (!view)
     return;
 
+  ScheduleHitTestRegionsUpdate();
+
   float min_scale = view->minimumPageScaleFactor();
   float max_scale = view->maximumPageScaleFactor();
 
@@ -403,6 +460,128 @@ void RenderViewObserverEfl::CheckContentsSize()
                                             size.height));
 }
 
+void RenderViewObserverEfl::SendScrollOffset()
+{
+  blink::WebFrame* frame = render_view()->GetWebView()->mainFrame();
+  if (!frame)
+    return;
+
+  const blink::WebSize scroll_offset = frame->scrollOffset();
+  Send(new EwkHostMsg_DidChangeScrollOffset(render_view()->GetRoutingID(),
+                                            scroll_offset.width,
+                                            scroll_offset.height));
+}
+
+void RenderViewObserverEfl::OnScrollOffsetTimer()
+{
+  if (scroll_offset_changed_) {
+    scroll_offset_changed_ = false;
+    SendScrollOffset();
+    return;
+  }
+
+  // A whole frame without scrolling, the browser has the final offset.
+  scroll_offset_timer_.Stop();
+  ScheduleHitTestRegionsUpdate();
+}
+
+void RenderViewObserverEfl::ScheduleHitTestRegionsUpdate()
+{
+  // Scrolling schedules an update once it stops.
+  if (hit_test_regions_timer_.IsRunning() || scroll_offset_timer_.IsRunning())
+    return;
+
+  hit_test_regions_timer_.Start(FROM_HERE,
+      base::TimeDelta::FromMilliseconds(kHitTestRegionsUpdateDelayMs), this,
+      &RenderViewObserverEfl::UpdateHitTestRegions);
+}
+
+void RenderViewObserverEfl::UpdateHitTestRegions()
+{
+  blink::WebView* view = render_view()->GetWebView();
+  if (!view || !view->mainFrame())
+    return;
+
+  blink::WebFrame* frame = view->mainFrame();
+  const float scale = view->pageScaleFactor();
+  if (scale <= 0)
+    return;
+
+  const blink::WebSize web_scroll_offset = frame->scrollOffset();
+  const gfx::Vector2d scroll_offset(web_scroll_offset.width,
+                                    web_scroll_offset.height);
+  const gfx::Rect viewport(gfx::Size(view->size()));
+
+  blink::WebVector<blink::WebElement> elements;
+  frame->document().querySelectorAll(
+      blink::WebString::fromUTF8(kHitTestRegionSelector), elements);
+
+  HitTestRegionsEfl regions;
+  for (size_t i = 0; i < elements.size() && regions.size() < kMaxHitTestRegions; ++i) {
+    gfx::Rect bounds = elements[i].boundsInViewportSpace();
+    bounds.Intersect(viewport);
+    if (bounds.IsEmpty())
+      continue;
+
+    const gfx::Point center = bounds.CenterPoint();
+    const blink::WebHitTestResult web_hit_test_result =
+        view->hitTestResultAt(blink::WebPoint(center.x(), center.y()));
+
+    HitTestRegionEfl region;
+    region.hit_test.mode = TW_HIT_TEST_MODE_DEFAULT;
+    PopulateEwkHitTestData(web_hit_test_result, &region.hit_test);
+
+    // Something else is on top of the element, leave it to real hit tests.
+    if (!(region.hit_test.context & (TW_HIT_TEST_RESULT_CONTEXT_LINK |
+                                     TW_HIT_TEST_RESULT_CONTEXT_IMAGE |
+                                     TW_HIT_TEST_RESULT_CONTEXT_EDITABLE)))
+      continue;
+
+    // Viewport space is scaled by the page scale factor, the browser looks
+    // regions up in document coordinates.
+    region.rect = gfx::ScaleToEnclosedRect(bounds, 1.f / scale);
+    region.rect.Offset(scroll_offset);
+    regions.push_back(region);
+  }
+
+  // Only the regions which changed are sent, the others keep their id.
+  HitTestRegionsEfl added;
+  HitTestRegionsEfl kept;
+  std::vector<int> removed_ids;
+  std::vector<bool> still_there(sent_hit_test_regions_.size(), false);
+  for (size_t i = 0; i < regions.size(); ++i) {
+    size_t j = 0;
+    while (j < sent_hit_test_regions_.size() &&
+           (still_there[j] || !IsSameHitTestRegion(sent_hit_test_regions_[j], regions[i])))
+      ++j;
+
+    if (j < sent_hit_test_regions_.size()) {
+      still_there[j] = true;
+      kept.push_back(sent_hit_test_regions_[j]);
+    } else {
+      regions[i].id = next_hit_test_region_id_++;
+      added.push_back(regions[i]);
+      kept.push_back(regions[i]);
+    }
+  }
+  for (size_t j = 0; j < sent_hit_test_regions_.size(); ++j) {
+    if (!still_there[j])
+      removed_ids.push_back(sent_hit_test_regions_[j].id);
+  }
+  sent_hit_test_regions_.swap(kept);
+
+  if (!hit_test_regions_reset_ && added.empty() && removed_ids.empty() &&
+      scroll_offset == hit_test_regions_scroll_offset_)
+    return;
+
+  Send(new EwkHostMsg_DidUpdateHitTestRegions(render_view()->GetRoutingID(),
+                                              added, removed_ids,
+                                              hit_test_regions_reset_,
+                                              scroll_offset));
+  hit_test_regions_reset_ = false;
+  hit_test_regions_scroll_offset_ = scroll_offset;
+}
+
 void RenderViewObserverEfl::OnSetDrawsTransparentBackground(bool draws_transparent_background)
 {
   blink::WebView* view = render_view()->GetWebView();
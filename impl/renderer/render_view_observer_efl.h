@@ -11,7 +11,9 @@
 #include "renderer/print_web_view_helper_efl.h"
 #include "content/public/renderer/render_view_observer.h"
 #include "API/ewk_hit_test_private.h"
+#include "common/hit_test_params_efl.h"
 #include "third_party/WebKit/public/platform/WebSize.h"
+#include "ui/gfx/vector2d.h"
 #include "tizen_webview/public/tw_content_security_policy.h"
 #include "tizen_webview/public/tw_hit_test.h"
 
@@ -36,6 +38,8 @@ class RenderViewObserverEfl: public content::RenderViewObserver {
 
   void DidChangeScrollOffset(blink::WebLocalFrame* frame) override;
   bool OnMessageReceived(const IPC::Message& message) override;
+  void DidCommitProvisionalLoad(blink::WebLocalFrame* frame,
+                                bool is_new_navigation) override;
   virtual void DidCreateDocumentElement(blink::WebLocalFrame* frame) override;
   virtual void OrientationChangeEvent() override;
 #if !defined(EWK_BRINGUP)
@@ -56,7 +60,7 @@ class RenderViewObserverEfl: public content::RenderViewObserver {
   void OnGetSelectionStyle();
   void OnSelectClosestWord(int x, int y);
   void OnDoHitTest(int x, int y, tizen_webview::Hit_Test_Mode mode);
-  void OnDoHitTestAsync(int view_x, int view_y, tizen_webview::Hit_Test_Mode mode, int64_t request_id);
+  void OnDoHitTestAsync(const HitTestAsyncQueriesEfl& queries);
   bool DoHitTest(int view_x, int view_y, tizen_webview::Hit_Test_Mode mode, _Ewk_Hit_Test* hit_test_result, NodeAttributesMap* attributes);
   void OnPrintToPdf(int width, int height, const base::FilePath& filename);
   void OnGetMHTMLData(int callback_id);
@@ -66,6 +70,10 @@ class RenderViewObserverEfl: public content::RenderViewObserver {
   void OnWebAppCapableGet(int callback_id);
   void OnSetBrowserFont();
   void CheckContentsSize();
+  void SendScrollOffset();
+  void OnScrollOffsetTimer();
+  void ScheduleHitTestRegionsUpdate();
+  void UpdateHitTestRegions();
   void OnSuspendScheduledTasks();
   void OnResumeScheduledTasks();
 
@@ -74,6 +82,15 @@ class RenderViewObserverEfl: public content::RenderViewObserver {
   float cached_max_page_scale_factor_;
   gfx::Size last_sent_contents_size_;
   base::OneShotTimer<RenderViewObserverEfl> check_contents_size_timer_;
+  base::RepeatingTimer<RenderViewObserverEfl> scroll_offset_timer_;
+  bool scroll_offset_changed_;
+  base::OneShotTimer<RenderViewObserverEfl> hit_test_regions_timer_;
+  // The browser's copy of the hit test regions.
+  HitTestRegionsEfl sent_hit_test_regions_;
+  gfx::Vector2d hit_test_regions_scroll_offset_;
+  int next_hit_test_region_id_;
+  // Set until the browser got the regions of the current document.
+  bool hit_test_regions_reset_;
 };
 
 #endif /* RENDER_VIEW_OBSERVER_EFL_H_ */
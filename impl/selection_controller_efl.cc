@@ -177,6 +177,10 @@ void SelectionControllerEfl::ShowHandleAndContextMenuIfRequired(bool anchor_firs
 
 void SelectionControllerEfl::ShowHandleAndContextMenuIfRequired(
     Evas_Object* o, int x, int y, int mode, tizen_webview::Hit_Test* hit_test, bool anchor_first) {
+  // The hit test was cancelled or failed, the selection may be gone too.
+  if (!hit_test)
+    return;
+
   DCHECK(!scrolling_);
 
   gfx::Rect left, right;
@@ -191,8 +195,7 @@ void SelectionControllerEfl::ShowHandleAndContextMenuIfRequired(
   // Is in edit field and no text is selected. show only single handle
   if (selection_data_->IsInEditField() && left == right) {
 
-    if (hit_test
-        && !(hit_test->GetResultContext() & tizen_webview::TW_HIT_TEST_RESULT_CONTEXT_EDITABLE))
+    if (!(hit_test->GetResultContext() & tizen_webview::TW_HIT_TEST_RESULT_CONTEXT_EDITABLE))
       return;
 
     gfx::Rect left = selection_data_->GetLeftRect();
@@ -215,8 +218,7 @@ void SelectionControllerEfl::ShowHandleAndContextMenuIfRequired(
     return;
   }
 
-  if (hit_test
-      && !(hit_test->GetResultContext() & tizen_webview::TW_HIT_TEST_RESULT_CONTEXT_SELECTION))
+  if (!(hit_test->GetResultContext() & tizen_webview::TW_HIT_TEST_RESULT_CONTEXT_SELECTION))
     return;
 
   // The base position of start_handle should be set to the middle of the left rectangle.
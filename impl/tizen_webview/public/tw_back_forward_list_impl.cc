@@ -2,22 +2,30 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+
 #include "content/public/browser/notification_types.h"
 #include "content/public/browser/notification_service.h"
 #include "content/public/browser/navigation_details.h"
+#include "content/public/browser/web_contents.h"
 #include "tizen_webview/public/tw_back_forward_list_impl.h"
 
 namespace tizen_webview {
 
 BackForwardList::BackForwardList(content::NavigationController &controller)
     : navigation_controller_(controller) {
+  // Only this list's own controller and web contents are of interest,
+  // listening to all sources made every list work for every view.
+  content::Source<content::NavigationController> controller_source(&controller);
   notification_registrar_.Add(this, content::NOTIFICATION_NAV_ENTRY_CHANGED,
-      content::NotificationService::AllBrowserContextsAndSources());
+      controller_source);
+  notification_registrar_.Add(this, content::NOTIFICATION_NAV_ENTRY_COMMITTED,
+      controller_source);
+  notification_registrar_.Add(this, content::NOTIFICATION_NAV_LIST_PRUNED,
+      controller_source);
   notification_registrar_.Add(this,
       content::NOTIFICATION_WEB_CONTENTS_TITLE_UPDATED,
-      content::NotificationService::AllBrowserContextsAndSources());
-  notification_registrar_.Add(this, content::NOTIFICATION_NAV_ENTRY_COMMITTED,
-      content::NotificationService::AllBrowserContextsAndSources());
+      content::Source<content::WebContents>(controller.GetWebContents()));
 }
 
 int BackForwardList::GetCurrentIndex() const {
@@ -49,39 +57,37 @@ back_forward_list::Item* BackForwardList::GetItemAtIndex(int index) const {
 
 void BackForwardList::NewPageCommited(int prev_entry_index,
                                       content::NavigationEntry* new_entry) {
-  int current = prev_entry_index + 1;
-  if (current != navigation_controller_.GetCurrentEntryIndex()) {
+  // Forward items dropped by the new page and the oldest items dropped
+  // once the controller is full were already removed by EntriesPruned().
+  int index = navigation_controller_.GetIndexOfEntry(new_entry);
+  if (index < 0 || static_cast<size_t>(index) >= slots_.size())
     return;
-  }
 
-  // When user went back several pages and now loaded
-  // some new page (so new entry is commited) then all forward items
-  // were deleted, so we have to do the same in our cache.
-  for (unsigned i = current; i < indexes_.size(); ++i) {
-    content::NavigationEntry* entry = indexes_[i];
-    indexes_[i] = NULL;
-    if (entry) {
-      cache_.erase(entry);
-    }
+  Slot& slot = slots_[index];
+  if (slot.item.get() && slot.unique_id == new_entry->GetUniqueID()) {
+    slot.item->Update(new_entry);
+  } else {
+    slot.unique_id = new_entry->GetUniqueID();
+    slot.item = new BackForwardListItem(new_entry);
   }
-
-  InsertEntryToIndexes(current, new_entry);
-  cache_[new_entry] = scoped_refptr<BackForwardListItem>(new BackForwardListItem(new_entry));
 }
 
 void BackForwardList::UpdateItemWithEntry(
     const content::NavigationEntry* entry) {
-  if (entry) {
-    CacheMap::iterator it = cache_.find(entry);
-    if (it != cache_.end()) {
-      it->second->Update(entry);
-    }
-  }
+  if (!entry)
+    return;
+
+  int index = navigation_controller_.GetIndexOfEntry(entry);
+  if (index < 0 || static_cast<size_t>(index) >= slots_.size())
+    return;
+
+  Slot& slot = slots_[index];
+  if (slot.item.get() && slot.unique_id == entry->GetUniqueID())
+    slot.item->Update(entry);
 }
 
 void BackForwardList::ClearCache() {
-  indexes_.clear();
-  cache_.clear();
+  slots_.clear();
 }
 
 void BackForwardList::Observe(int type,
@@ -93,6 +99,11 @@ void BackForwardList::Observe(int type,
       NewPageCommited(d->previous_entry_index, d->entry);
       break;
     }
+    case content::NOTIFICATION_NAV_LIST_PRUNED: {
+      content::Details<content::PrunedDetails> d = details;
+      EntriesPruned(d->from_front, d->count);
+      break;
+    }
     case content::NOTIFICATION_NAV_ENTRY_CHANGED: {
       content::Details<content::EntryChangedDetails> d = details;
       const content::NavigationEntry* entry = d->changed_entry;
@@ -119,33 +130,30 @@ BackForwardListItem* BackForwardList::FindOrCreateItem(int index) const {
     return NULL;
   }
 
-  BackForwardListItem* item = NULL;
-  CacheMap::iterator it = cache_.find(entry);
-  if (it != cache_.end()) {
-    // item already in cache
-    item = it->second.get();
-  } else {
+  if (static_cast<size_t>(index) >= slots_.size())
+    slots_.resize(index + 1);
+
+  Slot& slot = slots_[index];
+  if (!slot.item.get() || slot.unique_id != entry->GetUniqueID()) {
     // need to create new item
-    item = new BackForwardListItem(entry);
-    cache_[entry] = scoped_refptr<BackForwardListItem>(item);
+    slot.unique_id = entry->GetUniqueID();
+    slot.item = new BackForwardListItem(entry);
   }
 
-  InsertEntryToIndexes(index, entry);
-
-  return item;
+  return slot.item.get();
 }
 
-void BackForwardList::InsertEntryToIndexes(
-    unsigned index, content::NavigationEntry* entry) const {
-  if (index == indexes_.size()) {
-    indexes_.push_back(entry);
+void BackForwardList::EntriesPruned(bool from_front, int count) {
+  if (from_front) {
+    size_t pruned = std::min(static_cast<size_t>(count), slots_.size());
+    slots_.erase(slots_.begin(), slots_.begin() + pruned);
     return;
   }
 
-  if (index > indexes_.size()) {
-    indexes_.resize(index + 1, NULL);
-  }
-  indexes_[index] = entry;
+  // Slots are filled lazily and may not reach the pruned entries at all,
+  // only drop those past the end of the controller's list.
+  slots_.resize(std::min(slots_.size(),
+      static_cast<size_t>(navigation_controller_.GetEntryCount())));
 }
 
 } // namespace tizen_webview
@@ -14,7 +14,7 @@
 #include "content/public/browser/notification_observer.h"
 #include "content/public/browser/notification_registrar.h"
 
-#include <map>
+#include <deque>
 
 namespace tizen_webview {
 
@@ -56,9 +56,6 @@ class BackForwardList :
     public back_forward_list::List,
     public content::NotificationObserver {
  public:
-  typedef std::map<const content::NavigationEntry*,
-      scoped_refptr<BackForwardListItem> > CacheMap;
-
   BackForwardList(content::NavigationController &controller);
   ~BackForwardList() {}
 
@@ -71,21 +68,34 @@ class BackForwardList :
   void NewPageCommited(int prev_entry_index,
                        content::NavigationEntry* new_entry);
   void UpdateItemWithEntry(const content::NavigationEntry* entry);
+  // Drops the cached items, they are created again on next use.
   void ClearCache();
 
   void Observe(int type, const content::NotificationSource &source,
                const content::NotificationDetails &details);
 
  private:
+  // Item of the entry at the same index of the controller, created on
+  // first use. Entries are told apart by their unique id, their address
+  // may be reused once the controller freed them.
+  struct Slot {
+    Slot() : unique_id(0) {}
+    int unique_id;
+    scoped_refptr<BackForwardListItem> item;
+  };
+  typedef std::deque<Slot> SlotRing;
+
   BackForwardListItem* FindOrCreateItem(int index) const;
-  void InsertEntryToIndexes(unsigned index,
-                            content::NavigationEntry* entry) const;
+  // Drops the slots of entries the controller pruned from the front or the
+  // back, the remaining ones keep their items.
+  void EntriesPruned(bool from_front, int count);
 
  private:
   content::NavigationController &navigation_controller_;
   content::NotificationRegistrar notification_registrar_;
-  mutable CacheMap cache_;
-  mutable std::vector<content::NavigationEntry*> indexes_;
+  // Mirrors the controller's entries, the controller caps their number
+  // so the ring stays small.
+  mutable SlotRing slots_;
 };
 
 }
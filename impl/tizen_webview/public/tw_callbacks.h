@@ -11,6 +11,8 @@
 namespace tizen_webview {
 class Hit_Test;
 class Security_Origin;
+struct Memory_Sample;
+struct Http_Cache_Statistics;
 
 // from ewk_context.h
 typedef void (*Local_File_System_Origins_Get_Callback)(Eina_List *origins, void *user_data);
@@ -22,6 +24,11 @@ typedef void (*Context_Did_Start_Download_Callback)(const char* download_url, vo
 typedef void (*Vibration_Client_Vibrate_Cb)(uint64_t vibration_time, void *user_data);
 typedef void (*Vibration_Client_Vibration_Cancel_Cb)(void *user_data);
 typedef Eina_Bool (*Mime_Override_Callback)(const char *url, const char *current_mime, char **new_mime);
+typedef void (*Context_Session_Restore_Callback)(Evas_Object* view, Eina_Bool success, void* user_data);
+typedef void (*Context_Memory_Usage_Get_Callback)(const Memory_Sample* samples, unsigned count, void* user_data);
+typedef void (*Context_Http_Cache_Statistics_Get_Callback)(const Http_Cache_Statistics* statistics, void* user_data);
+typedef void (*Context_Proxy_Set_Callback)(void* user_data);
+typedef void (*Context_Favicon_Object_Add_Callback)(Evas_Object* icon, void* user_data);
 
 /**
  * Callback for ewk_view_web_app_capable_get
@@ -47,6 +54,14 @@ typedef void (*Web_App_Icon_URL_Get_Callback)(const char* icon_url, void* user_d
  */
 typedef void (*Web_App_Icon_URLs_Get_Callback)(Eina_List *icon_urls, void *user_data);
 
+/**
+ * Callback for ewk_view_screenshot_contents_get_async
+ *
+ * @param image captured snapshot or NULL on failure, ownership is passed to the callee
+ * @param user_data user_data will be passsed when ewk_view_screenshot_contents_get_async is called
+ */
+typedef void (*Web_App_Screenshot_Captured_Callback)(Evas_Object* image, void* user_data);
+
 /**
  * Callback for ewk_view_script_execute
  *
@@ -0,0 +1,26 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TIZEN_WEBVIEW_PUBLIC_TW_FAVICON_CACHE_STATISTICS_H_
+#define TIZEN_WEBVIEW_PUBLIC_TW_FAVICON_CACHE_STATISTICS_H_
+
+#include <stddef.h>
+
+namespace tizen_webview {
+
+// Favicon bitmaps kept in memory, and how they came and went since start.
+// @info    Keep this in sync with Ewk_Icon_Database_Statistics in ewk_context.h
+struct Favicon_Cache_Statistics {
+  unsigned hits;           // bitmaps found in memory
+  unsigned misses;         // bitmaps read from the database
+  unsigned evictions;      // bitmaps dropped from memory
+  size_t evicted_size;     // bytes of the dropped bitmaps
+  unsigned count;          // bitmaps in memory
+  size_t size;             // bytes of the bitmaps in memory
+  size_t capacity;
+};
+
+} // namespace tizen_webview
+
+#endif  // TIZEN_WEBVIEW_PUBLIC_TW_FAVICON_CACHE_STATISTICS_H_
@@ -0,0 +1,23 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TIZEN_WEBVIEW_PUBLIC_TW_FRAME_TIMING_H_
+#define TIZEN_WEBVIEW_PUBLIC_TW_FRAME_TIMING_H_
+
+namespace tizen_webview {
+
+// Timing of one presented frame. Times are in seconds on the monotonic
+// clock.
+// @info    Keep this in sync with Ewk_Frame_Timing in ewk_view.h
+struct Frame_Timing {
+  double swap_time;        // compositor swap reached the view
+  double present_time;     // Evas finished rendering the frame
+  double paint_duration;   // time spent blitting into the Evas GL surface,
+                           // 0 for zero-copy presentation
+  unsigned dropped_frames; // swaps superseded before this frame was shown
+};
+
+} // namespace tizen_webview
+
+#endif  // TIZEN_WEBVIEW_PUBLIC_TW_FRAME_TIMING_H_
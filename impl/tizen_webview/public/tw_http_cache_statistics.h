@@ -0,0 +1,25 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TIZEN_WEBVIEW_PUBLIC_TW_HTTP_CACHE_STATISTICS_H_
+#define TIZEN_WEBVIEW_PUBLIC_TW_HTTP_CACHE_STATISTICS_H_
+
+#include <stddef.h>
+
+namespace tizen_webview {
+
+// Lookups of the HTTP cache tiers since the context was created.
+// @info    Keep this in sync with Ewk_Http_Cache_Statistics in ewk_context.h
+struct Http_Cache_Statistics {
+  unsigned memory_hits;    // entries read from the in-memory hot tier
+  unsigned memory_misses;
+  unsigned disk_hits;      // entries read from the disk cache
+  unsigned disk_misses;    // entries in neither tier
+  size_t memory_size;      // bytes held by the hot tier
+  size_t memory_capacity;
+};
+
+} // namespace tizen_webview
+
+#endif  // TIZEN_WEBVIEW_PUBLIC_TW_HTTP_CACHE_STATISTICS_H_
@@ -0,0 +1,36 @@
+// Copyright 2014 Samsung Electronics. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef TIZEN_WEBVIEW_PUBLIC_TW_MEMORY_SAMPLE_H_
+#define TIZEN_WEBVIEW_PUBLIC_TW_MEMORY_SAMPLE_H_
+
+#include <stddef.h>
+
+namespace tizen_webview {
+
+// The GPU runs in the browser process, no sample is of TW_PROCESS_TYPE_GPU.
+// @info    Keep this in sync with Ewk_Process_Type in ewk_context.h
+enum Process_Type {
+  TW_PROCESS_TYPE_BROWSER,
+  TW_PROCESS_TYPE_RENDERER,
+  TW_PROCESS_TYPE_GPU
+};
+
+// Memory use of one process at one point in time. Sizes are in kB.
+// @info    Keep this in sync with Ewk_Memory_Sample in ewk_context.h
+struct Memory_Sample {
+  double time;             // seconds since the epoch, when /proc was read
+  Process_Type process_type;
+  int pid;
+  size_t rss;              // resident set size
+  size_t pss;              // proportional set size
+  size_t private_dirty;    // private dirty pages
+  size_t web_cache;        // Blink memory cache, renderers only
+  size_t v8_heap_used;     // used V8 heap, renderers only
+  size_t v8_heap_total;    // V8 heap size, renderers only
+};
+
+} // namespace tizen_webview
+
+#endif  // TIZEN_WEBVIEW_PUBLIC_TW_MEMORY_SAMPLE_H_
@@ -45,8 +45,8 @@ void PolicyDecision::Download() {
   impl_->Download();
 }
 
-void PolicyDecision::Suspend() {
-  impl_->Suspend();
+bool PolicyDecision::Suspend() {
+  return impl_->Suspend();
 }
 
 bool PolicyDecision::isDecided() const {
@@ -61,7 +61,7 @@ class PolicyDecision {
   void Use();
   void Ignore();
   void Download();
-  void Suspend();
+  bool Suspend();
 
   bool isDecided() const;
   bool isSuspended() const;
@@ -79,6 +79,18 @@ const char* WebContext::GetProxyUri() const {
   return impl->GetProxyUri();
 }
 
+bool WebContext::SetProxy(const char* uri, const char* bypass_rule,
+                          Context_Proxy_Set_Callback callback,
+                          void* user_data) {
+  return impl->SetProxy(uri, bypass_rule, callback, user_data);
+}
+
+bool WebContext::SetProxyPacUrl(const char* pac_url,
+                                Context_Proxy_Set_Callback callback,
+                                void* user_data) {
+  return impl->SetProxyPacUrl(pac_url, callback, user_data);
+}
+
 void WebContext::AddExtraPluginDir(const char *path) {
   impl->AddExtraPluginDir(path);
 }
@@ -87,6 +99,10 @@ void WebContext::NotifyLowMemory() {
   impl->NotifyLowMemory();
 }
 
+void WebContext::SetMemorySavingMode(bool enable) {
+  impl->SetMemorySavingMode(enable);
+}
+
 bool WebContext::HTTPCustomHeaderAdd(const char* name, const char* value) {
   return impl->HTTPCustomHeaderAdd(name, value);
 }
@@ -107,6 +123,11 @@ tizen_webview::Cache_Model WebContext::GetCacheModel() const {
   return impl->GetCacheModel();
 }
 
+void WebContext::GetHttpCacheStatistics(
+    Context_Http_Cache_Statistics_Get_Callback callback, void* user_data) {
+  impl->GetHttpCacheStatistics(callback, user_data);
+}
+
 void WebContext::SetNetworkCacheEnable(bool enable) {
   impl->SetNetworkCacheEnable(enable);
 }
@@ -185,6 +206,16 @@ Evas_Object * WebContext::AddFaviconObject(const char *uri, Evas *canvas) const
   return impl->AddFaviconObject(uri, canvas);
 }
 
+void WebContext::AddFaviconObjectAsync(const char *uri, Evas *canvas,
+    Context_Favicon_Object_Add_Callback callback, void* user_data) const {
+  impl->AddFaviconObjectAsync(uri, canvas, callback, user_data);
+}
+
+void WebContext::GetFaviconCacheStatistics(
+    Favicon_Cache_Statistics* statistics) const {
+  impl->GetFaviconCacheStatistics(statistics);
+}
+
 void WebContext::SendWidgetInfo(int widget_id, double scale, const std::string &theme, const std::string &encoded_bundle) {
   impl->SendWidgetInfo(widget_id, scale, theme, encoded_bundle);
 }
@@ -217,4 +248,20 @@ void WebContext::StopMemorySampler() const {
   impl->StopMemorySampler();
 }
 
+void WebContext::SetMemorySamplerDumpPath(const char* path) {
+  impl->SetMemorySamplerDumpPath(path);
+}
+
+void WebContext::GetMemoryUsage(Context_Memory_Usage_Get_Callback callback,
+                                void* user_data) {
+  impl->GetMemoryUsage(callback, user_data);
+}
+
+bool WebContext::RestoreSessions(const std::vector<WebView*>& views,
+    const std::vector<std::string>& data, size_t foreground_index,
+    Context_Session_Restore_Callback callback, void* user_data) {
+  return impl->RestoreSessions(views, data, foreground_index, callback,
+                               user_data);
+}
+
 } // namespace tizen_webview
@@ -7,6 +7,7 @@
 #define TIZEN_WEBVIEW_PUBLIC_TW_WEB_CONTEXT_H_
 
 #include <string>
+#include <vector>
 #include <Evas.h>
 
 #include "tizen_webview/public/tw_callbacks.h"
@@ -28,6 +29,8 @@ class BrowserContextEfl;
 
 namespace tizen_webview {
 class URL;
+class WebView;
+struct Favicon_Cache_Statistics;
 
 struct WebContext : public tizen_webview::RefCounted<WebContext> {
  public:
@@ -51,10 +54,15 @@ struct WebContext : public tizen_webview::RefCounted<WebContext> {
   // Proxy URI
   void SetProxyUri(const char* uri);
   const char* GetProxyUri() const;
+  bool SetProxy(const char* uri, const char* bypass_rule,
+      Context_Proxy_Set_Callback callback, void* user_data);
+  bool SetProxyPacUrl(const char* pac_url,
+      Context_Proxy_Set_Callback callback, void* user_data);
 
   // System
   void AddExtraPluginDir(const char *path);
   void NotifyLowMemory();
+  void SetMemorySavingMode(bool enable);
 
   // HTTP Custom Header
   bool HTTPCustomHeaderAdd(const char* name, const char* value);
@@ -64,6 +72,8 @@ struct WebContext : public tizen_webview::RefCounted<WebContext> {
   // Cache Model
   void SetCacheModel(tizen_webview::Cache_Model cm);
   tizen_webview::Cache_Model GetCacheModel() const;
+  void GetHttpCacheStatistics(
+      Context_Http_Cache_Statistics_Get_Callback callback, void* user_data);
 
   // Network Cache
   void SetNetworkCacheEnable(bool enable);
@@ -103,6 +113,9 @@ struct WebContext : public tizen_webview::RefCounted<WebContext> {
   // Favicon
   bool SetFaviconDatabasePath(const char *path);
   Evas_Object *AddFaviconObject(const char *uri, Evas *canvas) const;
+  void AddFaviconObjectAsync(const char *uri, Evas *canvas,
+      Context_Favicon_Object_Add_Callback callback, void* user_data) const;
+  void GetFaviconCacheStatistics(Favicon_Cache_Statistics* statistics) const;
 
   // Widget
   void SendWidgetInfo(int widget_id, double scale, const std::string &theme,
@@ -119,6 +132,14 @@ struct WebContext : public tizen_webview::RefCounted<WebContext> {
   // MemorySampler
   void StartMemorySampler(double timerInterval) const;
   void StopMemorySampler() const;
+  void SetMemorySamplerDumpPath(const char* path);
+  void GetMemoryUsage(Context_Memory_Usage_Get_Callback callback,
+      void* user_data);
+
+  // Session
+  bool RestoreSessions(const std::vector<WebView*>& views,
+      const std::vector<std::string>& data, size_t foreground_index,
+      Context_Session_Restore_Callback callback, void* user_data);
 
   // Set MIME override callback
   static void SetMimeOverrideCallback(Mime_Override_Callback callback);
@@ -308,6 +308,38 @@ Evas_Object* WebView::GetSnapshot(Eina_Rectangle rect) {
   return impl_->GetSnapshot(rect);
 }
 
+bool WebView::GetSnapshotAsync(Eina_Rectangle rect, float scale_factor,
+                               Evas* canvas,
+                               Web_App_Screenshot_Captured_Callback callback,
+                               void* user_data) {
+  return impl_->GetSnapshotAsync(rect, scale_factor, canvas, callback, user_data);
+}
+
+bool WebView::SetFrameTimingEnabled(bool enabled) {
+  return impl_->SetFrameTimingEnabled(enabled);
+}
+
+bool WebView::GetFrameTimings(std::vector<Frame_Timing>* timings) const {
+  return impl_->GetFrameTimings(timings);
+}
+
+bool WebView::NavigationPolicyEnabled() const {
+  return impl_->NavigationPolicyEnabled();
+}
+
+void WebView::SetNavigationPolicyEnabled(bool enabled) {
+  return impl_->SetNavigationPolicyEnabled(enabled);
+}
+
+void WebView::SetResponsePolicyEnabled(bool enabled) {
+  return impl_->SetResponsePolicyEnabled(enabled);
+}
+
+void WebView::SetResponsePolicyFilter(const std::vector<std::string>& mime_types,
+                                      const std::vector<std::string>& url_patterns) {
+  return impl_->SetResponsePolicyFilter(mime_types, url_patterns);
+}
+
 void WebView::SetDrawsTransparentBackground(bool enabled) {
   return impl_->SetDrawsTransparentBackground(enabled);
 }
@@ -369,6 +401,10 @@ void WebView::GetSessionData(const char **data, unsigned *length) const {
   return impl_->GetSessionData(data, length);
 }
 
+void WebView::GetSessionCheckpoint(const char **data, unsigned *length) const {
+  return impl_->GetSessionCheckpoint(data, length);
+}
+
 bool WebView::RestoreFromSessionData(const char *data, unsigned length) {
   return impl_->RestoreFromSessionData(data, length);
 }
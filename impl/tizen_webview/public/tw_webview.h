@@ -9,12 +9,14 @@
 #include <Evas.h>
 #include <string>
 #include <map>
+#include <vector>
 #include "tizen_webview/public/tw_back_forward_history.h"
 #include "tizen_webview/public/tw_back_forward_list_impl.h"
 #include "tizen_webview/public/tw_callbacks.h"
 #include "tizen_webview/public/tw_content_security_policy.h"
 #include "tizen_webview/public/tw_hit_test.h"
 #include "tizen_webview/public/tw_find_options.h"
+#include "tizen_webview/public/tw_frame_timing.h"
 #include "tizen_webview/public/tw_macro.h"
 #include "tizen_webview/public/tw_touch_event.h"
 
@@ -141,6 +143,20 @@ class WebView {
   // > View Snapshot
   // Get snapshot for given |rect|. Return a new created Evas_Object.
   Evas_Object* GetSnapshot(Eina_Rectangle rect);
+  // Get snapshot for given |rect| scaled by |scale_factor| without blocking.
+  // |callback| receives the new Evas_Object created on |canvas|.
+  bool GetSnapshotAsync(Eina_Rectangle rect, float scale_factor, Evas* canvas,
+                        Web_App_Screenshot_Captured_Callback callback,
+                        void* user_data);
+  // > View Frame Timing
+  bool SetFrameTimingEnabled(bool enabled);
+  bool GetFrameTimings(std::vector<Frame_Timing>* timings) const;
+  // > View Navigation Policy
+  bool NavigationPolicyEnabled() const;
+  void SetNavigationPolicyEnabled(bool enabled);
+  void SetResponsePolicyEnabled(bool enabled);
+  void SetResponsePolicyFilter(const std::vector<std::string>& mime_types,
+                               const std::vector<std::string>& url_patterns);
   // > View Misc.
   void SetDrawsTransparentBackground(bool enabled);
 
@@ -162,6 +178,7 @@ class WebView {
 
   // ---- Session
   void GetSessionData(const char **data, unsigned *length) const;
+  void GetSessionCheckpoint(const char **data, unsigned *length) const;
   bool RestoreFromSessionData(const char *data, unsigned length);
 
   // ---- Settings
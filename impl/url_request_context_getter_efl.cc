@@ -16,13 +16,19 @@
 #include "content/public/common/url_constants.h"
 #include "content/browser/net/sqlite_persistent_cookie_store.h"
 #include "net/base/cache_type.h"
+#include "net/base/net_errors.h"
 #include "net/cert/cert_verifier.h"
+#include "net/disk_cache/blockfile/backend_impl.h"
+#include "net/disk_cache/memory/mem_backend_impl.h"
 #include "net/dns/host_resolver.h"
 #include "net/dns/mapped_host_resolver.h"
 #include "net/http/http_auth_handler_factory.h"
 #include "net/http/http_cache.h"
 #include "net/http/http_server_properties_impl.h"
+#include "net/proxy/dhcp_proxy_script_fetcher_factory.h"
+#include "net/proxy/proxy_script_fetcher_impl.h"
 #include "net/proxy/proxy_service.h"
+#include "net/proxy/proxy_service_v8.h"
 #include "net/ssl/channel_id_service.h"
 #include "net/ssl/default_channel_id_store.h"
 #include "net/ssl/ssl_config_service_defaults.h"
@@ -33,6 +39,7 @@
 #include "net/url_request/url_request_intercepting_job_factory.h"
 #include "net/url_request/url_request_job_factory_impl.h"
 #include "network_delegate_efl.h"
+#include "proxy_config_service_efl.h"
 #include "eweb_context.h"
 #include "http_user_agent_settings_efl.h"
 
@@ -71,16 +78,21 @@ URLRequestContextGetterEfl::URLRequestContextGetterEfl(
       io_task_runner_(io_task_runner),
       file_task_runner_(file_task_runner),
       request_interceptors_(request_interceptors.Pass()),
-      net_log_(net_log) {
+      net_log_(net_log),
+      http_cache_memory_size_(0),
+      http_cache_disk_size_(0),
+      http_cache_backend_(NULL),
+      proxy_config_service_efl_(NULL) {
   // Must first be created on the UI thread.
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
 
   if (protocol_handlers)
     std::swap(protocol_handlers_, *protocol_handlers);
 
-  proxy_config_service_.reset(
+  proxy_config_service_.reset(new net::ProxyConfigServiceEfl(
       net::ProxyService::CreateSystemProxyConfigService(
-          io_task_runner, file_task_runner));
+          io_task_runner, file_task_runner)));
+  proxy_config_service_efl_ = proxy_config_service_.get();
 }
 
 URLRequestContextGetterEfl::~URLRequestContextGetterEfl() {
@@ -115,13 +127,6 @@ net::URLRequestContext* URLRequestContextGetterEfl::GetURLRequestContext() {
     storage_->set_cert_verifier(net::CertVerifier::CreateDefault());
     storage_->set_transport_security_state(new net::TransportSecurityState);
 
-    // TODO(jam): use v8 if possible, look at chrome code.
-    storage_->set_proxy_service(
-        net::ProxyService::CreateUsingSystemProxyResolver(
-        proxy_config_service_.release(),
-        0,
-        url_request_context_->net_log()));
-
     storage_->set_ssl_config_service(new net::SSLConfigServiceDefaults);
     storage_->set_http_auth_handler_factory(
         net::HttpAuthHandlerFactory::CreateDefault(host_resolver.get()));
@@ -129,7 +134,7 @@ net::URLRequestContext* URLRequestContextGetterEfl::GetURLRequestContext() {
         scoped_ptr<net::HttpServerProperties>(
             new net::HttpServerPropertiesImpl()));
 
-    net::HttpCache::DefaultBackend* main_backend = NULL;
+    net::HttpCache::BackendFactory* main_backend = NULL;
     scoped_refptr<base::MessageLoopProxy> message_loop_proxy =
         BrowserThread::GetMessageLoopProxyForThread(BrowserThread::CACHE);
     if (base_path_.empty()) {
@@ -137,17 +142,21 @@ net::URLRequestContext* URLRequestContextGetterEfl::GetURLRequestContext() {
           net::MEMORY_CACHE,
           net::CACHE_BACKEND_DEFAULT,
           base::FilePath(),
-          0,
+          http_cache_memory_size_,
           message_loop_proxy.get());
     } else {
       base::FilePath cache_path = base_path_.Append(FILE_PATH_LITERAL("Cache"));
 
-      main_backend = new net::HttpCache::DefaultBackend(
-          net::DISK_CACHE,
-          net::CACHE_BACKEND_DEFAULT,
-          cache_path,
-          0,
-          message_loop_proxy.get());
+      // Blockfile explicitly, ResizeHttpCache() relies on the backend type.
+      // Hot entries are kept in memory in front of it.
+      main_backend = new net::HttpCacheHotTierEfl::Factory(
+          new net::HttpCache::DefaultBackend(
+              net::DISK_CACHE,
+              net::CACHE_BACKEND_BLOCKFILE,
+              cache_path,
+              http_cache_disk_size_,
+              message_loop_proxy.get()),
+          http_cache_memory_size_);
     }
     net::HttpNetworkSession::Params network_session_params;
     network_session_params.cert_verifier =
@@ -156,8 +165,6 @@ net::URLRequestContext* URLRequestContextGetterEfl::GetURLRequestContext() {
         url_request_context_->transport_security_state();
     network_session_params.channel_id_service =
         url_request_context_->channel_id_service();
-    network_session_params.proxy_service =
-        url_request_context_->proxy_service();
     network_session_params.ssl_config_service =
         url_request_context_->ssl_config_service();
     network_session_params.http_auth_handler_factory =
@@ -195,6 +202,20 @@ net::URLRequestContext* URLRequestContextGetterEfl::GetURLRequestContext() {
     network_session_params.host_resolver =
         url_request_context_->host_resolver();
 
+    // PAC scripts are fetched with this context and run in V8, the system
+    // has no resolver of its own.
+    net::DhcpProxyScriptFetcherFactory dhcp_factory;
+    storage_->set_proxy_service(
+        net::CreateProxyServiceUsingV8ProxyResolver(
+            proxy_config_service_.release(),
+            new net::ProxyScriptFetcherImpl(url_request_context_.get()),
+            dhcp_factory.Create(url_request_context_.get()),
+            url_request_context_->host_resolver(),
+            url_request_context_->net_log(),
+            network_delegate_.get()));
+    network_session_params.proxy_service =
+        url_request_context_->proxy_service();
+
     net::HttpCache* main_cache = new net::HttpCache(
         network_session_params, main_backend);
     storage_->set_http_transaction_factory(main_cache);
@@ -269,6 +290,96 @@ void URLRequestContextGetterEfl::SetCookieStoragePath(
   }
 }
 
+void URLRequestContextGetterEfl::SetHttpCacheSizes(int memory_cache_size,
+                                                   int disk_cache_size) {
+  if (!BrowserThread::CurrentlyOn(BrowserThread::IO)) {
+    BrowserThread::PostTask(
+      BrowserThread::IO, FROM_HERE,
+      base::Bind(&URLRequestContextGetterEfl::SetHttpCacheSizes,
+                 this, memory_cache_size, disk_cache_size));
+    return;
+  }
+
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  http_cache_memory_size_ = memory_cache_size;
+  http_cache_disk_size_ = disk_cache_size;
+  // Otherwise the backend is created with these sizes.
+  if (url_request_context_)
+    ResizeHttpCache();
+}
+
+void URLRequestContextGetterEfl::ResizeHttpCache() {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  net::HttpCache* http_cache =
+      url_request_context_->http_transaction_factory()->GetCache();
+  if (!http_cache)
+    return;
+
+  // The backend factory is fixed once the cache exists, so the backend is
+  // created, if it was not yet, and resized.
+  int rv = http_cache->GetBackend(
+      &http_cache_backend_,
+      base::Bind(&URLRequestContextGetterEfl::HttpCacheBackendReady, this));
+  if (rv != net::ERR_IO_PENDING)
+    HttpCacheBackendReady(rv);
+}
+
+void URLRequestContextGetterEfl::HttpCacheBackendReady(int rv) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  if (rv != net::OK || !http_cache_backend_)
+    return;
+
+  // A size of 0 keeps the current one.
+  bool resized = false;
+  switch (http_cache_backend_->GetCacheType()) {
+    case net::MEMORY_CACHE:
+      resized = static_cast<disk_cache::MemBackendImpl*>(
+          http_cache_backend_)->SetMaxSize(http_cache_memory_size_);
+      break;
+    case net::DISK_CACHE: {
+      // The blockfile backend behind the hot tier.
+      net::HttpCacheHotTierEfl* hot_tier =
+          static_cast<net::HttpCacheHotTierEfl*>(http_cache_backend_);
+      hot_tier->SetCapacity(http_cache_memory_size_);
+      resized = static_cast<disk_cache::BackendImpl*>(
+          hot_tier->disk_backend())->SetMaxSize(http_cache_disk_size_);
+      break;
+    }
+    default:
+      break;
+  }
+  if (!resized)
+    LOG(WARNING) << "The HTTP cache could not be resized";
+}
+
+void URLRequestContextGetterEfl::SetProxyConfig(
+    const net::ProxyConfig& config) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  // The proxy service picks it up, whether it exists yet or not.
+  proxy_config_service_efl_->SetProxyConfig(config);
+}
+
+net::HttpCacheHotTierEfl* URLRequestContextGetterEfl::http_cache_hot_tier() {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  // Only disk caches have one, it is created with the backend.
+  if (!url_request_context_ || base_path_.empty())
+    return NULL;
+  net::HttpCache* http_cache =
+      url_request_context_->http_transaction_factory()->GetCache();
+  if (!http_cache)
+    return NULL;
+  return static_cast<net::HttpCacheHotTierEfl*>(
+      http_cache->GetCurrentBackend());
+}
+
+net::HttpCacheHotTierEfl::Stats
+    URLRequestContextGetterEfl::GetHttpCacheStatistics() {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  net::HttpCacheHotTierEfl* hot_tier = http_cache_hot_tier();
+  return hot_tier ? hot_tier->GetStatistics() :
+                    net::HttpCacheHotTierEfl::Stats();
+}
+
 void URLRequestContextGetterEfl::CreateSQLitePersistentCookieStore(
     const base::FilePath& path,
     bool persist_session_cookies)
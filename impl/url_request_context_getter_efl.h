@@ -8,17 +8,23 @@
 
 #include "base/memory/scoped_ptr.h"
 #include "content/public/browser/content_browser_client.h"
+#include "http_cache_hot_tier_efl.h"
 #include "net/url_request/url_request_context_getter.h"
 
 namespace base {
 class MessageLoop;
 }
 
+namespace disk_cache {
+class Backend;
+}
+
 namespace net {
 class HostResolver;
 class NetworkDelegate;
 class NetLog;
-class ProxyConfigService;
+class ProxyConfig;
+class ProxyConfigServiceEfl;
 class URLRequestContextStorage;
 }
 
@@ -48,6 +54,20 @@ class URLRequestContextGetterEfl : public net::URLRequestContextGetter {
                             bool persist_session_cookies,
                             bool file_storage=true);
 
+  // Maximum sizes of the HTTP cache backend in bytes. The memory size is
+  // the memory cache of contexts without a path, and the hot tier in front
+  // of the disk cache of the others. 0 leaves the size to the backend.
+  // Applies to a backend already in use as well.
+  void SetHttpCacheSizes(int memory_cache_size, int disk_cache_size);
+
+  // Applies to requests started afterwards. Called on the IO thread.
+  void SetProxyConfig(const net::ProxyConfig& config);
+
+  // NULL until the disk cache backend is created, and for memory caches.
+  net::HttpCacheHotTierEfl* http_cache_hot_tier();
+  // Hit and miss counts of the tiers, zero for memory caches.
+  net::HttpCacheHotTierEfl::Stats GetHttpCacheStatistics();
+
  protected:
   virtual ~URLRequestContextGetterEfl();
 
@@ -58,6 +78,8 @@ class URLRequestContextGetterEfl : public net::URLRequestContextGetter {
   void CreatePersistentCookieStore(
       const base::FilePath& path,
       bool persist_session_cookies);
+  void ResizeHttpCache();
+  void HttpCacheBackendReady(int rv);
 
   EWebContext& web_context_;
   bool ignore_certificate_errors_;
@@ -69,7 +91,13 @@ class URLRequestContextGetterEfl : public net::URLRequestContextGetter {
   base::FilePath cookie_store_path_;
   scoped_refptr<net::CookieStore> cookie_store_;
 
-  scoped_ptr<net::ProxyConfigService> proxy_config_service_;
+  int http_cache_memory_size_;
+  int http_cache_disk_size_;
+  disk_cache::Backend* http_cache_backend_;
+
+  // Owned by the proxy service once the request context is created.
+  scoped_ptr<net::ProxyConfigServiceEfl> proxy_config_service_;
+  net::ProxyConfigServiceEfl* proxy_config_service_efl_;
   scoped_ptr<net::NetworkDelegate> network_delegate_;
   scoped_ptr<net::URLRequestContextStorage> storage_;
   scoped_ptr<net::URLRequestContext> url_request_context_;
@@ -11,6 +11,7 @@
 #include "API/ewk_user_media_private.h"
 #include "browser/policy_response_delegate_efl.h"
 #include "browser/renderer_host/render_widget_host_view_efl.h"
+#include "browser/web_view_registry_efl.h"
 #include "browser/inputpicker/color_chooser_efl.h"
 #include "common/render_messages_efl.h"
 #include "eweb_view.h"
@@ -21,6 +22,8 @@
 #include "content/public/browser/invalidate_type.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/navigation_entry.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/render_frame_host.h"
 #include "content/public/browser/favicon_status.h"
 #include "content/public/common/favicon_url.h"
 #include "content/common/date_time_suggestion.h"
@@ -28,6 +31,7 @@
 #include "net/http/http_response_headers.h"
 #include "printing/pdf_metafile_skia.h"
 #include "url/gurl.h"
+#include "browser/favicon/favicon_fetch_scheduler.h"
 #include "browser/favicon/favicon_service.h"
 
 #include "tizen_webview/public/tw_web_context.h"
@@ -51,6 +55,16 @@ using namespace ui;
 
 namespace content {
 
+namespace {
+
+FaviconFetchScheduler* GetFaviconFetchScheduler(WebContents& web_contents) {
+  EWebContext* web_context = static_cast<BrowserContextEfl*>(
+      web_contents.GetBrowserContext())->WebContext();
+  return web_context ? web_context->favicon_fetch_scheduler() : NULL;
+}
+
+}  // namespace
+
 void WritePdfDataToFile(printing::PdfMetafileSkia* metafile, const base::FilePath& filename) {
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::FILE));
   DCHECK(metafile);
@@ -82,6 +96,10 @@ WebContentsDelegateEfl::WebContentsDelegateEfl(EWebView* view)
 }
 
 WebContentsDelegateEfl::~WebContentsDelegateEfl() {
+  WebViewRegistryEfl::GetInstance()->UnregisterAll(this);
+  if (FaviconFetchScheduler* scheduler = GetFaviconFetchScheduler(web_contents_))
+    scheduler->Cancel(&web_contents_);
+
   // It's important to delete web_contents_ before dialog_manager_
   // destructor of web contents uses dialog_manager_
 
@@ -135,6 +153,9 @@ void WebContentsDelegateEfl::NavigationStateChanged(
 
 void WebContentsDelegateEfl::LoadingStateChanged(WebContents* source,
                                                  bool to_different_document) {
+  if (FaviconFetchScheduler* scheduler = GetFaviconFetchScheduler(*source))
+    scheduler->LoadingStateChanged(source, source->IsLoading());
+
   if (source->IsLoading())
     web_view_->SmartCallback<EWebViewCallbacks::LoadProgressStarted>().call();
   else
@@ -275,12 +296,68 @@ void WebContentsDelegateEfl::DidStartProvisionalLoadForFrame(RenderFrameHost* re
                                                              const GURL& validated_url,
                                                              bool is_error_page,
                                                              bool is_iframe_srcdoc) {
+  if (!render_frame_host->GetParent())
+    web_view_->CancelAsyncHitTests();
+  // The session is saved ahead of the navigation policy decision, which is
+  // not asked for when the application turned it off.
+  if (!web_view_->NavigationPolicyEnabled())
+    web_view_->SmartCallback<EWebViewCallbacks::SaveSessionData>().call();
   web_view_->SmartCallback<EWebViewCallbacks::ProvisionalLoadStarted>().call();
 }
 
+void WebContentsDelegateEfl::RenderViewCreated(RenderViewHost* render_view_host) {
+  WebViewRegistryEfl::GetInstance()->Register(
+      render_view_host->GetProcess()->GetID(),
+      render_view_host->GetRoutingID(),
+      weak_ptr_factory_.GetWeakPtr());
+
+  // Renderers ask for the navigation policy until told otherwise.
+  if (!web_view_->NavigationPolicyEnabled()) {
+    render_view_host->Send(new EwkViewMsg_SetNavigationPolicyEnabled(
+        render_view_host->GetRoutingID(), false));
+  }
+  PublishSettings();
+}
+
+void WebContentsDelegateEfl::RenderViewDeleted(RenderViewHost* render_view_host) {
+  WebViewRegistryEfl::GetInstance()->Unregister(
+      render_view_host->GetProcess()->GetID(),
+      render_view_host->GetRoutingID());
+}
+
+void WebContentsDelegateEfl::RenderFrameCreated(RenderFrameHost* render_frame_host) {
+  WebViewRegistryEfl::GetInstance()->Register(
+      render_frame_host->GetProcess()->GetID(),
+      render_frame_host->GetRoutingID(),
+      weak_ptr_factory_.GetWeakPtr());
+}
+
+void WebContentsDelegateEfl::PublishSettings() {
+  WebViewRegistryEfl::Settings settings;
+  settings.navigation_policy_enabled = web_view_->NavigationPolicyEnabled();
+  settings.response_policy_filter = web_view_->response_policy_filter();
+  EWebContext* web_context = static_cast<BrowserContextEfl*>(
+      web_contents_.GetBrowserContext())->WebContext();
+  if (web_context) {
+    settings.custom_headers = web_context->GetHTTPCustomHeadersEflMap();
+    settings.download_start_callback =
+        web_context->DidStartDownloadCallback() != NULL;
+  }
+  WebViewRegistryEfl::GetInstance()->PublishSettings(this, settings);
+}
+
+void WebContentsDelegateEfl::RenderFrameDeleted(RenderFrameHost* render_frame_host) {
+  WebViewRegistryEfl::GetInstance()->Unregister(
+      render_frame_host->GetProcess()->GetID(),
+      render_frame_host->GetRoutingID());
+}
+
 void WebContentsDelegateEfl::DidCommitProvisionalLoadForFrame(RenderFrameHost* render_frame_host,
                                                               const GURL& url,
                                                               ui::PageTransition transition_type) {
+  // The renderer pushes the regions of the new document once it is laid out.
+  if (!render_frame_host->GetParent())
+    web_view_->InvalidateHitTestRegions();
   web_view_->SmartCallback<EWebViewCallbacks::LoadCommitted>().call();
 }
 
@@ -326,15 +403,21 @@ void WebContentsDelegateEfl::DidFinishLoad(RenderFrameHost* render_frame_host,
   FaviconService fs;
   fs.SetFaviconURLForPageURL(favicon.url, validated_url);
 
-  // download favicon if there is no such in database
+  // download favicon if there is no such in database, pages of the context
+  // which wait for the same icon share the download
   if (!fs.ExistsForFaviconURL(favicon.url)) {
     LOG(ERROR) << "[DidFinishLoad] :: no favicon in database for URL: "
                << favicon.url.spec();
-    favicon_downloader_.reset(new FaviconDownloader(&web_contents_,
-                                                   favicon.url,
-                                                   base::Bind(&WebContentsDelegateEfl::DidDownloadFavicon,
-                                                              weak_ptr_factory_.GetWeakPtr())));
-    favicon_downloader_->Start();
+    RenderWidgetHostView* view = web_contents_.GetRenderWidgetHostView();
+    if (FaviconFetchScheduler* scheduler = GetFaviconFetchScheduler(web_contents_)) {
+      scheduler->Fetch(&web_contents_,
+                       favicon.url,
+                       view && view->IsShowing() ?
+                           FaviconFetchScheduler::PRIORITY_HIGH :
+                           FaviconFetchScheduler::PRIORITY_LOW,
+                       base::Bind(&WebContentsDelegateEfl::DidDownloadFavicon,
+                                  weak_ptr_factory_.GetWeakPtr()));
+    }
   } else {
     web_view_->SmartCallback<EWebViewCallbacks::IconReceived>().call();
   }
@@ -364,10 +447,8 @@ void WebContentsDelegateEfl::DidUpdateFaviconURL(const std::vector<FaviconURL>&
 }
 
 void WebContentsDelegateEfl::DidDownloadFavicon(bool success, const GURL& icon_url, const SkBitmap& bitmap) {
-  favicon_downloader_.reset();
+  // the scheduler stored the bitmap
   if (success) {
-    FaviconService fs;
-    fs.SetBitmapForFaviconURL(bitmap, icon_url);
     // emit "icon,received"
     web_view_->SmartCallback<EWebViewCallbacks::IconReceived>().call();
   }
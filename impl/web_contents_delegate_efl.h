@@ -20,13 +20,13 @@
 #include "content/public/browser/web_contents_observer.h"
 #include "content/browser/web_contents/web_contents_impl.h"
 #include "url/gurl.h"
-#include "browser/favicon/favicon_downloader.h"
 #include "third_party/WebKit/Source/platform/text/TextDirection.h"
 #include "ui/base/ime/text_input_type.h"
 
 #include "tizen_webview/public/tw_content_security_policy.h"
 
 class DidPrintPagesParams;
+class SkBitmap;
 
 namespace tizen_webview {
 class WrtIpcMessageData;
@@ -125,6 +125,13 @@ class WebContentsDelegateEfl
                              const GURL& validated_url) override;
 
   virtual void DidStartLoading(RenderViewHost* render_view_host) override;
+  virtual void RenderViewCreated(RenderViewHost* render_view_host) override;
+  virtual void RenderViewDeleted(RenderViewHost* render_view_host) override;
+  virtual void RenderFrameCreated(RenderFrameHost* render_frame_host) override;
+  virtual void RenderFrameDeleted(RenderFrameHost* render_frame_host) override;
+  // Hands the view's and its context's settings requests depend on to
+  // WebViewRegistryEfl, for the IO thread.
+  void PublishSettings();
   virtual void DidUpdateFaviconURL(const std::vector<FaviconURL>& candidates) override;
   virtual void DidDownloadFavicon(bool success, const GURL& icon_url, const SkBitmap& bitmap);
 
@@ -193,7 +200,6 @@ class WebContentsDelegateEfl
   bool should_open_new_window_;
   JavaScriptDialogManagerEfl* dialog_manager_;
   int forward_backward_list_count_;
-  scoped_ptr<FaviconDownloader> favicon_downloader_;
   base::WeakPtrFactory<WebContentsDelegateEfl> weak_ptr_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(WebContentsDelegateEfl);
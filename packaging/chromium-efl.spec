@@ -214,7 +214,8 @@ ninja %{_smp_mflags} -C"%{OUTPUT_FOLDER}" angle_unittests env_chromium_unittests
   gfx_unittests printing_unittests events_unittests ppapi_unittests jingle_unittests \
   flip_in_mem_edsm_server_unittests breakpad_unittests dbus_unittests libphonenumber_unittests \
   base_unittests ffmpeg_unittests gin_unittests net_unittests snapshot_unittests \
-  google_apis_unittests
+  google_apis_unittests efl_message_pump_unittests efl_favicon_fetch_scheduler_unittests \
+  efl_web_view_registry_unittests
 # TODO: Fix compilation of the following tests content_unittests cc_unittests shell_dialogs_unittests
 # gpu_unittests compositor_unittests media_unittests
 %endif